@@ -0,0 +1,181 @@
+// libE57Format benchmarking
+// SPDX-License-Identifier: BSL-1.0
+
+// Microbenchmarks for the bit-pack integer decode/encode kernels, which dominate
+// CompressedVector read/write time.  Register widths are chosen the same way
+// Decoder/EncoderFactory choose them for each bit width.
+
+#include <climits>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Decoder.h"
+#include "Encoder.h"
+
+namespace
+{
+   constexpr size_t cRecordCount = 64 * 1024;
+
+   const char *cScratchFileName = "./bench_scratch.e57";
+
+   /// A throwaway write-mode ImageFile; SourceDestBuffers cannot be constructed without one.
+   struct ScratchImageFile
+   {
+      ScratchImageFile() : imf( cScratchFileName, "w" )
+      {
+      }
+
+      ~ScratchImageFile()
+      {
+         try
+         {
+            imf.cancel();
+         }
+         catch ( ... )
+         {
+         }
+
+         std::remove( cScratchFileName );
+      }
+
+      e57::ImageFile imf;
+   };
+
+   /// Deterministic pseudo-random packed input covering cRecordCount records
+   std::vector<char> makePackedInput( unsigned bitsPerRecord )
+   {
+      std::mt19937 gen( 42 );
+
+      const size_t byteCount = ( cRecordCount * bitsPerRecord + 7 ) / 8 + 8;
+
+      std::vector<char> packed( byteCount );
+
+      for ( auto &byte : packed )
+      {
+         byte = static_cast<char>( gen() );
+      }
+
+      return packed;
+   }
+
+   int64_t maximumForBits( unsigned bits )
+   {
+      return ( int64_t( 1 ) << bits ) - 1;
+   }
+
+   /// Decode raw integers into an int64 destination (no scaling)
+   template <typename RegisterT> void BM_DecodeInteger( benchmark::State &state )
+   {
+      const auto bits = static_cast<unsigned>( state.range( 0 ) );
+
+      ScratchImageFile scratch;
+
+      std::vector<int64_t> values( cRecordCount );
+      std::vector<e57::SourceDestBuffer> dbufs;
+
+      dbufs.emplace_back( scratch.imf, "value", values.data(), cRecordCount, true );
+
+      e57::BitpackIntegerDecoder<RegisterT> decoder( false, 0, dbufs[0], 0, maximumForBits( bits ),
+                                                     1.0, 0.0, UINT64_MAX );
+
+      const std::vector<char> packed = makePackedInput( bits );
+
+      for ( auto _ : state )
+      {
+         decoder.destBufferSetNew( dbufs );
+         decoder.stateReset();
+
+         benchmark::DoNotOptimize(
+            decoder.inputProcessAligned( packed.data(), 0, cRecordCount * bits ) );
+      }
+
+      state.SetItemsProcessed( state.iterations() * cRecordCount );
+      state.SetBytesProcessed( state.iterations() * ( cRecordCount * bits / CHAR_BIT ) );
+   }
+
+   /// Decode scaled integers into a double destination (conversion with scaling)
+   template <typename RegisterT> void BM_DecodeScaledInteger( benchmark::State &state )
+   {
+      const auto bits = static_cast<unsigned>( state.range( 0 ) );
+
+      ScratchImageFile scratch;
+
+      std::vector<double> values( cRecordCount );
+      std::vector<e57::SourceDestBuffer> dbufs;
+
+      dbufs.emplace_back( scratch.imf, "value", values.data(), cRecordCount, true, true );
+
+      e57::BitpackIntegerDecoder<RegisterT> decoder( true, 0, dbufs[0], 0, maximumForBits( bits ),
+                                                     0.001, 0.0, UINT64_MAX );
+
+      const std::vector<char> packed = makePackedInput( bits );
+
+      for ( auto _ : state )
+      {
+         decoder.destBufferSetNew( dbufs );
+         decoder.stateReset();
+
+         benchmark::DoNotOptimize(
+            decoder.inputProcessAligned( packed.data(), 0, cRecordCount * bits ) );
+      }
+
+      state.SetItemsProcessed( state.iterations() * cRecordCount );
+      state.SetBytesProcessed( state.iterations() * ( cRecordCount * bits / CHAR_BIT ) );
+   }
+
+   /// Encode int64 source values into packed integers
+   template <typename RegisterT> void BM_EncodeInteger( benchmark::State &state )
+   {
+      const auto bits = static_cast<unsigned>( state.range( 0 ) );
+
+      ScratchImageFile scratch;
+
+      const int64_t maximum = maximumForBits( bits );
+
+      std::mt19937_64 gen( 42 );
+      std::vector<int64_t> values( cRecordCount );
+
+      for ( auto &value : values )
+      {
+         value = static_cast<int64_t>( gen() ) & maximum;
+      }
+
+      std::vector<e57::SourceDestBuffer> sbufs;
+
+      sbufs.emplace_back( scratch.imf, "value", values.data(), cRecordCount, true );
+
+      const auto outputMaxSize =
+         static_cast<unsigned>( cRecordCount * bits / CHAR_BIT + sizeof( RegisterT ) );
+
+      e57::BitpackIntegerEncoder<RegisterT> encoder( false, 0, sbufs[0], outputMaxSize, 0, maximum,
+                                                     1.0, 0.0 );
+
+      for ( auto _ : state )
+      {
+         encoder.sourceBufferSetNew( sbufs );
+
+         benchmark::DoNotOptimize( encoder.processRecords( cRecordCount ) );
+
+         encoder.outputClear();
+      }
+
+      state.SetItemsProcessed( state.iterations() * cRecordCount );
+      state.SetBytesProcessed( state.iterations() * ( cRecordCount * bits / CHAR_BIT ) );
+   }
+}
+
+// Register widths mirror DecoderFactory: <=8 bits use a uint8_t register, <=16 uint16_t,
+// <=32 uint32_t.
+BENCHMARK_TEMPLATE( BM_DecodeInteger, uint8_t )->Arg( 8 );
+BENCHMARK_TEMPLATE( BM_DecodeInteger, uint16_t )->Arg( 12 )->Arg( 16 );
+BENCHMARK_TEMPLATE( BM_DecodeInteger, uint32_t )->Arg( 24 )->Arg( 32 );
+
+BENCHMARK_TEMPLATE( BM_DecodeScaledInteger, uint16_t )->Arg( 12 )->Arg( 16 );
+BENCHMARK_TEMPLATE( BM_DecodeScaledInteger, uint32_t )->Arg( 24 )->Arg( 32 );
+
+BENCHMARK_TEMPLATE( BM_EncodeInteger, uint8_t )->Arg( 8 );
+BENCHMARK_TEMPLATE( BM_EncodeInteger, uint16_t )->Arg( 12 )->Arg( 16 );
+BENCHMARK_TEMPLATE( BM_EncodeInteger, uint32_t )->Arg( 24 )->Arg( 32 );
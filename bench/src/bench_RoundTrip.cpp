@@ -0,0 +1,195 @@
+// libE57Format benchmarking
+// SPDX-License-Identifier: BSL-1.0
+
+// End-to-end throughput benchmarks: full write and full read of a synthetic scan through
+// the simple API, at a few representative prototypes.  These are the macro numbers
+// (points/s, MB/s of file data) used to compare releases; the kernels measured in
+// bench_Bitpack.cpp explain where the time goes.
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "E57SimpleReader.h"
+#include "E57SimpleWriter.h"
+
+namespace
+{
+   constexpr uint64_t cPointCount = 1024 * 1024;
+
+   const e57::ustring cBenchFileName = "./bench_roundtrip.e57";
+
+   /// The prototype variants exercised; passed as the benchmark argument.
+   enum Prototype
+   {
+      XYZDouble = 0,         // cartesian xyz stored as doubles
+      XYZIntensityRGB = 1,   // xyz + intensity + 8-bit colour
+      XYZScaledInteger = 2   // xyz stored as scaled integers (millimetre resolution)
+   };
+
+   e57::Data3D makeHeader( int64_t prototype )
+   {
+      e57::Data3D header;
+
+      header.guid = "Round Trip Benchmark Scan GUID";
+      header.pointCount = cPointCount;
+
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      switch ( prototype )
+      {
+         case XYZIntensityRGB:
+         {
+            header.pointFields.intensityField = true;
+            header.intensityLimits.intensityMaximum = 1.0;
+
+            header.pointFields.colorRedField = true;
+            header.pointFields.colorGreenField = true;
+            header.pointFields.colorBlueField = true;
+
+            header.colorLimits.colorRedMaximum = 255;
+            header.colorLimits.colorGreenMaximum = 255;
+            header.colorLimits.colorBlueMaximum = 255;
+            break;
+         }
+
+         case XYZScaledInteger:
+         {
+            header.pointFields.pointRangeNodeType = e57::NumericalNodeType::ScaledInteger;
+            header.pointFields.pointRangeScale = 0.001;
+            header.pointFields.pointRangeMinimum = -1.0;
+            header.pointFields.pointRangeMaximum = 1.0;
+            break;
+         }
+
+         default:
+         {
+            break;
+         }
+      }
+
+      return header;
+   }
+
+   /// Deterministic synthetic point content inside the unit cube
+   void fillPoints( e57::Data3DPointsDouble &pointsData, int64_t prototype )
+   {
+      std::mt19937 gen( 42 );
+      std::uniform_real_distribution<double> dist( -1.0, 1.0 );
+
+      for ( uint64_t i = 0; i < cPointCount; ++i )
+      {
+         pointsData.cartesianX[i] = dist( gen );
+         pointsData.cartesianY[i] = dist( gen );
+         pointsData.cartesianZ[i] = dist( gen );
+
+         if ( prototype == XYZIntensityRGB )
+         {
+            pointsData.intensity[i] = ( dist( gen ) + 1.0 ) / 2.0;
+
+            pointsData.colorRed[i] = static_cast<uint8_t>( gen() );
+            pointsData.colorGreen[i] = static_cast<uint8_t>( gen() );
+            pointsData.colorBlue[i] = static_cast<uint8_t>( gen() );
+         }
+      }
+   }
+
+   uint64_t fileSize( const e57::ustring &fileName )
+   {
+      std::ifstream file( fileName, std::ios::binary | std::ios::ate );
+
+      return static_cast<uint64_t>( file.tellg() );
+   }
+
+   void writeBenchFile( int64_t prototype )
+   {
+      e57::WriterOptions options;
+      options.guid = "Round Trip Benchmark File GUID";
+
+      e57::Writer writer( cBenchFileName, options );
+
+      e57::Data3D header = makeHeader( prototype );
+      e57::Data3DPointsDouble pointsData( header );
+
+      fillPoints( pointsData, prototype );
+
+      writer.WriteData3DData( header, pointsData );
+      writer.Close();
+   }
+
+   void BM_WritePoints( benchmark::State &state )
+   {
+      const int64_t prototype = state.range( 0 );
+
+      e57::Data3D header = makeHeader( prototype );
+      e57::Data3DPointsDouble pointsData( header );
+
+      fillPoints( pointsData, prototype );
+
+      for ( auto _ : state )
+      {
+         e57::WriterOptions options;
+         options.guid = "Round Trip Benchmark File GUID";
+
+         e57::Writer writer( cBenchFileName, options );
+
+         writer.WriteData3DData( header, pointsData );
+         writer.Close();
+      }
+
+      state.SetItemsProcessed( state.iterations() * cPointCount );
+      state.SetBytesProcessed( state.iterations() * fileSize( cBenchFileName ) );
+
+      std::remove( cBenchFileName.c_str() );
+   }
+
+   void BM_ReadPoints( benchmark::State &state )
+   {
+      const int64_t prototype = state.range( 0 );
+
+      writeBenchFile( prototype );
+
+      for ( auto _ : state )
+      {
+         e57::Reader reader( cBenchFileName, {} );
+
+         e57::Data3D header;
+         reader.ReadData3D( 0, header );
+
+         e57::Data3DPointsDouble pointsData( header );
+
+         auto vectorReader = reader.SetUpData3DPointsData( 0, header.pointCount, pointsData );
+
+         uint64_t totalRead = 0;
+         uint64_t count = 0;
+
+         while ( ( count = vectorReader.read() ) > 0 )
+         {
+            totalRead += count;
+         }
+
+         vectorReader.close();
+
+         benchmark::DoNotOptimize( totalRead );
+      }
+
+      state.SetItemsProcessed( state.iterations() * cPointCount );
+      state.SetBytesProcessed( state.iterations() * fileSize( cBenchFileName ) );
+
+      std::remove( cBenchFileName.c_str() );
+   }
+}
+
+BENCHMARK( BM_WritePoints )
+   ->Arg( XYZDouble )
+   ->Arg( XYZIntensityRGB )
+   ->Arg( XYZScaledInteger );
+
+BENCHMARK( BM_ReadPoints )
+   ->Arg( XYZDouble )
+   ->Arg( XYZIntensityRGB )
+   ->Arg( XYZScaledInteger );
@@ -0,0 +1,25 @@
+// libE57Format benchmarking
+// SPDX-License-Identifier: BSL-1.0
+
+#include <iostream>
+
+#include <benchmark/benchmark.h>
+
+#include "E57Version.h"
+
+int main( int argc, char **argv )
+{
+   std::cout << "e57Format version: " << e57::Version::library() << std::endl;
+   std::cout << "ASTM version: " << e57::Version::astm() << std::endl;
+
+   ::benchmark::Initialize( &argc, argv );
+
+   if ( ::benchmark::ReportUnrecognizedArguments( argc, argv ) )
+   {
+      return 1;
+   }
+
+   ::benchmark::RunSpecifiedBenchmarks();
+
+   return 0;
+}
@@ -33,6 +33,8 @@
 
 #include <cfloat>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <vector>
 
@@ -147,7 +149,17 @@ namespace e57
       ChecksumNone = 0,    ///< Do not verify the checksums. (fast)
       ChecksumSparse = 25, ///< Only verify 25% of the checksums. The last block is always verified.
       ChecksumHalf = 50,   ///< Only verify 50% of the checksums. The last block is always verified.
-      ChecksumAll = 100    ///< Verify all checksums. This is the default. (slow)
+      ChecksumAll = 100,   ///< Verify all checksums. This is the default. (slow)
+
+      /// Verify the file header and XML section synchronously at open, then verify data pages on
+      /// a background task instead of on the decode path. See
+      /// ImageFile::setChecksumMismatchCallback() and ImageFile::checksumVerifyPending().
+      ChecksumTiered = -1,
+
+      /// Verify every checksum (like ChecksumAll), but fan the CRC math of large reads out
+      /// across the worker pool so the reading thread does not verify multi-page spans alone.
+      /// Mismatches surface as ::ErrorBadChecksum from the read, exactly like ChecksumAll.
+      ChecksumParallel = -2
    };
 
    /// @brief Specifies the percentage of checksums which are verified when reading an ImageFile
@@ -181,6 +193,31 @@ namespace e57
 
    ///@}
 
+   /// @brief Instrumentation points fired from the read/write hot paths
+   /// @see e57::SetTraceHandler
+   enum class TraceEvent
+   {
+      PacketRead,  ///< a packet was read from the file; offset = logical offset, count = bytes
+      DecodeStart, ///< a decode pass began; offset = records decoded so far, count = 0
+      DecodeEnd,   ///< a decode pass finished; offset = records decoded so far, count = records
+                   ///< decoded by this pass
+      PacketWrite  ///< a packet was written to the file; offset = logical offset, count = bytes
+   };
+
+   /// @brief Callback invoked at each instrumentation point
+   /// @details A plain function pointer (not std::function) so firing a disabled hook costs one
+   /// predictable branch. The handler may be called concurrently from multiple threads and must
+   /// not call back into the library.
+   using TraceHandler = void ( * )( TraceEvent event, uint64_t offset, uint64_t count,
+                                    void *userData );
+
+   /// @brief Registers a process-wide tracing callback, replacing any previous one
+   /// @details Intended for correlating E57 activity with external profiling or storage-layer
+   /// traces without recompiling. Pass nullptr to disable tracing (the default).
+   /// @param [in] handler The callback to invoke, or nullptr to disable
+   /// @param [in] userData Opaque pointer passed unchanged to every callback invocation
+   E57_DLL void SetTraceHandler( TraceHandler handler, void *userData = nullptr );
+
    /// @brief The URI of ASTM E57 v1.0 standard XML namespace
    /// @note Even though this URI does not point to a valid document, the standard (section 8.4.2.3)
    /// says that this is the required namespace.
@@ -190,6 +227,13 @@ namespace e57
    [[deprecated( "Will be removed in 4.0. Use e57::VERSION_1_0_URI." )]] // TODO Remove in 4.0
    constexpr auto E57_V1_0_URI = VERSION_1_0_URI;
 
+   /// @brief The URI of the vendor extension for zstd-compressed data packets
+   /// @note Registered (with prefix "zstd") in any file written with
+   /// CompressedVectorWriter::setZstdPackets enabled, so readers can tell why such a file is
+   /// rejected when the library was built without the E57_ZSTD option.
+   constexpr char ZSTD_PACKETS_URI[] =
+      "https://github.com/asmaloney/libE57Format/wiki/zstd-packets-extension";
+
    /// @cond documentNonPublic   The following aren't documented
    // Minimum and maximum values for integers
    constexpr uint8_t UINT8_MIN = 0U;
@@ -419,6 +463,23 @@ public:
       /// @endcond
    };
 
+   /// @brief Minimum/maximum/count of one field, accumulated while records stream through a
+   /// CompressedVectorReader or CompressedVectorWriter (see setStatisticsEnabled())
+   struct E57_DLL FieldStatistics
+   {
+      /// Path name of the field in the prototype
+      ustring pathName;
+
+      /// Smallest value seen, as a double; DBL_MAX until a value has been accumulated
+      double minimum = DBL_MAX;
+
+      /// Largest value seen, as a double; -DBL_MAX until a value has been accumulated
+      double maximum = -DBL_MAX;
+
+      /// Number of values accumulated
+      uint64_t count = 0;
+   };
+
    class E57_DLL CompressedVectorReader
    {
    public:
@@ -426,7 +487,12 @@ public:
 
       unsigned read();
       unsigned read( std::vector<SourceDestBuffer> &dbufs );
-      void seek( int64_t recordNumber ); // !!! not implemented yet
+      std::future<unsigned> readAsync();
+      std::future<unsigned> readAsync( std::vector<SourceDestBuffer> &dbufs );
+      void setDecodeThreadCount( unsigned threadCount );
+      void setStatisticsEnabled( bool enabled );
+      std::vector<FieldStatistics> statistics() const;
+      void seek( int64_t recordNumber );
       void close();
       bool isOpen();
       CompressedVectorNode compressedVectorNode() const;
@@ -454,6 +520,13 @@ public:
 
       void write( size_t recordCount );
       void write( std::vector<SourceDestBuffer> &sbufs, size_t recordCount );
+      std::future<void> writeAsync( size_t recordCount );
+      std::future<void> writeAsync( std::vector<SourceDestBuffer> &sbufs, size_t recordCount );
+      void setEncodeThreadCount( unsigned threadCount );
+      void setPipelinedWrite( bool enabled );
+      void setZstdPackets( bool enabled );
+      void setStatisticsEnabled( bool enabled );
+      std::vector<FieldStatistics> statistics() const;
       void close();
       bool isOpen();
       CompressedVectorNode compressedVectorNode() const;
@@ -474,6 +547,21 @@ public:
       /// @endcond
    };
 
+   /// @brief One decode-aligned split point in a CompressedVectorNode's binary section.
+   ///
+   /// Decoding can start fresh at @ref recordNumber without reading any earlier packet, so the
+   /// records between two consecutive split points (or between the last split point and the end
+   /// of the vector) can be read independently of the rest of the section.
+   /// @see CompressedVectorNode::partitionPoints
+   struct E57_DLL RecordSplitPoint
+   {
+      /// Record number of the first record of the chunk (the first split point is record 0)
+      uint64_t recordNumber = 0;
+
+      /// Physical file offset of the chunk's first data packet
+      uint64_t chunkPhysicalOffset = 0;
+   };
+
    class E57_DLL CompressedVectorNode
    {
    public:
@@ -489,6 +577,12 @@ public:
       CompressedVectorWriter writer( std::vector<SourceDestBuffer> &sbufs );
       CompressedVectorReader reader( const std::vector<SourceDestBuffer> &dbufs );
 
+      // Packet-level copy into another file (no decode/re-encode)
+      CompressedVectorNode copyTo( const ImageFile &destImageFile ) const;
+
+      // Decode-aligned split points for partitioned reading
+      std::vector<RecordSplitPoint> partitionPoints() const;
+
       // Up/Down cast conversion
       operator Node() const;
       explicit CompressedVectorNode( const Node &n );
@@ -695,6 +789,11 @@ public:
       void read( uint8_t *buf, int64_t start, size_t count );
       void write( uint8_t *buf, int64_t start, size_t count );
 
+      // Physical location of the blob data (for mmap-style access)
+      uint64_t physicalOffset() const;
+      uint64_t physicalLength() const;
+      std::vector<uint8_t> readAll() const;
+
       // Up/Down cast conversion
       operator Node() const;
       explicit BlobNode( const Node &n );
@@ -727,6 +826,59 @@ public:
       /// @endcond
    };
 
+   /// @brief Abstract positionless byte source for reading an E57 file from custom storage.
+   ///
+   /// Implement this to open files that are not on a local filesystem - object storage,
+   /// network services, archives - without downloading them first.  The library fetches
+   /// only the byte ranges it actually needs (the header, the XML section, and the
+   /// packets of the vectors being read), so one scan of a large remote file costs only
+   /// that scan's ranges.
+   ///
+   /// readAt() may be called concurrently from several threads once the file is open
+   /// (packet cache misses from parallel readers each issue their own range request),
+   /// so implementations can and should serve overlapping requests in parallel - e.g.
+   /// as simultaneous HTTP range GETs.
+   class E57_DLL ReadBackend
+   {
+   public:
+      virtual ~ReadBackend() = default;
+
+      /// @brief Total size of the underlying byte stream.
+      virtual uint64_t length() = 0;
+
+      /// @brief Fill @p buffer with @p count bytes starting at @p offset.
+      ///
+      /// Must transfer all @p count bytes or throw; short reads are not retried.
+      /// The requested range is always within length().
+      virtual void readAt( uint64_t offset, char *buffer, size_t count ) = 0;
+   };
+
+   /// @brief Live and peak byte counts for the memory an ImageFile holds, per subsystem.
+   ///
+   /// Returned by ImageFile::memoryUsage().  Counters are bumped at the allocation
+   /// choke points, so reading them costs nothing on the data paths.  Peaks are
+   /// high-water marks since the file was opened.
+   struct E57_DLL MemoryUsage
+   {
+      /// Metadata tree storage.  Covers trees parsed from a file (which are arena
+      /// allocated); a tree being built for writing is allocated node by node and
+      /// reports zero here.
+      uint64_t nodeTreeBytes = 0;
+      uint64_t nodeTreePeakBytes = 0;
+
+      /// Packet cache buffers of the open CompressedVectorReader sessions
+      uint64_t packetCacheBytes = 0;
+      uint64_t packetCachePeakBytes = 0;
+
+      /// Per-channel decoder staging buffers of the open reader sessions
+      uint64_t decodeBufferBytes = 0;
+      uint64_t decodeBufferPeakBytes = 0;
+
+      /// Per-channel encoder staging buffers of the open CompressedVectorWriter sessions
+      uint64_t encodeBufferBytes = 0;
+      uint64_t encodeBufferPeakBytes = 0;
+   };
+
    class E57_DLL ImageFile
    {
    public:
@@ -735,6 +887,15 @@ public:
                  ReadChecksumPolicy checksumPolicy = ChecksumAll );
       ImageFile( const char *input, uint64_t size,
                  ReadChecksumPolicy checksumPolicy = ChecksumAll );
+      explicit ImageFile( const std::shared_ptr<ReadBackend> &backend,
+                          ReadChecksumPolicy checksumPolicy = ChecksumAll );
+      explicit ImageFile( std::vector<char> &outBuffer,
+                          ReadChecksumPolicy checksumPolicy = ChecksumAll );
+
+      static ImageFile openAsync(
+         const ustring &fname, ReadChecksumPolicy checksumPolicy = ChecksumAll,
+         const std::function<void( int64_t scanIndex )> &scanDiscovered = {} );
+      std::shared_future<void> xmlParseComplete() const;
 
       StructureNode root() const;
       void close();
@@ -744,6 +905,17 @@ public:
       ustring fileName() const;
       int writerCount() const;
       int readerCount() const;
+      void preallocate( uint64_t expectedSizeBytes );
+      void setMemoryBudget( uint64_t budgetBytes );
+      uint64_t memoryBudget() const;
+      void setChecksumMismatchCallback( std::function<void( const E57Exception &ex )> callback );
+      uint64_t checksumVerifyPending() const;
+      MemoryUsage memoryUsage() const;
+      bool enableSharedPacketCache();
+      bool enableMappedRead();
+      bool enableDirectRead();
+      void setPacketReadAhead( unsigned packetCount );
+      void setPacketCacheSize( unsigned packetCount );
 
       // Manipulate registered extensions in the file
       void extensionsAdd( const ustring &prefix, const ustring &uri );
@@ -787,4 +959,57 @@ public:
       std::shared_ptr<ImageFileImpl> impl_;
       /// @endcond
    };
+
+   /// @brief Runs one batch of tasks for the library's parallel features.
+   ///
+   /// The runner must invoke task( 0 ) through task( taskCount - 1 ), each exactly
+   /// once, and must not return until every invocation has finished.  Invocations may
+   /// run concurrently, in any order, and on any thread (including the calling
+   /// thread).  The tasks never throw.
+   using TaskRunner = std::function<void(
+      unsigned taskCount, const std::function<void( unsigned taskIndex )> &task )>;
+
+   /// @brief Replaces the thread pool behind the library's parallel features.
+   ///
+   /// By default all parallel work (parallel decode and encode, the Reader::ReadAll*
+   /// functions) shares one process-wide pool sized to the hardware, so a process with
+   /// many open files keeps a bounded thread count.  Applications that already own an
+   /// executor can route the work through it instead; per-operation limits (for example
+   /// CompressedVectorReader::setDecodeThreadCount()) still cap each batch.  Passing an
+   /// empty runner restores the built-in pool.  Not safe to call while parallel
+   /// operations are in flight.
+   E57_DLL void SetTaskRunner( TaskRunner runner );
+
+   /// @brief Caps the total memory the library's packet read caches may use, in bytes.
+   ///
+   /// Every CompressedVectorReader owns a cache of recently read (and, for compressed
+   /// packets, decompressed) 64 KB packets.  With many files and readers open at once
+   /// that memory is additive; under a budget, each cache opened afterwards claims only
+   /// its share of what is left, down to a small floor per cache, so the aggregate stays
+   /// bounded while each cache keeps its own LRU.  0 (the default) means unlimited.  The
+   /// budget is advisory: caches already open keep their memory until their reader
+   /// closes.
+   E57_DLL void SetPacketCacheBudget( uint64_t bytes );
+
+   /// @brief Allocates a block of at least the requested bytes (see SetMemoryAllocator())
+   using MemoryAllocator = std::function<void *( size_t bytes )>;
+
+   /// @brief Releases a block obtained from the matching MemoryAllocator; the original
+   /// request size is passed back for size-aware allocators
+   using MemoryDeallocator = std::function<void( void *block, size_t bytes )>;
+
+   /// @brief Routes the library's large internal buffers through caller-provided hooks.
+   ///
+   /// By default the node tree arena blocks and the packet cache storage come from plain
+   /// `new[]`.  Applications with strict allocator discipline (per-subsystem arenas,
+   /// allocation tracking) can supply their own allocator here - the C++14 equivalent of
+   /// handing the library a polymorphic memory resource.  The hooks are process-wide and
+   /// must be installed before any ImageFile is opened and left in place while files are
+   /// open, since blocks are released through whichever hook is current.  @a allocate must
+   /// return memory suitably aligned for any fundamental type (as `malloc` does) and may
+   /// return nullptr to report failure.  Passing two empty functions restores `new[]`.
+   /// Point buffer slabs have a hook of their own (see SetPointBufferAllocator()), since
+   /// those buffers are often placed in special memory rather than just tracked.
+   E57_DLL void SetMemoryAllocator( const MemoryAllocator &allocate,
+                                    const MemoryDeallocator &deallocate );
 }
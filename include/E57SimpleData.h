@@ -162,6 +162,22 @@ namespace e57
       }
    };
 
+   /// @brief Inclusive range test on one standardized point field.
+   /// @details Used by Reader::ReadData3DPredicated() to select records during decode. The
+   /// field is named by its element name in the prototype (e.g. "intensity", "returnIndex",
+   /// "cartesianZ", "timeStamp"); integer fields are compared as doubles. A record passes when
+   /// minimum <= value <= maximum; leaving a limit at its default makes the test one-sided.
+   struct E57_DLL FieldPredicate
+   {
+      /// Element name of the field the test applies to
+      ustring pathName;
+
+      /// The smallest value that passes the test
+      double minimum = -DOUBLE_MAX;
+      /// The largest value that passes the test
+      double maximum = DOUBLE_MAX;
+   };
+
    /// @brief Stores the bounds of some data in spherical coordinates.
    struct E57_DLL SphericalBounds
    {
@@ -616,6 +632,38 @@ namespace e57
       size_t pointCount = 0;
    };
 
+   /// Allocates a buffer of at least the requested number of bytes (see
+   /// SetPointBufferAllocator()). Returning nullptr reports allocation failure.
+   using PointBufferAllocator = std::function<void *( size_t bytes )>;
+
+   /// Releases a buffer obtained from the matching PointBufferAllocator
+   using PointBufferDeallocator = std::function<void( void *buffer )>;
+
+   /*!
+   @brief Route the point buffer slab allocations through caller-provided hooks.
+
+   @details
+   Data3DPointsData_t normally allocates its field buffers in one slab with plain `new[]`. When
+   hooks are installed here, subsequent allocations use @a allocate instead, so the buffers can
+   live in special memory - for example pinned host memory for fast DMA to a GPU, where an
+   external engine performs further processing on the decoded arrays.
+
+   The hooks are process-wide and apply to slabs allocated after the call. Every slab remembers
+   the deallocator it was allocated with, so buffers outliving a hook change (or the default
+   `new[]` buffers of earlier objects) are still released correctly. Alignment is handled by
+   the library; @a allocate only needs to return the requested number of bytes.
+
+   Pass empty functions to restore the default allocation. @a allocate and @a deallocate must
+   be set or cleared together.
+
+   @param [in] allocate Returns a buffer of at least the requested byte count, or nullptr
+   @param [in] deallocate Releases a buffer returned by @a allocate
+
+   @throw ::ErrorBadAPIArgument
+   */
+   E57_DLL void SetPointBufferAllocator( const PointBufferAllocator &allocate,
+                                         const PointBufferDeallocator &deallocate );
+
    /// @brief Stores pointers to user-provided buffers
    template <typename COORDTYPE> struct Data3DPointsData_t
    {
@@ -639,10 +687,76 @@ namespace e57
       */
       explicit Data3DPointsData_t( e57::Data3D &data3D );
 
+      /*!
+      @brief Constructor which allocates buffers only for a selected subset of fields.
+
+      @details
+      Like Data3DPointsData_t( e57::Data3D & ), but a field only gets a buffer if it is valid in
+      the given Data3D header @em and its flag is set in selectedFields. The other field flags in
+      data3D are cleared, so a reader set up from this header skips those channels entirely.
+      Default-construct a PointStandardizedFieldsAvailable (all flags start false) and set just
+      the flags you need.
+
+      @param [in] data3D Completed header which indicates the fields we are using
+      @param [in] selectedFields Flags for the subset of fields to allocate
+
+      @throw ::ErrorValueOutOfBounds
+      @throw ::ErrorInvalidNodeType
+      */
+      Data3DPointsData_t( e57::Data3D &data3D,
+                          const PointStandardizedFieldsAvailable &selectedFields );
+
       /// @brief Destructor will delete any memory allocated using the Data3DPointsData_t( const
-      /// e57::Data3D & ) constructor
+      /// e57::Data3D & ) constructor or resize()
       ~Data3DPointsData_t();
 
+      /// @brief Move constructor: ownership of any allocated buffers transfers to the new
+      /// object, and @a other is left empty (all field pointers null).
+      Data3DPointsData_t( Data3DPointsData_t &&other ) noexcept;
+
+      /// @brief Move assignment: frees any buffers this object owns, then takes @a other's.
+      Data3DPointsData_t &operator=( Data3DPointsData_t &&other ) noexcept;
+
+      /// Copying is not allowed - the object may own its buffers, and two owners would free
+      /// them twice.  Move instead.
+      Data3DPointsData_t( const Data3DPointsData_t & ) = delete;
+      Data3DPointsData_t &operator=( const Data3DPointsData_t & ) = delete;
+
+      /*!
+      @brief Rebind the buffers to a new header, reusing the existing allocation when possible.
+
+      @details
+      Sets @a data3D.pointCount to @a pointCount, then performs the same header adjustment,
+      validation, and buffer layout as the Data3DPointsData_t( e57::Data3D & ) constructor.
+      The underlying allocation is only ever grown, never shrunk, so one buffer set can serve a
+      whole project load without per-scan allocation and page-fault churn.  Any caller-owned
+      pointers a default-constructed object was wrapping are dropped (never freed), and the
+      object owns its buffers from here on.
+
+      @param [in,out] data3D Completed header for the next scan to read or write
+      @param [in] pointCount Number of points the buffers must hold
+
+      @throw ::ErrorValueOutOfBounds
+      @throw ::ErrorInvalidNodeType
+      */
+      void resize( e57::Data3D &data3D, size_t pointCount );
+
+      /*!
+      @brief Calculate how many bytes of buffer space @a pointCount points would need.
+
+      @details
+      Counts only the fields enabled in @a data3D.pointFields, using the same per-field
+      alignment and slab layout as resize(), but allocates nothing. Useful for sizing chunked
+      reads against a memory budget (see ReaderOptions::memoryBudget) before committing to an
+      allocation.
+
+      @param [in] data3D Completed header describing which fields are in use
+      @param [in] pointCount Number of points the buffers would hold
+
+      @return Returns the number of bytes resize( data3D, pointCount ) would allocate
+      */
+      static size_t estimatedSize( const e57::Data3D &data3D, size_t pointCount );
+
       /// @brief Pointer to a buffer with the X coordinate (in meters) of the point in Cartesian
       /// coordinates
       COORDTYPE *cartesianX = nullptr;
@@ -729,9 +843,26 @@ namespace e57
       ///@}
 
    private:
-      /// @brief Keeps track of whether we used the Data3D constructor or not so we can free our
-      /// memory.
+      /// @brief Exchanges every member (including buffer ownership) with @a other
+      void _swap( Data3DPointsData_t &other ) noexcept;
+
+      /// @brief Releases _buffer with the deallocator it was allocated with
+      void _freeBuffer() noexcept;
+
+      /// @brief Keeps track of whether we used the Data3D constructor (or resize()) or not so we
+      /// can free our memory.
       bool _selfAllocated = false;
+
+      /// @brief Single 64-byte-aligned slab holding all self-allocated field arrays; the field
+      /// pointers above point into it.
+      char *_buffer = nullptr;
+
+      /// @brief Usable bytes in _buffer; capacity is monotonic (see resize())
+      size_t _bufferBytes = 0;
+
+      /// @brief How to release _buffer; empty for the default `new[]` slabs (see
+      /// SetPointBufferAllocator())
+      PointBufferDeallocator _deallocate;
    };
 
    using Data3DPointsFloat = Data3DPointsData_t<float>;
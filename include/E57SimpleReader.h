@@ -35,6 +35,8 @@
 /// @details This includes support for the
 /// [E57_EXT_surface_normals](http://www.libe57.org/E57_EXT_surface_normals.txt) extension.
 
+#include <functional>
+
 #include "E57SimpleData.h"
 
 namespace e57
@@ -44,6 +46,91 @@ namespace e57
    {
       /// Set how frequently to verify the checksums (see ReadChecksumPolicy).
       ReadChecksumPolicy checksumPolicy = ChecksumAll;
+
+      /// Set how many threads to use when decoding compressed vector data (points and group
+      /// metadata). 1 decodes on the calling thread; 0 uses all available hardware threads.
+      /// (see CompressedVectorReader::setDecodeThreadCount)
+      unsigned decodeThreadCount = 1;
+
+      /// Maintain a binary sidecar file ("<filePath>.e57cache") holding the parsed metadata
+      /// tree, so reopening the same file skips XML parsing entirely. The sidecar is keyed to
+      /// the file's header and is ignored and rewritten whenever the E57 file changes.
+      bool sidecarMetadataCache = false;
+
+      /// Rough cap, in bytes, on the memory this reader allocates for itself: the packet
+      /// cache and the point buffers behind the chunked reads (Reader::ReadData3DChunks and
+      /// Reader::ReadAllData3D shrink their chunks to fit rather than failing, and
+      /// Reader::ReadAllData3D splits the budget between its workers). Buffers the caller
+      /// supplies are not counted. 0 means no cap; prefer predictable peak memory over
+      /// throughput by setting one on memory-constrained devices.
+      /// (see ImageFile::setMemoryBudget)
+      uint64_t memoryBudget = 0;
+
+      /// Share decoded packets with other processes reading the same file through a
+      /// shared-memory cache keyed to the file's identity, so a packet is read from disk
+      /// (and CRC-verified and decompressed) by only one of them. Best-effort: where
+      /// shared memory is unavailable the reader silently keeps private caching.
+      /// (see ImageFile::enableSharedPacketCache)
+      bool sharedPacketCache = false;
+
+      /// Read the file through a whole-file memory mapping, turning per-page read
+      /// syscalls into pointer arithmetic with CRC verification in place. Best-effort:
+      /// where mmap is unavailable the reader silently keeps the positioned-read path.
+      /// (see ImageFile::enableMappedRead)
+      bool mappedRead = false;
+
+      /// Read the file with direct I/O so a single-pass conversion doesn't evict other
+      /// processes' hot data from the OS page cache. Best-effort: where direct I/O is
+      /// unavailable the reader silently keeps cached reads.
+      /// (see ImageFile::enableDirectRead)
+      bool directRead = false;
+
+      /// Packets of background read-ahead behind each packet cache miss, overlapping disk
+      /// I/O with decoding on sequential scans. 0 disables read-ahead; a small number
+      /// (e.g. 4) is enough to keep a spinning disk streaming.
+      /// (see ImageFile::setPacketReadAhead)
+      unsigned packetReadAhead = 0;
+
+      /// Capacity, in 64 KB packets, of the packet cache behind each scan read. 0 keeps
+      /// the default (32 packets); interleaved reads of wide prototypes benefit from a
+      /// few hundred. Lookup stays O(1) at any capacity, so a large cache costs only
+      /// its memory.
+      /// (see ImageFile::setPacketCacheSize)
+      unsigned packetCacheSize = 0;
+   };
+
+   /// @brief Runtime statistics accumulated while reading a file (see Reader::GetStats())
+   ///
+   /// All counters are cheap plain increments that are always on - no special build is needed.
+   /// They make it possible to tell an I/O-bound read (high seek/byte counts) from a
+   /// cache-thrashing one (high packet cache misses) from a decode-bound one.
+   struct E57_DLL ReaderStats
+   {
+      /// Number of data packet requests satisfied from the packet cache
+      uint64_t packetCacheHits = 0;
+
+      /// Number of data packet requests that missed the private packet cache. Each miss
+      /// fetches exactly one packet, from the shared-memory cache when one is attached
+      /// and holds the packet, otherwise from the file.
+      uint64_t packetCacheMisses = 0;
+
+      /// Of the misses, how many were satisfied from the shared-memory cache without
+      /// touching the file (see ReaderOptions::sharedPacketCache)
+      uint64_t packetCacheSharedHits = 0;
+
+      /// Number of pages whose CRC was verified (depends on ReaderOptions::checksumPolicy)
+      uint64_t crcVerifications = 0;
+
+      /// Number of seek operations performed on the file
+      uint64_t seekCount = 0;
+
+      /// Total logical bytes read from the file
+      uint64_t bytesRead = 0;
+
+      /// Bytes fed to each channel's decoder, indexed by the channel's position in the
+      /// prototype.  Updated when a point read completes (i.e. the underlying
+      /// CompressedVectorReader closes).
+      std::vector<uint64_t> bytesDecodedPerChannel;
    };
 
    /// @brief Used for reading an E57 file using E57 Simple API.
@@ -80,6 +167,14 @@ namespace e57
       /// @return Returns true if successful
       bool GetE57Root( E57Root &fileHeader ) const;
 
+      /// @brief Returns runtime statistics accumulated while reading this file
+      /// @details The counters are always available and cost a few increments per page/packet,
+      /// so they are suitable for production telemetry.  Packet cache and decode counters are
+      /// rolled up when each point read completes; file-level counters (seeks, bytes, CRC
+      /// verifications) are live.
+      /// @return Returns the current statistics snapshot
+      ReaderStats GetStats() const;
+
       ///@}
 
       /// @name Image2D
@@ -125,6 +220,26 @@ namespace e57
                                Image2DType imageType, void *buffer, int64_t start,
                                int64_t count ) const;
 
+      /// @brief Reads every image in the file, using multiple threads.
+      /// @details Image blobs are independent binary sections, so they can be read concurrently.
+      /// Each worker thread opens its own view of the file (no CheckedFile state is shared) and
+      /// delivers whole images through a per-worker buffer that is reused from one image to the
+      /// next. The callback may be invoked from several threads at once, so it must be
+      /// thread-safe; the image data passed to it is owned by the Reader and is only valid
+      /// during the call. Images with a mask or visual reference representation are delivered
+      /// with their primary representation's data.
+      /// @param [in] parallelism number of worker threads; 1 reads on the calling thread and 0
+      /// uses all available hardware threads
+      /// @param [in] callback called once per image with the image index, its header, the
+      /// projection and format of the data, and the raw (JPEG/PNG) bytes; return false from the
+      /// callback to stop all reading early
+      /// @return Return true if successful, false otherwise
+      bool ReadAllImages2D(
+         unsigned parallelism,
+         const std::function<bool( int64_t imageIndex, const Image2D &imageHeader,
+                                   Image2DProjection imageProjection, Image2DType imageType,
+                                   const std::vector<uint8_t> &imageData )> &callback ) const;
+
       ///@}
 
       /// @name Data3D
@@ -141,6 +256,17 @@ namespace e57
       /// @return Returns true if successful
       bool ReadData3D( int64_t dataIndex, Data3D &data3DHeader ) const;
 
+      /// @brief Reads every Data3D header in the file in one pass, using multiple threads.
+      /// @details Equivalent to calling ReadData3D() for every index, but the per-scan parsing
+      /// is spread across worker threads, so enumerating the headers of a project with many
+      /// scans is much faster than a per-index loop. The returned vector is indexed like the
+      /// /data3D vector, so element i matches ReadData3D( i, ... ).
+      /// @param [in] parallelism number of worker threads; 1 parses on the calling thread and 0
+      /// uses all available hardware threads
+      /// @param [out] data3DHeaders filled with one Data3D header per scan, in file order
+      /// @return Return true if successful, false otherwise
+      bool ReadAllData3DHeaders( unsigned parallelism, std::vector<Data3D> &data3DHeaders ) const;
+
       /// @brief Returns the size of the point data
       /// @param [in] dataIndex This in the index into the images3D vector. Must be less than
       /// GetData3DCount().
@@ -181,6 +307,168 @@ namespace e57
       CompressedVectorReader SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
                                                     const Data3DPointsDouble &buffers ) const;
 
+      /// @brief Variant of SetUpData3DPointsData() reading into one interleaved (AoS) buffer
+      /// @details Each non-NULL pointer in @p buffers addresses its field inside the *first*
+      ///          record of an interleaved point buffer (e.g. <tt>&points[0].x</tt> for a
+      ///          PCL-style struct), and consecutive records are @p stride bytes apart.
+      ///          Points are decoded directly into their final interleaved layout, so no
+      ///          transpose pass is needed after reading. @p stride must be at least as large
+      ///          as the record struct.
+      /// @param [in] dataIndex data block index
+      /// @param [in] pointCount number of point records the destination buffer can hold
+      /// @param [in] buffers pointers to the fields of the first point record
+      /// @param [in] stride distance in bytes between consecutive point records
+      /// @return vector reader setup to read the selected data into the provided buffer
+      CompressedVectorReader SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                    const Data3DPointsFloat &buffers,
+                                                    size_t stride ) const;
+
+      /// @overload
+      CompressedVectorReader SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                    const Data3DPointsDouble &buffers,
+                                                    size_t stride ) const;
+
+      /// @brief Reads an entire scan in fixed-size chunks through one reused buffer set.
+      /// @details Allocates one set of chunkSize-element buffers for the fields present in the
+      /// scan, then repeatedly fills them and hands them to the callback until all points have
+      /// been read. Use this instead of SetUpData3DPointsData() when a scan is too large to
+      /// buffer in full. The buffers passed to the callback are owned by the Reader and are only
+      /// valid during the call.
+      /// @param [in] dataIndex data block index
+      /// @param [in] chunkSize maximum number of points delivered per callback invocation
+      /// @param [in] callback called after each chunk is read with the buffers and the number of
+      /// valid points in them; return false from the callback to stop reading early
+      /// @param [in] selectedFields if non-null, only the fields whose flags are set here are
+      /// allocated and decoded (e.g. set just the cartesian flags for a coordinates-only pass);
+      /// the other channels are skipped entirely
+      /// @return Return true if successful, false otherwise
+      bool ReadData3DChunks(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @overload
+      bool ReadData3DChunks(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @brief Reads only the points of a scan that lie inside a cartesian bounding box.
+      /// @details Pushes the spatial filter as deep as the file's metadata allows: a scan whose
+      /// cartesianBounds cannot intersect @p filterBounds is skipped without decoding anything,
+      /// groupingByLine groups carrying per-group cartesianBounds narrow the read to candidate
+      /// record ranges (including stopping before the trailing non-candidates), and a final
+      /// point-in-box test drops the rest. Surviving points are compacted to the front of the
+      /// buffers before each delivery, so the callback sees only points inside the box, in file
+      /// order. Points flagged invalid in cartesianInvalidState are never delivered. Scans
+      /// without cartesian coordinates cannot be filtered and return false.
+      /// @param [in] dataIndex data block index
+      /// @param [in] chunkSize maximum number of points delivered per callback invocation
+      /// @param [in] filterBounds the axis-aligned box to filter against
+      /// @param [in] callback called with the buffers and the number of in-box points in them;
+      /// return false from the callback to stop reading early
+      /// @param [in] selectedFields if non-null, only the fields whose flags are set here are
+      /// allocated and decoded (see ReadData3DChunks()); the cartesian coordinates are always
+      /// read since the filter tests them
+      /// @return Return true if successful, false otherwise
+      bool ReadData3DFiltered(
+         int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+         const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @overload
+      bool ReadData3DFiltered(
+         int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+         const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @brief Reads a scan like ReadData3DChunks(), dropping its invalid points.
+      /// @details Mobile scans routinely flag a large fraction of records invalid (via
+      /// cartesianInvalidState, or sphericalInvalidState for spherical-only scans), and most
+      /// consumers filter them out immediately. This variant applies that filter inside the
+      /// library: after each chunk is decoded the invalid-state channel is used as a mask and
+      /// only the valid records are compacted to the front of the buffers, so the callback sees
+      /// just valid points and downstream conversion and copies scale with the valid fraction.
+      /// A record with a nonzero invalid state is dropped. Scans without an invalid-state
+      /// channel are delivered unchanged.
+      /// @param [in] dataIndex data block index
+      /// @param [in] chunkSize maximum number of points delivered per callback invocation
+      /// @param [in] callback called with the buffers and the number of valid points in them;
+      /// return false from the callback to stop reading early
+      /// @param [in] selectedFields if non-null, only the fields whose flags are set here are
+      /// allocated and decoded (see ReadData3DChunks()); the invalid-state channel is always
+      /// read since the mask needs it
+      /// @return Return true if successful, false otherwise
+      bool ReadData3DCompacted(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @overload
+      bool ReadData3DCompacted(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @brief Reads a scan like ReadData3DChunks(), delivering only records that pass
+      /// field range tests.
+      /// @details Extraction queries such as "intensity above a threshold" or "first
+      /// returns only" usually decode every channel of every record and filter afterwards.
+      /// This variant pushes the tests into the decode loop: for each batch the tested
+      /// fields are decoded first and the predicates evaluated in one tight pass per
+      /// field; batches with no survivors are passed over without converting any other
+      /// channel, and in surviving batches the records are compacted to the front of the
+      /// buffers before delivery. On selective queries most conversion work and output
+      /// bandwidth is skipped. All predicates must pass for a record to survive (they and
+      /// together). Returns false when a predicate names a field the scan does not carry.
+      /// @param [in] dataIndex data block index
+      /// @param [in] chunkSize maximum number of points delivered per callback invocation
+      /// @param [in] predicates range tests, one per tested field (see FieldPredicate)
+      /// @param [in] callback called with the buffers and the number of surviving points
+      /// in them; return false from the callback to stop reading early
+      /// @param [in] selectedFields if non-null, only the fields whose flags are set here
+      /// are allocated and decoded for delivery (see ReadData3DChunks()); the tested
+      /// fields are decoded for the predicate pass regardless
+      /// @return Return true if successful, false otherwise
+      bool ReadData3DPredicated(
+         int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+         const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @overload
+      bool ReadData3DPredicated(
+         int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+         const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @brief Reads every scan in the file, using multiple threads.
+      /// @details Scans are independent compressed vector sections, so they can be read
+      /// concurrently. Each worker thread opens its own view of the file (no CheckedFile state is
+      /// shared) and streams scans through a chunk-sized buffer set as in ReadData3DChunks().
+      /// The callback may be invoked from several threads at once - one scan is always delivered
+      /// by a single thread with its chunks in order, but different scans arrive concurrently, so
+      /// the callback must be thread-safe.
+      /// @param [in] parallelism number of worker threads; 1 reads on the calling thread and 0
+      /// uses all available hardware threads
+      /// @param [in] chunkSize maximum number of points delivered per callback invocation
+      /// @param [in] callback called with the scan index, the buffers and the number of valid
+      /// points in them; return false from the callback to stop all reading early
+      /// @param [in] selectedFields if non-null, only the fields whose flags are set here are
+      /// allocated and decoded (see ReadData3DChunks())
+      /// @return Return true if successful, false otherwise
+      bool ReadAllData3D( unsigned parallelism, size_t chunkSize,
+                          const std::function<bool( int64_t dataIndex,
+                                                    const Data3DPointsFloat &buffers,
+                                                    size_t count )> &callback,
+                          const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      /// @overload
+      bool ReadAllData3D( unsigned parallelism, size_t chunkSize,
+                          const std::function<bool( int64_t dataIndex,
+                                                    const Data3DPointsDouble &buffers,
+                                                    size_t count )> &callback,
+                          const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
       ///@}
 
       /// @name File information
@@ -211,4 +499,40 @@ namespace e57
       /// @endcond
    }; // end Reader class
 
+   /// @brief One file of a multi-file project open (see OpenProject())
+   struct E57_DLL ProjectFile
+   {
+      /// Path this entry corresponds to, in the order handed to OpenProject()
+      ustring path;
+
+      /// The opened reader, or null if this file failed to open
+      std::shared_ptr<Reader> reader;
+
+      /// Failure reason when reader is null
+      ustring error;
+   };
+
+   /*!
+   @brief Opens several E57 files concurrently on the library's shared thread pool.
+
+   @details
+   Sessions working with whole projects open tens of files; opening them one by one
+   serializes header reads and XML parses that are independent of each other. The result
+   vector matches @a paths in size and order, and a failed file doesn't disturb the others:
+   its entry carries a null reader and the failure reason.
+
+   To also bound the combined packet cache memory of the opened readers, set a process-wide
+   budget first (see SetPacketCacheBudget() in E57Format.h).
+
+   @param [in] paths The files to open.
+   @param [in] options Applied to every Reader.
+   @param [in] parallelism Maximum number of files opened at once. 1 opens them serially on
+   the calling thread; 0 (the default) uses all available hardware threads.
+
+   @return One ProjectFile per path, in the same order.
+   */
+   E57_DLL std::vector<ProjectFile> OpenProject( const std::vector<ustring> &paths,
+                                                 const ReaderOptions &options = ReaderOptions(),
+                                                 unsigned parallelism = 0 );
+
 } // end namespace e57
@@ -47,6 +47,19 @@ namespace e57
 
       /// Information describing the Coordinate Reference System to be used for the file
       ustring coordinateMetadata;
+
+      /// Open an existing E57 file and append to it instead of creating a new one.
+      /// Existing binary sections are preserved untouched and only the XML section is
+      /// rewritten on Close(), so the cost is proportional to the new data, not to the
+      /// size of the file. The guid and coordinateMetadata options are ignored since the
+      /// file already carries them.
+      bool append = false;
+
+      /// Rough expected size of the finished file in bytes (0 = no hint). When set, the
+      /// disk extents are reserved up front (see ImageFile::preallocate()) so the file
+      /// stays contiguous instead of growing page by page; over-estimates are harmless
+      /// since any unused reservation is released on Close().
+      uint64_t expectedFileSizeHint = 0;
    };
 
    /// @brief Used for writing an E57 file using the E57 Simple API.
@@ -61,6 +74,15 @@ namespace e57
       /// @param [in] options Options to be used for the file
       Writer( const ustring &filePath, const WriterOptions &options );
 
+      /// @brief Writer constructor writing to a memory buffer instead of a file
+      /// @details The E57 data is produced entirely in @p outBuffer without touching local disk,
+      /// which is useful for streaming a file over a network or storing it in a database. The
+      /// buffer is cleared when the Writer is created and holds a complete, checksummed E57 file
+      /// after Close(). It can be read back with the Reader or ImageFile buffer constructors.
+      /// @param [out] outBuffer Buffer to receive the file; must outlive the Writer
+      /// @param [in] options Options to be used for the file (the append option is not supported)
+      Writer( std::vector<char> &outBuffer, const WriterOptions &options );
+
       /// @brief Writer constructor (deprecated)
       /// @param [in] filePath Path to E57 file
       /// @param [in] coordinateMetadata Information describing the Coordinate Reference System to
@@ -101,6 +123,8 @@ namespace e57
       int64_t NewImage2D( Image2D &image2DHeader );
 
       /// @brief Writes the actual image data
+      /// @details The image blob space is preallocated by NewImage2D(), so chunks of different
+      /// images (or disjoint chunks of one image) may be written from several threads concurrently.
       /// @param [in] imageIndex picture block index given by the NewImage2D
       /// @param [in] imageType identifies the image format desired.
       /// @param [in] imageProjection identifies the projection desired.
@@ -119,7 +143,9 @@ namespace e57
 
       /// @brief This function writes the Data3D data to the file
       /// @details The user needs to config a Data3D structure with all the scanning information
-      /// before making this call.
+      /// before making this call. Min/max fields left at their defaults (ScaledInteger ranges,
+      /// intensity limits, and the rowIndex/columnIndex/return maxima) are computed from the
+      /// data in a pre-scan, so the integer fields are stored with minimal bit widths.
       /// @note @p data3DHeader may be modified (adding a guid or adding missing, required fields).
       /// @param [in,out] data3DHeader metadata about what is included in the buffers
       /// @param [in] buffers pointers to user-provided buffers containing the actual data
@@ -129,6 +155,24 @@ namespace e57
       /// @overload
       int64_t WriteData3DData( Data3D &data3DHeader, const Data3DPointsDouble &buffers );
 
+      /// @brief Variant of WriteData3DData() writing from one interleaved (AoS) buffer
+      /// @details Each non-NULL pointer in @p buffers addresses its field inside the *first*
+      ///          record of an interleaved point buffer (e.g. <tt>&points[0].x</tt> for a
+      ///          PCL-style struct), and consecutive records are @p stride bytes apart.
+      ///          Points are encoded straight from that layout, so no transpose into
+      ///          per-field arrays is needed before writing. @p stride must be at least as
+      ///          large as the record struct.
+      /// @param [in,out] data3DHeader metadata about what is included in the buffers
+      /// @param [in] buffers pointers to the fields of the first point record
+      /// @param [in] stride distance in bytes between consecutive point records
+      /// @return Returns the index of the new scan's data3D block.
+      int64_t WriteData3DData( Data3D &data3DHeader, const Data3DPointsFloat &buffers,
+                               size_t stride );
+
+      /// @overload
+      int64_t WriteData3DData( Data3D &data3DHeader, const Data3DPointsDouble &buffers,
+                               size_t stride );
+
       /// @brief Writes a new Data3D header
       /// @details The user needs to config a Data3D structure with all the scanning information
       /// before making this call.
@@ -136,6 +180,38 @@ namespace e57
       /// @return Returns the index of the new scan's data3D block.
       int64_t NewData3D( Data3D &data3DHeader );
 
+      /// @brief Starts a push-based streaming write of one scan
+      /// @details Use this instead of WriteData3DData() when a scan is too large to buffer in
+      ///          full. The non-NULL pointers in @p chunkBuffers address chunk-sized buffers
+      ///          (at least @p chunkCapacity elements each) owned by the caller. Refill them
+      ///          and call AppendData3DPoints() as often as needed, then finish the scan with
+      ///          EndData3DData(). Writer memory is bounded by one chunk.
+      /// @note Unlike WriteData3DData(), no pass over the points is possible up front, so any
+      ///       ScaledInteger min/max fields must already be set in @p data3DHeader.
+      /// @param [in,out] data3DHeader metadata about what is included in the chunk buffers
+      /// @param [in] chunkBuffers pointers to caller-owned buffers reused for every chunk
+      /// @param [in] chunkCapacity number of elements each chunk buffer can hold
+      /// @return Returns the index of the new scan's data3D block, or -1 on failure.
+      int64_t BeginData3DData( Data3D &data3DHeader, const Data3DPointsFloat &chunkBuffers,
+                               size_t chunkCapacity );
+
+      /// @overload
+      int64_t BeginData3DData( Data3D &data3DHeader, const Data3DPointsDouble &chunkBuffers,
+                               size_t chunkCapacity );
+
+      /// @brief Appends the first @p count points in the chunk buffers to the open stream
+      /// @details May be called any number of times between BeginData3DData() and
+      ///          EndData3DData(); the caller refills the chunk buffers before each call.
+      /// @param [in] count number of valid points in the chunk buffers; must not exceed the
+      /// chunkCapacity given to BeginData3DData()
+      /// @return Return true if successful, false otherwise
+      bool AppendData3DPoints( size_t count );
+
+      /// @brief Finishes the streaming write started by BeginData3DData()
+      /// @return Returns the index of the completed scan's data3D block, or -1 if no stream
+      /// was open.
+      int64_t EndData3DData();
+
       /// @brief Sets up a writer to write the actual scan data
       /// @param [in] dataIndex index returned by NewData3D
       /// @param [in] pointCount Number of points to write (number of elements in each of the
@@ -149,6 +225,23 @@ namespace e57
       CompressedVectorWriter SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
                                                     const Data3DPointsDouble &buffers );
 
+      /// @brief Variant of SetUpData3DPointsData() writing from one interleaved (AoS) buffer
+      /// @details See WriteData3DData( Data3D &, const Data3DPointsFloat &, size_t ) for how
+      ///          the field pointers and @p stride describe the interleaved layout.
+      /// @param [in] dataIndex index returned by NewData3D
+      /// @param [in] pointCount number of point records in the source buffer
+      /// @param [in] buffers pointers to the fields of the first point record
+      /// @param [in] stride distance in bytes between consecutive point records
+      /// @return returns a vector writer setup to write the selected scan data
+      CompressedVectorWriter SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                    const Data3DPointsFloat &buffers,
+                                                    size_t stride );
+
+      /// @overload
+      CompressedVectorWriter SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                    const Data3DPointsDouble &buffers,
+                                                    size_t stride );
+
       /// @brief Writes out the group data
       /// @param [in] dataIndex data block index given by the NewData3D
       /// @param [in] groupCount size of each of the buffers given
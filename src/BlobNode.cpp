@@ -267,6 +267,10 @@ portion is not written, it will remain zero. The BlobNode is one of the two node
 attached to the root of a write mode ImageFile before write operations can be performed (the other
 type is CompressedVectorNode).
 
+Because the Blob data is preallocated when the BlobNode is created, writes do not move the file
+cursor and several threads may write to different BlobNodes (or disjoint ranges of the same
+BlobNode) of one ImageFile concurrently.
+
 @pre The destination ImageFile must be open (i.e. destImageFile().isOpen()).
 @pre The associated destImageFile must have been opened in write mode (i.e.
 destImageFile().isWritable()).
@@ -293,6 +297,92 @@ void BlobNode::write( uint8_t *buf, int64_t start, size_t count )
    impl_->write( buf, start, count );
 }
 
+/*!
+@brief Get the physical file offset of the first byte of the blob's data.
+
+@details
+Together with physicalLength(), this exposes where the blob's data lives in the E57 file so
+external tooling can access it directly - for example by mmap'ing the file and handing the region
+to an image decoder without copying through read(). Note that the binary sections of an E57 file
+are striped for checksum protection: every 1024-byte physical page holds 1020 data bytes followed
+by a 4-byte CRC, so a consumer of the raw extent must skip the trailing 4 bytes of each page (and
+forgoes the checksum verification that read() performs). The returned offset always points at a
+data byte, never at a CRC word.
+
+@pre The destination ImageFile must be open (i.e. destImageFile().isOpen()).
+@post No visible state is modified.
+
+@return Physical file offset of the first data byte of the blob.
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see BlobNode::physicalLength, BlobNode::readAll, BlobNode::read
+*/
+uint64_t BlobNode::physicalOffset() const
+{
+   return impl_->physicalOffset();
+}
+
+/*!
+@brief Get the length of the physical file region holding the blob's data.
+
+@details
+The returned length spans from physicalOffset() up to just past the blob's last data byte, and
+includes the 4-byte CRC word that ends each 1024-byte physical page in between (see
+BlobNode::physicalOffset() for the page structure). It is therefore larger than byteCount() for
+blobs that cross a page boundary.
+
+@pre The destination ImageFile must be open (i.e. destImageFile().isOpen()).
+@post No visible state is modified.
+
+@return Length in bytes of the physical file region holding the blob data.
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see BlobNode::physicalOffset, BlobNode::readAll, BlobNode::read
+*/
+uint64_t BlobNode::physicalLength() const
+{
+   return impl_->physicalLength();
+}
+
+/*!
+@brief Read the entire blob into one contiguous buffer.
+
+@details
+Convenience wrapper around read() for consumers that want the whole payload in one piece (e.g.
+handing a complete JPEG to a decoder). The bytes are copied once, straight out of the checksummed
+page machinery into the returned buffer. Callers that can tolerate unverified data and want to
+avoid even that single copy can mmap the file region described by physicalOffset() and
+physicalLength() instead.
+
+@pre The destination ImageFile must be open (i.e. destImageFile().isOpen()).
+@post No visible state is modified.
+
+@return A buffer of byteCount() bytes holding the blob data.
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorSeekFailed
+@throw ::ErrorReadFailed
+@throw ::ErrorBadChecksum
+@throw ::ErrorInternal All objects in undocumented state
+
+@see BlobNode::read, BlobNode::physicalOffset, BlobNode::physicalLength
+*/
+std::vector<uint8_t> BlobNode::readAll() const
+{
+   std::vector<uint8_t> data( static_cast<size_t>( impl_->byteCount() ) );
+
+   if ( !data.empty() )
+   {
+      impl_->read( data.data(), 0, data.size() );
+   }
+
+   return data;
+}
+
 /*!
 @brief Diagnostic function to print internal state of object to output stream in an indented format.
 @copydetails Node::dump()
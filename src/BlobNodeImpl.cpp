@@ -134,10 +134,28 @@ namespace e57
                                   " length=" + toString( blobLogicalLength_ ) );
       }
 
+      // Positionless read, so concurrent blob reads on a read-only file don't
+      // fight over the file cursor
       ImageFileImplSharedPtr imf( destImageFile_ );
-      imf->file_->seek( binarySectionLogicalStart_ + sizeof( BlobSectionHeader ) + start );
-      imf->file_->read( reinterpret_cast<char *>( buf ),
-                        static_cast<size_t>( count ) ); //??? arg1 void* ?
+      imf->file_->readAt( reinterpret_cast<char *>( buf ), static_cast<size_t>( count ),
+                          binarySectionLogicalStart_ + sizeof( BlobSectionHeader ) + start );
+   }
+
+   uint64_t BlobNodeImpl::physicalOffset()
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+      return CheckedFile::logicalToPhysical( binarySectionLogicalStart_ +
+                                             sizeof( BlobSectionHeader ) );
+   }
+
+   uint64_t BlobNodeImpl::physicalLength()
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      const uint64_t dataLogicalStart = binarySectionLogicalStart_ + sizeof( BlobSectionHeader );
+
+      return CheckedFile::logicalToPhysical( dataLogicalStart + blobLogicalLength_ ) -
+             CheckedFile::logicalToPhysical( dataLogicalStart );
    }
 
    void BlobNodeImpl::write( uint8_t *buf, int64_t start, size_t count )
@@ -165,9 +183,13 @@ namespace e57
       }
 
       ImageFileImplSharedPtr imf( destImageFile_ );
-      imf->file_->seek( binarySectionLogicalStart_ + sizeof( BlobSectionHeader ) + start );
-      imf->file_->write( reinterpret_cast<char *>( buf ),
-                         static_cast<size_t>( count ) ); //??? arg1 void* ?
+
+      // Positionless write into the preallocated blob extent, so concurrent blob
+      // writes (and the cursor-based section writer) don't fight over the file
+      // cursor
+      imf->file_->writeAt( reinterpret_cast<char *>( buf ), static_cast<size_t>( count ),
+                           binarySectionLogicalStart_ + sizeof( BlobSectionHeader ) +
+                              start ); //??? arg1 void* ?
    }
 
    void BlobNodeImpl::checkLeavesInSet( const StringSet &pathNames, NodeImplSharedPtr origin )
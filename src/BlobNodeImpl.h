@@ -49,6 +49,20 @@ namespace e57
       void read( uint8_t *buf, int64_t start, size_t count );
       void write( uint8_t *buf, int64_t start, size_t count );
 
+      /// Physical file extent of the blob data (includes the interleaved CRC words)
+      uint64_t physicalOffset();
+      uint64_t physicalLength();
+
+      uint64_t binarySectionLogicalStart() const
+      {
+         return ( binarySectionLogicalStart_ );
+      }
+
+      uint64_t blobLogicalLength() const
+      {
+         return ( blobLogicalLength_ );
+      }
+
       void checkLeavesInSet( const StringSet &pathNames, NodeImplSharedPtr origin ) override;
 
       void writeXml( ImageFileImplSharedPtr imf, CheckedFile &cf, int indent,
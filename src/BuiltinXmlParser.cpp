@@ -0,0 +1,1025 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "BlobNodeImpl.h"
+#include "BuiltinXmlParser.h"
+#include "CheckedFile.h"
+#include "CompressedVectorNodeImpl.h"
+#include "FloatNodeImpl.h"
+#include "ImageFileImpl.h"
+#include "IntegerNodeImpl.h"
+#include "ScaledIntegerNodeImpl.h"
+#include "StringFunctions.h"
+#include "StringNodeImpl.h"
+#include "StructureNodeImpl.h"
+#include "VectorNodeImpl.h"
+
+using namespace e57;
+
+namespace
+{
+   inline int64_t convertStrToLL( const std::string &inStr )
+   {
+#if defined( _MSC_VER )
+      return _atoi64( inStr.c_str() );
+#elif defined( __GNUC__ )
+      return strtoll( inStr.c_str(), nullptr, 10 );
+#else
+#error "Need to define string to long long conversion for this compiler"
+#endif
+   }
+
+   inline bool isXmlWhitespace( char c )
+   {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+   }
+
+   // E57 element and attribute names are identifier-like ASCII; anything fancier
+   // is outside the subset and falls back to Xerces.
+   inline bool isNameStartChar( char c )
+   {
+      return ( c >= 'A' && c <= 'Z' ) || ( c >= 'a' && c <= 'z' ) || c == '_' || c == ':';
+   }
+
+   inline bool isNameChar( char c )
+   {
+      return isNameStartChar( c ) || ( c >= '0' && c <= '9' ) || c == '-' || c == '.';
+   }
+
+   // Append the UTF-8 encoding of a Unicode code point (from a numeric character reference)
+   void appendUTF8( ustring &out, uint32_t codePoint )
+   {
+      if ( codePoint < 0x80 )
+      {
+         out += static_cast<char>( codePoint );
+      }
+      else if ( codePoint < 0x800 )
+      {
+         out += static_cast<char>( 0xC0 | ( codePoint >> 6 ) );
+         out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+      }
+      else if ( codePoint < 0x10000 )
+      {
+         out += static_cast<char>( 0xE0 | ( codePoint >> 12 ) );
+         out += static_cast<char>( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+         out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+      }
+      else
+      {
+         out += static_cast<char>( 0xF0 | ( codePoint >> 18 ) );
+         out += static_cast<char>( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+         out += static_cast<char>( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+         out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+      }
+   }
+}
+
+//=============================================================================
+// BuiltinXmlParser
+
+BuiltinXmlParser::BuiltinXmlParser( ImageFileImplSharedPtr imf ) : imf_( imf )
+{
+}
+
+void BuiltinXmlParser::parse( CheckedFile *cf, uint64_t logicalStart, uint64_t logicalLength )
+{
+   // One sequential read of the whole XML section; for the file sizes we care about
+   // this is far cheaper than streaming it through a parser in small chunks.
+   xml_.resize( static_cast<size_t>( logicalLength ) );
+
+   if ( !xml_.empty() )
+   {
+      cf->seek( logicalStart );
+      cf->read( xml_.data(), xml_.size() );
+   }
+
+   cur_ = xml_.data();
+   end_ = cur_ + xml_.size();
+
+   parseDocument();
+}
+
+void BuiltinXmlParser::parseDocument()
+{
+   // Optional UTF-8 byte order mark
+   if ( end_ - cur_ >= 3 && std::memcmp( cur_, "\xEF\xBB\xBF", 3 ) == 0 )
+   {
+      cur_ += 3;
+   }
+
+   while ( cur_ < end_ )
+   {
+      if ( *cur_ != '<' )
+      {
+         parseText();
+         continue;
+      }
+
+      const size_t remaining = static_cast<size_t>( end_ - cur_ );
+
+      if ( remaining >= 2 && cur_[1] == '/' )
+      {
+         parseEndTag();
+         continue;
+      }
+
+      if ( ( remaining >= 4 && std::memcmp( cur_, "<!--", 4 ) == 0 ) ||
+           ( remaining >= 2 && cur_[1] == '?' ) )
+      {
+         skipCommentOrPI();
+         continue;
+      }
+
+      if ( remaining >= 9 && std::memcmp( cur_, "<![CDATA[", 9 ) == 0 )
+      {
+         cur_ += 9;
+
+         const char pat[] = "]]>";
+         const char *close = std::search( cur_, end_, pat, pat + 3 );
+         if ( close == end_ )
+         {
+            throw E57_EXCEPTION2( ErrorXMLParser, "unterminated CDATA section fileName=" +
+                                                     imf_->fileName() );
+         }
+
+         charactersHandler( cur_, static_cast<size_t>( close - cur_ ) );
+         cur_ = close + 3;
+         continue;
+      }
+
+      if ( remaining >= 2 && cur_[1] == '!' )
+      {
+         // DOCTYPE and friends are outside the E57 subset; let Xerces judge the file
+         throw E57_EXCEPTION2( ErrorXMLParser, "markup declaration not in E57 subset fileName=" +
+                                                  imf_->fileName() );
+      }
+
+      parseStartTag();
+   }
+
+   if ( !parsedRoot_ || !stack_.empty() )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "unexpected end of XML section fileName=" + imf_->fileName() );
+   }
+}
+
+void BuiltinXmlParser::parseStartTag()
+{
+   if ( parsedRoot_ )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "content after document element fileName=" + imf_->fileName() );
+   }
+
+   ++cur_; // consume '<'
+
+   const ustring qName = parseName();
+
+   std::vector<Attribute> attributes;
+
+   for ( ;; )
+   {
+      while ( cur_ < end_ && isXmlWhitespace( *cur_ ) )
+      {
+         ++cur_;
+      }
+
+      if ( cur_ >= end_ )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser, "unterminated start tag qName=" + qName +
+                                                  " fileName=" + imf_->fileName() );
+      }
+
+      if ( *cur_ == '>' )
+      {
+         ++cur_;
+         startElementHandler( qName, attributes );
+         return;
+      }
+
+      if ( *cur_ == '/' )
+      {
+         if ( cur_ + 1 >= end_ || cur_[1] != '>' )
+         {
+            throw E57_EXCEPTION2( ErrorXMLParser, "malformed empty-element tag qName=" + qName +
+                                                     " fileName=" + imf_->fileName() );
+         }
+
+         cur_ += 2;
+         startElementHandler( qName, attributes );
+         endElementHandler( qName );
+         return;
+      }
+
+      Attribute attribute;
+
+      attribute.name = parseName();
+
+      while ( cur_ < end_ && isXmlWhitespace( *cur_ ) )
+      {
+         ++cur_;
+      }
+
+      if ( cur_ >= end_ || *cur_ != '=' )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser, "expected '=' after attribute " + attribute.name +
+                                                  " fileName=" + imf_->fileName() );
+      }
+      ++cur_;
+
+      while ( cur_ < end_ && isXmlWhitespace( *cur_ ) )
+      {
+         ++cur_;
+      }
+
+      attribute.value = parseAttributeValue();
+
+      attributes.push_back( std::move( attribute ) );
+   }
+}
+
+void BuiltinXmlParser::parseEndTag()
+{
+   cur_ += 2; // consume "</"
+
+   const ustring qName = parseName();
+
+   while ( cur_ < end_ && isXmlWhitespace( *cur_ ) )
+   {
+      ++cur_;
+   }
+
+   if ( cur_ >= end_ || *cur_ != '>' )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser, "unterminated end tag qName=" + qName +
+                                               " fileName=" + imf_->fileName() );
+   }
+   ++cur_;
+
+   if ( stack_.empty() || stack_.top().qName != qName )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser, "mismatched end tag qName=" + qName +
+                                               " fileName=" + imf_->fileName() );
+   }
+
+   endElementHandler( qName );
+}
+
+void BuiltinXmlParser::parseText()
+{
+   const char *start = cur_;
+
+   while ( cur_ < end_ && *cur_ != '<' && *cur_ != '&' )
+   {
+      ++cur_;
+   }
+
+   if ( cur_ < end_ && *cur_ == '&' )
+   {
+      // The rare path: decode entity references into a temporary
+      ustring text( start, cur_ );
+
+      while ( cur_ < end_ && *cur_ != '<' )
+      {
+         if ( *cur_ == '&' )
+         {
+            decodeEntity( text );
+         }
+         else
+         {
+            text += *cur_++;
+         }
+      }
+
+      charactersHandler( text.data(), text.length() );
+      return;
+   }
+
+   charactersHandler( start, static_cast<size_t>( cur_ - start ) );
+}
+
+void BuiltinXmlParser::skipCommentOrPI()
+{
+   if ( cur_[1] == '?' )
+   {
+      const char pat[] = "?>";
+      const char *close = std::search( cur_ + 2, end_, pat, pat + 2 );
+      if ( close == end_ )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser, "unterminated processing instruction fileName=" +
+                                                  imf_->fileName() );
+      }
+      cur_ = close + 2;
+   }
+   else
+   {
+      const char pat[] = "-->";
+      const char *close = std::search( cur_ + 4, end_, pat, pat + 3 );
+      if ( close == end_ )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser,
+                               "unterminated comment fileName=" + imf_->fileName() );
+      }
+      cur_ = close + 3;
+   }
+}
+
+ustring BuiltinXmlParser::parseName()
+{
+   if ( cur_ >= end_ || !isNameStartChar( *cur_ ) )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser, "expected a name fileName=" + imf_->fileName() );
+   }
+
+   const char *start = cur_;
+   ++cur_;
+
+   while ( cur_ < end_ && isNameChar( *cur_ ) )
+   {
+      ++cur_;
+   }
+
+   return ustring( start, cur_ );
+}
+
+ustring BuiltinXmlParser::parseAttributeValue()
+{
+   if ( cur_ >= end_ || ( *cur_ != '"' && *cur_ != '\'' ) )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "expected a quoted attribute value fileName=" + imf_->fileName() );
+   }
+
+   const char quote = *cur_++;
+
+   ustring value;
+
+   while ( cur_ < end_ && *cur_ != quote )
+   {
+      if ( *cur_ == '&' )
+      {
+         decodeEntity( value );
+      }
+      else if ( *cur_ == '<' )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser,
+                               "'<' in attribute value fileName=" + imf_->fileName() );
+      }
+      else
+      {
+         value += *cur_++;
+      }
+   }
+
+   if ( cur_ >= end_ )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "unterminated attribute value fileName=" + imf_->fileName() );
+   }
+   ++cur_; // consume closing quote
+
+   return value;
+}
+
+void BuiltinXmlParser::decodeEntity( ustring &out )
+{
+   // cur_ points at '&'; entities are short, so cap the search for ';'
+   const size_t searchLimit = std::min<size_t>( static_cast<size_t>( end_ - cur_ ), 16 );
+   const char *semi = static_cast<const char *>( std::memchr( cur_, ';', searchLimit ) );
+
+   if ( semi == nullptr )
+   {
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "malformed entity reference fileName=" + imf_->fileName() );
+   }
+
+   const ustring name( cur_ + 1, semi );
+
+   if ( name == "amp" )
+   {
+      out += '&';
+   }
+   else if ( name == "lt" )
+   {
+      out += '<';
+   }
+   else if ( name == "gt" )
+   {
+      out += '>';
+   }
+   else if ( name == "quot" )
+   {
+      out += '"';
+   }
+   else if ( name == "apos" )
+   {
+      out += '\'';
+   }
+   else if ( !name.empty() && name[0] == '#' )
+   {
+      // Numeric character reference, decimal or hex
+      char *parseEnd = nullptr;
+      unsigned long codePoint = 0;
+
+      if ( name.length() > 1 && ( name[1] == 'x' || name[1] == 'X' ) )
+      {
+         codePoint = strtoul( name.c_str() + 2, &parseEnd, 16 );
+      }
+      else
+      {
+         codePoint = strtoul( name.c_str() + 1, &parseEnd, 10 );
+      }
+
+      if ( parseEnd == nullptr || *parseEnd != '\0' || codePoint == 0 || codePoint > 0x10FFFF )
+      {
+         throw E57_EXCEPTION2( ErrorXMLParser, "bad character reference &" + name +
+                                                  "; fileName=" + imf_->fileName() );
+      }
+
+      appendUTF8( out, static_cast<uint32_t>( codePoint ) );
+   }
+   else
+   {
+      // Unknown entity (would need a DTD); outside the E57 subset
+      throw E57_EXCEPTION2( ErrorXMLParser,
+                            "unknown entity &" + name + "; fileName=" + imf_->fileName() );
+   }
+
+   cur_ = semi + 1;
+}
+
+const ustring *BuiltinXmlParser::findAttribute( const std::vector<Attribute> &attributes,
+                                                const char *name )
+{
+   for ( const Attribute &attribute : attributes )
+   {
+      if ( attribute.name == name )
+      {
+         return &attribute.value;
+      }
+   }
+
+   return nullptr;
+}
+
+void BuiltinXmlParser::startElementHandler( const ustring &qName,
+                                            const std::vector<Attribute> &attributes )
+{
+   // Get Type attribute; every E57 element must have one
+   const ustring *node_type = findAttribute( attributes, "type" );
+   if ( node_type == nullptr )
+   {
+      throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=type" );
+   }
+
+   ParseInfo pi;
+
+   pi.qName = qName;
+
+   if ( *node_type == "Integer" )
+   {
+      pi.nodeType = TypeInteger;
+
+      if ( const ustring *minimum_str = findAttribute( attributes, "minimum" ) )
+      {
+         pi.minimum = convertStrToLL( *minimum_str );
+      }
+      else
+      {
+         // Not defined in XML, so defaults to E57_INT64_MIN
+         pi.minimum = INT64_MIN;
+      }
+
+      if ( const ustring *maximum_str = findAttribute( attributes, "maximum" ) )
+      {
+         pi.maximum = convertStrToLL( *maximum_str );
+      }
+      else
+      {
+         // Not defined in XML, so defaults to E57_INT64_MAX
+         pi.maximum = INT64_MAX;
+      }
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "ScaledInteger" )
+   {
+      pi.nodeType = TypeScaledInteger;
+
+      if ( const ustring *minimum_str = findAttribute( attributes, "minimum" ) )
+      {
+         pi.minimum = convertStrToLL( *minimum_str );
+      }
+      else
+      {
+         pi.minimum = INT64_MIN;
+      }
+
+      if ( const ustring *maximum_str = findAttribute( attributes, "maximum" ) )
+      {
+         pi.maximum = convertStrToLL( *maximum_str );
+      }
+      else
+      {
+         pi.maximum = INT64_MAX;
+      }
+
+      if ( const ustring *scale_str = findAttribute( attributes, "scale" ) )
+      {
+         pi.scale = strToDouble( *scale_str );
+      }
+      else
+      {
+         // Not defined in XML, so defaults to 1.0
+         pi.scale = 1.0;
+      }
+
+      if ( const ustring *offset_str = findAttribute( attributes, "offset" ) )
+      {
+         pi.offset = strToDouble( *offset_str );
+      }
+      else
+      {
+         // Not defined in XML, so defaults to 0.0
+         pi.offset = 0.0;
+      }
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "Float" )
+   {
+      pi.nodeType = TypeFloat;
+
+      if ( const ustring *precision_str = findAttribute( attributes, "precision" ) )
+      {
+         if ( *precision_str == "single" )
+         {
+            pi.precision = PrecisionSingle;
+         }
+         else if ( *precision_str == "double" )
+         {
+            pi.precision = PrecisionDouble;
+         }
+         else
+         {
+            throw E57_EXCEPTION2( ErrorBadXMLFormat, "precisionString=" + *precision_str +
+                                                        " fileName=" + imf_->fileName() +
+                                                        " qName=" + qName );
+         }
+      }
+      else
+      {
+         // Not defined in XML, so defaults to double
+         pi.precision = PrecisionDouble;
+      }
+
+      if ( const ustring *minimum_str = findAttribute( attributes, "minimum" ) )
+      {
+         pi.floatMinimum = strToDouble( *minimum_str );
+      }
+      else
+      {
+         pi.floatMinimum = ( pi.precision == PrecisionSingle ) ? FLOAT_MIN : DOUBLE_MIN;
+      }
+
+      if ( const ustring *maximum_str = findAttribute( attributes, "maximum" ) )
+      {
+         pi.floatMaximum = strToDouble( *maximum_str );
+      }
+      else
+      {
+         pi.floatMaximum = ( pi.precision == PrecisionSingle ) ? FLOAT_MAX : DOUBLE_MAX;
+      }
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "String" )
+   {
+      pi.nodeType = TypeString;
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "Blob" )
+   {
+      pi.nodeType = TypeBlob;
+
+      // fileOffset is required to be defined
+      const ustring *fileOffset_str = findAttribute( attributes, "fileOffset" );
+      if ( fileOffset_str == nullptr )
+      {
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=fileOffset" );
+      }
+      pi.fileOffset = convertStrToLL( *fileOffset_str );
+
+      // length is required to be defined
+      const ustring *length_str = findAttribute( attributes, "length" );
+      if ( length_str == nullptr )
+      {
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=length" );
+      }
+      pi.length = convertStrToLL( *length_str );
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "Structure" )
+   {
+      pi.nodeType = TypeStructure;
+
+      // Read name space decls, if e57Root element
+      if ( qName == "e57Root" )
+      {
+         // Search attributes for namespace declarations (only allowed in E57Root structure)
+         bool gotDefault = false;
+
+         for ( const Attribute &attribute : attributes )
+         {
+            // Check if declaring the default namespace
+            if ( attribute.name == "xmlns" )
+            {
+               imf_->extensionsAdd( "", attribute.value );
+               gotDefault = true;
+            }
+            // Check if declaring a namespace
+            else if ( attribute.name.compare( 0, 6, "xmlns:" ) == 0 )
+            {
+               imf_->extensionsAdd( attribute.name.substr( 6 ), attribute.value );
+            }
+         }
+
+         // If didn't declare a default namespace, have error
+         if ( !gotDefault )
+         {
+            throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                                  "fileName=" + imf_->fileName() + " qName=" + qName );
+         }
+      }
+
+      // Create container now, so can hold children
+      std::shared_ptr<StructureNodeImpl> s_ni = makeNode<StructureNodeImpl>( imf_ );
+      pi.container_ni = s_ni;
+
+      // After have Structure, check again if E57Root, if so mark attached so all children will be
+      // attached when added
+      if ( qName == "e57Root" )
+      {
+         s_ni->setAttachedRecursive();
+      }
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "Vector" )
+   {
+      pi.nodeType = TypeVector;
+
+      if ( const ustring *allowHetero_str =
+              findAttribute( attributes, "allowHeterogeneousChildren" ) )
+      {
+         const int64_t i64 = convertStrToLL( *allowHetero_str );
+
+         if ( i64 == 0 )
+         {
+            pi.allowHeterogeneousChildren = false;
+         }
+         else if ( i64 == 1 )
+         {
+            pi.allowHeterogeneousChildren = true;
+         }
+         else
+         {
+            throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                                  "allowHeterogeneousChildren=" + toString( i64 ) +
+                                     "fileName=" + imf_->fileName() + " qName=" + qName );
+         }
+      }
+      else
+      {
+         // Not defined in XML, so defaults to false
+         pi.allowHeterogeneousChildren = false;
+      }
+
+      // Create container now, so can hold children
+      std::shared_ptr<VectorNodeImpl> v_ni =
+         makeNode<VectorNodeImpl>( imf_, pi.allowHeterogeneousChildren );
+      pi.container_ni = v_ni;
+
+      // During an async open, remember the root-level /data3D vector so each scan can
+      // be reported as it completes (stack_ holds only the root element here)
+      if ( imf_->scanDiscoveredCallback_ && ( stack_.size() == 1 ) && ( qName == "data3D" ) )
+      {
+         data3DVector_ni_ = v_ni;
+      }
+
+      stack_.push( pi );
+   }
+   else if ( *node_type == "CompressedVector" )
+   {
+      pi.nodeType = TypeCompressedVector;
+
+      // fileOffset is required to be defined
+      const ustring *fileOffset_str = findAttribute( attributes, "fileOffset" );
+      if ( fileOffset_str == nullptr )
+      {
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=fileOffset" );
+      }
+      pi.fileOffset = convertStrToLL( *fileOffset_str );
+
+      // recordCount is required to be defined
+      const ustring *recordCount_str = findAttribute( attributes, "recordCount" );
+      if ( recordCount_str == nullptr )
+      {
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=recordCount" );
+      }
+      pi.recordCount = convertStrToLL( *recordCount_str );
+
+      // Create container now, so can hold children
+      std::shared_ptr<CompressedVectorNodeImpl> cv_ni = makeNode<CompressedVectorNodeImpl>( imf_ );
+      cv_ni->setRecordCount( pi.recordCount );
+      cv_ni->setBinarySectionLogicalStart( imf_->file_->physicalToLogical( pi.fileOffset ) );
+      pi.container_ni = cv_ni;
+
+      stack_.push( pi );
+   }
+   else
+   {
+      throw E57_EXCEPTION2( ErrorBadXMLFormat, "nodeType=" + *node_type +
+                                                  " fileName=" + imf_->fileName() +
+                                                  " qName=" + qName );
+   }
+}
+
+void BuiltinXmlParser::endElementHandler( const ustring &qName )
+{
+   // Pop the node that just ended
+   ParseInfo pi = stack_.top();
+   stack_.pop();
+
+   // We should now have all the info we need to create the node
+   NodeImplSharedPtr current_ni;
+
+   switch ( pi.nodeType )
+   {
+      case TypeStructure:
+      case TypeVector:
+      case TypeCompressedVector:
+         current_ni = pi.container_ni;
+         break;
+      case TypeInteger:
+      {
+         // Convert child text (if any) to value, else default to 0
+         int64_t intValue = 0;
+         bool foundValue = false;
+
+         if ( pi.childText.length() > 0 )
+         {
+            intValue = convertStrToLL( pi.childText );
+            foundValue = true;
+         }
+
+         std::shared_ptr<IntegerNodeImpl> i_ni =
+            makeNode<IntegerNodeImpl>( imf_, intValue, pi.minimum, pi.maximum );
+
+         if ( foundValue )
+         {
+            i_ni->validateValue();
+         }
+
+         current_ni = i_ni;
+      }
+      break;
+      case TypeScaledInteger:
+      {
+         // Convert child text (if any) to value, else default to 0
+         int64_t intValue = 0;
+         bool foundValue = false;
+
+         if ( pi.childText.length() > 0 )
+         {
+            intValue = convertStrToLL( pi.childText );
+            foundValue = true;
+         }
+
+         std::shared_ptr<ScaledIntegerNodeImpl> si_ni = makeNode<ScaledIntegerNodeImpl>(
+            imf_, intValue, pi.minimum, pi.maximum, pi.scale, pi.offset );
+
+         if ( foundValue )
+         {
+            si_ni->validateValue();
+         }
+
+         current_ni = si_ni;
+      }
+      break;
+      case TypeFloat:
+      {
+         // Convert child text (if any) to value, else default to 0.0
+         double floatValue = 0.0;
+         bool foundValue = false;
+
+         if ( pi.childText.length() > 0 )
+         {
+            floatValue = strToDouble( pi.childText );
+            foundValue = true;
+         }
+
+         std::shared_ptr<FloatNodeImpl> f_ni =
+            makeNode<FloatNodeImpl>( imf_, floatValue, pi.precision, pi.floatMinimum,
+                                     pi.floatMaximum );
+
+         if ( foundValue )
+         {
+            f_ni->validateValue();
+         }
+
+         current_ni = f_ni;
+      }
+      break;
+      case TypeString:
+         current_ni = makeNode<StringNodeImpl>( imf_, pi.childText );
+         break;
+      case TypeBlob:
+         current_ni = makeNode<BlobNodeImpl>( imf_, pi.fileOffset, pi.length );
+         break;
+      default:
+         throw E57_EXCEPTION2( ErrorInternal, "nodeType=" + toString( pi.nodeType ) +
+                                                 " fileName=" + imf_->fileName() +
+                                                 " qName=" + qName );
+   }
+
+   // If first node in file ended, we are all done
+   if ( stack_.empty() )
+   {
+      // Top level should be Structure
+      if ( current_ni->type() != TypeStructure )
+      {
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "currentType=" + toString( current_ni->type() ) +
+                                                     " fileName=" + imf_->fileName() +
+                                                     " qName=" + qName );
+      }
+      imf_->root_ = std::static_pointer_cast<StructureNodeImpl>( current_ni );
+
+      // Keep a handle on the tree's storage pool so ImageFile::memoryUsage() can
+      // report its size
+      imf_->nodeArena_ = arena_;
+      parsedRoot_ = true;
+      return;
+   }
+
+   // Get next level up node (when entered function), which should be a container.
+   NodeImplSharedPtr parent_ni = stack_.top().container_ni;
+
+   if ( !parent_ni )
+   {
+      throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                            "fileName=" + imf_->fileName() + " qName=" + qName );
+   }
+
+   // Add current node into parent at top of stack
+   switch ( parent_ni->type() )
+   {
+      case TypeStructure:
+      {
+         std::shared_ptr<StructureNodeImpl> struct_ni =
+            std::static_pointer_cast<StructureNodeImpl>( parent_ni );
+
+         // Add named child to structure
+         struct_ni->set( qName, current_ni );
+      }
+      break;
+      case TypeVector:
+      {
+         std::shared_ptr<VectorNodeImpl> vector_ni =
+            std::static_pointer_cast<VectorNodeImpl>( parent_ni );
+
+         // Add unnamed child to vector
+         vector_ni->append( current_ni );
+
+         // Async open progress: report each /data3D entry as soon as it is parsed
+         if ( data3DVector_ni_ && ( parent_ni == data3DVector_ni_ ) )
+         {
+            imf_->scanDiscoveredCallback_( imf_->scansDiscovered_++ );
+         }
+      }
+      break;
+      case TypeCompressedVector:
+      {
+         std::shared_ptr<CompressedVectorNodeImpl> cv_ni =
+            std::static_pointer_cast<CompressedVectorNodeImpl>( parent_ni );
+
+         // Child can be either prototype or codecs
+         if ( qName == "prototype" )
+         {
+            // Scans of a project file usually share one prototype shape; attach the
+            // canonical instance so identical trees aren't kept once per scan
+            cv_ni->setPrototype( imf_->canonicalPrototype( current_ni ) );
+         }
+         else if ( qName == "codecs" )
+         {
+            if ( current_ni->type() != TypeVector )
+            {
+               throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                                     "currentType=" + toString( current_ni->type() ) +
+                                        " fileName=" + imf_->fileName() + " qName=" + qName );
+            }
+            std::shared_ptr<VectorNodeImpl> vi =
+               std::static_pointer_cast<VectorNodeImpl>( current_ni );
+
+            // Check VectorNode is hetero
+            if ( !vi->allowHeteroChildren() )
+            {
+               throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                                     "currentType=" + toString( current_ni->type() ) +
+                                        " fileName=" + imf_->fileName() + " qName=" + qName );
+            }
+
+            cv_ni->setCodecs( vi );
+         }
+         else
+         {
+            // Found unknown XML child element of CompressedVector, not prototype or codecs
+            throw E57_EXCEPTION2( ErrorBadXMLFormat,
+                                  "fileName=" + imf_->fileName() + " qName=" + qName );
+         }
+      }
+      break;
+      default:
+         // Have bad XML nesting, parent should have been a container.
+         throw E57_EXCEPTION2( ErrorBadXMLFormat, "parentType=" + toString( parent_ni->type() ) +
+                                                     " fileName=" + imf_->fileName() +
+                                                     " qName=" + qName );
+   }
+}
+
+void BuiltinXmlParser::charactersHandler( const char *chars, size_t length )
+{
+   if ( length == 0 )
+   {
+      return;
+   }
+
+   if ( stack_.empty() )
+   {
+      // Only whitespace may appear outside the document element
+      for ( size_t i = 0; i < length; ++i )
+      {
+         if ( !isXmlWhitespace( chars[i] ) )
+         {
+            throw E57_EXCEPTION2( ErrorXMLParser, "text outside document element fileName=" +
+                                                     imf_->fileName() );
+         }
+      }
+      return;
+   }
+
+   // Get active element
+   ParseInfo &pi = stack_.top();
+
+   // Check if child text is allowed for current E57 element type
+   switch ( pi.nodeType )
+   {
+      case TypeStructure:
+      case TypeVector:
+      case TypeCompressedVector:
+      case TypeBlob:
+      {
+         // If characters aren't whitespace, have an error, else ignore.
+         for ( size_t i = 0; i < length; ++i )
+         {
+            if ( !isXmlWhitespace( chars[i] ) )
+            {
+               throw E57_EXCEPTION2( ErrorBadXMLFormat, "chars=" + ustring( chars, length ) );
+            }
+         }
+      }
+      break;
+      default:
+         // Append to any previous characters
+         pi.childText.append( chars, length );
+   }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <stack>
+#include <vector>
+
+#include "Common.h"
+#include "NodeArena.h"
+
+namespace e57
+{
+   class CheckedFile;
+
+   /// Parser specialized for the restricted subset of XML that E57 files actually use:
+   /// UTF-8 encoding, no DTDs, namespaces limited to extension prefix declarations on the
+   /// root element, and a small closed set of element/attribute names.  Within that subset
+   /// it builds exactly the same NodeImpl tree as E57XmlParser, without the per-open Xerces
+   /// platform initialization or the per-callback UTF-16 transcoding.
+   ///
+   /// Anything outside the subset (DOCTYPE, CDATA in containers, unknown entities, exotic
+   /// names) is reported as ErrorXMLParser, which the caller treats as "let Xerces judge
+   /// this file" — see ImageFileImpl::readXmlSection().
+   class BuiltinXmlParser
+   {
+   public:
+      explicit BuiltinXmlParser( ImageFileImplSharedPtr imf );
+
+      /// Parse the XML section of the file, building the node tree into imf_->root_
+      void parse( CheckedFile *cf, uint64_t logicalStart, uint64_t logicalLength );
+
+   private:
+      struct Attribute
+      {
+         ustring name;
+         ustring value;
+      };
+
+      /// Tokenizer over the in-memory copy of the XML section
+      void parseDocument();
+      void parseStartTag();
+      void parseEndTag();
+      void parseText();
+      void skipCommentOrPI();
+      ustring parseName();
+      ustring parseAttributeValue();
+      void decodeEntity( ustring &out );
+
+      /// Tree building, mirroring the SAX callbacks of E57XmlParser
+      void startElementHandler( const ustring &qName, const std::vector<Attribute> &attributes );
+      void endElementHandler( const ustring &qName );
+      void charactersHandler( const char *chars, size_t length );
+
+      static const ustring *findAttribute( const std::vector<Attribute> &attributes,
+                                           const char *name );
+
+      /// Build a node of type T in the per-file arena (see E57XmlParser::makeNode())
+      template <typename T, typename... Args> std::shared_ptr<T> makeNode( Args &&...args )
+      {
+         return std::allocate_shared<T>( ArenaAllocator<T>( arena_ ),
+                                         std::forward<Args>( args )... );
+      }
+
+      ImageFileImplSharedPtr imf_; /// Image file we are reading
+
+      /// Owns the storage of every NodeImpl built during the parse
+      std::shared_ptr<NodeArena> arena_{ new NodeArena };
+
+      struct ParseInfo
+      {
+         // Same role as E57XmlParser::ParseInfo: holds the attributes of an element
+         // until its end tag, when everything needed to create the node is known.
+         NodeType nodeType = static_cast<NodeType>( 0 );
+         int64_t minimum = 0;
+         int64_t maximum = 0;
+         double scale = 0.0;
+         double offset = 0.0;
+         FloatPrecision precision = static_cast<FloatPrecision>( 0 );
+         double floatMinimum = 0.0;
+         double floatMaximum = 0.0;
+         int64_t fileOffset = 0;
+         int64_t length = 0;
+         bool allowHeterogeneousChildren = false;
+         int64_t recordCount = 0;
+         ustring childText;
+         ustring qName; /// Tag name, for end-tag matching and insertion into the parent
+
+         NodeImplSharedPtr container_ni;
+      };
+
+      std::stack<ParseInfo> stack_; /// Stores the current path in tree we are reading
+
+      /// The root-level /data3D vector, remembered so an async open can report each
+      /// completed scan (see ImageFileImpl::scanDiscoveredCallback_)
+      NodeImplSharedPtr data3DVector_ni_;
+
+      std::vector<char> xml_; /// In-memory copy of the XML section
+      const char *cur_ = nullptr;
+      const char *end_ = nullptr;
+
+      bool parsedRoot_ = false;
+   };
+}
@@ -34,6 +34,7 @@
 #if defined( _MSC_VER )
 #include <codecvt>
 #include <io.h>
+#include <windows.h>
 #elif defined( __GNUC__ )
 #ifndef _LARGEFILE64_SOURCE
 #define _LARGEFILE64_SOURCE
@@ -54,15 +55,22 @@
 #ifndef __LARGE64_FILES
 #define __LARGE64_FILES
 #endif
+#include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #elif defined( __APPLE__ )
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 #elif defined( __BSD )
+#include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #else
 #error "no supported OS platform defined"
@@ -76,6 +84,7 @@
 #include "CRC.h"
 
 #include "CheckedFile.h"
+#include "Executor.h"
 #include "StringFunctions.h"
 
 // #define E57_CHECK_FILE_DEBUG
@@ -101,15 +110,142 @@ namespace
       return ( val << 16 ) | ( val >> 16 );
    }
 
-   /// Calc CRC32C of given data
-   uint32_t checksum( char *buf, size_t size )
+   /// Table-driven CRC-32C (CRCpp); always available, and the reference the hardware
+   /// kernel is cross-checked against
+   uint32_t checksumSoftware( const char *buf, size_t size )
    {
       static const CRC::Parameters<crcpp_uint32, 32> sCRCParams{ 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF,
                                                                  true, true };
 
       static const CRC::Table<crcpp_uint32, 32> sCRCTable = sCRCParams.MakeTable();
 
-      auto crc = CRC::Calculate<crcpp_uint32, 32>( buf, size, sCRCTable );
+      return CRC::Calculate<crcpp_uint32, 32>( buf, size, sCRCTable );
+   }
+
+   // Hardware CRC-32C kernels.  The polynomial the crc32 instructions implement
+   // (0x1EDC6F41, reflected, as cast into silicon by SSE4.2 and the ARMv8 CRC
+   // extension) is exactly the parameter set above, so the kernels are drop-in.
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define E57_CRC32C_HARDWARE
+#include <nmmintrin.h>
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#if defined( __GNUC__ )
+   // Compiled for baseline x86; only ever called after the cpuid check below
+   __attribute__( ( target( "sse4.2" ) ) )
+#endif
+   uint32_t
+   checksumHardware( const char *buf, size_t size )
+   {
+#if defined( __x86_64__ ) || defined( _M_X64 )
+      uint64_t crc = 0xFFFFFFFFu;
+
+      while ( size >= 8 )
+      {
+         uint64_t chunk;
+
+         memcpy( &chunk, buf, 8 );
+         crc = _mm_crc32_u64( crc, chunk );
+
+         buf += 8;
+         size -= 8;
+      }
+#else
+      uint32_t crc = 0xFFFFFFFFu;
+
+      while ( size >= 4 )
+      {
+         uint32_t chunk;
+
+         memcpy( &chunk, buf, 4 );
+         crc = _mm_crc32_u32( crc, chunk );
+
+         buf += 4;
+         size -= 4;
+      }
+#endif
+
+      while ( size > 0 )
+      {
+         crc = _mm_crc32_u8( static_cast<uint32_t>( crc ), static_cast<uint8_t>( *buf ) );
+
+         ++buf;
+         --size;
+      }
+
+      return static_cast<uint32_t>( crc ) ^ 0xFFFFFFFFu;
+   }
+
+   bool checksumHardwareAvailable()
+   {
+#if defined( _MSC_VER )
+      int info[4] = { 0, 0, 0, 0 };
+
+      __cpuid( info, 1 );
+
+      return ( info[2] & ( 1 << 20 ) ) != 0; // ECX bit 20 = SSE4.2
+#else
+      return __builtin_cpu_supports( "sse4.2" ) != 0;
+#endif
+   }
+
+#elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+#define E57_CRC32C_HARDWARE
+#include <arm_acle.h>
+
+   uint32_t checksumHardware( const char *buf, size_t size )
+   {
+      uint32_t crc = 0xFFFFFFFFu;
+
+      while ( size >= 8 )
+      {
+         uint64_t chunk;
+
+         memcpy( &chunk, buf, 8 );
+         crc = __crc32cd( crc, chunk );
+
+         buf += 8;
+         size -= 8;
+      }
+
+      while ( size > 0 )
+      {
+         crc = __crc32cb( crc, static_cast<uint8_t>( *buf ) );
+
+         ++buf;
+         --size;
+      }
+
+      return crc ^ 0xFFFFFFFFu;
+   }
+
+   bool checksumHardwareAvailable()
+   {
+      // __ARM_FEATURE_CRC32 means the whole build targets CPUs with the extension
+      return true;
+   }
+#endif
+
+   /// Calc CRC32C of given data
+   uint32_t checksum( char *buf, size_t size )
+   {
+#if defined( E57_CRC32C_HARDWARE )
+      // One-time dispatch: the CPU must have the instructions AND the kernel must agree
+      // with the table implementation on a known vector (belt and braces against a bad
+      // port), checked on the first page of the process
+      static const bool sUseHardware =
+         checksumHardwareAvailable() &&
+         checksumHardware( "123456789", 9 ) == checksumSoftware( "123456789", 9 );
+
+      if ( sUseHardware )
+      {
+         return swap_uint32( checksumHardware( buf, size ) );
+      }
+#endif
+
+      auto crc = checksumSoftware( buf, size );
 
       // (Andy) I don't understand why we need to swap bytes here
       crc = swap_uint32( crc );
@@ -169,6 +305,15 @@ public:
       }
    }
 
+   /// Positionless variant: does not use or move the cursor
+   void readAt( char *buffer, uint64_t count, uint64_t offset ) const
+   {
+      for ( uint64_t i = 0; i < count; ++i )
+      {
+         buffer[i] = stream_[offset + i];
+      }
+   }
+
 private:
    const uint64_t streamSize_;
    uint64_t cursorStream_ = 0;
@@ -183,6 +328,18 @@ CheckedFile::CheckedFile( const ustring &fileName, Mode mode, ReadChecksumPolicy
       case Read:
       {
 #if defined( _MSC_VER )
+         // Prefer the native Win32 backend; if it can't be opened, fall through to the
+         // CRT path below, whose open reports the error in the usual way
+         if ( openWinReadHandle( fileName_ ) )
+         {
+            readOnly_ = true;
+
+            logicalLength_ = physicalToLogical( physicalLength_ );
+
+            initVerifiedPages();
+            break;
+         }
+
          constexpr int readFlags = O_RDONLY | O_BINARY;
 #else
          constexpr int readFlags = O_RDONLY;
@@ -196,6 +353,27 @@ CheckedFile::CheckedFile( const ustring &fileName, Mode mode, ReadChecksumPolicy
          lseek64( 0, SEEK_SET );
 
          logicalLength_ = physicalToLogical( physicalLength_ );
+
+         initVerifiedPages();
+      }
+      break;
+
+      case WriteExisting:
+      {
+         // Open an existing file for both reading and writing, keeping its contents
+
+#if defined( _MSC_VER )
+         constexpr int appendFlags = O_RDWR | O_BINARY;
+#else
+         constexpr int appendFlags = O_RDWR;
+#endif
+
+         fd_ = open64( fileName_, appendFlags, 0 );
+
+         physicalLength_ = lseek64( 0LL, SEEK_END );
+         lseek64( 0, SEEK_SET );
+
+         logicalLength_ = physicalToLogical( physicalLength_ );
       }
       break;
 
@@ -228,6 +406,26 @@ CheckedFile::CheckedFile( const char *input, uint64_t size, ReadChecksumPolicy p
    lseek64( 0, SEEK_SET );
 
    logicalLength_ = physicalToLogical( physicalLength_ );
+
+   initVerifiedPages();
+}
+
+CheckedFile::CheckedFile( std::vector<char> *outBuffer, ReadChecksumPolicy policy ) :
+   fileName_( "<MemoryBuffer>" ), checkSumPolicy_( policy ), memBuffer_( outBuffer )
+{
+   // Fresh "file": write mode always starts from an empty stream
+   memBuffer_->clear();
+}
+
+CheckedFile::CheckedFile( std::shared_ptr<ReadBackend> backend, ReadChecksumPolicy policy ) :
+   fileName_( "<ReadBackend>" ), checkSumPolicy_( policy ), backend_( std::move( backend ) )
+{
+   readOnly_ = true;
+
+   physicalLength_ = backend_->length();
+   logicalLength_ = physicalToLogical( physicalLength_ );
+
+   initVerifiedPages();
 }
 
 int CheckedFile::open64( const ustring &fileName, int flags, int mode )
@@ -270,6 +468,75 @@ int CheckedFile::open64( const ustring &fileName, int flags, int mode )
 #endif
 }
 
+#if defined( _MSC_VER )
+bool CheckedFile::openWinReadHandle( const ustring &fileName )
+{
+   // Handle UTF-8 file names - Windows requires conversion to UTF-16
+   std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+   std::wstring widePath = converter.from_bytes( fileName );
+
+   HANDLE handle =
+      ::CreateFileW( widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_OVERLAPPED,
+                     nullptr );
+
+   if ( handle == INVALID_HANDLE_VALUE )
+   {
+      return false;
+   }
+
+   LARGE_INTEGER size;
+
+   if ( !::GetFileSizeEx( handle, &size ) )
+   {
+      ::CloseHandle( handle );
+      return false;
+   }
+
+   winReadHandle_ = handle;
+   physicalLength_ = static_cast<uint64_t>( size.QuadPart );
+
+   return true;
+}
+
+void CheckedFile::readWinHandleAt( char *buf, size_t nRead, uint64_t physicalOffset )
+{
+   OVERLAPPED overlapped = {};
+
+   overlapped.Offset = static_cast<DWORD>( physicalOffset & 0xFFFFFFFFu );
+   overlapped.OffsetHigh = static_cast<DWORD>( physicalOffset >> 32 );
+
+   // A fresh event per request keeps concurrent readAt() calls independent; waiting
+   // on the file handle itself would wake on any thread's completion
+   overlapped.hEvent = ::CreateEventW( nullptr, TRUE, FALSE, nullptr );
+
+   if ( overlapped.hEvent == nullptr )
+   {
+      throw E57_EXCEPTION2( ErrorReadFailed,
+                            "fileName=" + fileName_ +
+                               " error=" + toString( static_cast<uint64_t>( ::GetLastError() ) ) );
+   }
+
+   DWORD bytesRead = 0;
+   BOOL ok =
+      ::ReadFile( winReadHandle_, buf, static_cast<DWORD>( nRead ), &bytesRead, &overlapped );
+
+   if ( !ok && ::GetLastError() == ERROR_IO_PENDING )
+   {
+      ok = ::GetOverlappedResult( winReadHandle_, &overlapped, &bytesRead, TRUE );
+   }
+
+   ::CloseHandle( overlapped.hEvent );
+
+   if ( !ok || bytesRead != nRead )
+   {
+      throw E57_EXCEPTION2( ErrorReadFailed,
+                            "fileName=" + fileName_ + " bytesRead=" + toString( bytesRead ) +
+                               " error=" + toString( static_cast<uint64_t>( ::GetLastError() ) ) );
+   }
+}
+#endif
+
 CheckedFile::~CheckedFile()
 {
    try
@@ -284,11 +551,14 @@ CheckedFile::~CheckedFile()
 
 void CheckedFile::read( char *buf, size_t nRead, size_t /*bufSize*/ )
 {
+   flushBufferedWrites(); // no-op unless buffered writes are pending
+
    //??? what if read past logical end?, or physical end?
    //??? need to keep track of logical length?
    //??? check bufSize OK
 
-   const uint64_t end = position( Logical ) + nRead;
+   const uint64_t start = position( Logical );
+   const uint64_t end = start + nRead;
    const uint64_t logicalLength = length( Logical );
 
    if ( end > logicalLength )
@@ -297,6 +567,27 @@ void CheckedFile::read( char *buf, size_t nRead, size_t /*bufSize*/ )
                                               " length=" + toString( logicalLength ) );
    }
 
+   bytesRead_ += nRead;
+
+   if ( ( checkSumPolicy_ == ChecksumParallel ) && readParallelAt( buf, nRead, start ) )
+   {
+      seek( end, Logical );
+      return;
+   }
+
+   if ( readScatterAt( buf, nRead, start ) )
+   {
+      seek( end, Logical );
+      return;
+   }
+
+   if ( mapping_ != nullptr )
+   {
+      readFromMapping( buf, nRead, start );
+      seek( end, Logical );
+      return;
+   }
+
    uint64_t page = 0;
    size_t pageOffset = 0;
 
@@ -312,27 +603,7 @@ void CheckedFile::read( char *buf, size_t nRead, size_t /*bufSize*/ )
    {
       readPhysicalPage( page_buffer, page );
 
-      switch ( checkSumPolicy_ )
-      {
-         case ChecksumPolicy::ChecksumNone:
-            break;
-
-         case ChecksumPolicy::ChecksumAll:
-            verifyChecksum( page_buffer, page );
-            break;
-
-         default:
-         {
-            const auto checksumMod =
-               static_cast<unsigned int>( std::nearbyint( 100.0 / checkSumPolicy_ ) );
-
-            if ( !( page % checksumMod ) || ( nRead < physicalPageSize ) )
-            {
-               verifyChecksum( page_buffer, page );
-            }
-         }
-         break;
-      }
+      verifyPageForRead( page_buffer, page, nRead );
 
       memcpy( buf, page_buffer + pageOffset, n );
 
@@ -348,102 +619,1055 @@ void CheckedFile::read( char *buf, size_t nRead, size_t /*bufSize*/ )
    seek( end, Logical );
 }
 
-void CheckedFile::write( const char *buf, size_t nWrite )
+void CheckedFile::readAt( char *buf, size_t nRead, uint64_t logicalOffset )
 {
-#ifdef E57_VERBOSE
-   // cout << "write nWrite=" << nWrite << " position()="<< position() << std::endl;
-   // //???
-#endif
-   if ( readOnly_ )
+   flushBufferedWrites(); // no-op unless buffered writes are pending
+
+   const uint64_t end = logicalOffset + nRead;
+   const uint64_t logicalLength = length( Logical );
+
+   if ( end > logicalLength )
    {
-      throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + fileName_ );
+      throw E57_EXCEPTION2( ErrorInternal, "fileName=" + fileName_ + " end=" + toString( end ) +
+                                              " length=" + toString( logicalLength ) );
    }
 
-   uint64_t end = position( Logical ) + nWrite;
+   bytesRead_ += nRead;
 
-   uint64_t page = 0;
-   size_t pageOffset = 0;
+   if ( ( checkSumPolicy_ == ChecksumParallel ) && readParallelAt( buf, nRead, logicalOffset ) )
+   {
+      return;
+   }
 
-   getCurrentPageAndOffset( page, pageOffset );
+   if ( readScatterAt( buf, nRead, logicalOffset ) )
+   {
+      return;
+   }
 
-   size_t n = std::min( nWrite, logicalPageSize - pageOffset );
+   if ( mapping_ != nullptr )
+   {
+      readFromMapping( buf, nRead, logicalOffset );
+      return;
+   }
+
+   uint64_t page = logicalOffset / logicalPageSize;
+   size_t pageOffset = static_cast<size_t>( logicalOffset - page * logicalPageSize );
+
+   size_t n = std::min( nRead, logicalPageSize - pageOffset );
 
    // Allocate temp page buffer
    std::vector<char> page_buffer_v( physicalPageSize );
    char *page_buffer = page_buffer_v.data();
 
-   while ( nWrite > 0 )
+   while ( nRead > 0 )
    {
-      const uint64_t physicalLength = length( Physical );
+      readPhysicalPageAt( page_buffer, page );
 
-      if ( page * physicalPageSize < physicalLength )
-      {
-         readPhysicalPage( page_buffer, page );
-      }
+      verifyPageForRead( page_buffer, page, nRead );
+
+      memcpy( buf, page_buffer + pageOffset, n );
 
-#ifdef E57_VERBOSE
-      // cout << "  page_buffer[0] read: '" << page_buffer[0] << "'" << std::endl;
-      // cout << "copy " << n << "bytes to page=" << page << " pageOffset=" <<
-      // pageOffset << " buf='"; //??? for (size_t i=0; i < n; i++) cout <<
-      // buf[i]; cout << "'" << std::endl;
-#endif
-      memcpy( page_buffer + pageOffset, buf, n );
-      writePhysicalPage( page_buffer, page );
-#ifdef E57_VERBOSE
-      // cout << "  page_buffer[0] after write: '" << page_buffer[0] << "'" <<
-      // std::endl; //???
-#endif
       buf += n;
-      nWrite -= n;
+      nRead -= n;
       pageOffset = 0;
-      page++;
-      n = std::min( nWrite, logicalPageSize );
+      ++page;
+
+      n = std::min( nRead, logicalPageSize );
    }
+}
 
-   if ( end > logicalLength_ )
+bool CheckedFile::mapForReading()
+{
+#if defined( __GNUC__ ) && !defined( _WIN32 )
+   if ( mapping_ != nullptr )
    {
-      logicalLength_ = end;
+      return true;
    }
 
-   // When done, leave cursor just past end of buf
-   seek( end, Logical );
-}
+   // Only a read-only filesystem file can be mapped; the memory- and backend-backed
+   // modes have nothing to map, and a writer's pages change under the mapping
+   if ( !readOnly_ || fd_ < 0 )
+   {
+      return false;
+   }
 
-CheckedFile &CheckedFile::operator<<( const ustring &s )
-{
-   write( s.c_str(), s.length() ); //??? should be times size of uchar?
-   return ( *this );
-}
+   // A whole-file mapping needs as much contiguous address space as the file has
+   // bytes, which only a 64-bit process can offer for the multi-gigabyte case
+   if ( sizeof( void * ) < 8 )
+   {
+      return false;
+   }
 
-CheckedFile &CheckedFile::operator<<( int64_t i )
-{
-   std::stringstream ss;
-   ss << i;
-   return ( *this << ss.str() );
-}
+   const uint64_t physicalLength = length( Physical );
 
-CheckedFile &CheckedFile::operator<<( uint64_t i )
-{
-   std::stringstream ss;
-   ss << i;
-   return ( *this << ss.str() );
-}
+   if ( physicalLength == 0 )
+   {
+      return false;
+   }
 
-CheckedFile &CheckedFile::operator<<( float f )
-{
-   //??? is 7 digits right number?
-   return writeFloatingPoint( f, 7 );
-}
+   void *mem =
+      ::mmap( nullptr, static_cast<size_t>( physicalLength ), PROT_READ, MAP_SHARED, fd_, 0 );
 
-CheckedFile &CheckedFile::operator<<( double d )
-{
-   //??? is 17 digits right number?
-   return writeFloatingPoint( d, 17 );
-}
+   if ( mem == MAP_FAILED )
+   {
+      return false; // best-effort: stay on the pread() path
+   }
 
-template <class FTYPE> CheckedFile &CheckedFile::writeFloatingPoint( FTYPE value, int precision )
-{
-   static_assert( std::is_floating_point<FTYPE>::value, "Floating point type required." );
+   mapping_ = static_cast<const char *>( mem );
+   mappingBytes_ = physicalLength;
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+bool CheckedFile::enableDirectRead()
+{
+#if defined( O_DIRECT ) && defined( __linux__ )
+   if ( directRead_ )
+   {
+      return true;
+   }
+
+   // Only the plain read-only fd path issues the preads this redirects; a mapping
+   // never touches the page cache through the descriptor, and a writer's dirty
+   // pages belong in the cache
+   if ( !readOnly_ || ( fd_ < 0 ) || ( mapping_ != nullptr ) || ( backend_ != nullptr ) )
+   {
+      return false;
+   }
+
+   // O_DIRECT transfers must be aligned to the device's logical block size; 4 KB
+   // covers every common device and matches the kernel page size
+   constexpr size_t cDirectAlignment = 4096;
+
+   const int flags = ::fcntl( fd_, F_GETFL );
+
+   if ( ( flags < 0 ) || ( ::fcntl( fd_, F_SETFL, flags | O_DIRECT ) < 0 ) )
+   {
+      return false;
+   }
+
+   directAlignment_ = cDirectAlignment;
+   directRead_ = true;
+
+   return true;
+#else
+   return false;
+#endif
+}
+
+/// pread() under O_DIRECT's alignment contract: the transfer is widened to
+/// directAlignment_ boundaries through a locally aligned bounce buffer, then the
+/// requested bytes are copied out.  Only reached on the POSIX fd path, and only once
+/// enableDirectRead() has succeeded.
+void CheckedFile::readDirectAt( char *buf, size_t nBytes, uint64_t pos )
+{
+#if defined( O_DIRECT ) && defined( __linux__ )
+   const uint64_t alignedPos = pos & ~static_cast<uint64_t>( directAlignment_ - 1 );
+   const auto lead = static_cast<size_t>( pos - alignedPos );
+   const size_t alignedBytes =
+      ( lead + nBytes + directAlignment_ - 1 ) & ~( directAlignment_ - 1 );
+
+   // Align the buffer itself by over-allocating; a per-read allocation is noise next
+   // to a cache-bypassing device transfer
+   std::vector<char> raw( alignedBytes + directAlignment_ );
+   const auto addr = reinterpret_cast<uintptr_t>( raw.data() );
+   char *aligned =
+      raw.data() + ( ( directAlignment_ - addr % directAlignment_ ) % directAlignment_ );
+
+   size_t nDone = 0;
+
+   // The last file page may end short of an alignment boundary, so the final pread
+   // of the widened range is allowed to come back short at EOF
+   while ( nDone < lead + nBytes )
+   {
+      const ssize_t result = ::pread( fd_, aligned + nDone, alignedBytes - nDone,
+                                      static_cast<off_t>( alignedPos + nDone ) );
+
+      if ( result <= 0 )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " result=" + toString( result ) );
+      }
+
+      nDone += static_cast<size_t>( result );
+   }
+
+   memcpy( buf, aligned + lead, nBytes );
+#else
+   E57_UNUSED( buf );
+   E57_UNUSED( nBytes );
+   E57_UNUSED( pos );
+
+   throw E57_EXCEPTION2( ErrorInternal, "fileName=" + fileName_ );
+#endif
+}
+
+/// Copy nRead logical bytes starting at logicalOffset out of the whole-file mapping.
+/// No syscalls and no temp page buffer: each page is CRC-verified in place (once,
+/// thanks to the verified-page bitmap), then its payload is copied straight to the
+/// caller.  Safe from several threads at once, like readAt().
+void CheckedFile::readFromMapping( char *buf, size_t nRead, uint64_t logicalOffset )
+{
+   uint64_t page = logicalOffset / logicalPageSize;
+   size_t pageOffset = static_cast<size_t>( logicalOffset - page * logicalPageSize );
+
+   size_t n = std::min( nRead, logicalPageSize - pageOffset );
+
+   while ( nRead > 0 )
+   {
+      // The mapping is PROT_READ; the verification paths only look at the page
+      auto page_buffer = const_cast<char *>( &mapping_[page * physicalPageSize] );
+
+      verifyPageForRead( page_buffer, page, nRead );
+
+      memcpy( buf, page_buffer + pageOffset, n );
+
+      buf += n;
+      nRead -= n;
+      pageOffset = 0;
+      ++page;
+
+      n = std::min( nRead, logicalPageSize );
+   }
+}
+
+/// Bulk path for ChecksumParallel: fetch the whole physical span in one operation,
+/// verify its pages with a parallel fan-out, then copy the payloads out.  Returns false
+/// for spans too small to be worth the fan-out; the caller falls back to the per-page
+/// loop (which, under this policy, verifies every page inline like ChecksumAll).
+bool CheckedFile::readParallelAt( char *buf, size_t nRead, uint64_t logicalOffset )
+{
+   /// Below this span length, pool dispatch costs more than it saves
+   constexpr size_t cParallelVerifyMinPages = 16;
+
+   if ( nRead == 0 )
+   {
+      return false;
+   }
+
+   const uint64_t firstPage = logicalOffset / logicalPageSize;
+   const uint64_t lastPage = ( logicalOffset + nRead - 1 ) / logicalPageSize;
+   const auto pageCount = static_cast<size_t>( lastPage - firstPage + 1 );
+
+   if ( pageCount < cParallelVerifyMinPages )
+   {
+      return false;
+   }
+
+   const char *pages = nullptr;
+   std::vector<char> spanBuffer;
+
+   if ( mapping_ != nullptr )
+   {
+      // The mapping already holds the span; verify in place
+      pages = &mapping_[firstPage * physicalPageSize];
+   }
+   else
+   {
+      spanBuffer.resize( pageCount * physicalPageSize );
+      readPhysicalSpanAt( spanBuffer.data(), firstPage, pageCount );
+      pages = spanBuffer.data();
+   }
+
+   verifyPagesParallel( pages, firstPage, pageCount );
+
+   size_t pageOffset = static_cast<size_t>( logicalOffset - firstPage * logicalPageSize );
+   size_t n = std::min( nRead, logicalPageSize - pageOffset );
+   const char *page_buffer = pages;
+
+   while ( nRead > 0 )
+   {
+      memcpy( buf, page_buffer + pageOffset, n );
+
+      buf += n;
+      nRead -= n;
+      pageOffset = 0;
+      page_buffer += physicalPageSize;
+
+      n = std::min( nRead, logicalPageSize );
+   }
+
+   return true;
+}
+
+/// Scatter path for readAt(): preadv() delivers each whole page's payload straight into
+/// the caller's buffer and its 4-byte CRC into a side array, so the payload bytes are
+/// copied exactly once (by the kernel) instead of bouncing through a temp page buffer.
+/// Only the partial pages at the span's edges still take the per-page path.  Returns
+/// false when not applicable (non-POSIX, non-fd modes, mapped files, short spans); the
+/// caller then falls back to the per-page loop.
+bool CheckedFile::readScatterAt( char *buf, size_t nRead, uint64_t logicalOffset )
+{
+#if defined( __linux__ ) || defined( __EMSCRIPTEN__ ) || defined( __BSD )
+   /// Below this many whole pages the per-page loop's memcpy out of a cached-hot 1 KB
+   /// buffer is as fast as setting up the iovec array
+   constexpr size_t cScatterMinPages = 8;
+
+   // The scatter iovecs point at arbitrary caller addresses, which O_DIRECT forbids
+   if ( ( fd_ < 0 ) || directRead_ || ( mapping_ != nullptr ) || ( backend_ != nullptr ) ||
+        ( memBuffer_ != nullptr ) || ( bufView_ != nullptr ) )
+   {
+      return false;
+   }
+
+   // Only whole pages scatter; the edge pages need a bounce buffer regardless
+   const uint64_t firstWholePage = ( logicalOffset + logicalPageSize - 1 ) / logicalPageSize;
+   const uint64_t endWholePage = ( logicalOffset + nRead ) / logicalPageSize; // exclusive
+
+   if ( ( endWholePage <= firstWholePage ) ||
+        ( endWholePage - firstWholePage ) < cScatterMinPages )
+   {
+      return false;
+   }
+
+   const auto wholePages = static_cast<size_t>( endWholePage - firstWholePage );
+
+   std::vector<char> page_buffer_v( physicalPageSize );
+   char *page_buffer = page_buffer_v.data();
+
+   // Leading partial page
+   const uint64_t firstPage = logicalOffset / logicalPageSize;
+
+   if ( firstPage != firstWholePage )
+   {
+      const auto pageOffset = static_cast<size_t>( logicalOffset - firstPage * logicalPageSize );
+      const size_t n = logicalPageSize - pageOffset;
+
+      readPhysicalPageAt( page_buffer, firstPage );
+      verifyPageForRead( page_buffer, firstPage, nRead );
+      memcpy( buf, page_buffer + pageOffset, n );
+
+      buf += n;
+      nRead -= n;
+   }
+
+   // Whole pages: payloads land in buf, CRCs in the side array, one syscall per chunk
+   std::vector<uint32_t> storedChecksums( wholePages );
+
+#ifdef IOV_MAX
+   constexpr size_t cPagesPerCall = ( IOV_MAX / 2 < 512 ) ? IOV_MAX / 2 : 512;
+#else
+   // POSIX guarantees an iovec count of at least _XOPEN_IOV_MAX (16)
+   constexpr size_t cPagesPerCall = 8;
+#endif
+
+   size_t pageIndex = 0;
+
+   while ( pageIndex < wholePages )
+   {
+      const size_t count = std::min( wholePages - pageIndex, cPagesPerCall );
+
+      struct iovec iov[2 * cPagesPerCall];
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+         iov[2 * i].iov_base = buf + ( pageIndex + i ) * logicalPageSize;
+         iov[2 * i].iov_len = logicalPageSize;
+         iov[2 * i + 1].iov_base = &storedChecksums[pageIndex + i];
+         iov[2 * i + 1].iov_len = sizeof( uint32_t );
+      }
+
+      const uint64_t pos = ( firstWholePage + pageIndex ) * physicalPageSize;
+      const ssize_t result =
+         ::preadv( fd_, iov, static_cast<int>( 2 * count ), static_cast<off_t>( pos ) );
+
+      // The span was bounds-checked against the file length, so a short read is an error
+      if ( result != static_cast<ssize_t>( count * physicalPageSize ) )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " result=" + toString( result ) );
+      }
+
+      pageIndex += count;
+   }
+
+   // Whether a trailing partial page follows decides who is "last" for the percent
+   // policies' verify-the-final-page rule
+   const size_t wholeBytes = wholePages * logicalPageSize;
+   const bool endsOnPageBoundary = ( nRead == wholeBytes );
+
+   switch ( checkSumPolicy_ )
+   {
+      case ChecksumPolicy::ChecksumNone:
+         break;
+
+      case ChecksumPolicy::ChecksumAll:
+      case ChecksumPolicy::ChecksumParallel:
+         for ( size_t i = 0; i < wholePages; ++i )
+         {
+            verifyScatteredPage( buf + i * logicalPageSize, storedChecksums[i],
+                                 firstWholePage + i );
+         }
+         break;
+
+      case ChecksumPolicy::ChecksumTiered:
+         for ( size_t i = 0; i < wholePages; ++i )
+         {
+            if ( deferredVerify_ )
+            {
+               // The deferred queue copies whole physical page images, so put the
+               // payload and its CRC back together first
+               memcpy( page_buffer, buf + i * logicalPageSize, logicalPageSize );
+               memcpy( page_buffer + logicalPageSize, &storedChecksums[i],
+                       sizeof( uint32_t ) );
+               enqueueDeferredVerify( page_buffer, firstWholePage + i );
+            }
+            else
+            {
+               verifyScatteredPage( buf + i * logicalPageSize, storedChecksums[i],
+                                    firstWholePage + i );
+            }
+         }
+         break;
+
+      default:
+      {
+         const auto checksumMod =
+            static_cast<unsigned int>( std::nearbyint( 100.0 / checkSumPolicy_ ) );
+
+         for ( size_t i = 0; i < wholePages; ++i )
+         {
+            const uint64_t page = firstWholePage + i;
+            const bool lastOfRead = endsOnPageBoundary && ( i == wholePages - 1 );
+
+            if ( !( page % checksumMod ) || lastOfRead )
+            {
+               verifyScatteredPage( buf + i * logicalPageSize, storedChecksums[i], page );
+            }
+         }
+      }
+      break;
+   }
+
+   buf += wholeBytes;
+   nRead -= wholeBytes;
+
+   // Trailing partial page
+   if ( nRead > 0 )
+   {
+      readPhysicalPageAt( page_buffer, endWholePage );
+      verifyPageForRead( page_buffer, endWholePage, nRead );
+      memcpy( buf, page_buffer, nRead );
+   }
+
+   return true;
+#else
+   E57_UNUSED( buf );
+   E57_UNUSED( nRead );
+   E57_UNUSED( logicalOffset );
+
+   return false;
+#endif
+}
+
+/// Positionless read of pageCount whole physical pages starting at firstPage, in as few
+/// operations as the backing store allows (one, for everything but the CRT fd path)
+void CheckedFile::readPhysicalSpanAt( char *buf, uint64_t firstPage, size_t pageCount )
+{
+   const uint64_t pos = firstPage * physicalPageSize;
+   const size_t nBytes = pageCount * physicalPageSize;
+
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      if ( pos + nBytes > memBuffer_->size() )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " page=" + toString( firstPage ) );
+      }
+
+      memcpy( buf, memBuffer_->data() + pos, nBytes );
+      return;
+   }
+
+   if ( ( fd_ < 0 ) && ( bufView_ != nullptr ) )
+   {
+      bufView_->readAt( buf, nBytes, pos );
+      return;
+   }
+
+   if ( backend_ != nullptr )
+   {
+      backend_->readAt( pos, buf, nBytes );
+      return;
+   }
+
+   if ( directRead_ )
+   {
+      readDirectAt( buf, nBytes, pos );
+      return;
+   }
+
+#if defined( _MSC_VER )
+   if ( winReadHandle_ != nullptr )
+   {
+      readWinHandleAt( buf, nBytes, pos );
+      return;
+   }
+
+   // No pread() on the CRT fd path; fall back to the stateful seek+read pair
+   seek( pos, Physical );
+
+   size_t nDone = 0;
+
+   while ( nDone < nBytes )
+   {
+      const int result =
+         ::_read( fd_, buf + nDone, static_cast<unsigned>( std::min<size_t>( nBytes - nDone,
+                                                                             1u << 30 ) ) );
+
+      if ( result <= 0 )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " result=" + toString( result ) );
+      }
+
+      nDone += static_cast<size_t>( result );
+   }
+#elif defined( __GNUC__ )
+   size_t nDone = 0;
+
+   while ( nDone < nBytes )
+   {
+      const ssize_t result =
+         ::pread( fd_, buf + nDone, nBytes - nDone, static_cast<off_t>( pos + nDone ) );
+
+      if ( result <= 0 )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " result=" + toString( result ) );
+      }
+
+      nDone += static_cast<size_t>( result );
+   }
+#else
+#error "no supported compiler defined"
+#endif
+}
+
+/// Verify the CRCs of pageCount consecutive pages (whose images sit back to back at
+/// pages) across the worker pool.  Already proven pages are skipped via the bitmap;
+/// the first mismatch is rethrown on the calling thread as the standard
+/// ::ErrorBadChecksum.
+void CheckedFile::verifyPagesParallel( const char *pages, uint64_t firstPage,
+                                       size_t pageCount )
+{
+   /// Pages per claimed task; small enough to fan a single 64 KB packet out, large
+   /// enough that a task amortizes its dispatch
+   constexpr size_t cPagesPerVerifyTask = 16;
+
+   const unsigned hardware = std::max( 1u, std::thread::hardware_concurrency() );
+   const auto workers = static_cast<unsigned>(
+      std::max<size_t>( 1, std::min<size_t>( hardware, pageCount / cPagesPerVerifyTask ) ) );
+
+   std::atomic<uint64_t> badPage{ UINT64_MAX };
+   std::atomic<uint64_t> verified{ 0 };
+
+   Executor::run( workers, [&]( unsigned workerIndex ) {
+      uint64_t localVerified = 0;
+
+      // Interleaved stripes, so one slow region doesn't serialize on one worker
+      for ( size_t i = workerIndex; i < pageCount; i += workers )
+      {
+         const uint64_t page = firstPage + i;
+         const auto word = static_cast<size_t>( page >> 6 );
+         const uint64_t bit = UINT64_C( 1 ) << ( page & 63 );
+
+         if ( readOnly_ && ( word < verifiedPageWords_ ) &&
+              ( verifiedPages_[word].load( std::memory_order_relaxed ) & bit ) != 0 )
+         {
+            continue;
+         }
+
+         auto page_buffer = const_cast<char *>( &pages[i * physicalPageSize] );
+
+         ++localVerified;
+
+         const uint32_t computed = checksum( page_buffer, logicalPageSize );
+         const uint32_t stored =
+            *reinterpret_cast<const uint32_t *>( &page_buffer[logicalPageSize] );
+
+         if ( computed != stored )
+         {
+            uint64_t expected = UINT64_MAX;
+
+            badPage.compare_exchange_strong( expected, page );
+            return;
+         }
+
+         if ( readOnly_ && ( word < verifiedPageWords_ ) )
+         {
+            verifiedPages_[word].fetch_or( bit, std::memory_order_relaxed );
+         }
+      }
+
+      verified.fetch_add( localVerified );
+   } );
+
+   // The workers bump only thread-local counts; fold them into the plain counter here
+   crcVerifyCount_ += verified.load();
+
+   const uint64_t bad = badPage.load();
+
+   if ( bad != UINT64_MAX )
+   {
+      // Re-run the serial verifier on the failing page so the exception carries the
+      // same context as every other mismatch
+      auto page_buffer = const_cast<char *>( &pages[( bad - firstPage ) * physicalPageSize] );
+
+      verifyChecksum( page_buffer, bad );
+   }
+}
+
+/// Apply the read checksum policy to a page about to be consumed by read()/readAt()
+void CheckedFile::verifyPageForRead( char *page_buffer, uint64_t page, size_t nRemaining )
+{
+   switch ( checkSumPolicy_ )
+   {
+      case ChecksumPolicy::ChecksumNone:
+         break;
+
+      case ChecksumPolicy::ChecksumAll:
+         verifyChecksum( page_buffer, page );
+         break;
+
+      case ChecksumPolicy::ChecksumParallel:
+         // Reads too small for the bulk fan-out still verify every page, inline
+         verifyChecksum( page_buffer, page );
+         break;
+
+      case ChecksumPolicy::ChecksumTiered:
+         if ( deferredVerify_ )
+         {
+            enqueueDeferredVerify( page_buffer, page );
+         }
+         else
+         {
+            // Eager phase: these are the open-time reads (file header, XML section),
+            // cheap to verify and the ones that catch a corrupt file at open
+            verifyChecksum( page_buffer, page );
+         }
+         break;
+
+      default:
+      {
+         const auto checksumMod =
+            static_cast<unsigned int>( std::nearbyint( 100.0 / checkSumPolicy_ ) );
+
+         if ( !( page % checksumMod ) || ( nRemaining < physicalPageSize ) )
+         {
+            verifyChecksum( page_buffer, page );
+         }
+      }
+      break;
+   }
+}
+
+void CheckedFile::beginDeferredVerification()
+{
+   // Deferral leans on the verified-page bitmap, which only read-only files keep; a
+   // writer (append mode) under the tiered policy just stays eager
+   if ( !readOnly_ )
+   {
+      return;
+   }
+
+   // Set by the opening thread before any reader exists, so the read paths can
+   // consult it without locking
+   deferredVerify_ = true;
+}
+
+void CheckedFile::setChecksumMismatchCallback(
+   std::function<void( const E57Exception &ex )> callback )
+{
+   std::lock_guard<std::mutex> lock( verifyMutex_ );
+
+   mismatchCallback_ = std::move( callback );
+}
+
+uint64_t CheckedFile::pendingVerifyCount() const
+{
+   return verifyPending_.load( std::memory_order_relaxed );
+}
+
+/// Hand a page to the background verifier.  The copy is one physical page (1 KB), which
+/// is what moves the CRC math off the decode path; the verifier never touches the file.
+void CheckedFile::enqueueDeferredVerify( char *page_buffer, uint64_t page )
+{
+   // Already proven intact on an earlier read; nothing to queue
+   const size_t word = static_cast<size_t>( page >> 6 );
+
+   if ( ( word < verifiedPageWords_ ) &&
+        ( verifiedPages_[word].load( std::memory_order_relaxed ) &
+          ( UINT64_C( 1 ) << ( page & 63 ) ) ) != 0 )
+   {
+      return;
+   }
+
+   // Bound the backlog: past this many pages the readers are outrunning the verifier
+   // badly enough that queueing more just grows memory, so verify inline instead
+   constexpr size_t cMaxVerifyBacklog = 16 * 1024;
+
+   {
+      std::unique_lock<std::mutex> lock( verifyMutex_ );
+
+      if ( verifyQueue_.size() < cMaxVerifyBacklog )
+      {
+         verifyQueue_.emplace_back(
+            page, std::vector<char>( page_buffer, page_buffer + physicalPageSize ) );
+         verifyPending_.fetch_add( 1, std::memory_order_relaxed );
+
+         if ( !verifyThread_.joinable() )
+         {
+            verifyThread_ = std::thread( [this]() { verifierLoop(); } );
+         }
+
+         lock.unlock();
+         verifyCV_.notify_one();
+
+         return;
+      }
+   }
+
+   verifyChecksum( page_buffer, page );
+}
+
+/// Body of the background verifier thread (ChecksumTiered).  Drains the queue; a
+/// mismatch is reported through the callback (or saved for close()) and does not stop
+/// verification of the remaining pages.  Exits once stopVerifier() asks and the queue
+/// is empty, so every queued page is always checked.
+void CheckedFile::verifierLoop()
+{
+   while ( true )
+   {
+      std::pair<uint64_t, std::vector<char>> entry;
+
+      {
+         std::unique_lock<std::mutex> lock( verifyMutex_ );
+
+         verifyCV_.wait( lock, [this]() { return !verifyQueue_.empty() || verifyShutdown_; } );
+
+         if ( verifyQueue_.empty() )
+         {
+            return;
+         }
+
+         entry = std::move( verifyQueue_.front() );
+         verifyQueue_.pop_front();
+      }
+
+      try
+      {
+         verifyChecksum( entry.second.data(), entry.first );
+      }
+      catch ( E57Exception &ex )
+      {
+         std::function<void( const E57Exception & )> callback;
+
+         {
+            std::lock_guard<std::mutex> lock( verifyMutex_ );
+
+            if ( firstMismatch_ == nullptr )
+            {
+               firstMismatch_.reset( new E57Exception( ex ) );
+            }
+
+            callback = mismatchCallback_;
+         }
+
+         if ( callback )
+         {
+            callback( ex );
+         }
+      }
+
+      verifyPending_.fetch_sub( 1, std::memory_order_relaxed );
+   }
+}
+
+void CheckedFile::stopVerifier()
+{
+   {
+      std::lock_guard<std::mutex> lock( verifyMutex_ );
+
+      verifyShutdown_ = true;
+   }
+
+   verifyCV_.notify_all();
+
+   if ( verifyThread_.joinable() )
+   {
+      verifyThread_.join();
+   }
+}
+
+void CheckedFile::write( const char *buf, size_t nWrite )
+{
+   if ( readOnly_ )
+   {
+      throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + fileName_ );
+   }
+
+   // Collect sequential writes while buffering is on (see beginBufferedWrites)
+   if ( writeBufferCapacity_ > 0 )
+   {
+      while ( nWrite > 0 )
+      {
+         const size_t n = std::min( nWrite, writeBufferCapacity_ - writeBuffer_.size() );
+
+         writeBuffer_.insert( writeBuffer_.end(), buf, buf + n );
+         buf += n;
+         nWrite -= n;
+
+         if ( writeBuffer_.size() == writeBufferCapacity_ )
+         {
+            flushBufferedWrites();
+         }
+      }
+
+      return;
+   }
+
+   writeInternal( buf, nWrite );
+}
+
+void CheckedFile::writeAt( const char *buf, size_t nWrite, uint64_t logicalOffset )
+{
+   if ( readOnly_ )
+   {
+      throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + fileName_ );
+   }
+
+   // Compare against the member directly: writeAt() runs on blob-writer threads, so it
+   // must not touch the cursor the way length( Logical ) would
+   const uint64_t end = logicalOffset + nWrite;
+
+   if ( end > logicalLength_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "fileName=" + fileName_ + " end=" + toString( end ) +
+                                              " length=" + toString( logicalLength_ ) );
+   }
+
+   uint64_t page = logicalOffset / logicalPageSize;
+   size_t pageOffset = static_cast<size_t>( logicalOffset - page * logicalPageSize );
+
+   size_t n = std::min( nWrite, logicalPageSize - pageOffset );
+
+   // Allocate temp page buffer
+   std::vector<char> page_buffer_v( physicalPageSize );
+   char *page_buffer = page_buffer_v.data();
+
+   while ( nWrite > 0 )
+   {
+      // Page-granular critical section: another writer can share this page, so its
+      // read-modify-write must be atomic (see pageLocks_)
+      std::lock_guard<std::mutex> pageLock( pageLocks_[page % cPageLockCount] );
+
+#if defined( _MSC_VER )
+      // No pwrite()/pread() on the CRT fd; serialize with the cursor writer and put
+      // the cursor back afterwards so the stateful write path never sees it move
+      std::unique_lock<std::mutex> cursorLock;
+      uint64_t savedPosition = 0;
+
+      if ( fd_ >= 0 )
+      {
+         cursorLock = std::unique_lock<std::mutex>( cursorMutex_ );
+         savedPosition = lseek64( 0LL, SEEK_CUR );
+      }
+#endif
+
+      // A full-page overwrite replaces every logical byte, so only partial pages
+      // need the read half of the read-modify-write
+      if ( n < logicalPageSize )
+      {
+         readPhysicalPageAt( page_buffer, page );
+      }
+
+      memcpy( page_buffer + pageOffset, buf, n );
+      writePhysicalPageAt( page_buffer, page );
+
+#if defined( _MSC_VER )
+      if ( fd_ >= 0 )
+      {
+         lseek64( static_cast<int64_t>( savedPosition ), SEEK_SET );
+      }
+#endif
+
+      buf += n;
+      nWrite -= n;
+      pageOffset = 0;
+      ++page;
+
+      n = std::min( nWrite, logicalPageSize );
+   }
+}
+
+void CheckedFile::writeInternal( const char *buf, size_t nWrite )
+{
+#ifdef E57_VERBOSE
+   // cout << "write nWrite=" << nWrite << " position()="<< position() << std::endl;
+   // //???
+#endif
+
+   uint64_t end = position( Logical ) + nWrite;
+
+   uint64_t page = 0;
+   size_t pageOffset = 0;
+
+   getCurrentPageAndOffset( page, pageOffset );
+
+   // Allocate temp page buffer
+   std::vector<char> page_buffer_v( physicalPageSize );
+   char *page_buffer = page_buffer_v.data();
+
+   // Read-modify-write of one partial page (the boundary pages of a write; a full
+   // page replaces every logical byte, so it never needs the read half)
+   auto writePartialPage = [&]( size_t n ) {
+      const uint64_t physicalLength = length( Physical );
+
+      // Guard the page's read-modify-write against concurrent writeAt() callers
+      // landing on a shared boundary page
+      std::lock_guard<std::mutex> pageLock( pageLocks_[page % cPageLockCount] );
+
+      if ( page * physicalPageSize < physicalLength )
+      {
+         readPhysicalPage( page_buffer, page );
+      }
+
+      memcpy( page_buffer + pageOffset, buf, n );
+      writePhysicalPage( page_buffer, page );
+
+      buf += n;
+      nWrite -= n;
+      pageOffset = 0;
+      ++page;
+   };
+
+   // Leading partial page
+   if ( ( pageOffset > 0 ) && ( nWrite > 0 ) )
+   {
+      writePartialPage( std::min( nWrite, logicalPageSize - pageOffset ) );
+   }
+
+   // Coalesce the run of fully overwritten pages: assemble their images (payload plus
+   // per-page CRC) back to back and hand whole runs to the OS in one write, instead of
+   // a seek+write pair per 1 KB page
+   if ( nWrite >= logicalPageSize )
+   {
+      /// Bounds the assembly buffer to 1 MB of physical pages per write
+      constexpr size_t cMaxCoalescedPages = 1024;
+
+      const size_t fullPages = nWrite / logicalPageSize;
+      std::vector<char> span( std::min( fullPages, cMaxCoalescedPages ) * physicalPageSize );
+
+      size_t remaining = fullPages;
+
+      while ( remaining > 0 )
+      {
+         const size_t runPages = std::min( remaining, cMaxCoalescedPages );
+
+         for ( size_t i = 0; i < runPages; ++i )
+         {
+            char *dest = &span[i * physicalPageSize];
+
+            memcpy( dest, buf + i * logicalPageSize, logicalPageSize );
+
+            const uint32_t check_sum = checksum( dest, logicalPageSize );
+            *reinterpret_cast<uint32_t *>( &dest[logicalPageSize] ) =
+               check_sum; //??? little endian dependency
+         }
+
+         writePhysicalSpan( span.data(), page, runPages );
+
+         buf += runPages * logicalPageSize;
+         nWrite -= runPages * logicalPageSize;
+         page += runPages;
+         remaining -= runPages;
+      }
+   }
+
+   // Trailing partial page
+   if ( nWrite > 0 )
+   {
+      writePartialPage( nWrite );
+   }
+
+   if ( end > logicalLength_ )
+   {
+      logicalLength_ = end;
+   }
+
+   // When done, leave cursor just past end of buf
+   seek( end, Logical );
+}
+
+void CheckedFile::beginBufferedWrites( size_t bufferBytes )
+{
+   // Flush anything left over from a previous buffered region before resizing
+   flushBufferedWrites();
+
+   writeBufferCapacity_ = bufferBytes;
+   writeBuffer_.reserve( writeBufferCapacity_ );
+}
+
+void CheckedFile::endBufferedWrites()
+{
+   flushBufferedWrites();
+
+   writeBufferCapacity_ = 0;
+   writeBuffer_ = std::vector<char>(); // free the buffer storage
+}
+
+void CheckedFile::flushBufferedWrites()
+{
+   if ( writeBuffer_.empty() )
+   {
+      return;
+   }
+
+   // Swap the pending bytes out first: writeInternal's position bookkeeping (and
+   // the seek it does when finished) must see an empty buffer
+   std::vector<char> pending;
+   pending.swap( writeBuffer_ );
+
+   writeInternal( pending.data(), pending.size() );
+
+   writeBuffer_.reserve( writeBufferCapacity_ );
+}
+
+CheckedFile &CheckedFile::operator<<( const ustring &s )
+{
+   write( s.c_str(), s.length() ); //??? should be times size of uchar?
+   return ( *this );
+}
+
+CheckedFile &CheckedFile::operator<<( int64_t i )
+{
+   return ( *this << std::to_string( i ) );
+}
+
+CheckedFile &CheckedFile::operator<<( uint64_t i )
+{
+   return ( *this << std::to_string( i ) );
+}
+
+CheckedFile &CheckedFile::operator<<( float f )
+{
+   //??? is 7 digits right number?
+   return writeFloatingPoint( f, 7 );
+}
+
+CheckedFile &CheckedFile::operator<<( double d )
+{
+   //??? is 17 digits right number?
+   return writeFloatingPoint( d, 17 );
+}
+
+template <class FTYPE> CheckedFile &CheckedFile::writeFloatingPoint( FTYPE value, int precision )
+{
+   static_assert( std::is_floating_point<FTYPE>::value, "Floating point type required." );
 
 #ifdef E57_VERBOSE
    std::cout << "CheckedFile::writeFloatingPoint, value=" << value << " precision=" << precision
@@ -455,6 +1679,10 @@ template <class FTYPE> CheckedFile &CheckedFile::writeFloatingPoint( FTYPE value
 
 void CheckedFile::seek( uint64_t offset, OffsetMode omode )
 {
+   flushBufferedWrites(); // no-op unless buffered writes are pending
+
+   ++seekCount_;
+
    //??? check for seek beyond logicalLength_
    const auto pos =
       static_cast<int64_t>( omode == Physical ? offset : logicalToPhysical( offset ) );
@@ -468,19 +1696,120 @@ void CheckedFile::seek( uint64_t offset, OffsetMode omode )
 
 uint64_t CheckedFile::lseek64( int64_t offset, int whence )
 {
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      int64_t newPosition = 0;
+
+      switch ( whence )
+      {
+         case SEEK_SET:
+            newPosition = offset;
+            break;
+         case SEEK_CUR:
+            newPosition = static_cast<int64_t>( memPosition_ ) + offset;
+            break;
+         case SEEK_END:
+            newPosition = static_cast<int64_t>( memBuffer_->size() ) + offset;
+            break;
+         default:
+            newPosition = -1;
+            break;
+      }
+
+      // Seeking beyond the end is fine (like a real file, a later write extends the buffer)
+      if ( newPosition < 0 )
+      {
+         throw E57_EXCEPTION2( ErrorSeekFailed, "fileName=" + fileName_ +
+                                                   " offset=" + toString( offset ) +
+                                                   " whence=" + toString( whence ) );
+      }
+
+      memPosition_ = static_cast<uint64_t>( newPosition );
+
+      return memPosition_;
+   }
+
    if ( ( fd_ < 0 ) && ( bufView_ != nullptr ) )
    {
-      const auto uoffset = static_cast<uint64_t>( offset );
+      const auto uoffset = static_cast<uint64_t>( offset );
+
+      if ( bufView_->seek( uoffset, whence ) )
+      {
+         return bufView_->pos();
+      }
+
+      throw E57_EXCEPTION2( ErrorSeekFailed, "fileName=" + fileName_ +
+                                                " offset=" + toString( offset ) +
+                                                " whence=" + toString( whence ) );
+   }
+
+   if ( backend_ != nullptr )
+   {
+      // Backend reads are positionless; track the stateful cursor ourselves
+      int64_t newPosition = 0;
+
+      switch ( whence )
+      {
+         case SEEK_SET:
+            newPosition = offset;
+            break;
+         case SEEK_CUR:
+            newPosition = static_cast<int64_t>( backendPosition_ ) + offset;
+            break;
+         case SEEK_END:
+            newPosition = static_cast<int64_t>( physicalLength_ ) + offset;
+            break;
+         default:
+            newPosition = -1;
+            break;
+      }
+
+      if ( newPosition < 0 )
+      {
+         throw E57_EXCEPTION2( ErrorSeekFailed, "fileName=" + fileName_ +
+                                                   " offset=" + toString( offset ) +
+                                                   " whence=" + toString( whence ) );
+      }
+
+      backendPosition_ = static_cast<uint64_t>( newPosition );
+
+      return backendPosition_;
+   }
+
+#if defined( _MSC_VER )
+   // An overlapped handle has no usable file pointer; track the cursor ourselves
+   if ( winReadHandle_ != nullptr )
+   {
+      int64_t newPosition = 0;
 
-      if ( bufView_->seek( uoffset, whence ) )
+      switch ( whence )
       {
-         return bufView_->pos();
+         case SEEK_SET:
+            newPosition = offset;
+            break;
+         case SEEK_CUR:
+            newPosition = static_cast<int64_t>( winReadPosition_ ) + offset;
+            break;
+         case SEEK_END:
+            newPosition = static_cast<int64_t>( physicalLength_ ) + offset;
+            break;
+         default:
+            newPosition = -1;
+            break;
       }
 
-      throw E57_EXCEPTION2( ErrorSeekFailed, "fileName=" + fileName_ +
-                                                " offset=" + toString( offset ) +
-                                                " whence=" + toString( whence ) );
+      if ( newPosition < 0 )
+      {
+         throw E57_EXCEPTION2( ErrorSeekFailed, "fileName=" + fileName_ +
+                                                   " offset=" + toString( offset ) +
+                                                   " whence=" + toString( whence ) );
+      }
+
+      winReadPosition_ = static_cast<uint64_t>( newPosition );
+
+      return winReadPosition_;
    }
+#endif
 
 #if defined( _WIN32 )
    __int64 result = _lseeki64( fd_, offset, whence );
@@ -507,16 +1836,31 @@ uint64_t CheckedFile::position( OffsetMode omode )
    // Get current file cursor position
    const uint64_t pos = lseek64( 0LL, SEEK_CUR );
 
+   if ( writeBuffer_.empty() )
+   {
+      if ( omode == Physical )
+      {
+         return pos;
+      }
+
+      return physicalToLogical( pos );
+   }
+
+   // Buffered writes land logically just past the cursor
+   const uint64_t logical = physicalToLogical( pos ) + writeBuffer_.size();
+
    if ( omode == Physical )
    {
-      return pos;
+      return logicalToPhysical( logical );
    }
 
-   return physicalToLogical( pos );
+   return logical;
 }
 
 uint64_t CheckedFile::length( OffsetMode omode )
 {
+   flushBufferedWrites(); // no-op unless buffered writes are pending
+
    if ( omode == Physical )
    {
       if ( readOnly_ )
@@ -637,10 +1981,109 @@ void CheckedFile::extend( uint64_t newLength, OffsetMode omode )
    seek( newLogicalLength, Logical );
 }
 
+void CheckedFile::preallocate( uint64_t expectedPhysicalSize )
+{
+   if ( readOnly_ )
+   {
+      throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + fileName_ );
+   }
+
+   // Nothing to reserve for a memory-backed file
+   if ( fd_ < 0 )
+   {
+      return;
+   }
+
+   if ( expectedPhysicalSize <= length( Physical ) )
+   {
+      return;
+   }
+
+   // All of these reserve space without changing the visible file length, so none of the
+   // page/checksum bookkeeping (which is driven by the end-of-file position) is affected.
+   // The hint is best-effort: failures (e.g. an unsupporting filesystem) are ignored.
+#if defined( _MSC_VER )
+   FILE_ALLOCATION_INFO allocationInfo;
+   allocationInfo.AllocationSize.QuadPart = static_cast<LONGLONG>( expectedPhysicalSize );
+
+   const BOOL result =
+      ::SetFileInformationByHandle( reinterpret_cast<HANDLE>( ::_get_osfhandle( fd_ ) ),
+                                    FileAllocationInfo, &allocationInfo,
+                                    sizeof( allocationInfo ) );
+   E57_UNUSED( result );
+#elif defined( __linux__ ) && defined( FALLOC_FL_KEEP_SIZE )
+   const int result = ::fallocate( fd_, FALLOC_FL_KEEP_SIZE, 0,
+                                   static_cast<off_t>( expectedPhysicalSize ) );
+   E57_UNUSED( result );
+#elif defined( __APPLE__ )
+   fstore_t store = { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0,
+                      static_cast<off_t>( expectedPhysicalSize ), 0 };
+
+   if ( ::fcntl( fd_, F_PREALLOCATE, &store ) == -1 )
+   {
+      // Couldn't get contiguous space; take whatever extents are available
+      store.fst_flags = F_ALLOCATEALL;
+      ::fcntl( fd_, F_PREALLOCATE, &store );
+   }
+#else
+   E57_UNUSED( expectedPhysicalSize );
+   return;
+#endif
+
+   preallocated_ = true;
+}
+
 void CheckedFile::close()
 {
+   flushBufferedWrites(); // no-op unless buffered writes are pending
+
+   // Let the background verifier (ChecksumTiered) finish its backlog first, so close()
+   // never drops a queued page unchecked
+   stopVerifier();
+
+#if defined( _MSC_VER )
+   if ( winReadHandle_ != nullptr )
+   {
+      const BOOL result = ::CloseHandle( winReadHandle_ );
+
+      winReadHandle_ = nullptr;
+
+      if ( !result )
+      {
+         throw E57_EXCEPTION2( ErrorCloseFailed, "fileName=" + fileName_ );
+      }
+   }
+#endif
+
+#if defined( __GNUC__ ) && !defined( _WIN32 )
+   if ( mapping_ != nullptr )
+   {
+      ::munmap( const_cast<char *>( mapping_ ), static_cast<size_t>( mappingBytes_ ) );
+
+      mapping_ = nullptr;
+      mappingBytes_ = 0;
+   }
+#endif
+
    if ( fd_ >= 0 )
    {
+      // Release any reservation left over from preallocate() beyond the data actually written
+      if ( preallocated_ && !readOnly_ )
+      {
+         const auto finalLength = static_cast<int64_t>( length( Physical ) );
+
+#if defined( _MSC_VER )
+         const int result = ::_chsize_s( fd_, finalLength );
+#elif defined( __GNUC__ )
+         const int result = ::ftruncate( fd_, static_cast<off_t>( finalLength ) );
+#else
+#error "no supported compiler defined"
+#endif
+         E57_UNUSED( result );
+
+         preallocated_ = false;
+      }
+
 #if defined( _MSC_VER )
       int result = ::_close( fd_ );
 #elif defined( __GNUC__ )
@@ -665,6 +2108,24 @@ void CheckedFile::close()
       // WARNING: do NOT delete buffer of bufView_ because
       // pointer is handled by user !!
    }
+
+   backend_.reset();
+
+   // A mismatch the background verifier found must not pass silently: if the caller
+   // didn't install a callback, the first one surfaces here
+   if ( firstMismatch_ != nullptr )
+   {
+      if ( !mismatchCallback_ )
+      {
+         const E57Exception ex = *firstMismatch_;
+
+         firstMismatch_.reset();
+
+         throw ex;
+      }
+
+      firstMismatch_.reset();
+   }
 }
 
 void CheckedFile::unlink()
@@ -683,8 +2144,42 @@ void CheckedFile::unlink()
 #endif
 }
 
+/// Size the verified-page bitmap for a read-only file.  The length of a read-only
+/// file is fixed once it is open, so the bitmap never has to grow, and its fixed
+/// size is what lets verifyChecksum() consult it from concurrent readAt() callers
+/// without locking.
+void CheckedFile::initVerifiedPages()
+{
+   const uint64_t pageCount = ( physicalLength_ + physicalPageSize - 1 ) / physicalPageSize;
+
+   verifiedPageWords_ = static_cast<size_t>( ( pageCount + 63 ) / 64 );
+   verifiedPages_.reset( new std::atomic<uint64_t>[verifiedPageWords_] );
+
+   for ( size_t i = 0; i < verifiedPageWords_; ++i )
+   {
+      verifiedPages_[i].store( 0, std::memory_order_relaxed );
+   }
+}
+
 void CheckedFile::verifyChecksum( char *page_buffer, uint64_t page )
 {
+   // In a read-only file a page proven intact stays intact, so don't re-verify pages
+   // that get re-read after cycling out of a cache.  The bitmap costs 1 bit per
+   // physical page (about 128 KB per GB of file).  Writers skip it: their pages change.
+   if ( readOnly_ )
+   {
+      const size_t word = static_cast<size_t>( page >> 6 );
+      const uint64_t bit = UINT64_C( 1 ) << ( page & 63 );
+
+      if ( ( word < verifiedPageWords_ ) &&
+           ( verifiedPages_[word].load( std::memory_order_relaxed ) & bit ) != 0 )
+      {
+         return;
+      }
+   }
+
+   ++crcVerifyCount_;
+
    const uint32_t check_sum = checksum( page_buffer, logicalPageSize );
    const uint32_t check_sum_in_page =
       *reinterpret_cast<uint32_t *>( &page_buffer[logicalPageSize] );
@@ -698,6 +2193,62 @@ void CheckedFile::verifyChecksum( char *page_buffer, uint64_t page )
                                " storedChecksum=" + toString( check_sum_in_page ) + " page=" +
                                toString( page ) + " length=" + toString( physicalLength ) );
    }
+
+   if ( readOnly_ )
+   {
+      const size_t word = static_cast<size_t>( page >> 6 );
+
+      if ( word < verifiedPageWords_ )
+      {
+         verifiedPages_[word].fetch_or( UINT64_C( 1 ) << ( page & 63 ),
+                                        std::memory_order_relaxed );
+      }
+   }
+}
+
+/// Twin of verifyChecksum() for the scatter-read path, where a page's payload sits in
+/// the caller's buffer and its stored CRC in a side array instead of back to back in a
+/// page image.  Same bitmap skip/record and the same ::ErrorBadChecksum on mismatch.
+void CheckedFile::verifyScatteredPage( const char *payload, uint32_t storedChecksum,
+                                       uint64_t page )
+{
+   if ( readOnly_ )
+   {
+      const size_t word = static_cast<size_t>( page >> 6 );
+      const uint64_t bit = UINT64_C( 1 ) << ( page & 63 );
+
+      if ( ( word < verifiedPageWords_ ) &&
+           ( verifiedPages_[word].load( std::memory_order_relaxed ) & bit ) != 0 )
+      {
+         return;
+      }
+   }
+
+   ++crcVerifyCount_;
+
+   // checksum() only reads the page; the non-const signature is historical
+   const uint32_t check_sum = checksum( const_cast<char *>( payload ), logicalPageSize );
+
+   if ( storedChecksum != check_sum )
+   {
+      const uint64_t physicalLength = length( Physical );
+
+      throw E57_EXCEPTION2( ErrorBadChecksum,
+                            "fileName=" + fileName_ + " computedChecksum=" + toString( check_sum ) +
+                               " storedChecksum=" + toString( storedChecksum ) + " page=" +
+                               toString( page ) + " length=" + toString( physicalLength ) );
+   }
+
+   if ( readOnly_ )
+   {
+      const size_t word = static_cast<size_t>( page >> 6 );
+
+      if ( word < verifiedPageWords_ )
+      {
+         verifiedPages_[word].fetch_or( UINT64_C( 1 ) << ( page & 63 ),
+                                        std::memory_order_relaxed );
+      }
+   }
 }
 
 void CheckedFile::getCurrentPageAndOffset( uint64_t &page, size_t &pageOffset, OffsetMode omode )
@@ -731,13 +2282,48 @@ void CheckedFile::readPhysicalPage( char *page_buffer, uint64_t page )
    // Seek to start of physical page
    seek( page * physicalPageSize, Physical );
 
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      if ( memPosition_ + physicalPageSize > memBuffer_->size() )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " page=" + toString( page ) );
+      }
+
+      memcpy( page_buffer, memBuffer_->data() + memPosition_, physicalPageSize );
+      memPosition_ += physicalPageSize;
+      return;
+   }
+
    if ( ( fd_ < 0 ) && ( bufView_ != nullptr ) )
    {
       bufView_->read( page_buffer, physicalPageSize );
       return;
    }
 
+   if ( backend_ != nullptr )
+   {
+      // The seek() above already moved backendPosition_ to the page start
+      backend_->readAt( backendPosition_, page_buffer, physicalPageSize );
+      backendPosition_ += physicalPageSize;
+      return;
+   }
+
+   if ( directRead_ )
+   {
+      readDirectAt( page_buffer, physicalPageSize, page * physicalPageSize );
+      return;
+   }
+
 #if defined( _MSC_VER )
+   if ( winReadHandle_ != nullptr )
+   {
+      // The seek() above already moved winReadPosition_ to the page start
+      readWinHandleAt( page_buffer, physicalPageSize, winReadPosition_ );
+      winReadPosition_ += physicalPageSize;
+      return;
+   }
+
    int result = ::_read( fd_, page_buffer, physicalPageSize );
 #elif defined( __GNUC__ )
    ssize_t result = ::read( fd_, page_buffer, physicalPageSize );
@@ -752,6 +2338,67 @@ void CheckedFile::readPhysicalPage( char *page_buffer, uint64_t page )
    }
 }
 
+void CheckedFile::readPhysicalPageAt( char *page_buffer, uint64_t page )
+{
+   const uint64_t pos = page * physicalPageSize;
+
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      if ( pos + physicalPageSize > memBuffer_->size() )
+      {
+         throw E57_EXCEPTION2( ErrorReadFailed,
+                               "fileName=" + fileName_ + " page=" + toString( page ) );
+      }
+
+      memcpy( page_buffer, memBuffer_->data() + pos, physicalPageSize );
+      return;
+   }
+
+   if ( ( fd_ < 0 ) && ( bufView_ != nullptr ) )
+   {
+      bufView_->readAt( page_buffer, physicalPageSize, pos );
+      return;
+   }
+
+   if ( backend_ != nullptr )
+   {
+      // Positionless and safe to issue from several threads at once; a remote
+      // backend can serve these as parallel range requests
+      backend_->readAt( pos, page_buffer, physicalPageSize );
+      return;
+   }
+
+   if ( directRead_ )
+   {
+      readDirectAt( page_buffer, physicalPageSize, pos );
+      return;
+   }
+
+#if defined( _MSC_VER )
+   if ( winReadHandle_ != nullptr )
+   {
+      // Positionless by construction: the offset travels in the OVERLAPPED block
+      readWinHandleAt( page_buffer, physicalPageSize, pos );
+      return;
+   }
+
+   // No pread() on the CRT fd path; fall back to the stateful seek+read pair
+   seek( pos, Physical );
+
+   int result = ::_read( fd_, page_buffer, physicalPageSize );
+#elif defined( __GNUC__ )
+   ssize_t result = ::pread( fd_, page_buffer, physicalPageSize, static_cast<off_t>( pos ) );
+#else
+#error "no supported compiler defined"
+#endif
+
+   if ( result < 0 || static_cast<size_t>( result ) != physicalPageSize )
+   {
+      throw E57_EXCEPTION2( ErrorReadFailed,
+                            "fileName=" + fileName_ + " result=" + toString( result ) );
+   }
+}
+
 void CheckedFile::writePhysicalPage( char *page_buffer, uint64_t page )
 {
 #ifdef E57_VERBOSE
@@ -766,6 +2413,18 @@ void CheckedFile::writePhysicalPage( char *page_buffer, uint64_t page )
    // Seek to start of physical page
    seek( page * physicalPageSize, Physical );
 
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      if ( memPosition_ + physicalPageSize > memBuffer_->size() )
+      {
+         memBuffer_->resize( static_cast<size_t>( memPosition_ + physicalPageSize ) );
+      }
+
+      memcpy( memBuffer_->data() + memPosition_, page_buffer, physicalPageSize );
+      memPosition_ += physicalPageSize;
+      return;
+   }
+
 #if defined( _MSC_VER )
    int result = ::_write( fd_, page_buffer, physicalPageSize );
 #elif defined( __GNUC__ )
@@ -780,3 +2439,94 @@ void CheckedFile::writePhysicalPage( char *page_buffer, uint64_t page )
                             "fileName=" + fileName_ + " result=" + toString( result ) );
    }
 }
+
+/// Write pageCount already-checksummed physical page images, sitting back to back at
+/// pages, in one operation (see the coalescing in writeInternal()).  Leaves the cursor
+/// at the end of the span, like the per-page path does.
+void CheckedFile::writePhysicalSpan( const char *pages, uint64_t firstPage, size_t pageCount )
+{
+   const size_t nBytes = pageCount * physicalPageSize;
+
+   seek( firstPage * physicalPageSize, Physical );
+
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      if ( memPosition_ + nBytes > memBuffer_->size() )
+      {
+         memBuffer_->resize( static_cast<size_t>( memPosition_ + nBytes ) );
+      }
+
+      memcpy( memBuffer_->data() + memPosition_, pages, nBytes );
+      memPosition_ += nBytes;
+      return;
+   }
+
+   size_t nDone = 0;
+
+   while ( nDone < nBytes )
+   {
+#if defined( _MSC_VER )
+      const int result =
+         ::_write( fd_, pages + nDone,
+                   static_cast<unsigned>( std::min<size_t>( nBytes - nDone, 1u << 30 ) ) );
+#elif defined( __GNUC__ )
+      const ssize_t result = ::write( fd_, pages + nDone, nBytes - nDone );
+#else
+#error "no supported compiler defined"
+#endif
+
+      if ( result <= 0 )
+      {
+         throw E57_EXCEPTION2( ErrorWriteFailed,
+                               "fileName=" + fileName_ + " result=" + toString( result ) );
+      }
+
+      nDone += static_cast<size_t>( result );
+   }
+}
+
+/// Positionless page write for writeAt(): checksums the page and stores it at its
+/// physical offset without disturbing the write cursor.  pwrite() on POSIX; the
+/// CRT fd path seeks instead and relies on writeAt() holding cursorMutex_ and
+/// restoring the cursor around the call.
+void CheckedFile::writePhysicalPageAt( char *page_buffer, uint64_t page )
+{
+   // Append checksum
+   uint32_t check_sum = checksum( page_buffer, logicalPageSize );
+   *reinterpret_cast<uint32_t *>( &page_buffer[logicalPageSize] ) =
+      check_sum; //??? little endian dependency
+
+   const uint64_t pos = page * physicalPageSize;
+
+   if ( ( fd_ < 0 ) && ( memBuffer_ != nullptr ) )
+   {
+      // A resize moves the storage out from under other writers, so take the same
+      // lock the cursor fallbacks use
+      std::lock_guard<std::mutex> lock( cursorMutex_ );
+
+      if ( pos + physicalPageSize > memBuffer_->size() )
+      {
+         memBuffer_->resize( static_cast<size_t>( pos + physicalPageSize ) );
+      }
+
+      memcpy( memBuffer_->data() + pos, page_buffer, physicalPageSize );
+      return;
+   }
+
+#if defined( _MSC_VER )
+   lseek64( static_cast<int64_t>( pos ), SEEK_SET );
+
+   const int result = ::_write( fd_, page_buffer, physicalPageSize );
+#elif defined( __GNUC__ )
+   const ssize_t result =
+      ::pwrite( fd_, page_buffer, physicalPageSize, static_cast<off_t>( pos ) );
+#else
+#error "no supported compiler defined"
+#endif
+
+   if ( result < 0 )
+   {
+      throw E57_EXCEPTION2( ErrorWriteFailed,
+                            "fileName=" + fileName_ + " result=" + toString( result ) );
+   }
+}
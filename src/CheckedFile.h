@@ -28,6 +28,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include "Common.h"
 
@@ -53,6 +59,8 @@ namespace e57
       {
          Read,
          Write,
+         /// Open an existing file read-write without truncating it (append mode)
+         WriteExisting,
       };
 
       enum OffsetMode
@@ -63,10 +71,56 @@ namespace e57
 
       CheckedFile( const e57::ustring &fileName, Mode mode, ReadChecksumPolicy policy );
       CheckedFile( const char *input, uint64_t size, ReadChecksumPolicy policy );
+
+      /// Memory-backed write mode: pages are written into the caller-owned, growable
+      /// outBuffer instead of a filesystem path.  After close() the buffer holds the
+      /// complete E57 byte stream, ready to hand to a network sink.
+      CheckedFile( std::vector<char> *outBuffer, ReadChecksumPolicy policy );
+
+      /// Backend-backed read mode: every page comes from backend->readAt(), so the
+      /// bytes can live anywhere the caller can fetch ranges from (see e57::ReadBackend)
+      CheckedFile( std::shared_ptr<ReadBackend> backend, ReadChecksumPolicy policy );
+
       ~CheckedFile();
 
       void read( char *buf, size_t nRead, size_t bufSize = 0 );
+
+      /// Positionless read: fetch nRead bytes starting at logicalOffset without
+      /// using or moving the current seek position.  Backed by pread() on POSIX
+      /// and overlapped ReadFile() on Windows (MSVC), so it halves the syscalls
+      /// of a seek+read pair and is the
+      /// primitive to build concurrent access to one open file on.  On a
+      /// read-only file it is safe to call from several threads at once; the
+      /// statistics counters are the only shared state it touches (see below).
+      void readAt( char *buf, size_t nRead, uint64_t logicalOffset );
+
+      /// Map the whole file into memory (read-only files on POSIX platforms), so page
+      /// access in read()/readAt() becomes pointer arithmetic over the mapping instead
+      /// of one pread() per 1024-byte physical page, with CRC verification done in
+      /// place.  Best-effort: returns false (and the pread() path keeps working) for
+      /// writable or memory-backed files, 32-bit address spaces, unsupported platforms
+      /// and any mmap() failure.
+      bool mapForReading();
+
+      /// Switch the descriptor to O_DIRECT so single-pass reads bypass the OS page
+      /// cache instead of evicting other processes' hot data (bulk conversion on a
+      /// shared host).  Transfers are widened to the device alignment through a bounce
+      /// buffer, so callers see no alignment constraints.  Best-effort: returns false
+      /// (and cached reads keep working) for writable, memory-backed or mapped files
+      /// and on platforms without O_DIRECT.
+      bool enableDirectRead();
+
       void write( const char *buf, size_t nWrite );
+
+      /// Positionless write: store nWrite bytes at logicalOffset without using or
+      /// moving the write cursor.  The range must lie inside the file's current
+      /// logical length (blob extents are reserved up front, see
+      /// ImageFileImpl::allocateSpace()).  Backed by pwrite() on POSIX, so disjoint
+      /// ranges can be written from several threads at once - concurrently with each
+      /// other and with the (single) cursor writer; pages shared across writers are
+      /// made atomic by a per-page lock stripe.  The CRT fd path has no pwrite() and
+      /// serializes each page against the cursor instead.
+      void writeAt( const char *buf, size_t nWrite, uint64_t logicalOffset );
       CheckedFile &operator<<( const e57::ustring &s );
       CheckedFile &operator<<( int64_t i );
       CheckedFile &operator<<( uint64_t i );
@@ -77,29 +131,106 @@ namespace e57
       uint64_t length( OffsetMode omode = Logical );
       void extend( uint64_t newLength, OffsetMode omode = Logical );
 
+      /// Best-effort hint that the file will grow to roughly expectedPhysicalSize bytes.
+      /// Asks the OS to reserve (ideally contiguous) extents up front so incremental page
+      /// writes don't fragment the file; the visible file length is unchanged and any unused
+      /// reservation is released when the file is closed.  Unsupported platforms and
+      /// filesystems silently ignore the hint.
+      void preallocate( uint64_t expectedPhysicalSize );
+
+      /// Between begin/endBufferedWrites(), sequential write()s are collected in a
+      /// fixed-size buffer and hit the page/checksum machinery in bufferBytes-sized
+      /// runs instead of once per call.  Used while streaming out the XML section,
+      /// which is emitted as many small tokens.  Seeking or reading flushes the
+      /// buffer automatically.
+      void beginBufferedWrites( size_t bufferBytes = 1024 * 1024 );
+      void endBufferedWrites();
+
       e57::ustring fileName() const
       {
          return fileName_;
       }
 
+      /// Descriptor of the underlying file, or -1 for a memory-buffer file.  Used by
+      /// SharedPacketCache::attach() to derive the file's identity; callers must not
+      /// read, write or seek through it.
+      int fileDescriptor() const
+      {
+         return fd_;
+      }
+
+      /// Switch a ChecksumTiered read-only file from eager to deferred verification.
+      /// Called once the header and XML section have been read (and so verified
+      /// synchronously); from then on, pages are queued for a background verifier
+      /// thread instead of being CRC-checked on the read path.
+      void beginDeferredVerification();
+
+      /// Invoked (on the verifier thread) for each page the background verifier finds
+      /// corrupt.  Without a callback the first mismatch is rethrown from close().
+      void setChecksumMismatchCallback( std::function<void( const E57Exception &ex )> callback );
+
+      /// Pages handed to the background verifier and not yet checked; 0 means every
+      /// page read so far has been verified
+      uint64_t pendingVerifyCount() const;
+
       void close();
       void unlink();
 
+      /// Cheap always-on counters feeding Reader::GetStats(); plain increments, not atomic,
+      /// so cross-thread reads are approximate while another thread is using the file.
+      uint64_t seekCount() const
+      {
+         return seekCount_;
+      }
+
+      uint64_t crcVerifyCount() const
+      {
+         return crcVerifyCount_;
+      }
+
+      uint64_t bytesRead() const
+      {
+         return bytesRead_;
+      }
+
       static inline uint64_t logicalToPhysical( uint64_t logicalOffset );
       static inline uint64_t physicalToLogical( uint64_t physicalOffset );
 
    private:
       void verifyChecksum( char *page_buffer, uint64_t page );
+      void initVerifiedPages();
 
       template <class FTYPE> CheckedFile &writeFloatingPoint( FTYPE value, int precision );
 
+      void writeInternal( const char *buf, size_t nWrite );
+      void flushBufferedWrites();
+
       void getCurrentPageAndOffset( uint64_t &page, size_t &pageOffset,
                                     OffsetMode omode = Logical );
+      void readFromMapping( char *buf, size_t nRead, uint64_t logicalOffset );
+      bool readParallelAt( char *buf, size_t nRead, uint64_t logicalOffset );
+      bool readScatterAt( char *buf, size_t nRead, uint64_t logicalOffset );
+      void verifyScatteredPage( const char *payload, uint32_t storedChecksum, uint64_t page );
+      void readDirectAt( char *buf, size_t nBytes, uint64_t pos );
+      void readPhysicalSpanAt( char *buf, uint64_t firstPage, size_t pageCount );
+      void verifyPagesParallel( const char *pages, uint64_t firstPage, size_t pageCount );
       void readPhysicalPage( char *page_buffer, uint64_t page );
+      void readPhysicalPageAt( char *page_buffer, uint64_t page );
+      void writePhysicalPageAt( char *page_buffer, uint64_t page );
+      void verifyPageForRead( char *page_buffer, uint64_t page, size_t nRemaining );
+      void enqueueDeferredVerify( char *page_buffer, uint64_t page );
+      void verifierLoop();
+      void stopVerifier();
       void writePhysicalPage( char *page_buffer, uint64_t page );
+      void writePhysicalSpan( const char *pages, uint64_t firstPage, size_t pageCount );
       int open64( const e57::ustring &fileName, int flags, int mode );
       uint64_t lseek64( int64_t offset, int whence );
 
+#if defined( _MSC_VER )
+      bool openWinReadHandle( const e57::ustring &fileName );
+      void readWinHandleAt( char *buf, size_t nRead, uint64_t physicalOffset );
+#endif
+
       e57::ustring fileName_;
       uint64_t logicalLength_ = 0;
       uint64_t physicalLength_ = 0;
@@ -108,7 +239,82 @@ namespace e57
 
       int fd_ = -1;
       BufferView *bufView_ = nullptr;
+
+#if defined( _MSC_VER )
+      /// Native Win32 backend for read-only files.  The handle is opened with
+      /// FILE_FLAG_SEQUENTIAL_SCAN (aggressive cache-manager read-ahead) and
+      /// FILE_FLAG_OVERLAPPED, so every read carries its own offset - the Win32
+      /// equivalent of pread() - instead of the CRT's seek+read pair.  An
+      /// overlapped handle has no usable file pointer, so the cursor for the
+      /// stateful read path is tracked here (like the memory-backed modes).
+      /// Declared void* to keep <windows.h> out of this header.
+      void *winReadHandle_ = nullptr;
+      uint64_t winReadPosition_ = 0;
+#endif
       bool readOnly_ = false;
+      bool preallocated_ = false;
+
+      /// Whole-file read-only mapping (see mapForReading()); null unless enabled
+      const char *mapping_ = nullptr;
+      uint64_t mappingBytes_ = 0;
+
+      /// Page-cache-bypassing reads (see enableDirectRead()); off unless enabled
+      bool directRead_ = false;
+      size_t directAlignment_ = 0;
+
+      /// Memory-backed write mode (see the outBuffer constructor); cursor is tracked
+      /// here since there is no file descriptor to ask
+      std::vector<char> *memBuffer_ = nullptr;
+      uint64_t memPosition_ = 0;
+
+      /// Backend-backed read mode (see the ReadBackend constructor); reads are
+      /// positionless, so only the stateful read path needs the tracked cursor
+      std::shared_ptr<ReadBackend> backend_;
+      uint64_t backendPosition_ = 0;
+
+      /// One bit per physical page that already passed CRC verification; read-only
+      /// instances consult it so cache churn doesn't re-verify proven pages.
+      /// Sized once at open (1 bit per KB of file, the length of a read-only file
+      /// is fixed) and updated with relaxed atomics, so concurrent readAt() calls
+      /// never race on it.  Re-verifying a page twice is harmless, so no stronger
+      /// ordering is needed.
+      std::unique_ptr<std::atomic<uint64_t>[]> verifiedPages_;
+      size_t verifiedPageWords_ = 0;
+
+      /// Tiered verification state (only used with ChecksumTiered; see
+      /// beginDeferredVerification()).  Queued pages are copies, so the verifier never
+      /// touches the file and reader threads never wait on it.  The queue is capped:
+      /// when the verifier falls too far behind, readers verify inline instead of
+      /// growing the backlog without bound.
+      bool deferredVerify_ = false;
+      std::function<void( const E57Exception &ex )> mismatchCallback_;
+      std::deque<std::pair<uint64_t, std::vector<char>>> verifyQueue_;
+      mutable std::mutex verifyMutex_;
+      std::condition_variable verifyCV_;
+      std::thread verifyThread_;
+      bool verifyShutdown_ = false;
+      std::atomic<uint64_t> verifyPending_{ 0 };
+      std::unique_ptr<E57Exception> firstMismatch_;
+
+      /// Lock stripe making each page's read-modify-write atomic: blob extents are
+      /// only 4-byte aligned, so a writeAt() caller and another writer (writeAt() or
+      /// the cursor path) can land on the same boundary page.  Striped by page number
+      /// so concurrent writers on distinct pages never contend.
+      static constexpr size_t cPageLockCount = 64;
+      std::mutex pageLocks_[cPageLockCount];
+
+      /// Serializes cursor movement between the stateful write path and the
+      /// writeAt() fallbacks that have no pwrite() (CRT fd, memory buffer resize)
+      std::mutex cursorMutex_;
+
+      /// Pending sequential writes (only used between begin/endBufferedWrites())
+      std::vector<char> writeBuffer_;
+      size_t writeBufferCapacity_ = 0;
+
+      /// Runtime statistics (see accessors above)
+      uint64_t seekCount_ = 0;
+      uint64_t crcVerifyCount_ = 0;
+      uint64_t bytesRead_ = 0;
    };
 
    inline uint64_t CheckedFile::logicalToPhysical( uint64_t logicalOffset )
@@ -3,10 +3,84 @@
 
 #include "Common.h"
 
+#include <mutex>
+#include <new>
 #include <random>
 
 namespace e57
 {
+   namespace
+   {
+      std::mutex memoryHookMutex;
+
+      /// Installed by SetMemoryAllocator(); both empty by default (plain `new[]`)
+      MemoryAllocator customMemoryAllocate;
+      MemoryDeallocator customMemoryDeallocate;
+   }
+
+   void SetMemoryAllocator( const MemoryAllocator &allocate, const MemoryDeallocator &deallocate )
+   {
+      if ( static_cast<bool>( allocate ) != static_cast<bool>( deallocate ) )
+      {
+         throw E57_EXCEPTION2( ErrorBadAPIArgument,
+                               "allocate and deallocate must be set or cleared together" );
+      }
+
+      const std::lock_guard<std::mutex> lock( memoryHookMutex );
+
+      customMemoryAllocate = allocate;
+      customMemoryDeallocate = deallocate;
+   }
+
+   void *internalAllocate( size_t bytes )
+   {
+      MemoryAllocator allocate;
+
+      {
+         const std::lock_guard<std::mutex> lock( memoryHookMutex );
+
+         allocate = customMemoryAllocate;
+      }
+
+      if ( !allocate )
+      {
+         return new char[bytes];
+      }
+
+      void *block = allocate( bytes );
+
+      if ( block == nullptr )
+      {
+         throw std::bad_alloc();
+      }
+
+      return block;
+   }
+
+   void internalDeallocate( void *block, size_t bytes ) noexcept
+   {
+      if ( block == nullptr )
+      {
+         return;
+      }
+
+      MemoryDeallocator deallocate;
+
+      {
+         const std::lock_guard<std::mutex> lock( memoryHookMutex );
+
+         deallocate = customMemoryDeallocate;
+      }
+
+      if ( deallocate )
+      {
+         deallocate( block, bytes );
+      }
+      else
+      {
+         delete[] static_cast<char *>( block );
+      }
+   }
 
    std::string generateRandomGUID()
    {
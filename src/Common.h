@@ -79,4 +79,10 @@ namespace e57
 
    /// generates a new random GUID
    std::string generateRandomGUID();
+
+   /// Allocation trampolines for the library's large internal buffers (node tree arena
+   /// blocks, packet cache storage).  They dispatch to the hooks installed with
+   /// e57::SetMemoryAllocator() and fall back to plain `new[]` when none are set.
+   void *internalAllocate( size_t bytes );
+   void internalDeallocate( void *block, size_t bytes ) noexcept;
 }
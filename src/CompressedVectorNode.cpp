@@ -478,3 +478,153 @@ CompressedVectorReader CompressedVectorNode::reader( const std::vector<SourceDes
 {
    return CompressedVectorReader( impl_->reader( dbufs ) );
 }
+
+namespace
+{
+   // Rebuild a prototype/codecs subtree against another ImageFile.  Only the node types and
+   // attributes matter for these trees (see CompressedVectorNode), so this produces the same
+   // result as writing the tree out as XML and parsing it back in the destination file.
+   Node copyNodeTree( const ImageFile &destImageFile, const Node &in )
+   {
+      switch ( in.type() )
+      {
+         case TypeStructure:
+         {
+            const StructureNode source( in );
+            StructureNode copy( destImageFile );
+
+            for ( int64_t i = 0; i < source.childCount(); ++i )
+            {
+               const Node child = source.get( i );
+               copy.set( child.elementName(), copyNodeTree( destImageFile, child ) );
+            }
+
+            return copy;
+         }
+
+         case TypeVector:
+         {
+            const VectorNode source( in );
+            VectorNode copy( destImageFile, source.allowHeteroChildren() );
+
+            for ( int64_t i = 0; i < source.childCount(); ++i )
+            {
+               copy.append( copyNodeTree( destImageFile, source.get( i ) ) );
+            }
+
+            return copy;
+         }
+
+         case TypeInteger:
+         {
+            const IntegerNode source( in );
+
+            return IntegerNode( destImageFile, source.value(), source.minimum(),
+                                source.maximum() );
+         }
+
+         case TypeScaledInteger:
+         {
+            const ScaledIntegerNode source( in );
+
+            return ScaledIntegerNode( destImageFile, source.rawValue(), source.minimum(),
+                                      source.maximum(), source.scale(), source.offset() );
+         }
+
+         case TypeFloat:
+         {
+            const FloatNode source( in );
+
+            return FloatNode( destImageFile, source.value(), source.precision(), source.minimum(),
+                              source.maximum() );
+         }
+
+         case TypeString:
+         {
+            const StringNode source( in );
+
+            return StringNode( destImageFile, source.value() );
+         }
+
+         default:
+            // BlobNodes and CompressedVectorNodes can't appear in prototype or codecs trees
+            throw E57_EXCEPTION2( ErrorInvalidNodeType, "nodeType=" + toString( in.type() ) );
+      }
+   }
+}
+
+/*!
+@brief Copy this CompressedVectorNode and its binary section into another ImageFile without
+decoding.
+
+@param [in] destImageFile The ImageFile that will receive the copy.
+
+@details
+The prototype and codecs trees are rebuilt against @a destImageFile, and the binary section (the
+section header and all data and index packets, see the ASTM E57 data format standard) is copied
+byte-for-byte into free space of @a destImageFile. Only the absolute file offsets stored in the
+section header and in index packets are patched for the new location, and destination pages are
+re-checksummed as they are written. Since no records are decoded or re-encoded, the cost is bound
+by disk bandwidth rather than CPU, which makes this the preferred way to extract scans from a
+large project file.
+
+The returned CompressedVectorNode is unattached; add it underneath the root of @a destImageFile
+(e.g. append it to a "data3D" VectorNode) to include it in the file.
+
+@pre The destination ImageFile must be open (i.e. destImageFile.isOpen()).
+@pre The @a destImageFile must have been opened in write mode (i.e. destImageFile.isWritable()).
+@pre The source ImageFile must be open (i.e. destImageFile().isOpen()).
+
+@return A smart CompressedVectorNode handle referencing the copy in @a destImageFile.
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorFileReadOnly
+@throw ::ErrorBadCVPacket
+@throw ::ErrorInvalidNodeType
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorNode::CompressedVectorNode, CompressedVectorNode::prototype
+*/
+CompressedVectorNode CompressedVectorNode::copyTo( const ImageFile &destImageFile ) const
+{
+   CompressedVectorNode copy( destImageFile, copyNodeTree( destImageFile, prototype() ),
+                              VectorNode( copyNodeTree( destImageFile, codecs() ) ) );
+
+   impl_->copyBinarySectionTo( copy.impl_ );
+
+   return copy;
+}
+
+/*!
+@brief Get the decode-aligned split points of this CompressedVectorNode for partitioned reading.
+
+@details
+Returns the points where decoding of the binary section can start without reading any earlier
+packet, gathered from the section's index packets (see the ASTM E57 data format standard). The
+points are in ascending record order and the first one is always record 0; the records between
+two consecutive points — or between the last point and childCount() — form a chunk that can be
+decoded independently of the rest of the section.
+
+This is intended for distributed or multi-process ingest: a planner calls this once, assigns
+consecutive runs of chunks to workers, and each worker opens the file independently and reads
+only its record range, instead of every worker decoding from record 0. The granularity of the
+plan is whatever the file's index provides — one point per indexed chunk. Files that carry only
+the minimal one-entry index required by the standard yield a single point, i.e. the section
+cannot be split.
+
+An empty result means the CompressedVectorNode was never written and has no binary section.
+
+@pre The associated ImageFile must be open (i.e. destImageFile().isOpen()).
+
+@return The split points, in ascending record order.
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorBadCVPacket
+@throw ::ErrorInternal All objects in undocumented state
+
+@see RecordSplitPoint, CompressedVectorNode::reader, CompressedVectorNode::childCount
+*/
+std::vector<RecordSplitPoint> CompressedVectorNode::partitionPoints() const
+{
+   return impl_->partitionPoints();
+}
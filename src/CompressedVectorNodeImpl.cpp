@@ -25,11 +25,15 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <cstring>
+
 #include "CompressedVectorNodeImpl.h"
 #include "CheckedFile.h"
 #include "CompressedVectorReaderImpl.h"
 #include "CompressedVectorWriterImpl.h"
 #include "ImageFileImpl.h"
+#include "Packet.h"
+#include "SectionHeaders.h"
 #include "StringFunctions.h"
 #include "VectorNodeImpl.h"
 
@@ -187,6 +191,21 @@ namespace e57
       }
    }
 
+   void CompressedVectorNodeImpl::buildLookupIndexesRecursive()
+   {
+      // The prototype tree is looked up by reader setup (e.g. checkBuffers()), so it
+      // needs its indexes frozen just like the main tree
+      if ( prototype_ )
+      {
+         prototype_->buildLookupIndexesRecursive();
+      }
+
+      if ( codecs_ )
+      {
+         codecs_->buildLookupIndexesRecursive();
+      }
+   }
+
    int64_t CompressedVectorNodeImpl::childCount() const
    {
       checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
@@ -332,7 +351,10 @@ namespace e57
                                   " writerCount=" + toString( destImageFile->writerCount() ) +
                                   " readerCount=" + toString( destImageFile->readerCount() ) );
       }
-      if ( destImageFile->readerCount() > 0 )
+      // A read-only file supports concurrent reader sessions (each reader owns its
+      // packet cache and reads positionlessly); in write mode the file cursor is
+      // shared with the writer machinery, so only one reader may be open at a time.
+      if ( destImageFile->isWriter() && ( destImageFile->readerCount() > 0 ) )
       {
          throw E57_EXCEPTION2( ErrorTooManyReaders,
                                "fileName=" + destImageFile->fileName() +
@@ -371,4 +393,251 @@ namespace e57
          new CompressedVectorReaderImpl( cai, dbufs ) );
       return ( cvri );
    }
+
+   CompressedVectorNodeImpl::DecodePlanEntry CompressedVectorNodeImpl::decodePlanEntry(
+      const ustring &pathName )
+   {
+      std::lock_guard<std::mutex> lock( decodePlanMutex_ );
+
+      const auto found = decodePlan_.find( pathName );
+      if ( found != decodePlan_.end() )
+      {
+         return ( found->second );
+      }
+
+      // Compile the entry: resolve the field's node in the prototype tree, then find
+      // which bytestream carries it (its position among the prototype's terminals).
+      // Both walks are what make opening repeated readers on the same scan expensive,
+      // so the result is cached for the scan's lifetime - the prototype is immutable
+      // once the vector has been written or read from a file.
+      DecodePlanEntry entry;
+
+      entry.decodeNode = prototype_->get( pathName );
+
+      uint64_t bytestreamNumber = 0;
+      if ( !prototype_->findTerminalPosition( entry.decodeNode, bytestreamNumber ) )
+      {
+         throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName );
+      }
+
+      entry.bytestreamNumber = static_cast<unsigned>( bytestreamNumber );
+
+      decodePlan_.emplace( pathName, entry );
+
+      return ( entry );
+   }
+
+   void CompressedVectorNodeImpl::copyBinarySectionTo(
+      const std::shared_ptr<CompressedVectorNodeImpl> &destCVector ) const
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      ImageFileImplSharedPtr srcImageFile( destImageFile_ );
+      ImageFileImplSharedPtr destImageFile( destCVector->destImageFile() );
+
+      if ( !destImageFile->isWriter() )
+      {
+         throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + destImageFile->fileName() );
+      }
+
+      // A CompressedVector that was never written has no binary section, so there is nothing
+      // to transplant and the new vector stays empty.
+      if ( binarySectionLogicalStart_ == 0 )
+      {
+         return;
+      }
+
+      CheckedFile *srcFile = srcImageFile->file();
+      CheckedFile *destFile = destImageFile->file();
+
+      // Read the source section header to learn the section extent
+      CompressedVectorSectionHeader sectionHeader;
+      srcFile->readAt( reinterpret_cast<char *>( &sectionHeader ), sizeof( sectionHeader ),
+                       binarySectionLogicalStart_ );
+      sectionHeader.verify( srcFile->length( CheckedFile::Physical ) );
+
+      // Reserve room for the whole section in the destination, then copy it over in bulk.
+      // The copy works in logical (checksum-free) space, so relative offsets inside the
+      // section are preserved exactly and CheckedFile::write() re-checksums each destination
+      // page as it is rewritten.  The packets themselves are never decoded.
+      const uint64_t destSectionLogicalStart =
+         destImageFile->allocateSpace( sectionHeader.sectionLogicalLength, false );
+
+      std::vector<char> copyBuffer( 1024 * 1024 );
+      uint64_t bytesCopied = 0;
+      while ( bytesCopied < sectionHeader.sectionLogicalLength )
+      {
+         const auto chunkSize = static_cast<size_t>( std::min(
+            sectionHeader.sectionLogicalLength - bytesCopied,
+            static_cast<uint64_t>( copyBuffer.size() ) ) );
+
+         srcFile->readAt( copyBuffer.data(), chunkSize, binarySectionLogicalStart_ + bytesCopied );
+         destFile->seek( destSectionLogicalStart + bytesCopied );
+         destFile->write( copyBuffer.data(), chunkSize );
+
+         bytesCopied += chunkSize;
+      }
+
+      // The section header and index packets store absolute physical offsets into their own
+      // file; rebase them from the source section start to the destination section start.
+      auto rebasePhysicalOffset = [this, destSectionLogicalStart]( uint64_t srcPhysicalOffset ) {
+         const uint64_t relativeOffset =
+            CheckedFile::physicalToLogical( srcPhysicalOffset ) - binarySectionLogicalStart_;
+
+         return CheckedFile::logicalToPhysical( destSectionLogicalStart + relativeOffset );
+      };
+
+      sectionHeader.dataPhysicalOffset = rebasePhysicalOffset( sectionHeader.dataPhysicalOffset );
+      if ( sectionHeader.indexPhysicalOffset != 0 )
+      {
+         sectionHeader.indexPhysicalOffset =
+            rebasePhysicalOffset( sectionHeader.indexPhysicalOffset );
+      }
+
+      destFile->seek( destSectionLogicalStart );
+      destFile->write( reinterpret_cast<const char *>( &sectionHeader ), sizeof( sectionHeader ) );
+
+      // Walk the copied packets and patch the chunk offsets inside any index packets.  Data
+      // and empty packets hold no absolute offsets and are left exactly as copied.
+      const uint64_t sectionEndLogicalOffset =
+         destSectionLogicalStart + sectionHeader.sectionLogicalLength;
+      uint64_t packetLogicalOffset =
+         destSectionLogicalStart + sizeof( CompressedVectorSectionHeader );
+
+      while ( packetLogicalOffset < sectionEndLogicalOffset )
+      {
+         // All three packet types share the same 4-byte prefix: type, flags, lengthMinus1
+         char packetPrefix[4];
+         destFile->readAt( packetPrefix, sizeof( packetPrefix ), packetLogicalOffset );
+
+         uint16_t packetLogicalLengthMinus1 = 0;
+         std::memcpy( &packetLogicalLengthMinus1, &packetPrefix[2],
+                      sizeof( packetLogicalLengthMinus1 ) );
+         const uint64_t packetLength = static_cast<uint64_t>( packetLogicalLengthMinus1 ) + 1;
+
+         const auto packetType = static_cast<uint8_t>( packetPrefix[0] );
+
+         switch ( packetType )
+         {
+            case INDEX_PACKET:
+            {
+               IndexPacket indexPacket;
+               destFile->readAt( reinterpret_cast<char *>( &indexPacket ),
+                                 static_cast<size_t>( packetLength ), packetLogicalOffset );
+
+               for ( unsigned i = 0; i < indexPacket.header.entryCount; i++ )
+               {
+                  indexPacket.entries[i].chunkPhysicalOffset =
+                     rebasePhysicalOffset( indexPacket.entries[i].chunkPhysicalOffset );
+               }
+
+               destFile->seek( packetLogicalOffset );
+               destFile->write( reinterpret_cast<const char *>( &indexPacket ),
+                                static_cast<size_t>( packetLength ) );
+            }
+            break;
+
+            case DATA_PACKET:
+            case EMPTY_PACKET:
+            case ZSTD_PACKET:
+               break;
+
+            default:
+               throw E57_EXCEPTION2(
+                  ErrorBadCVPacket, "packetType=" + toString( static_cast<unsigned>( packetType ) ) +
+                                       " packetLogicalOffset=" + toString( packetLogicalOffset ) );
+         }
+
+         packetLogicalOffset += packetLength;
+      }
+
+      destCVector->setBinarySectionLogicalStart( destSectionLogicalStart );
+      destCVector->setRecordCount( recordCount_ );
+   }
+
+   std::vector<RecordSplitPoint> CompressedVectorNodeImpl::partitionPoints() const
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      std::vector<RecordSplitPoint> points;
+
+      // A vector that was never written has no binary section, and no records to partition.
+      if ( binarySectionLogicalStart_ == 0 )
+      {
+         return points;
+      }
+
+      ImageFileImplSharedPtr imf( destImageFile_ );
+      CheckedFile *file = imf->file();
+
+      CompressedVectorSectionHeader sectionHeader;
+      file->readAt( reinterpret_cast<char *>( &sectionHeader ), sizeof( sectionHeader ),
+                    binarySectionLogicalStart_ );
+
+#if VALIDATE_BASIC
+      sectionHeader.verify( file->length( CheckedFile::Physical ) );
+#endif
+
+      if ( sectionHeader.indexPhysicalOffset == 0 )
+      {
+         // No index packets: the only place decoding can start is the first data packet.
+         points.push_back( { 0, sectionHeader.dataPhysicalOffset } );
+
+         return points;
+      }
+
+      // Walk the index packet tree depth-first, collecting the bottom-level entries.  The
+      // standard requires the entries to be in ascending record order, so the result is too.
+      collectIndexEntries( file, sectionHeader.indexPhysicalOffset, 0, points );
+
+      return points;
+   }
+
+   void CompressedVectorNodeImpl::collectIndexEntries( CheckedFile *file,
+                                                       uint64_t indexPhysicalOffset,
+                                                       unsigned depth,
+                                                       std::vector<RecordSplitPoint> &points ) const
+   {
+      // The index packet tree of a well formed file is extremely shallow (2048-way fan-out per
+      // level), so a deep chain of packets means the file is corrupt or malicious.
+      if ( depth > 8 )
+      {
+         throw E57_EXCEPTION2( ErrorBadCVPacket, "depth=" + toString( depth ) );
+      }
+
+      const uint64_t packetLogicalOffset = CheckedFile::physicalToLogical( indexPhysicalOffset );
+
+      IndexPacket indexPacket;
+
+      // Read the header first to learn the packet length, then the whole packet
+      file->readAt( reinterpret_cast<char *>( &indexPacket.header ), sizeof( IndexPacketHeader ),
+                    packetLogicalOffset );
+
+      const unsigned packetLength = indexPacket.header.packetLogicalLengthMinus1 + 1;
+
+      if ( packetLength < sizeof( IndexPacketHeader ) || packetLength > sizeof( IndexPacket ) )
+      {
+         throw E57_EXCEPTION2( ErrorBadCVPacket, "packetLength=" + toString( packetLength ) );
+      }
+
+      file->readAt( reinterpret_cast<char *>( &indexPacket ), packetLength, packetLogicalOffset );
+
+      indexPacket.verify( packetLength, static_cast<uint64_t>( recordCount_ ),
+                          file->length( CheckedFile::Physical ) );
+
+      for ( unsigned i = 0; i < indexPacket.header.entryCount; ++i )
+      {
+         const IndexPacket::Entry &entry = indexPacket.entries[i];
+
+         if ( indexPacket.header.indexLevel > 0 )
+         {
+            // Entries of an upper-level packet point at lower-level index packets
+            collectIndexEntries( file, entry.chunkPhysicalOffset, depth + 1, points );
+         }
+         else
+         {
+            points.push_back( { entry.chunkRecordNumber, entry.chunkPhysicalOffset } );
+         }
+      }
+   }
 }
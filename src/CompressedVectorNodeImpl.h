@@ -26,6 +26,9 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <mutex>
+#include <unordered_map>
+
 #include "NodeImpl.h"
 
 namespace e57
@@ -44,6 +47,7 @@ namespace e57
       bool isTypeEquivalent( NodeImplSharedPtr ni ) override;
       bool isDefined( const ustring &pathName ) override;
       void setAttachedRecursive() override;
+      void buildLookupIndexesRecursive() override;
 
       void setPrototype( const NodeImplSharedPtr &prototype );
       NodeImplSharedPtr getPrototype() const;
@@ -61,6 +65,29 @@ namespace e57
       std::shared_ptr<CompressedVectorWriterImpl> writer( std::vector<SourceDestBuffer> sbufs );
       std::shared_ptr<CompressedVectorReaderImpl> reader( std::vector<SourceDestBuffer> dbufs );
 
+      /// Part of the decode plan cached per prototype terminal path: where the field's
+      /// node lives in the prototype tree and which bytestream carries it.
+      struct DecodePlanEntry
+      {
+         NodeImplSharedPtr decodeNode;
+         unsigned bytestreamNumber = 0;
+      };
+
+      /// Plan entry for pathName, compiled on first use and cached across reader
+      /// instances, so opening the Nth reader on a scan skips the prototype tree walks.
+      DecodePlanEntry decodePlanEntry( const ustring &pathName );
+
+      /// Transplant this vector's binary section (section header plus packets) verbatim into
+      /// destCVector's file, patching only the absolute offsets stored in the section header and
+      /// in any index packets.  No records are decoded or re-encoded.
+      void copyBinarySectionTo( const std::shared_ptr<CompressedVectorNodeImpl> &destCVector ) const;
+
+      /// Decode-aligned split points gathered from the section's index packets, in record
+      /// order and always starting with record 0.  The granularity is whatever the file's
+      /// index provides: one entry per indexed chunk, or a single entry when the section
+      /// only carries the minimal one-entry index required by the standard.
+      std::vector<RecordSplitPoint> partitionPoints() const;
+
       int64_t getRecordCount() const
       {
          return ( recordCount_ );
@@ -88,9 +115,17 @@ namespace e57
    private:
       friend class CompressedVectorReaderImpl;
 
+      void collectIndexEntries( CheckedFile *file, uint64_t indexPhysicalOffset, unsigned depth,
+                                std::vector<RecordSplitPoint> &points ) const;
+
       NodeImplSharedPtr prototype_;
       std::shared_ptr<VectorNodeImpl> codecs_;
 
+      /// pathName -> compiled plan entry (see decodePlanEntry()); the mutex keeps the
+      /// lazy fill safe when reader sessions open concurrently
+      std::unordered_map<ustring, DecodePlanEntry> decodePlan_;
+      std::mutex decodePlanMutex_;
+
       int64_t recordCount_ = 0;
       uint64_t binarySectionLogicalStart_ = 0;
    };
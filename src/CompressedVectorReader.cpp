@@ -254,6 +254,130 @@ unsigned CompressedVectorReader::read( std::vector<SourceDestBuffer> &dbufs )
    return impl_->read( dbufs );
 }
 
+/*!
+@brief Start a read on a background thread, so decoding overlaps the caller's processing.
+
+@details
+Behaves like read() but returns immediately with a std::future that yields the number of records
+read (exceptions thrown by the read are rethrown from future::get()).
+
+The intended use is double buffering: register two sets of SourceDestBuffers, start a readAsync()
+into one set, process the other, then get() the future and swap. The caller's processing time and
+the library's decode+I/O time then overlap instead of adding.
+
+While the future is outstanding, the background thread owns this CompressedVectorReader and its
+ImageFile: no other operation may be performed on either until get()/wait() has returned.
+
+@pre The associated ImageFile must be open.
+@pre This CompressedVectorReader must be open (i.e isOpen())
+
+@return A future yielding the number of records read.
+
+@see CompressedVectorReader::read(), SourceDestBuffer
+*/
+std::future<unsigned> CompressedVectorReader::readAsync()
+{
+   auto impl = impl_;
+
+   return std::async( std::launch::async, [impl]() { return impl->read(); } );
+}
+
+/*!
+@brief Start a read into the given buffers on a background thread.
+
+@param [in] dbufs Destination buffers for the read; must stay alive and untouched until the
+returned future has been waited on.
+
+@details
+Behaves like read(dbufs) but returns immediately with a std::future that yields the number of
+records read. See readAsync() for the double-buffering pattern and the single-owner requirement
+while the future is outstanding.
+
+@pre The associated ImageFile must be open.
+@pre This CompressedVectorReader must be open (i.e isOpen())
+
+@return A future yielding the number of records read.
+
+@see CompressedVectorReader::readAsync(), CompressedVectorReader::read(), SourceDestBuffer
+*/
+std::future<unsigned> CompressedVectorReader::readAsync( std::vector<SourceDestBuffer> &dbufs )
+{
+   auto impl = impl_;
+   auto *buffers = &dbufs;
+
+   return std::async( std::launch::async, [impl, buffers]() { return impl->read( *buffers ); } );
+}
+
+/*!
+@brief Set the number of threads used to decode bytestreams during read().
+
+@param [in] threadCount Number of decode threads to use. 1 (the default) decodes serially on the
+calling thread. 0 requests one thread per hardware core.
+
+@details
+Each field (bytestream) in the prototype is decoded independently, so when more than one
+SourceDestBuffer is requested the per-packet decode work can be spread across threads. The decoded
+values always land in the same SourceDestBuffer locations as a serial read, and all exceptions are
+rethrown on the calling thread.
+
+This is an opt-in setting because the benefit depends on the number of fields requested and on the
+caller's threading environment.
+
+@pre This CompressedVectorReader must be open (i.e isOpen())
+
+@throw ::ErrorReaderNotOpen       This CompressedVectorReader in undocumented state
+@throw ::ErrorInternal            All objects in undocumented state
+
+@see CompressedVectorReader::read()
+*/
+void CompressedVectorReader::setDecodeThreadCount( unsigned threadCount )
+{
+   impl_->setDecodeThreadCount( threadCount );
+}
+
+/*!
+@brief Accumulate per-field minimum/maximum/count while reading.
+
+@param [in] enabled true starts accumulating on the next read(); false stops.
+
+@details
+When enabled, each read() folds the records it just delivered into a running minimum, maximum, and
+count per requested field, while the destination buffers are still cache-hot from decoding. This
+replaces the separate full pass over the data that callers otherwise make to compute bounds or
+intensity ranges after reading - a significant saving in memory bandwidth on large files.
+
+Statistics accumulate across read() calls until the reader is closed; fetch them with
+statistics(). Accumulation is off by default because it adds a small amount of per-record work.
+
+@pre This CompressedVectorReader must be open (i.e isOpen())
+
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorReader::statistics()
+*/
+void CompressedVectorReader::setStatisticsEnabled( bool enabled )
+{
+   impl_->setStatisticsEnabled( enabled );
+}
+
+/*!
+@brief Get the per-field statistics accumulated so far.
+
+@details
+One entry per requested SourceDestBuffer, in request order, identified by its path name. Entries
+for fields that have not accumulated any values (or string fields, which have no numeric range)
+keep their initial minimum/maximum.
+
+@return Returns the statistics accumulated since the reader was opened (empty unless
+setStatisticsEnabled() was called before reading).
+
+@see CompressedVectorReader::setStatisticsEnabled()
+*/
+std::vector<FieldStatistics> CompressedVectorReader::statistics() const
+{
+   return impl_->statistics();
+}
+
 /*!
 @brief Set record number of CompressedVectorNode where next read will start.
 
@@ -263,7 +387,14 @@ CompressedVectorReader will start.
 @details
 This function may be called at any time (as long as ImageFile and CompressedVectorReader are open).
 The next read will start at the given recordNumber. It is not an error to seek to recordNumber =
-childCount() (i.e. to one record past end of CompressedVectorNode).
+childCount() (i.e. to one record past end of CompressedVectorNode). Seeking in either direction is
+supported, and costs a binary search of a record-to-packet table (built once per reader by a
+header-only scan of the binary section) plus the decode-free skip of at most one packet's worth of
+bits per requested field, so jumps are cheap regardless of distance.
+
+Seeking requires every requested field to have a fixed record width. If one of the destination
+buffers is bound to a variable length field (a String), record boundaries can only be found by
+decoding from the front, and this function throws ::ErrorNotImplemented.
 
 @pre @a recordNumber <= childCount() of CompressedVectorNode.
 @pre The associated ImageFile must be open.
@@ -272,6 +403,7 @@ childCount() (i.e. to one record past end of CompressedVectorNode).
 @throw ::ErrorBadAPIArgument
 @throw ::ErrorImageFileNotOpen
 @throw ::ErrorReaderNotOpen
+@throw ::ErrorNotImplemented A requested field is variable length
 @throw ::ErrorBadCVPacket
 @throw ::ErrorSeekFailed
 @throw ::ErrorReadFailed
@@ -282,7 +414,7 @@ childCount() (i.e. to one record past end of CompressedVectorNode).
 */
 void CompressedVectorReader::seek( int64_t recordNumber )
 {
-   impl_->seek( recordNumber );
+   impl_->seek( static_cast<uint64_t>( recordNumber ) );
 }
 
 /*!
@@ -25,14 +25,18 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <thread>
+
 #include "CompressedVectorReaderImpl.h"
 #include "CheckedFile.h"
 #include "CompressedVectorNodeImpl.h"
+#include "Executor.h"
 #include "ImageFileImpl.h"
 #include "Packet.h"
 #include "SectionHeaders.h"
 #include "SourceDestBufferImpl.h"
 #include "StringFunctions.h"
+#include "Trace.h"
 
 namespace e57
 {
@@ -68,28 +72,25 @@ namespace e57
       setBuffers( dbufs );
 
       // For each dbuf, create an appropriate Decoder based on the cVector_
-      // attributes
+      // attributes.  The per-field plan (prototype node, bytestream number) is cached
+      // on the vector, so re-opening readers on the same scan skips the proto walks.
       for ( unsigned i = 0; i < dbufs_.size(); i++ )
       {
+         const CompressedVectorNodeImpl::DecodePlanEntry plan =
+            cVector_->decodePlanEntry( dbufs.at( i ).pathName() );
+
          std::vector<SourceDestBuffer> theDbuf;
          theDbuf.push_back( dbufs.at( i ) );
 
          std::shared_ptr<Decoder> decoder =
-            Decoder::DecoderFactory( i, cVector_.get(), theDbuf, ustring() );
-
-         // Calc which stream the given path belongs to.  This depends on position
-         // of the node in the proto tree.
-         NodeImplSharedPtr readNode = proto_->get( dbufs.at( i ).pathName() );
-         uint64_t bytestreamNumber = 0;
-         if ( !proto_->findTerminalPosition( readNode, bytestreamNumber ) )
-         {
-            throw E57_EXCEPTION2( ErrorInternal, "dbufIndex=" + toString( i ) );
-         }
+            Decoder::DecoderFactory( i, cVector_.get(), plan.decodeNode, theDbuf, ustring() );
 
-         channels_.emplace_back( dbufs.at( i ), decoder, static_cast<unsigned>( bytestreamNumber ),
+         channels_.emplace_back( dbufs.at( i ), decoder, plan.bytestreamNumber,
                                  cVector_->childCount() );
       }
 
+      bytesDecoded_.assign( channels_.size(), 0 );
+
       recordCount_ = 0;
 
       // Get how many records are actually defined
@@ -118,8 +119,8 @@ namespace e57
 
       // Read CompressedVector section header
       CompressedVectorSectionHeader sectionHeader;
-      imf->file_->seek( sectionLogicalStart, CheckedFile::Logical );
-      imf->file_->read( reinterpret_cast<char *>( &sectionHeader ), sizeof( sectionHeader ) );
+      imf->file_->readAt( reinterpret_cast<char *>( &sectionHeader ), sizeof( sectionHeader ),
+                          sectionLogicalStart );
 
 #if VALIDATE_BASIC
       sectionHeader.verify( imf->file_->length( CheckedFile::Physical ) );
@@ -132,8 +133,27 @@ namespace e57
       uint64_t dataLogicalOffset =
          imf->file_->physicalToLogical( sectionHeader.dataPhysicalOffset );
 
+      dataStartLogicalOffset_ = dataLogicalOffset;
+
+      // A file-level memory budget (ImageFile::setMemoryBudget()) caps the packet cache;
+      // half the budget is left for channel state and the caller's destination buffers.
+      unsigned cachePacketCount =
+         ( imf->packetCacheSize_ != 0 ) ? imf->packetCacheSize_ : 32;
+
+      const uint64_t memoryBudget = imf->memoryBudget();
+
+      if ( memoryBudget != 0 )
+      {
+         const uint64_t budgetedPackets =
+            std::max<uint64_t>( 1, ( memoryBudget / 2 ) / DATA_PACKET_MAX );
+
+         cachePacketCount = static_cast<unsigned>(
+            std::min( static_cast<uint64_t>( cachePacketCount ), budgetedPackets ) );
+      }
+
       //??? what if fault in this constructor?
-      cache_ = new PacketReadCache( imf->file_, 32 );
+      cache_ = new PacketReadCache( imf->file_, cachePacketCount, imf->sharedPacketCache_,
+                                    imf->packetReadAhead_ );
 
       // Verify that packet given by dataPhysicalOffset is actually a data packet,
       // init channels
@@ -163,6 +183,18 @@ namespace e57
          }
       }
 
+      // Account this session's buffers while it is open (see ImageFile::memoryUsage());
+      // the cache storage and decoder staging buffers are fixed at this point
+      accountedCacheBytes_ = cache_->storageBytes();
+
+      for ( auto &channel : channels_ )
+      {
+         accountedDecodeBytes_ += channel.decoder->stagingBytes();
+      }
+
+      imf->packetCacheMem_.add( accountedCacheBytes_ );
+      imf->decodeBufferMem_.add( accountedDecodeBytes_ );
+
       // Just before return (and can't throw) increment reader count  ??? safer
       // way to assure don't miss close?
       imf->incrReaderCount();
@@ -196,6 +228,28 @@ namespace e57
       // don't checkImageFileOpen
       // don't checkReaderOpen
 
+      // Fast path for the chunked-read pattern: the caller re-presents exactly the same
+      // buffers on every read() call (drained in place between calls), so revalidating and
+      // re-binding them every time is redundant per-call work.
+      if ( !dbufs_.empty() && dbufs_.size() == dbufs.size() )
+      {
+         bool sameBuffers = true;
+
+         for ( size_t i = 0; i < dbufs.size(); ++i )
+         {
+            if ( dbufs[i].impl().get() != boundBufferImpls_[i] )
+            {
+               sameBuffers = false;
+               break;
+            }
+         }
+
+         if ( sameBuffers )
+         {
+            return;
+         }
+      }
+
       // Check dbufs well formed: no dups, no extra, missing is ok
       proto_->checkBuffers( dbufs, true );
 
@@ -220,6 +274,17 @@ namespace e57
       }
 
       dbufs_ = dbufs;
+
+      // Cache the raw buffer pointers so the per-call paths (identity check above, rewind in
+      // read()) stay away from shared_ptr reference count traffic.  The handles in dbufs_
+      // keep the pointed-to objects alive.
+      boundBufferImpls_.clear();
+      boundBufferImpls_.reserve( dbufs_.size() );
+
+      for ( auto &dbuf : dbufs_ )
+      {
+         boundBufferImpls_.push_back( dbuf.impl().get() );
+      }
    }
 
    unsigned CompressedVectorReaderImpl::read( std::vector<SourceDestBuffer> &dbufs )
@@ -244,11 +309,13 @@ namespace e57
       checkReaderOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
 
       // Rewind all dbufs so start writing to them at beginning
-      for ( auto &dbuf : dbufs_ )
+      for ( auto *dbuf : boundBufferImpls_ )
       {
-         dbuf.impl()->rewind();
+         dbuf->rewind();
       }
 
+      trace::emit( TraceEvent::DecodeStart, recordCount_, 0 );
+
       // Allow decoders to use data they already have in their queue to fill newly
       // empty dbufs This helps to keep decoder input queues smaller, which
       // reduces backtracking in the packet cache.
@@ -283,23 +350,79 @@ namespace e57
          DecodeChannel *chan = &channels_[i];
          if ( i == 0 )
          {
-            outputCount = chan->dbuf.impl()->nextIndex();
+            outputCount = chan->dbufImpl->nextIndex();
          }
          else
          {
-            if ( outputCount != chan->dbuf.impl()->nextIndex() )
+            if ( outputCount != chan->dbufImpl->nextIndex() )
             {
                throw E57_EXCEPTION2(
                   ErrorInternal, "outputCount=" + toString( outputCount ) +
-                                    " nextIndex=" + toString( chan->dbuf.impl()->nextIndex() ) );
+                                    " nextIndex=" + toString( chan->dbufImpl->nextIndex() ) );
             }
          }
       }
 
+      recordCount_ += outputCount;
+
+      if ( statisticsEnabled_ && ( outputCount > 0 ) )
+      {
+         accumulateStatistics( outputCount );
+      }
+
+      trace::emit( TraceEvent::DecodeEnd, recordCount_, outputCount );
+
       // Return number of records transferred to each dbuf.
       return outputCount;
    }
 
+   void CompressedVectorReaderImpl::setStatisticsEnabled( bool enabled )
+   {
+      statisticsEnabled_ = enabled;
+   }
+
+   std::vector<FieldStatistics> CompressedVectorReaderImpl::statistics() const
+   {
+      return statistics_;
+   }
+
+   void CompressedVectorReaderImpl::accumulateStatistics( unsigned recordCount )
+   {
+      // (Re)build the per-field slots when the bound buffers changed
+      if ( statistics_.size() != dbufs_.size() )
+      {
+         statistics_.assign( dbufs_.size(), FieldStatistics() );
+
+         for ( size_t i = 0; i < dbufs_.size(); ++i )
+         {
+            statistics_[i].pathName = dbufs_[i].pathName();
+         }
+      }
+
+      for ( size_t i = 0; i < boundBufferImpls_.size(); ++i )
+      {
+         FieldStatistics &fieldStats = statistics_[i];
+
+         boundBufferImpls_[i]->accumulateMinMax( recordCount, fieldStats.minimum,
+                                                 fieldStats.maximum );
+         fieldStats.count += recordCount;
+      }
+   }
+
+   void CompressedVectorReaderImpl::setDecodeThreadCount( unsigned threadCount )
+   {
+      // don't checkImageFileOpen
+      // don't checkReaderOpen
+
+      // Zero means "choose for me": use what the hardware reports.
+      if ( threadCount == 0 )
+      {
+         threadCount = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      decodeThreadCount_ = threadCount;
+   }
+
    uint64_t CompressedVectorReaderImpl::earliestPacketNeededForInput() const
    {
       uint64_t earliestPacketLogicalOffset = UINT64_MAX;
@@ -355,6 +478,72 @@ namespace e57
                channel.isOutputBlocked() );
    }
 
+   void CompressedVectorReaderImpl::feedChannel( DataPacket *dpkt, DecodeChannel &channel )
+   {
+      // Get bytestream buffer for this channel from packet
+      unsigned int bsbLength = 0;
+      const char *bsbStart = dpkt->getBytestream( channel.bytestreamNumber, bsbLength );
+
+      // Double check we are not off end of buffer
+      if ( channel.currentBytestreamBufferIndex > bsbLength )
+      {
+         throw E57_EXCEPTION2(
+            ErrorInternal,
+            "currentBytestreamBufferIndex =" + toString( channel.currentBytestreamBufferIndex ) +
+               " bsbLength=" + toString( bsbLength ) );
+      }
+
+      // Calc where we are in the buffer
+      const char *uneatenStart = &bsbStart[channel.currentBytestreamBufferIndex];
+      const size_t uneatenLength = bsbLength - channel.currentBytestreamBufferIndex;
+
+      if ( &uneatenStart[uneatenLength] > &bsbStart[bsbLength] )
+      {
+         throw E57_EXCEPTION2( ErrorInternal, "uneatenLength=" + toString( uneatenLength ) +
+                                                 " bsbLength=" + toString( bsbLength ) );
+      }
+
+      // Feed into decoder
+      const size_t bytesProcessed = channel.decoder->inputProcess( uneatenStart, uneatenLength );
+
+      // Safe from parallel feed threads: each channel has its own slot
+      bytesDecoded_[static_cast<size_t>( &channel - channels_.data() )] += bytesProcessed;
+
+#ifdef E57_VERBOSE
+      std::cout << "  stream[" << channel.bytestreamNumber << "]: feeding decoder " << uneatenLength
+                << " bytes" << std::endl;
+
+      if ( uneatenLength == 0 )
+      {
+         channel.dump( 8 );
+      }
+
+      std::cout << "  stream[" << channel.bytestreamNumber << "]: bytesProcessed=" << bytesProcessed
+                << std::endl;
+#endif
+
+      // Adjust counts of bytestream location
+      channel.currentBytestreamBufferIndex += bytesProcessed;
+   }
+
+   void CompressedVectorReaderImpl::feedChannelsParallel(
+      DataPacket *dpkt, std::vector<DecodeChannel *> &feedChannels )
+   {
+      // The channels share no mutable state: each decoder writes to its own
+      // SourceDestBuffer and only reads the (pinned) packet.  Partition the
+      // channels across the shared pool's workers; Executor::run() rethrows
+      // the first failure, if any.
+      const auto threadCount = static_cast<unsigned>(
+         std::min( static_cast<size_t>( decodeThreadCount_ ), feedChannels.size() ) );
+
+      Executor::run( threadCount, [&]( unsigned workerIndex ) {
+         for ( size_t i = workerIndex; i < feedChannels.size(); i += threadCount )
+         {
+            feedChannel( dpkt, *feedChannels[i] );
+         }
+      } );
+   }
+
    void CompressedVectorReaderImpl::feedPacketToDecoders( uint64_t currentPacketLogicalOffset )
    {
       // Get packet at currentPacketLogicalOffset into memory.
@@ -371,7 +560,12 @@ namespace e57
       bool anyChannelHasExhaustedPacket = false;
       uint64_t nextPacketLogicalOffset = UINT64_MAX;
 
-      // Feed bytestreams to channels with unblocked output that are reading from this packet
+      // Collect the channels with unblocked output that are reading from this packet (reused
+      // member vector, so this is allocation-free in steady state)
+      std::vector<DecodeChannel *> &channelsToFeed = channelsToFeed_;
+      channelsToFeed.clear();
+      channelsToFeed.reserve( channels_.size() );
+
       for ( DecodeChannel &channel : channels_ )
       {
          // Skip channels that have already read this packet.
@@ -380,59 +574,36 @@ namespace e57
             continue;
          }
 
-         // Get bytestream buffer for this channel from packet
-         unsigned int bsbLength = 0;
-         const char *bsbStart = dpkt->getBytestream( channel.bytestreamNumber, bsbLength );
-
-         // Double check we are not off end of buffer
-         if ( channel.currentBytestreamBufferIndex > bsbLength )
-         {
-            throw E57_EXCEPTION2(
-               ErrorInternal,
-               "currentBytestreamBufferIndex =" + toString( channel.currentBytestreamBufferIndex ) +
-                  " bsbLength=" + toString( bsbLength ) );
-         }
-
-         // Calc where we are in the buffer
-         const char *uneatenStart = &bsbStart[channel.currentBytestreamBufferIndex];
-         const size_t uneatenLength = bsbLength - channel.currentBytestreamBufferIndex;
-
-         if ( &uneatenStart[uneatenLength] > &bsbStart[bsbLength] )
-         {
-            throw E57_EXCEPTION2( ErrorInternal, "uneatenLength=" + toString( uneatenLength ) +
-                                                    " bsbLength=" + toString( bsbLength ) );
-         }
-
-         // Feed into decoder
-         const size_t bytesProcessed = channel.decoder->inputProcess( uneatenStart, uneatenLength );
-
-#ifdef E57_VERBOSE
-         std::cout << "  stream[" << channel.bytestreamNumber << "]: feeding decoder "
-                   << uneatenLength << " bytes" << std::endl;
+         channelsToFeed.push_back( &channel );
+      }
 
-         if ( uneatenLength == 0 )
+      // Feed bytestreams to the hungry channels, in parallel if requested
+      if ( decodeThreadCount_ > 1 && channelsToFeed.size() > 1 )
+      {
+         feedChannelsParallel( dpkt, channelsToFeed );
+      }
+      else
+      {
+         for ( DecodeChannel *channel : channelsToFeed )
          {
-            channel.dump( 8 );
+            feedChannel( dpkt, *channel );
          }
+      }
 
-         std::cout << "  stream[" << channel.bytestreamNumber
-                   << "]: bytesProcessed=" << bytesProcessed << std::endl;
-#endif
-
-         // Adjust counts of bytestream location
-         channel.currentBytestreamBufferIndex += bytesProcessed;
-
-         // Check if this channel has exhausted its bytestream buffer in this
-         // packet
-         if ( channel.isInputBlocked() )
+      // Check if any channel has exhausted its bytestream buffer in this packet
+      for ( DecodeChannel *channel : channelsToFeed )
+      {
+         if ( channel->isInputBlocked() )
          {
 #ifdef E57_VERBOSE
-            std::cout << "  stream[" << channel.bytestreamNumber
+            std::cout << "  stream[" << channel->bytestreamNumber
                       << "] has exhausted its input in current packet" << std::endl;
 #endif
             anyChannelHasExhaustedPacket = true;
-            nextPacketLogicalOffset =
-               currentPacketLogicalOffset + dpkt->header.packetLogicalLengthMinus1 + 1;
+            // Ask the cache for the on-disk length: for a zstd-compressed packet the cached
+            // header holds the decompressed length, which is not how far to step in the file.
+            nextPacketLogicalOffset = currentPacketLogicalOffset +
+                                      cache_->packetLengthOnDisk( currentPacketLogicalOffset );
          }
       }
 
@@ -516,38 +687,367 @@ namespace e57
       // hit end of binary section.
       while ( nextPacketLogicalOffset < sectionEndLogicalOffset_ )
       {
-         char *anyPacket = nullptr;
+         // Scope the lock: packetLengthOnDisk() below re-locks the cache.
+         {
+            char *anyPacket = nullptr;
 
-         std::unique_ptr<PacketLock> packetLock =
-            cache_->lock( nextPacketLogicalOffset, anyPacket );
+            std::unique_ptr<PacketLock> packetLock =
+               cache_->lock( nextPacketLogicalOffset, anyPacket );
 
-         // Guess it's a data packet, if not continue to next packet
-         auto dpkt = reinterpret_cast<const DataPacket *>( anyPacket );
+            // Guess it's a data packet, if not continue to next packet
+            auto dpkt = reinterpret_cast<const DataPacket *>( anyPacket );
 
-         if ( dpkt->header.packetType == DATA_PACKET )
-         {
+            if ( dpkt->header.packetType == DATA_PACKET )
+            {
 #ifdef E57_VERBOSE
-            std::cout << "  Found next data packet at nextPacketLogicalOffset="
-                      << nextPacketLogicalOffset << std::endl;
+               std::cout << "  Found next data packet at nextPacketLogicalOffset="
+                         << nextPacketLogicalOffset << std::endl;
 #endif
-            return nextPacketLogicalOffset;
+               return nextPacketLogicalOffset;
+            }
          }
 
-         // All packets have length in same place, so can use the field to skip to
-         // next packet.
-         nextPacketLogicalOffset += dpkt->header.packetLogicalLengthMinus1 + 1;
+         // Skip to the next packet using the on-disk length tracked by the cache (the length
+         // field of a cached zstd packet is the decompressed length, so don't use that).
+         nextPacketLogicalOffset += cache_->packetLengthOnDisk( nextPacketLogicalOffset );
       }
 
       // Ran off end of section, so return failure code.
       return UINT64_MAX;
    }
 
-   void CompressedVectorReaderImpl::seek( uint64_t /*recordNumber*/ )
+   void CompressedVectorReaderImpl::discardRecords( const uint64_t recordCount )
+   {
+      if ( recordCount == 0 )
+      {
+         return;
+      }
+
+      // Arm every channel, then run the normal feed loop: while a skip is pending the
+      // channel stays hungry, and once it completes the channel reports itself
+      // output-blocked, so it is neither fed further nor advanced past the bytes the
+      // next read() needs.
+      for ( auto &channel : channels_ )
+      {
+         channel.decoder->skipRecords( recordCount );
+      }
+
+      while ( true )
+      {
+         const uint64_t earliestPacketLogicalOffset = earliestPacketNeededForInput();
+
+         if ( earliestPacketLogicalOffset == UINT64_MAX )
+         {
+            break;
+         }
+
+         feedPacketToDecoders( earliestPacketLogicalOffset );
+      }
+
+      for ( auto &channel : channels_ )
+      {
+         channel.decoder->skipDisarm();
+      }
+
+      recordCount_ += recordCount;
+   }
+
+   void CompressedVectorReaderImpl::seek( uint64_t recordNumber )
    {
       checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+      checkReaderOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      if ( recordNumber > maxRecordCount_ )
+      {
+         throw E57_EXCEPTION2( ErrorBadAPIArgument,
+                               "recordNumber=" + toString( recordNumber ) +
+                                  " childCount=" + toString( maxRecordCount_ ) );
+      }
+
+      if ( recordNumber == recordCount_ )
+      {
+         return;
+      }
+
+      // The record-to-packet table drives the landing below.  It stays empty when a
+      // requested field is variable length (string), since record boundaries can then
+      // only be found by decoding from the front.
+      if ( chunkIndex().empty() )
+      {
+         if ( maxRecordCount_ == 0 )
+         {
+            recordCount_ = recordNumber; // can only be 0 here
+
+            return;
+         }
+
+         throw E57_EXCEPTION2( ErrorNotImplemented,
+                               "seek requires fixed-width fields, recordNumber=" +
+                                  toString( recordNumber ) );
+      }
+
+      // Land each fixed-width channel on the packet holding the first bit of record
+      // recordNumber, reset its decoder there, and arm a bit-granular skip for the
+      // bits between the packet's stream start and that record.  The channels land on
+      // different packets in general, because their streams fill packets at different
+      // rates; the feed loop below is the same one read() uses and handles that.
+      uint64_t earliestLanding = UINT64_MAX;
+
+      for ( size_t i = 0; i < channels_.size(); ++i )
+      {
+         DecodeChannel &channel = channels_[i];
+         unsigned bits = 0;
+
+         channel.decoder->bitsPerRecord( bits ); // fixed width, or the index were empty
+
+         // Constant streams consume no input; they are parked after this loop
+         if ( bits == 0 )
+         {
+            continue;
+         }
+
+         const uint64_t targetBit = recordNumber * bits;
+
+         // Binary search for the first chunk whose stream range contains targetBit
+         size_t lo = 0;
+         size_t hi = chunkIndex_.size();
+
+         while ( lo < hi )
+         {
+            const size_t mid = ( lo + hi ) / 2;
+
+            if ( chunkChannelBits_[mid][i] > targetBit )
+            {
+               hi = mid;
+            }
+            else
+            {
+               lo = mid + 1;
+            }
+         }
+
+         if ( lo == chunkIndex_.size() )
+         {
+            // Past the channel's last bit; only reachable for recordNumber ==
+            // childCount, which the API allows (the next read() returns 0)
+            channel.decoder->seekToRecord( recordNumber, 0 );
+            channel.currentBytestreamBufferIndex = 0;
+            channel.currentBytestreamBufferLength = 0;
+            channel.inputFinished = true;
+
+            continue;
+         }
+
+         const uint64_t bitsBefore = ( lo == 0 ) ? 0 : chunkChannelBits_[lo - 1][i];
+         const uint64_t landingOffset = chunkIndex_[lo].packetLogicalOffset;
+
+         channel.decoder->seekToRecord( recordNumber, targetBit - bitsBefore );
+
+         channel.currentPacketLogicalOffset = landingOffset;
+         channel.currentBytestreamBufferIndex = 0;
+         channel.inputFinished = false;
+
+         {
+            char *anyPacket = nullptr;
+            std::unique_ptr<PacketLock> packetLock = cache_->lock( landingOffset, anyPacket );
+
+            auto dpkt = reinterpret_cast<DataPacket *>( anyPacket );
+
+            channel.currentBytestreamBufferLength =
+               dpkt->getBytestreamBufferLength( channel.bytestreamNumber );
+         }
+
+         earliestLanding = std::min( earliestLanding, landingOffset );
+      }
+
+      // Park the constant channels at the earliest landing so the feed loop steps
+      // them forward just as if a sequential read had reached this area
+      for ( auto &channel : channels_ )
+      {
+         unsigned bits = 0;
+
+         channel.decoder->bitsPerRecord( bits );
+
+         if ( bits != 0 )
+         {
+            continue;
+         }
+
+         channel.decoder->seekToRecord( recordNumber, 0 );
+
+         if ( earliestLanding != UINT64_MAX )
+         {
+            channel.currentPacketLogicalOffset = earliestLanding;
+            channel.currentBytestreamBufferIndex = 0;
+            channel.currentBytestreamBufferLength = 0;
+            channel.inputFinished = false;
+         }
+      }
+
+      // Consume the armed drops, exactly as in discardRecords(): a channel stays
+      // hungry while its drop is pending and reports itself output-blocked once in
+      // place, so it is neither fed further nor advanced past the bytes the next
+      // read() needs
+      while ( true )
+      {
+         const uint64_t earliestPacketLogicalOffset = earliestPacketNeededForInput();
+
+         if ( earliestPacketLogicalOffset == UINT64_MAX )
+         {
+            break;
+         }
+
+         feedPacketToDecoders( earliestPacketLogicalOffset );
+      }
+
+      for ( auto &channel : channels_ )
+      {
+         channel.decoder->skipDisarm();
+      }
+
+      recordCount_ = recordNumber;
+   }
+
+   const std::vector<CompressedVectorReaderImpl::ChunkIndexEntry> &CompressedVectorReaderImpl::
+      chunkIndex()
+   {
+      if ( !chunkIndexBuilt_ )
+      {
+         buildChunkIndex();
+         chunkIndexBuilt_ = true;
+      }
 
-      // !!! implement
-      throw E57_EXCEPTION1( ErrorNotImplemented );
+      return ( chunkIndex_ );
+   }
+
+   void CompressedVectorReaderImpl::buildChunkIndex()
+   {
+      // Per-channel fixed record widths.  A variable-width field (string) defeats the
+      // header arithmetic below, so the index stays empty and callers fall back to
+      // sequential reading.
+      std::vector<unsigned> recordBits( channels_.size(), 0 );
+
+      for ( size_t i = 0; i < channels_.size(); ++i )
+      {
+         if ( !channels_[i].decoder->bitsPerRecord( recordBits[i] ) )
+         {
+            return;
+         }
+      }
+
+      ImageFileImplSharedPtr imf( cVector_->destImageFile_ );
+
+      // First four bytes common to every packet type
+      struct PacketPrefix
+      {
+         uint8_t packetType = 0;
+         uint8_t packetFlags = 0;
+         uint16_t packetLogicalLengthMinus1 = 0;
+      };
+
+      std::vector<uint64_t> cumulativeBits( channels_.size(), 0 );
+      std::vector<uint16_t> streamLengths;
+
+      uint64_t offset = dataStartLogicalOffset_;
+
+      while ( offset < sectionEndLogicalOffset_ )
+      {
+         PacketPrefix prefix;
+
+         imf->file_->readAt( reinterpret_cast<char *>( &prefix ), sizeof( prefix ), offset );
+
+         const unsigned packetLength = prefix.packetLogicalLengthMinus1 + 1;
+
+         if ( packetLength > DATA_PACKET_MAX )
+         {
+            throw E57_EXCEPTION2( ErrorBadCVPacket, "packetLength=" + toString( packetLength ) );
+         }
+
+         switch ( prefix.packetType )
+         {
+            case DATA_PACKET:
+            {
+               // Header-only reads: the bytestream count and the per-stream byte
+               // counts sit right after the packet header, so the packet's payload
+               // never has to be fetched or verified
+               uint16_t bytestreamCount = 0;
+
+               imf->file_->readAt( reinterpret_cast<char *>( &bytestreamCount ),
+                                   sizeof( bytestreamCount ), offset + 4 );
+
+               if ( sizeof( DataPacketHeader ) + 2 * bytestreamCount > packetLength )
+               {
+                  throw E57_EXCEPTION2( ErrorBadCVPacket,
+                                        "bytestreamCount=" + toString( bytestreamCount ) +
+                                           " packetLength=" + toString( packetLength ) );
+               }
+
+               streamLengths.resize( bytestreamCount );
+               imf->file_->readAt( reinterpret_cast<char *>( streamLengths.data() ),
+                                   2 * bytestreamCount, offset + sizeof( DataPacketHeader ) );
+
+               uint64_t records = maxRecordCount_;
+
+               for ( size_t i = 0; i < channels_.size(); ++i )
+               {
+                  if ( channels_[i].bytestreamNumber >= bytestreamCount )
+                  {
+                     throw E57_EXCEPTION2( ErrorBadCVPacket,
+                                           "bytestreamCount=" + toString( bytestreamCount ) );
+                  }
+
+                  cumulativeBits[i] += 8ULL * streamLengths[channels_[i].bytestreamNumber];
+
+                  // Constant streams consume no input, so they never constrain
+                  if ( recordBits[i] > 0 )
+                  {
+                     records = std::min( records, cumulativeBits[i] / recordBits[i] );
+                  }
+               }
+
+               chunkIndex_.push_back( { offset, records } );
+               chunkChannelBits_.push_back( cumulativeBits );
+               break;
+            }
+
+            case ZSTD_PACKET:
+            {
+               // Stream byte counts sit inside the compressed image, so this one
+               // packet has to go through the cache (which decompresses it)
+               char *anyPacket = nullptr;
+               std::unique_ptr<PacketLock> packetLock = cache_->lock( offset, anyPacket );
+
+               auto dpkt = reinterpret_cast<DataPacket *>( anyPacket );
+
+               uint64_t records = maxRecordCount_;
+
+               for ( size_t i = 0; i < channels_.size(); ++i )
+               {
+                  cumulativeBits[i] +=
+                     8ULL * dpkt->getBytestreamBufferLength( channels_[i].bytestreamNumber );
+
+                  if ( recordBits[i] > 0 )
+                  {
+                     records = std::min( records, cumulativeBits[i] / recordBits[i] );
+                  }
+               }
+
+               chunkIndex_.push_back( { offset, records } );
+               chunkChannelBits_.push_back( cumulativeBits );
+               break;
+            }
+
+            case INDEX_PACKET:
+            case EMPTY_PACKET:
+               break;
+
+            default:
+               throw E57_EXCEPTION2( ErrorBadCVPacket,
+                                     "packetType=" + toString( prefix.packetType ) );
+         }
+
+         offset += packetLength;
+      }
    }
 
    bool CompressedVectorReaderImpl::isOpen() const
@@ -577,6 +1077,15 @@ namespace e57
          return;
       }
 
+      // Roll this reader's counters up into the file so Reader::GetStats() can still
+      // report them after the reader is gone.
+      imf->accumulateReadStats( cache_->cacheHits(), cache_->cacheMisses(),
+                                cache_->sharedCacheHits(), bytesDecoded_ );
+
+      // This session's buffers go away with it
+      imf->packetCacheMem_.subtract( accountedCacheBytes_ );
+      imf->decodeBufferMem_.subtract( accountedDecodeBytes_ );
+
       // Destroy decoders
       channels_.clear();
 
@@ -42,7 +42,35 @@ namespace e57
 
       unsigned read();
       unsigned read( std::vector<SourceDestBuffer> &dbufs );
+      void setDecodeThreadCount( unsigned threadCount );
+      void setStatisticsEnabled( bool enabled );
+      std::vector<FieldStatistics> statistics() const;
       void seek( uint64_t recordNumber );
+
+      /// One entry per data packet in the section, in file order (see chunkIndex())
+      struct ChunkIndexEntry
+      {
+         uint64_t packetLogicalOffset = 0;
+
+         /// Whole records every requested channel has fully consumed once all packets
+         /// up to and including this one have been fed to its decoder
+         uint64_t recordsCompleted = 0;
+      };
+
+      /// Record-to-packet table for sections without usable index packets, built by a
+      /// one-time header-only scan of the section on first use.  Stays empty when a
+      /// requested field has no fixed record width (strings), since record boundaries
+      /// can then only be found by decoding.
+      const std::vector<ChunkIndexEntry> &chunkIndex();
+
+      /// Pass over the next recordCount records without converting them, at the cost
+      /// of bit-position arithmetic in the decoders instead of a full decode into
+      /// throwaway buffers (see Decoder::skipRecords()); the building block for
+      /// landing mid-chunk in seek() and for skipping culled batches in
+      /// ReaderImpl::ReadData3DPredicated().  Requires every requested field to have
+      /// a fixed record width (throws ErrorInternal when one is a string).
+      void discardRecords( uint64_t recordCount );
+
       bool isOpen() const;
       std::shared_ptr<CompressedVectorNodeImpl> compressedVectorNode() const;
       void close();
@@ -59,8 +87,16 @@ namespace e57
       void setBuffers( std::vector<SourceDestBuffer> &dbufs ); //???needed?
       uint64_t earliestPacketNeededForInput() const;
 
+      void buildChunkIndex();
+
+      /// Folds the records a read() call just delivered into statistics_ while the
+      /// destination buffers are still cache-hot (see setStatisticsEnabled())
+      void accumulateStatistics( unsigned recordCount );
+
       DataPacket *dataPacket( uint64_t inLogicalOffset ) const;
       void feedPacketToDecoders( uint64_t currentPacketLogicalOffset );
+      void feedChannel( DataPacket *dpkt, DecodeChannel &channel );
+      void feedChannelsParallel( DataPacket *dpkt, std::vector<DecodeChannel *> &feedChannels );
       uint64_t findNextDataPacket( uint64_t nextPacketLogicalOffset );
 
       //??? no default ctor, copy, assignment?
@@ -72,8 +108,47 @@ namespace e57
       std::vector<DecodeChannel> channels_;
       PacketReadCache *cache_;
 
-      uint64_t recordCount_; /// number of records written so far
+      /// Raw pointers to the impls of dbufs_ (which keeps them alive), cached so the
+      /// per-call read paths can check buffer identity and rewind without shared_ptr
+      /// reference count traffic
+      std::vector<SourceDestBufferImpl *> boundBufferImpls_;
+
+      /// Scratch vector reused across packets so the steady-state read loop doesn't
+      /// allocate (see feedPacketToDecoders())
+      std::vector<DecodeChannel *> channelsToFeed_;
+
+      /// Bytes fed to each channel's decoder, indexed like dbufs_; rolled up into the
+      /// ImageFileImpl when the reader closes (see Reader::GetStats())
+      std::vector<uint64_t> bytesDecoded_;
+
+      uint64_t recordCount_; /// number of records decoded so far
       uint64_t maxRecordCount_;
       uint64_t sectionEndLogicalOffset_;
+
+      /// Offset of the section's first data packet, kept for the chunk index scan
+      uint64_t dataStartLogicalOffset_ = 0;
+
+      /// Lazily built record-to-packet table (see chunkIndex())
+      std::vector<ChunkIndexEntry> chunkIndex_;
+      bool chunkIndexBuilt_ = false;
+
+      /// Cumulative bits each channel's bytestream has supplied through the end of
+      /// each chunk, indexed [chunk][channel] like chunkIndex_; built during the same
+      /// scan and used by seek() to binary search each channel's landing packet.
+      /// Costs 8 bytes per channel per data packet in the section.
+      std::vector<std::vector<uint64_t>> chunkChannelBits_;
+
+      /// Number of threads used to decode channels of a packet (1 = serial decode)
+      unsigned decodeThreadCount_ = 1;
+
+      /// Per-field min/max/count, indexed like dbufs_; only maintained when enabled
+      /// (see setStatisticsEnabled())
+      std::vector<FieldStatistics> statistics_;
+      bool statisticsEnabled_ = false;
+
+      /// Bytes this session added to the file's memory accounting at open, released
+      /// at close (see ImageFile::memoryUsage())
+      uint64_t accountedCacheBytes_ = 0;
+      uint64_t accountedDecodeBytes_ = 0;
    };
 }
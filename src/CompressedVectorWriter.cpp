@@ -253,6 +253,200 @@ void CompressedVectorWriter::write( std::vector<SourceDestBuffer> &sbufs, const
    impl_->write( sbufs, recordCount );
 }
 
+/*!
+@brief Start a write on a background thread, so encoding overlaps the caller's production.
+
+@param [in] recordCount Number of records to write from the previously designated SourceDestBuffers.
+
+@details
+Behaves like write(unsigned) but returns immediately with a std::future that completes when the
+records have been encoded and flushed (exceptions thrown by the write are rethrown from
+future::get()).
+
+The intended use is double buffering (ping-pong): fill one set of SourceDestBuffers, start a
+writeAsync() from it, fill the other set while the library encodes and flushes, then get() the
+future and swap. A real-time producer then never stalls on the encode+CRC+I/O cost of a write as
+long as producing a buffer set takes at least as long as writing one.
+
+While the future is outstanding, the background thread owns this CompressedVectorWriter and its
+ImageFile: no other operation may be performed on either - including refilling the buffer set being
+written - until get()/wait() has returned.
+
+@pre The associated ImageFile must be open.
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@return A future that completes when the records are written.
+
+@see CompressedVectorWriter::write(unsigned), SourceDestBuffer
+*/
+std::future<void> CompressedVectorWriter::writeAsync( const size_t recordCount )
+{
+   auto impl = impl_;
+
+   return std::async( std::launch::async, [impl, recordCount]() { impl->write( recordCount ); } );
+}
+
+/*!
+@brief Start a write from the given buffers on a background thread.
+
+@param [in] sbufs Source buffers for the write; must stay alive and untouched until the returned
+future has been waited on.
+@param [in] recordCount Number of records to write.
+
+@details
+Behaves like write(std::vector<SourceDestBuffer>&,unsigned) but returns immediately with a
+std::future that completes when the records have been encoded and flushed. See writeAsync(unsigned)
+for the ping-pong double-buffering pattern and the single-owner requirement while the future is
+outstanding.
+
+@pre The associated ImageFile must be open.
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@return A future that completes when the records are written.
+
+@see CompressedVectorWriter::writeAsync(unsigned),
+CompressedVectorWriter::write(std::vector<SourceDestBuffer>&,unsigned), SourceDestBuffer
+*/
+std::future<void> CompressedVectorWriter::writeAsync( std::vector<SourceDestBuffer> &sbufs,
+                                                      const size_t recordCount )
+{
+   auto impl = impl_;
+   auto *buffers = &sbufs;
+
+   return std::async( std::launch::async,
+                      [impl, buffers, recordCount]() { impl->write( *buffers, recordCount ); } );
+}
+
+/*!
+@brief Set the number of threads used to encode bytestreams during write().
+
+@param [in] threadCount Number of encode threads to use. 1 (the default) encodes serially on the
+calling thread. 0 requests one thread per hardware core.
+
+@details
+Each field (bytestream) in the prototype is encoded independently from its own SourceDestBuffer, so
+when the prototype has more than one field the per-record encode work can be spread across threads.
+The threads join before each data packet is assembled, so the bytes written to the file are
+identical to a serial write, and all exceptions are rethrown on the calling thread.
+
+This is an opt-in setting because the benefit depends on the number of fields in the prototype and
+on the caller's threading environment.
+
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorWriter::write(unsigned)
+*/
+void CompressedVectorWriter::setEncodeThreadCount( unsigned threadCount )
+{
+   impl_->setEncodeThreadCount( threadCount );
+}
+
+/*!
+@brief Enable or disable pipelined (double-buffered) packet writing.
+
+@param [in] enabled true overlaps packet flushing with encoding; false (the default) writes each
+packet synchronously.
+
+@details
+When enabled, each finished data packet is handed to a background thread that checksums it and
+writes it to the file while the encoders fill the next packet. The packets, their offsets, and the
+bytes on disk are identical to a synchronous write; only the scheduling changes. The pipeline is
+drained before write() returns and before close(), and any error encountered by the background
+thread is rethrown on the calling thread at the next packet boundary.
+
+This helps most when both the encoders and the storage device are individually slower than the
+combined pipeline, e.g. writing large scans to spinning disks or network filesystems.
+
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorWriter::write(unsigned), CompressedVectorWriter::setEncodeThreadCount
+*/
+void CompressedVectorWriter::setPipelinedWrite( bool enabled )
+{
+   impl_->setPipelinedWrite( enabled );
+}
+
+/*!
+@brief Enable or disable the zstd packet extension for this writer.
+
+@param [in] enabled true compresses each finished data packet with zstd before it is written to
+the file; false (the default) writes standard E57 data packets.
+
+@details
+This is a vendor extension to the E57 format, available when the library was built with the
+E57_ZSTD CMake option. Each finished data packet that shrinks under zstd is written as an
+extension packet holding the compressed image of the original packet; packets that do not shrink
+are written unchanged. Readers built with E57_ZSTD decompress the packets transparently, so the
+decoded records are identical to an uncompressed write.
+
+The file advertises the extension in its XML section under the prefix "zstd" (see
+::ZSTD_PACKETS_URI). Readers without support — including other E57 implementations — reject the
+compressed packets with ::ErrorBadCVPacket rather than misreading them, so only enable this for
+files that stay within a libE57Format-based pipeline (e.g. archive storage) rather than for
+interchange.
+
+Bitpacked scan data often compresses substantially further under zstd, so at archive tier the
+saved physical I/O usually outweighs the extra (de)compression CPU.
+
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@throw ::ErrorNotImplemented The library was built without the E57_ZSTD option
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorWriter::setPipelinedWrite, ImageFile::extensionsAdd
+*/
+void CompressedVectorWriter::setZstdPackets( bool enabled )
+{
+   impl_->setZstdPackets( enabled );
+}
+
+/*!
+@brief Accumulate per-field minimum/maximum/count while writing.
+
+@param [in] enabled true starts accumulating on the next write(); false stops.
+
+@details
+When enabled, each write() folds the new records into a running minimum, maximum, and count per
+source field before they are encoded, while the source buffers are still cache-hot. This saves
+the separate pre-scan over the buffers that callers otherwise make to fill in header bounds - the
+accumulated ranges can be written into the scan's metadata after close().
+
+Statistics accumulate across write() calls; fetch them with statistics(). Accumulation is off by
+default because it adds a small amount of per-record work.
+
+@pre This CompressedVectorWriter must be open (i.e isOpen())
+
+@throw ::ErrorInternal All objects in undocumented state
+
+@see CompressedVectorWriter::statistics()
+*/
+void CompressedVectorWriter::setStatisticsEnabled( bool enabled )
+{
+   impl_->setStatisticsEnabled( enabled );
+}
+
+/*!
+@brief Get the per-field statistics accumulated so far.
+
+@details
+One entry per source SourceDestBuffer, in request order, identified by its path name. Entries for
+fields that have not accumulated any values (or string fields, which have no numeric range) keep
+their initial minimum/maximum.
+
+@return Returns the statistics accumulated since the writer was opened (empty unless
+setStatisticsEnabled() was called before writing).
+
+@see CompressedVectorWriter::setStatisticsEnabled()
+*/
+std::vector<FieldStatistics> CompressedVectorWriter::statistics() const
+{
+   return impl_->statistics();
+}
+
 /*!
 @brief End the write operation.
 
@@ -25,16 +25,25 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <numeric>
+#include <thread>
+
+#ifdef E57_ZSTD
+#include <zstd.h>
+#endif
 
 #include "CheckedFile.h"
 #include "CompressedVectorNodeImpl.h"
 #include "CompressedVectorWriterImpl.h"
+#include "Executor.h"
 #include "ImageFileImpl.h"
 #include "SectionHeaders.h"
 #include "SourceDestBufferImpl.h"
 #include "StringFunctions.h"
+#include "Trace.h"
 
 namespace e57
 {
@@ -123,6 +132,15 @@ namespace e57
       dataPacketsCount_ = 0;
       indexPacketsCount_ = 0;
 
+      // Account this session's encoder staging buffers while it is open (see
+      // ImageFile::memoryUsage())
+      for ( auto &bytestream : bytestreams_ )
+      {
+         accountedEncodeBytes_ += bytestream->stagingBytes();
+      }
+
+      imf->encodeBufferMem_.add( accountedEncodeBytes_ );
+
       // Just before return (and can't throw) increment writer count  ??? safer
       // way to assure don't miss close?
       imf->incrWriterCount();
@@ -148,6 +166,12 @@ namespace e57
       {
          //??? report?
       }
+
+      // Never leave a pipelined flush thread running (close() normally drains it)
+      if ( flushThread_.joinable() )
+      {
+         flushThread_.join();
+      }
    }
 
    void CompressedVectorWriterImpl::close()
@@ -172,6 +196,9 @@ namespace e57
       // try to close again.
       isOpen_ = false;
 
+      // This session's staging buffers go away with it
+      imf->encodeBufferMem_.subtract( accountedEncodeBytes_ );
+
       // If have any data, write packet
       // Write all remaining ioBuffers and internal encoder register cache into
       // file. Know we are done when totalOutputAvailable() returns 0 after a
@@ -183,7 +210,7 @@ namespace e57
          flush();
       }
 
-      // Write one index packet (required by standard).
+      // Write the index packets for the section (at least one is required by standard).
       packetWriteIndex();
 
       // Compute length of whole section we just wrote (from section start to
@@ -245,6 +272,28 @@ namespace e57
    {
       // don't checkImageFileOpen
 
+      // Fast path for the chunked-write pattern: the caller re-presents exactly the same
+      // buffers on every write() call (refilled in place between calls), so revalidating
+      // and re-binding them every time is redundant per-call work.
+      if ( !sbufs_.empty() && sbufs_.size() == sbufs.size() )
+      {
+         bool sameBuffers = true;
+
+         for ( size_t i = 0; i < sbufs.size(); ++i )
+         {
+            if ( sbufs[i].impl().get() != boundBufferImpls_[i] )
+            {
+               sameBuffers = false;
+               break;
+            }
+         }
+
+         if ( sameBuffers )
+         {
+            return;
+         }
+      }
+
       // If had previous sbufs_, check to see if new ones have changed in
       // incompatible way
       if ( !sbufs_.empty() )
@@ -272,6 +321,17 @@ namespace e57
       proto_->checkBuffers( sbufs, false );
 
       sbufs_ = sbufs;
+
+      // Cache the raw buffer pointers: the per-call paths (identity check above, rewind and
+      // capacity in write()) can then stay away from shared_ptr reference count traffic.
+      // The handles in sbufs_ keep the pointed-to objects alive.
+      boundBufferImpls_.clear();
+      boundBufferImpls_.reserve( sbufs_.size() );
+
+      for ( auto &sbuf : sbufs_ )
+      {
+         boundBufferImpls_.push_back( sbuf.impl().get() );
+      }
    }
 
    void CompressedVectorWriterImpl::write( std::vector<SourceDestBuffer> &sbufs,
@@ -299,19 +359,43 @@ namespace e57
       }
 
       // Check that requestedRecordCount is not larger than the sbufs
-      if ( requestedRecordCount > sbufs_.at( 0 ).impl()->capacity() )
+      if ( requestedRecordCount > boundBufferImpls_.at( 0 )->capacity() )
       {
          throw E57_EXCEPTION2( ErrorBadAPIArgument,
                                "requested=" + toString( requestedRecordCount ) +
-                                  " capacity=" + toString( sbufs_.at( 0 ).impl()->capacity() ) +
+                                  " capacity=" + toString( boundBufferImpls_.at( 0 )->capacity() ) +
                                   " imageFileName=" + cVector_->imageFileName() +
                                   " cvPathName=" + cVector_->pathName() );
       }
 
       // Rewind all sbufs so start reading from beginning
-      for ( auto &sbuf : sbufs_ )
+      for ( auto *sbuf : boundBufferImpls_ )
       {
-         sbuf.impl()->rewind();
+         sbuf->rewind();
+      }
+
+      // Fold the new records into the running statistics before the encoders consume
+      // them, while the source buffers are still cache-hot
+      if ( statisticsEnabled_ )
+      {
+         if ( statistics_.size() != sbufs_.size() )
+         {
+            statistics_.assign( sbufs_.size(), FieldStatistics() );
+
+            for ( size_t i = 0; i < sbufs_.size(); ++i )
+            {
+               statistics_[i].pathName = sbufs_[i].pathName();
+            }
+         }
+
+         for ( size_t i = 0; i < boundBufferImpls_.size(); ++i )
+         {
+            FieldStatistics &fieldStats = statistics_[i];
+
+            boundBufferImpls_[i]->accumulateMinMax( requestedRecordCount, fieldStats.minimum,
+                                                    fieldStats.maximum );
+            fieldStats.count += requestedRecordCount;
+         }
       }
 
       // Loop until all channels have completed requestedRecordCount transfers
@@ -380,27 +464,149 @@ namespace e57
          // Don't allow a single channel to get too far ahead ???
          // Process channels that are furthest behind first. ???
 
-         // !!!! For now just process one record per loop until packet is full
-         // enough, or completed request
-         for ( auto &bytestream : bytestreams_ )
-         {
-            if ( bytestream->currentRecordIndex() < endRecordIndex )
-            {
-               // !!! For now, process up to 50 records at a time
-               uint64_t recordCount = endRecordIndex - bytestream->currentRecordIndex();
-               recordCount =
-                  ( recordCount < 50ULL ) ? recordCount : 50ULL; // min(recordCount, 50ULL);
-               bytestream->processRecords( static_cast<unsigned>( recordCount ) );
-            }
-         }
+         processChannels( endRecordIndex );
       }
 
+      // Drain the write pipeline before returning: other objects (blob writes, other
+      // writers) are free to use the file between calls to write().
+      waitForPendingFlush();
+
       recordCount_ += requestedRecordCount;
 
       // When we leave this function, will likely still have data in channel
       // ioBuffers as well as partial words in Encoder registers.
    }
 
+   void CompressedVectorWriterImpl::setEncodeThreadCount( unsigned threadCount )
+   {
+      // don't checkImageFileOpen
+      // don't checkWriterOpen
+
+      // Zero means "choose for me": use what the hardware reports.
+      if ( threadCount == 0 )
+      {
+         threadCount = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      encodeThreadCount_ = threadCount;
+   }
+
+   void CompressedVectorWriterImpl::setPipelinedWrite( bool enabled )
+   {
+      // don't checkImageFileOpen
+      // don't checkWriterOpen
+
+      // Turning the pipeline off must not lose a packet that is still in flight
+      if ( !enabled )
+      {
+         waitForPendingFlush();
+      }
+
+      pipelinedWrite_ = enabled;
+   }
+
+   void CompressedVectorWriterImpl::setZstdPackets( bool enabled )
+   {
+      // don't checkImageFileOpen
+      // don't checkWriterOpen
+
+#ifdef E57_ZSTD
+      if ( enabled )
+      {
+         // Readers without zstd support reject these packets, so the file must advertise
+         // the extension in its XML section.
+         ImageFileImplSharedPtr imf( cVector_->destImageFile_ );
+         ustring uri;
+
+         if ( !imf->extensionsLookupPrefix( "zstd", uri ) )
+         {
+            imf->extensionsAdd( "zstd", ZSTD_PACKETS_URI );
+         }
+      }
+
+      zstdPackets_ = enabled;
+#else
+      if ( enabled )
+      {
+         throw E57_EXCEPTION2( ErrorNotImplemented, "library was built without E57_ZSTD" );
+      }
+
+      zstdPackets_ = false;
+#endif
+   }
+
+   void CompressedVectorWriterImpl::setStatisticsEnabled( bool enabled )
+   {
+      // don't checkImageFileOpen
+      // don't checkWriterOpen
+
+      statisticsEnabled_ = enabled;
+   }
+
+   std::vector<FieldStatistics> CompressedVectorWriterImpl::statistics() const
+   {
+      return statistics_;
+   }
+
+   void CompressedVectorWriterImpl::processChannels( uint64_t endRecordIndex )
+   {
+      // !!!! For now just process one record per loop until packet is full
+      // enough, or completed request
+
+      // Collect the encoders that still have records to process (reused member vector, so
+      // this is allocation-free in steady state)
+      std::vector<Encoder *> &encodersToProcess = encodersToProcess_;
+      encodersToProcess.clear();
+      encodersToProcess.reserve( bytestreams_.size() );
+
+      for ( auto &bytestream : bytestreams_ )
+      {
+         if ( bytestream->currentRecordIndex() < endRecordIndex )
+         {
+            encodersToProcess.push_back( bytestream.get() );
+         }
+      }
+
+      // Run the encoders, in parallel if requested
+      if ( encodeThreadCount_ > 1 && encodersToProcess.size() > 1 )
+      {
+         processChannelsParallel( encodersToProcess, endRecordIndex );
+      }
+      else
+      {
+         for ( Encoder *encoder : encodersToProcess )
+         {
+            // !!! For now, process up to 50 records at a time
+            uint64_t recordCount = endRecordIndex - encoder->currentRecordIndex();
+            recordCount = ( recordCount < 50ULL ) ? recordCount : 50ULL; // min(recordCount, 50ULL);
+            encoder->processRecords( static_cast<unsigned>( recordCount ) );
+         }
+      }
+   }
+
+   void CompressedVectorWriterImpl::processChannelsParallel( std::vector<Encoder *> &encoders,
+                                                             uint64_t endRecordIndex )
+   {
+      // The encoders share no mutable state until packet assembly: each reads
+      // its own SourceDestBuffer and fills its own output buffer.  Partition
+      // them across the shared pool's workers; Executor::run() rethrows the
+      // first failure, if any.
+      const auto threadCount = static_cast<unsigned>(
+         std::min( static_cast<size_t>( encodeThreadCount_ ), encoders.size() ) );
+
+      Executor::run( threadCount, [&]( unsigned workerIndex ) {
+         for ( size_t i = workerIndex; i < encoders.size(); i += threadCount )
+         {
+            Encoder *encoder = encoders[i];
+
+            // !!! For now, process up to 50 records at a time
+            uint64_t recordCount = endRecordIndex - encoder->currentRecordIndex();
+            recordCount = ( recordCount < 50ULL ) ? recordCount : 50ULL;
+            encoder->processRecords( static_cast<unsigned>( recordCount ) );
+         }
+      } );
+   }
+
    size_t CompressedVectorWriterImpl::totalOutputAvailable() const
    {
       size_t total = 0;
@@ -447,8 +653,10 @@ namespace e57
       std::cout << "  packetMaxPayloadBytes=" << cPacketMaxPayloadBytes << std::endl;
 #endif
 
-      // Allocate vector for number of bytes that each bytestream will write to file.
-      std::vector<size_t> count( cNumByteStreams );
+      // Number of bytes that each bytestream will write to file.  Reuses a member vector so
+      // the steady-state write loop doesn't allocate once it has reached its high-water mark.
+      std::vector<size_t> &count = streamWriteCounts_;
+      count.assign( cNumByteStreams, 0 );
 
       // See if we can fit into a single data packet
       if ( cTotalOutput < cPacketMaxPayloadBytes )
@@ -588,12 +796,59 @@ namespace e57
       // Double check that data packet is well formed
       dataPacket_.verify( packetLength );
 
+      // The finished packet as it will appear on disk
+      const char *writePacket = packet;
+      unsigned writeLength = packetLength;
+
+#ifdef E57_ZSTD
+      if ( zstdPackets_ )
+      {
+         const unsigned compressedPacketLength = zstdPacketCompress( packet, packetLength );
+
+         // Zero means the packet didn't shrink, so it is written uncompressed
+         if ( compressedPacketLength > 0 )
+         {
+            writePacket = reinterpret_cast<const char *>( &zstdPacket_ );
+            writeLength = compressedPacketLength;
+         }
+      }
+#endif
+
       // Write whole data packet at beginning of free space in file
-      uint64_t packetLogicalOffset = imf->allocateSpace( packetLength, false );
+      uint64_t packetLogicalOffset = imf->allocateSpace( writeLength, false );
       uint64_t packetPhysicalOffset = imf->file_->logicalToPhysical( packetLogicalOffset );
-      imf->file_->seek( packetLogicalOffset ); //??? have seekLogical and seekPhysical instead?
-                                               // more explicit
-      imf->file_->write( packet, packetLength );
+
+      // Wait until the file is ours again (no-op unless a pipelined flush is in flight)
+      waitForPendingFlush();
+
+      if ( pipelinedWrite_ )
+      {
+         // Hand the finished packet to the flush thread, so checksumming and the write
+         // syscall overlap encoding of the next packet into dataPacket_.
+         memcpy( reinterpret_cast<char *>( &inFlightPacket_ ), writePacket, writeLength );
+
+         flushThread_ = std::thread( [this, imf, packetLogicalOffset, writeLength]() {
+            try
+            {
+               imf->file_->seek( packetLogicalOffset );
+               imf->file_->write( reinterpret_cast<char *>( &inFlightPacket_ ), writeLength );
+
+               trace::emit( TraceEvent::PacketWrite, packetLogicalOffset, writeLength );
+            }
+            catch ( ... )
+            {
+               flushError_ = std::current_exception();
+            }
+         } );
+      }
+      else
+      {
+         imf->file_->seek( packetLogicalOffset ); //??? have seekLogical and seekPhysical instead?
+                                                  // more explicit
+         imf->file_->write( writePacket, writeLength );
+
+         trace::emit( TraceEvent::PacketWrite, packetLogicalOffset, writeLength );
+      }
 
 #ifdef E57_VERBOSE
 //  std::cout << "data packet:" << std::endl;
@@ -612,12 +867,63 @@ namespace e57
       }
       dataPacketsCount_++;
 
-      // !!! update seekIndex here? if started new chunk?
+      // Remember where this chunk starts for the index packets written at close
+      recordChunkEntry( packetPhysicalOffset, count );
 
       // Return physical offset of data packet for potential use in seekIndex
       return ( packetPhysicalOffset ); //??? needed
    }
 
+#ifdef E57_ZSTD
+   /// Compress a finished data packet image into zstdPacket_ as a ZSTD_PACKET.
+   /// Returns the on-disk length of the compressed packet, or 0 when compression would not
+   /// shrink the packet (incompressible data, or the compressed form didn't fit).
+   unsigned CompressedVectorWriterImpl::zstdPacketCompress( const char *packet,
+                                                            unsigned packetLength )
+   {
+      auto *out = reinterpret_cast<char *>( &zstdPacket_ );
+
+      // Leave room for the header and up to 3 bytes of zero padding
+      constexpr size_t cMaxCompressed = DATA_PACKET_MAX - sizeof( ZstdPacketHeader ) - 3;
+
+      const size_t compressedLength =
+         ZSTD_compress( &out[sizeof( ZstdPacketHeader )], cMaxCompressed, packet, packetLength,
+                        ZSTD_CLEVEL_DEFAULT );
+
+      // An error here just means the compressed form didn't fit in the buffer
+      if ( ZSTD_isError( compressedLength ) )
+      {
+         return ( 0 );
+      }
+
+      unsigned totalLength =
+         static_cast<unsigned>( sizeof( ZstdPacketHeader ) + compressedLength );
+
+      // On-disk packets must be a multiple of 4 logical bytes, pad with zeros (like
+      // packetWrite() does for an uncompressed packet)
+      while ( totalLength % 4 )
+      {
+         out[totalLength++] = 0;
+      }
+
+      // Only worth doing if the padded packet is actually smaller
+      if ( totalLength >= packetLength )
+      {
+         return ( 0 );
+      }
+
+      ZstdPacketHeader header;
+
+      header.packetLogicalLengthMinus1 = static_cast<uint16_t>( totalLength - 1 );
+      header.uncompressedLengthMinus1 = static_cast<uint16_t>( packetLength - 1 );
+      header.compressedLengthMinus1 = static_cast<uint16_t>( compressedLength - 1 );
+
+      memcpy( out, &header, sizeof( header ) );
+
+      return ( totalLength );
+   }
+#endif
+
    // If we don't have any records, write a packet which is only the header + zero padding.
    // Code is a simplified version of packetWrite().
    void CompressedVectorWriterImpl::packetWriteZeroRecords()
@@ -650,6 +956,8 @@ namespace e57
       uint64_t packetLogicalOffset = imf->allocateSpace( packetLength, false );
       uint64_t packetPhysicalOffset = imf->file_->logicalToPhysical( packetLogicalOffset );
 
+      waitForPendingFlush();
+
       imf->file_->seek( packetLogicalOffset );
       imf->file_->write( packet, packetLength );
 
@@ -661,31 +969,163 @@ namespace e57
       }
 
       dataPacketsCount_++;
+
+      recordChunkEntry( packetPhysicalOffset, {} );
+   }
+
+   // Remember an index entry for a data packet just written at packetPhysicalOffset.
+   // The entry's chunkRecordNumber is the first record not fully encoded before the
+   // packet, computed from cumulative per-stream byte counts and the streams' fixed
+   // record widths (the same arithmetic a reader can do from the packet headers).
+   // byteCounts holds the bytes each bytestream contributed to the packet.
+   void CompressedVectorWriterImpl::recordChunkEntry( uint64_t packetPhysicalOffset,
+                                                      const std::vector<size_t> &byteCounts )
+   {
+      if ( !chunkEntriesValid_ )
+      {
+         return;
+      }
+
+      // First packet: cache the per-stream record widths.  A variable length stream
+      // (strings) defeats the byte-count arithmetic, so entry tracking is turned off
+      // and close() falls back to a minimal one-entry index.
+      if ( streamRecordBits_.empty() )
+      {
+         streamRecordBits_.resize( bytestreams_.size(), 0 );
+         streamCumulativeBits_.resize( bytestreams_.size(), 0 );
+
+         for ( size_t i = 0; i < bytestreams_.size(); ++i )
+         {
+            if ( !bytestreams_.at( i )->fixedBitsPerRecord( streamRecordBits_[i] ) )
+            {
+               chunkEntriesValid_ = false;
+               chunkEntries_.clear();
+
+               return;
+            }
+         }
+      }
+
+      // Records every stream had fully encoded before this packet (constant streams
+      // produce no output, so they never constrain)
+      uint64_t recordsBefore = recordCount_;
+
+      for ( size_t i = 0; i < bytestreams_.size(); ++i )
+      {
+         if ( streamRecordBits_[i] > 0 )
+         {
+            recordsBefore =
+               std::min( recordsBefore, streamCumulativeBits_[i] / streamRecordBits_[i] );
+         }
+      }
+
+      for ( size_t i = 0; i < byteCounts.size(); ++i )
+      {
+         streamCumulativeBits_[i] += 8ULL * byteCounts[i];
+      }
+
+      // Entries must be strictly increasing in record number; a packet that starts no
+      // new record (e.g. a final flush of leftover bits) adds nothing to the index
+      if ( !chunkEntries_.empty() && recordsBefore <= chunkEntries_.back().chunkRecordNumber )
+      {
+         return;
+      }
+
+      chunkEntries_.push_back( { recordsBefore, packetPhysicalOffset } );
    }
 
-   // Write one index packet.
-   // We don't have an interface to work with index packets, but one is required by the standard, so
-   // write one index packet with one entry pointing to the first data packet.
-   void e57::CompressedVectorWriterImpl::packetWriteIndex()
+   // Write one index packet holding the given entries and return its physical offset.
+   uint64_t CompressedVectorWriterImpl::packetWriteIndexPacket( const IndexPacket::Entry *entries,
+                                                                unsigned entryCount,
+                                                                uint8_t indexLevel )
    {
       ImageFileImplSharedPtr imf( cVector_->destImageFile_ );
 
       IndexPacket indexPacket;
 
-      indexPacket.entries[0].chunkPhysicalOffset = dataPhysicalOffset_;
+      memcpy( indexPacket.entries, entries, entryCount * sizeof( IndexPacket::Entry ) );
 
-      const auto cPacketLength = sizeof( IndexPacketHeader ) + sizeof( IndexPacket::Entry );
+      const auto cPacketLength =
+         sizeof( IndexPacketHeader ) + entryCount * sizeof( IndexPacket::Entry );
 
-      indexPacket.header.packetLogicalLengthMinus1 = cPacketLength - 1;
-      indexPacket.header.entryCount = 1;
+      indexPacket.header.packetLogicalLengthMinus1 = static_cast<uint16_t>( cPacketLength - 1 );
+      indexPacket.header.entryCount = static_cast<uint16_t>( entryCount );
+      indexPacket.header.indexLevel = indexLevel;
+
+      // Double check that index packet is well formed
+      indexPacket.verify( static_cast<unsigned>( cPacketLength ) );
 
       uint64_t packetLogicalOffset = imf->allocateSpace( cPacketLength, false );
-      topIndexPhysicalOffset_ = imf->file_->logicalToPhysical( packetLogicalOffset );
+      const uint64_t packetPhysicalOffset = imf->file_->logicalToPhysical( packetLogicalOffset );
 
       imf->file_->seek( packetLogicalOffset );
       imf->file_->write( reinterpret_cast<const char *>( &indexPacket ), cPacketLength );
 
       indexPacketsCount_++;
+
+      return ( packetPhysicalOffset );
+   }
+
+   // Write the index packets for the section (at least one is required by the standard).
+   // The entries accumulated in chunkEntries_ are emitted as level 0 index packets of up
+   // to IndexPacket::MAX_ENTRIES entries each; when they don't fit in one packet, higher
+   // level packets are layered on top (each entry pointing to an index packet of the
+   // level below) until a single top level packet remains, whose physical offset goes in
+   // the section header.
+   void CompressedVectorWriterImpl::packetWriteIndex()
+   {
+      waitForPendingFlush();
+
+      std::vector<IndexPacket::Entry> levelEntries = std::move( chunkEntries_ );
+
+      // When entry tracking was off (a variable length field), fall back to the
+      // minimal index: one entry pointing to the first data packet
+      if ( levelEntries.empty() )
+      {
+         levelEntries.push_back( { 0, dataPhysicalOffset_ } );
+      }
+
+      uint8_t indexLevel = 0;
+
+      while ( true )
+      {
+         std::vector<IndexPacket::Entry> nextLevelEntries;
+
+         size_t first = 0;
+
+         while ( first < levelEntries.size() )
+         {
+            auto entryCount = static_cast<unsigned>( std::min(
+               levelEntries.size() - first, static_cast<size_t>( IndexPacket::MAX_ENTRIES ) ) );
+
+            // Packets above level 0 must hold at least two entries; when a full packet
+            // would strand a single entry, leave it one short so the last packet gets two
+            if ( indexLevel > 0 && ( levelEntries.size() - first ) - entryCount == 1 )
+            {
+               entryCount--;
+            }
+
+            const uint64_t packetPhysicalOffset =
+               packetWriteIndexPacket( &levelEntries[first], entryCount, indexLevel );
+
+            // The packet covers records from its first entry onward
+            nextLevelEntries.push_back(
+               { levelEntries[first].chunkRecordNumber, packetPhysicalOffset } );
+
+            topIndexPhysicalOffset_ = packetPhysicalOffset;
+
+            first += entryCount;
+         }
+
+         // A single packet at this level is the top of the index
+         if ( nextLevelEntries.size() == 1 )
+         {
+            break;
+         }
+
+         levelEntries.swap( nextLevelEntries );
+         indexLevel++;
+      }
    }
 
    void CompressedVectorWriterImpl::flush()
@@ -696,6 +1136,23 @@ namespace e57
       }
    }
 
+   /// Join the pipelined flush thread (if one is running) and rethrow any error it hit.
+   /// After this returns, the calling thread may safely access the file again.
+   void CompressedVectorWriterImpl::waitForPendingFlush()
+   {
+      if ( flushThread_.joinable() )
+      {
+         flushThread_.join();
+      }
+
+      if ( flushError_ )
+      {
+         std::exception_ptr error = flushError_;
+         flushError_ = nullptr;
+         std::rethrow_exception( error );
+      }
+   }
+
    void CompressedVectorWriterImpl::checkImageFileOpen( const char *srcFileName, int srcLineNumber,
                                                         const char *srcFunctionName ) const
    {
@@ -26,6 +26,8 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <thread>
+
 #include "Encoder.h"
 #include "Packet.h"
 
@@ -40,6 +42,11 @@ namespace e57
 
       void write( size_t requestedRecordCount );
       void write( std::vector<SourceDestBuffer> &sbufs, size_t requestedRecordCount );
+      void setEncodeThreadCount( unsigned threadCount );
+      void setPipelinedWrite( bool enabled );
+      void setZstdPackets( bool enabled );
+      void setStatisticsEnabled( bool enabled );
+      std::vector<FieldStatistics> statistics() const;
       bool isOpen() const;
       std::shared_ptr<CompressedVectorNodeImpl> compressedVectorNode() const;
       void close();
@@ -56,9 +63,19 @@ namespace e57
       void setBuffers( std::vector<SourceDestBuffer> &sbufs ); //???needed?
       size_t totalOutputAvailable() const;
       size_t currentPacketSize() const;
+      void processChannels( uint64_t endRecordIndex );
+      void processChannelsParallel( std::vector<Encoder *> &encoders, uint64_t endRecordIndex );
       uint64_t packetWrite();
+#ifdef E57_ZSTD
+      unsigned zstdPacketCompress( const char *packet, unsigned packetLength );
+#endif
       void packetWriteZeroRecords();
+      void recordChunkEntry( uint64_t packetPhysicalOffset,
+                             const std::vector<size_t> &byteCounts );
       void packetWriteIndex();
+      uint64_t packetWriteIndexPacket( const IndexPacket::Entry *entries, unsigned entryCount,
+                                       uint8_t indexLevel );
+      void waitForPendingFlush();
 
       void flush();
 
@@ -66,6 +83,17 @@ namespace e57
       std::shared_ptr<CompressedVectorNodeImpl> cVector_;
       NodeImplSharedPtr proto_;
 
+      /// Raw pointers to the impls of sbufs_ (which keeps them alive), cached so the
+      /// per-call write paths can check buffer identity, rewind and query capacity without
+      /// shared_ptr reference count traffic
+      std::vector<SourceDestBufferImpl *> boundBufferImpls_;
+
+      /// Scratch vectors reused across calls so the steady-state write loop doesn't
+      /// allocate: per-bytestream byte counts in packetWrite(), and the still-busy encoder
+      /// list in processChannels()
+      std::vector<size_t> streamWriteCounts_;
+      std::vector<Encoder *> encodersToProcess_;
+
       std::vector<std::shared_ptr<Encoder>> bytestreams_;
       DataPacket dataPacket_;
 
@@ -77,5 +105,46 @@ namespace e57
       uint64_t recordCount_;               /// number of records written so far
       uint64_t dataPacketsCount_;          /// number of data packets written so far
       uint64_t indexPacketsCount_;         /// number of index packets written so far
+
+      /// Number of threads used to run the per-bytestream encoders (1 = serial encode)
+      unsigned encodeThreadCount_ = 1;
+
+      /// When pipelined writing is enabled, a finished data packet is copied into
+      /// inFlightPacket_ and checksummed/written to the file by flushThread_ while the
+      /// encoders fill dataPacket_ with the next one.  The thread is joined before the
+      /// file is touched again, so the file itself is never accessed concurrently.
+      bool pipelinedWrite_ = false;
+      DataPacket inFlightPacket_;
+      std::thread flushThread_;
+      std::exception_ptr flushError_;
+
+      /// When the zstd packet extension is enabled (see setZstdPackets()), each finished
+      /// data packet that shrinks under compression is rebuilt in zstdPacket_ as a
+      /// ZSTD_PACKET; packets that don't shrink are written unchanged.  zstdPacket_ is a raw
+      /// 64 KByte packet buffer holding a ZstdPacketHeader followed by compressed bytes.
+      bool zstdPackets_ = false;
+      DataPacket zstdPacket_;
+
+      /// Per-field min/max/count folded in while write() still has the source buffers
+      /// cache-hot, indexed like sbufs_; only maintained when enabled
+      /// (see setStatisticsEnabled())
+      std::vector<FieldStatistics> statistics_;
+      bool statisticsEnabled_ = false;
+
+      /// One index entry per data packet, accumulated as packets are written and
+      /// emitted as (possibly multi-level) index packets when the writer closes.
+      /// chunkRecordNumber is the first record not fully encoded before the packet,
+      /// computed from per-stream cumulative byte counts and fixed record widths
+      /// (see recordChunkEntry()).  Stays empty when a field is variable length
+      /// (strings), in which case a minimal one-entry index is written instead.
+      /// Costs 16 bytes per data packet (~ a million entries for a billion points).
+      std::vector<IndexPacket::Entry> chunkEntries_;
+      std::vector<uint64_t> streamCumulativeBits_;
+      std::vector<unsigned> streamRecordBits_;
+      bool chunkEntriesValid_ = true;
+
+      /// Bytes this session added to the file's memory accounting at open, released
+      /// at close (see ImageFile::memoryUsage())
+      uint64_t accountedEncodeBytes_ = 0;
    };
 }
@@ -33,7 +33,8 @@ namespace e57
 {
    DecodeChannel::DecodeChannel( SourceDestBuffer dbuf_arg, std::shared_ptr<Decoder> decoder_arg,
                                  unsigned bytestreamNumber_arg, uint64_t maxRecordCount_arg ) :
-      dbuf( dbuf_arg ), decoder( decoder_arg ), bytestreamNumber( bytestreamNumber_arg )
+      dbuf( dbuf_arg ), dbufImpl( dbuf.impl().get() ), decoder( decoder_arg ),
+      bytestreamNumber( bytestreamNumber_arg )
    {
       maxRecordCount = maxRecordCount_arg;
       currentPacketLogicalOffset = 0;
@@ -50,8 +51,16 @@ namespace e57
          return ( true );
       }
 
+      // A skip in progress always accepts input; a completed one blocks the channel
+      // so it is neither fed further nor advanced past the bytes the next decode
+      // needs (see CompressedVectorReaderImpl::discardRecords())
+      if ( decoder->skipArmed() )
+      {
+         return ( decoder->skipRecordsPending() == 0 );
+      }
+
       // If we have filled the dest buffer, we are blocked
-      return ( dbuf.impl()->nextIndex() == dbuf.impl()->capacity() );
+      return ( dbufImpl->nextIndex() == dbufImpl->capacity() );
    }
 
    bool DecodeChannel::isInputBlocked() const
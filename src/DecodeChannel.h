@@ -31,10 +31,16 @@
 namespace e57
 {
    class SourceDestBuffer;
+   class SourceDestBufferImpl;
 
    struct DecodeChannel
    {
       SourceDestBuffer dbuf;
+
+      /// Raw pointer to dbuf's impl (which dbuf keeps alive), cached so the per-record hot
+      /// paths don't pay shared_ptr reference count traffic for every query
+      SourceDestBufferImpl *dbufImpl;
+
       std::shared_ptr<Decoder> decoder;
       unsigned bytestreamNumber;
       uint64_t maxRecordCount;
@@ -26,6 +26,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
 #include "CompressedVectorNodeImpl.h"
@@ -41,16 +42,12 @@ using namespace e57;
 
 std::shared_ptr<Decoder> Decoder::DecoderFactory( unsigned bytestreamNumber, //!!! name ok?
                                                   const CompressedVectorNodeImpl *cVector,
+                                                  const NodeImplSharedPtr &decodeNode,
                                                   std::vector<SourceDestBuffer> &dbufs,
                                                   const ustring & /*codecPath*/ )
 {
    // !!! verify single dbuf
 
-   // Get node we are going to decode from the CompressedVector's prototype
-   NodeImplSharedPtr prototype = cVector->getPrototype();
-   ustring path = dbufs.at( 0 ).pathName();
-   NodeImplSharedPtr decodeNode = prototype->get( path );
-
 #ifdef E57_VERBOSE
    std::cout << "Node to decode:" << std::endl; //???
    decodeNode->dump( 2 );
@@ -223,12 +220,63 @@ size_t BitpackDecoder::inputProcess( const char *source, const size_t availableB
              << " availableByteCount=" << availableByteCount << std::endl;
 #endif
    size_t bytesUnsaved = availableByteCount;
+
+   if ( skipArmed() )
+   {
+      // Pass over skipped records arithmetically: first any bits already buffered,
+      // then whole input bytes (which are never copied or converted), and finally the
+      // boundary byte holding both the last skipped bit and the first wanted bit,
+      // which must be buffered for the next decode.
+      const size_t bufferedBits = inBufferEndByte_ * 8 - inBufferFirstBit_;
+      const auto bufferedEaten =
+         static_cast<size_t>( std::min<uint64_t>( skipBitsRemaining_, bufferedBits ) );
+
+      inBufferFirstBit_ += bufferedEaten;
+      skipBitsRemaining_ -= bufferedEaten;
+
+      if ( skipBitsRemaining_ > 0 && source != nullptr && bytesUnsaved > 0 )
+      {
+         // The skip outran the buffer, so the buffer is fully drained and reusable
+         const auto wholeBytes =
+            static_cast<size_t>( std::min<uint64_t>( bytesUnsaved, skipBitsRemaining_ / 8 ) );
+
+         skipBitsRemaining_ -= static_cast<uint64_t>( wholeBytes ) * 8;
+         source += wholeBytes;
+         bytesUnsaved -= wholeBytes;
+
+         if ( skipBitsRemaining_ > 0 && bytesUnsaved > 0 )
+         {
+            inBuffer_[0] = *source;
+            inBufferEndByte_ = 1;
+            inBufferFirstBit_ = static_cast<size_t>( skipBitsRemaining_ );
+            skipBitsRemaining_ = 0;
+            ++source;
+            --bytesUnsaved;
+         }
+      }
+
+      // While armed, never decode: the caller disarms once every channel is in place
+      return ( availableByteCount - bytesUnsaved );
+   }
+
    size_t bitsEaten = 0;
    do
    {
       size_t byteCount =
          std::min( bytesUnsaved, inBuffer_.size() - static_cast<size_t>( inBufferEndByte_ ) );
 
+      // Refills are append-only and the decoder consumes in place; the uneaten
+      // tail is only compacted to the front when the end of inBuffer_ has
+      // actually been reached, not once per refill.  The tail at that point is
+      // typically a fraction of a word, so the memmove is amortized away.
+      if ( byteCount == 0 && bytesUnsaved > 0 )
+      {
+         inBufferShiftDown();
+
+         byteCount =
+            std::min( bytesUnsaved, inBuffer_.size() - static_cast<size_t>( inBufferEndByte_ ) );
+      }
+
       // Copy input bytes from caller, if any
       if ( ( byteCount > 0 ) && ( source != nullptr ) )
       {
@@ -290,10 +338,6 @@ size_t BitpackDecoder::inputProcess( const char *source, const size_t availableB
 #endif
       inBufferFirstBit_ += bitsEaten;
 
-      // Shift uneaten data to beginning of inBuffer_, keep on natural word
-      // boundaries.
-      inBufferShiftDown();
-
       // If the lower level processing didn't eat anything on this iteration,
       // stop looping and tell caller how much we ate or stored.
    } while ( bytesUnsaved > 0 && bitsEaten > 0 );
@@ -306,6 +350,40 @@ void BitpackDecoder::stateReset()
 {
    inBufferFirstBit_ = 0;
    inBufferEndByte_ = 0;
+   skipBitsRemaining_ = 0;
+   skipArmed_ = false;
+}
+
+void BitpackDecoder::skipRecords( const uint64_t recordCount )
+{
+   unsigned bits = 0;
+
+   if ( !bitsPerRecord( bits ) )
+   {
+      throw E57_EXCEPTION2( ErrorInternal,
+                            "cannot skip variable-length records, bytestreamNumber=" +
+                               toString( bytestreamNumber_ ) );
+   }
+
+   // The skipped records are accounted as completed up front; inputProcess() then
+   // consumes their bits without converting them.
+   skipArmed_ = true;
+   skipBitsRemaining_ += recordCount * bits;
+   currentRecordIndex_ += recordCount;
+}
+
+void BitpackDecoder::seekToRecord( const uint64_t recordNumber, const uint64_t dropBits )
+{
+   // Start clean at the landing packet, then let the armed-skip machinery consume
+   // the bits between the packet's stream start and the record's first bit.  The
+   // drop is rarely a whole number of records; the bit-granular skip in
+   // inputProcess() handles that, buffering the byte shared between the last
+   // skipped bit and the first wanted one.
+   stateReset();
+
+   currentRecordIndex_ = recordNumber;
+   skipArmed_ = true;
+   skipBitsRemaining_ = dropBits;
 }
 
 void BitpackDecoder::inBufferShiftDown()
@@ -430,34 +508,18 @@ size_t BitpackFloatDecoder::inputProcessAligned( const char *inbuf, const size_t
       // Form the starting address for first data location in inBuffer
       auto inp = reinterpret_cast<const float *>( inbuf );
 
-      // Copy floats from inbuf to destBuffer_
-      for ( unsigned i = 0; i < n; i++ )
-      {
-         float value = *inp;
-
-#ifdef E57_VERBOSE
-         std::cout << "  got float value=" << value << std::endl;
-#endif
-         destBuffer_->setNextFloat( value );
-         inp++;
-      }
+      // Copy floats from inbuf to destBuffer_.  If the destination is a plain
+      // contiguous float array this is one block copy of the whole run.
+      destBuffer_->setNextFloatArray( inp, n );
    }
    else
    { // Double precision
       // Form the starting address for first data location in inBuffer
       auto inp = reinterpret_cast<const double *>( inbuf );
 
-      // Copy doubles from inbuf to destBuffer_
-      for ( unsigned i = 0; i < n; i++ )
-      {
-         double value = *inp;
-
-#ifdef E57_VERBOSE
-         std::cout << "  got double value=" << value << std::endl;
-#endif
-         destBuffer_->setNextDouble( value );
-         inp++;
-      }
+      // Copy doubles from inbuf to destBuffer_.  If the destination is a plain
+      // contiguous double array this is one block copy of the whole run.
+      destBuffer_->setNextDoubleArray( inp, n );
    }
 
    // Update counts of records processed
@@ -521,6 +583,56 @@ size_t BitpackStringDecoder::inputProcessAligned( const char *inbuf, const size_
                 << " prefixLength=" << prefixLength_ << " nBytesPrefixRead=" << nBytesPrefixRead_
                 << " nBytesStringRead=" << nBytesStringRead_ << std::endl;
 #endif
+      // Batched fast path: when we are at a record boundary and the whole
+      // length-prefixed record is available, carve it straight out of the input
+      // and commit it with one in-place assignment - no per-byte state machine
+      // steps and no temporary ustring.  Records that straddle the input
+      // boundary fall through to the incremental path below.
+      if ( readingPrefix_ && nBytesPrefixRead_ == 0 )
+      {
+         const size_t remaining = nBytesAvailable - nBytesRead;
+         const auto firstByte = static_cast<uint8_t>( *inbuf );
+         const size_t wholePrefixLength = ( firstByte & 0x01 ) ? 8 : 1;
+
+         if ( remaining >= wholePrefixLength )
+         {
+            uint64_t wholeStringLength = 0;
+
+            if ( wholePrefixLength == 1 )
+            {
+               wholeStringLength = static_cast<uint64_t>( firstByte >> 1 );
+            }
+            else
+            {
+               const auto prefix = reinterpret_cast<const uint8_t *>( inbuf );
+
+               wholeStringLength = ( static_cast<uint64_t>( prefix[0] ) >> 1 ) +
+                                   ( static_cast<uint64_t>( prefix[1] ) << ( 1 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[2] ) << ( 2 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[3] ) << ( 3 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[4] ) << ( 4 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[5] ) << ( 5 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[6] ) << ( 6 * 8 - 1 ) ) +
+                                   ( static_cast<uint64_t>( prefix[7] ) << ( 7 * 8 - 1 ) );
+            }
+
+            if ( remaining - wholePrefixLength >= wholeStringLength )
+            {
+               destBuffer_->setNextString( inbuf + wholePrefixLength,
+                                           static_cast<size_t>( wholeStringLength ) );
+               currentRecordIndex_++;
+
+               const size_t recordBytes =
+                  wholePrefixLength + static_cast<size_t>( wholeStringLength );
+
+               inbuf += recordBytes;
+               nBytesRead += recordBytes;
+
+               continue;
+            }
+         }
+      }
+
       if ( readingPrefix_ )
       {
          // Try to read more prefix bytes
@@ -679,6 +791,267 @@ BitpackIntegerDecoder<RegisterT>::BitpackIntegerDecoder( bool isScaledInteger,
    bitsPerRecord_ = imf->bitsNeeded( minimum_, maximum_ );
    destBitMask_ =
       ( bitsPerRecord_ == 64 ) ? ~0 : static_cast<RegisterT>( 1ULL << bitsPerRecord_ ) - 1;
+
+   selectUnpackRoutine();
+}
+
+template <typename RegisterT>
+void BitpackIntegerDecoder<RegisterT>::destBufferSetNew( std::vector<SourceDestBuffer> &dbufs )
+{
+   BitpackDecoder::destBufferSetNew( dbufs );
+
+   // The new destination may have a different representation, stride, or scaling
+   // request, so the monomorphized routine has to be re-resolved.
+   selectUnpackRoutine();
+}
+
+template <typename RegisterT>
+template <typename DestT, bool Scaled>
+void BitpackIntegerDecoder<RegisterT>::unpackInto( const RegisterT *inp, const size_t firstBit,
+                                                   const size_t recordCount, char *dest )
+{
+   auto out = reinterpret_cast<DestT *>( dest );
+
+   if ( ( bitsPerRecord_ == RegisterBits ) && ( firstBit == 0 ) )
+   {
+      // Records are exactly one register wide and aligned: straight load/convert/store.
+      for ( size_t i = 0; i < recordCount; i++ )
+      {
+         const int64_t raw = minimum_ + static_cast<int64_t>( static_cast<uint64_t>( inp[i] ) );
+
+         if ( Scaled )
+         {
+            if ( std::is_floating_point<DestT>::value )
+            {
+               out[i] = static_cast<DestT>( raw * scale_ + offset_ );
+            }
+            else
+            {
+               out[i] = static_cast<DestT>( floor( raw * scale_ + offset_ + 0.5 ) );
+            }
+         }
+         else
+         {
+            out[i] = static_cast<DestT>( raw );
+         }
+      }
+
+      return;
+   }
+
+   // General fixed-width case, same bit extraction as the staged path in
+   // inputProcessAligned() but fused with the conversion and final store.
+   size_t bitOffset = firstBit;
+   unsigned wordPosition = 0;
+
+   for ( size_t i = 0; i < recordCount; i++ )
+   {
+      const RegisterT low = inp[wordPosition];
+
+      RegisterT w;
+      if ( bitOffset == 0 )
+      {
+         w = low;
+      }
+      else if ( bitOffset + bitsPerRecord_ <= RegisterBits )
+      {
+         w = low >> bitOffset;
+      }
+      else
+      {
+         const RegisterT high = inp[wordPosition + 1];
+
+         w = ( high << ( RegisterBits - bitOffset ) ) | ( low >> bitOffset );
+      }
+
+      const int64_t raw =
+         minimum_ + static_cast<int64_t>( static_cast<uint64_t>( w & destBitMask_ ) );
+
+      if ( Scaled )
+      {
+         if ( std::is_floating_point<DestT>::value )
+         {
+            out[i] = static_cast<DestT>( raw * scale_ + offset_ );
+         }
+         else
+         {
+            out[i] = static_cast<DestT>( floor( raw * scale_ + offset_ + 0.5 ) );
+         }
+      }
+      else
+      {
+         out[i] = static_cast<DestT>( raw );
+      }
+
+      bitOffset += bitsPerRecord_;
+      if ( bitOffset >= RegisterBits )
+      {
+         bitOffset -= RegisterBits;
+         wordPosition++;
+      }
+   }
+}
+
+template <typename RegisterT> void BitpackIntegerDecoder<RegisterT>::selectUnpackRoutine()
+{
+   unpackRoutine_ = nullptr;
+
+   // Largest raw value the bit width can produce (the mask may cover a little more
+   // than maximum_ when maximum_ - minimum_ + 1 is not a power of two).  Guard the
+   // addition so a corrupt or extreme field range can't overflow.
+   const auto mask = static_cast<uint64_t>( destBitMask_ );
+   int64_t rawMax = INT64_MAX;
+   if ( mask <= static_cast<uint64_t>( INT64_MAX ) &&
+        minimum_ <= INT64_MAX - static_cast<int64_t>( mask ) )
+   {
+      rawMax = minimum_ + static_cast<int64_t>( mask );
+   }
+
+   const size_t stride = destBuffer_->stride();
+   const bool doConversion = destBuffer_->doConversion();
+
+   if ( isScaledInteger_ && destBuffer_->doScaling() )
+   {
+      // The affine map value*scale+offset is monotonic, so checking the two raw
+      // endpoints once here proves every decodable value is representable in the
+      // destination, and the per-value range checks can be omitted from the loop.
+      const double endA = static_cast<double>( minimum_ ) * scale_ + offset_;
+      const double endB = static_cast<double>( rawMax ) * scale_ + offset_;
+      const double scaledMin = std::min( endA, endB );
+      const double scaledMax = std::max( endA, endB );
+      const double roundedMin = floor( scaledMin + 0.5 );
+      const double roundedMax = floor( scaledMax + 0.5 );
+
+      switch ( destBuffer_->memoryRepresentation() )
+      {
+         case Int8:
+            if ( stride == sizeof( int8_t ) && INT8_MIN <= roundedMin && roundedMax <= INT8_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int8_t, true>;
+            }
+            break;
+         case UInt8:
+            if ( stride == sizeof( uint8_t ) && UINT8_MIN <= roundedMin && roundedMax <= UINT8_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint8_t, true>;
+            }
+            break;
+         case Int16:
+            if ( stride == sizeof( int16_t ) && INT16_MIN <= roundedMin && roundedMax <= INT16_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int16_t, true>;
+            }
+            break;
+         case UInt16:
+            if ( stride == sizeof( uint16_t ) && UINT16_MIN <= roundedMin &&
+                 roundedMax <= UINT16_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint16_t, true>;
+            }
+            break;
+         case Int32:
+            if ( stride == sizeof( int32_t ) && INT32_MIN <= roundedMin && roundedMax <= INT32_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int32_t, true>;
+            }
+            break;
+         case UInt32:
+            if ( stride == sizeof( uint32_t ) && UINT32_MIN <= roundedMin &&
+                 roundedMax <= UINT32_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint32_t, true>;
+            }
+            break;
+         case Int64:
+            if ( stride == sizeof( int64_t ) && static_cast<double>( INT64_MIN ) <= roundedMin &&
+                 roundedMax <= static_cast<double>( INT64_MAX ) )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int64_t, true>;
+            }
+            break;
+         case Real32:
+            if ( doConversion && stride == sizeof( float ) && DOUBLE_MIN <= scaledMin &&
+                 scaledMax <= DOUBLE_MAX )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<float, true>;
+            }
+            break;
+         case Real64:
+            if ( doConversion && stride == sizeof( double ) )
+            {
+               unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<double, true>;
+            }
+            break;
+         default:
+            // Bool and UString destinations keep the staged path
+            break;
+      }
+
+      return;
+   }
+
+   // Raw values: every decodable value lies in [minimum_, rawMax], so a direct
+   // routine is safe whenever that interval fits the destination type.
+   switch ( destBuffer_->memoryRepresentation() )
+   {
+      case Int8:
+         if ( stride == sizeof( int8_t ) && INT8_MIN <= minimum_ && rawMax <= INT8_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int8_t, false>;
+         }
+         break;
+      case UInt8:
+         if ( stride == sizeof( uint8_t ) && UINT8_MIN <= minimum_ && rawMax <= UINT8_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint8_t, false>;
+         }
+         break;
+      case Int16:
+         if ( stride == sizeof( int16_t ) && INT16_MIN <= minimum_ && rawMax <= INT16_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int16_t, false>;
+         }
+         break;
+      case UInt16:
+         if ( stride == sizeof( uint16_t ) && UINT16_MIN <= minimum_ && rawMax <= UINT16_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint16_t, false>;
+         }
+         break;
+      case Int32:
+         if ( stride == sizeof( int32_t ) && INT32_MIN <= minimum_ && rawMax <= INT32_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int32_t, false>;
+         }
+         break;
+      case UInt32:
+         if ( stride == sizeof( uint32_t ) && UINT32_MIN <= minimum_ && rawMax <= UINT32_MAX )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<uint32_t, false>;
+         }
+         break;
+      case Int64:
+         if ( stride == sizeof( int64_t ) )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<int64_t, false>;
+         }
+         break;
+      case Real32:
+         if ( doConversion && stride == sizeof( float ) )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<float, false>;
+         }
+         break;
+      case Real64:
+         if ( doConversion && stride == sizeof( double ) )
+         {
+            unpackRoutine_ = &BitpackIntegerDecoder::unpackInto<double, false>;
+         }
+         break;
+      default:
+         // Bool and UString destinations keep the staged path
+         break;
+   }
 }
 
 template <typename RegisterT>
@@ -730,6 +1103,23 @@ size_t BitpackIntegerDecoder<RegisterT>::inputProcessAligned( const char *inbuf,
    std::cout << "  recordCount=" << recordCount << std::endl;
 #endif
 
+   // Fast path: when a routine was resolved for this destination, one monomorphized
+   // loop converts and stores straight into the user's buffer, with no staging
+   // array and no per-batch representation dispatch.
+   if ( unpackRoutine_ != nullptr )
+   {
+      char *dest = static_cast<char *>( destBuffer_->base() ) +
+                   destBuffer_->nextIndex() * destBuffer_->stride();
+
+      ( this->*unpackRoutine_ )( reinterpret_cast<const RegisterT *>( inbuf ), firstBit,
+                                 recordCount, dest );
+      destBuffer_->advanceNextIndex( recordCount );
+
+      currentRecordIndex_ += recordCount;
+
+      return ( recordCount * bitsPerRecord_ );
+   }
+
    auto inp = reinterpret_cast<const RegisterT *>( inbuf );
    unsigned wordPosition = 0; // The index in inbuf of the word we are currently working on.
 
@@ -747,80 +1137,96 @@ size_t BitpackIntegerDecoder<RegisterT>::inputProcessAligned( const char *inbuf,
 
    size_t bitOffset = firstBit;
 
-   for ( size_t i = 0; i < recordCount; i++ )
-   {
-      // Get lower word (contains at least the LSbit of the value),
-      RegisterT low = inp[wordPosition];
+   // Unpack records in batches.  The extraction loops below are free of function
+   // calls and stores through destBuffer_, so the compiler can keep everything in
+   // registers and auto-vectorize the common fixed-width cases.  The unpacked raw
+   // values are staged in a small local array and then handed to destBuffer_.
+   int64_t batch[UnpackBatchSize];
 
-#ifdef E57_VERBOSE
-      std::cout << "  bitOffset: " << bitOffset << std::endl;
-      std::cout << "  low: " << binaryString( low ) << std::endl;
-#endif
+   for ( size_t i = 0; i < recordCount; )
+   {
+      size_t batchCount = std::min( recordCount - i, UnpackBatchSize );
 
-      RegisterT w;
-      if ( bitOffset == 0 )
+      if ( ( bitsPerRecord_ == RegisterBits ) && ( bitOffset == 0 ) )
       {
-         // The left shift (used below) is not defined if shift is >= size of
-         // word
-         w = low;
-      }
-      // Avoid reading the next word, unless it is needed
-      // If the last record finishes on the last bit of input, avoid UMR
-      else if ( bitOffset + bitsPerRecord_ <= RegisterBits )
-      {
-         w = low >> bitOffset;
+         // Records are exactly one register wide and aligned: a straight
+         // load/widen loop (vectorizable on all register sizes).
+         for ( size_t j = 0; j < batchCount; j++ )
+         {
+            batch[j] =
+               minimum_ + static_cast<int64_t>( static_cast<uint64_t>( inp[wordPosition + j] ) );
+         }
+         wordPosition += batchCount;
       }
       else
       {
-         // Get upper word (may or may not contain interesting bits),
-         RegisterT high = inp[wordPosition + 1];
-
-#ifdef E57_VERBOSE
-         std::cout << "  high:" << binaryString( high ) << std::endl;
-#endif
+         // General fixed-width case: each value may straddle a register boundary.
+         for ( size_t j = 0; j < batchCount; j++ )
+         {
+            // Get lower word (contains at least the LSbit of the value),
+            RegisterT low = inp[wordPosition];
 
-         // Shift high to just above the lower bits, shift low LSBit to bit0,
-         // OR together. Note shifts are logical (not arithmetic) because using
-         // unsigned variables.
-         w = ( high << ( RegisterBits - bitOffset ) ) | ( low >> bitOffset );
-      }
+            RegisterT w;
+            if ( bitOffset == 0 )
+            {
+               // The left shift (used below) is not defined if shift is >= size
+               // of word
+               w = low;
+            }
+            // Avoid reading the next word, unless it is needed
+            // If the last record finishes on the last bit of input, avoid UMR
+            else if ( bitOffset + bitsPerRecord_ <= RegisterBits )
+            {
+               w = low >> bitOffset;
+            }
+            else
+            {
+               // Get upper word (may or may not contain interesting bits),
+               RegisterT high = inp[wordPosition + 1];
 
-#ifdef E57_VERBOSE
-      std::cout << "  w:   " << binaryString( w ) << std::endl;
-#endif
+               // Shift high to just above the lower bits, shift low LSBit to
+               // bit0, OR together. Note shifts are logical (not arithmetic)
+               // because using unsigned variables.
+               w = ( high << ( RegisterBits - bitOffset ) ) | ( low >> bitOffset );
+            }
 
-      // Mask off uninteresting bits
-      w &= destBitMask_;
+            // Mask off uninteresting bits, then add minimum_ to value to get
+            // back what writer originally sent
+            batch[j] = minimum_ + static_cast<int64_t>( static_cast<uint64_t>( w & destBitMask_ ) );
 
-      // Add minimum_ to value to get back what writer originally sent
-      int64_t value = minimum_ + static_cast<uint64_t>( w );
+            // Calc next bit alignment and which word it starts in
+            bitOffset += bitsPerRecord_;
+            if ( bitOffset >= RegisterBits )
+            {
+               bitOffset -= RegisterBits;
+               wordPosition++;
+            }
+         }
+      }
 
 #ifdef E57_VERBOSE
-      std::cout << "  Storing value=" << value << std::endl;
+      for ( size_t j = 0; j < batchCount; j++ )
+      {
+         std::cout << "  Storing value=" << batch[j] << std::endl;
+      }
 #endif
 
-      // The parameter isScaledInteger_ determines which version of
-      // setNextInt64 gets called
+      // Store the results in the next available positions in the user's dest
+      // buffer.  The parameter isScaledInteger_ determines which version of
+      // setNextInt64Array gets called.
       if ( isScaledInteger_ )
       {
-         destBuffer_->setNextInt64( value, scale_, offset_ );
+         destBuffer_->setNextInt64Array( batch, batchCount, scale_, offset_ );
       }
       else
       {
-         destBuffer_->setNextInt64( value );
+         destBuffer_->setNextInt64Array( batch, batchCount );
       }
 
-      // Store the result in next available position in the user's dest buffer
+      i += batchCount;
 
-      // Calc next bit alignment and which word it starts in
-      bitOffset += bitsPerRecord_;
-      if ( bitOffset >= 8 * sizeof( RegisterT ) )
-      {
-         bitOffset -= 8 * sizeof( RegisterT );
-         wordPosition++;
-      }
 #ifdef E57_VERBOSE
-      std::cout << "  Processed " << i + 1 << " records, wordPosition=" << wordPosition
+      std::cout << "  Processed " << i << " records, wordPosition=" << wordPosition
                 << " decoder:" << std::endl;
       dump( 4 );
 #endif
@@ -883,6 +1289,12 @@ size_t ConstantIntegerDecoder::inputProcess( const char *source, const size_t av
    // We don't need any input bytes to produce output, so ignore source and
    // availableByteCount.
 
+   // While a skip is armed no output may be produced (see Decoder::skipRecords())
+   if ( skipArmed() )
+   {
+      return 0;
+   }
+
    // Fill dest buffer unless get to maxRecordCount
    size_t count = destBuffer_->capacity() - destBuffer_->nextIndex();
    uint64_t remainingRecordCount = maxRecordCount_ - currentRecordIndex_;
@@ -891,19 +1303,15 @@ size_t ConstantIntegerDecoder::inputProcess( const char *source, const size_t av
       count = static_cast<unsigned>( remainingRecordCount );
    }
 
+   // Bulk fill: the constant is validated/converted once and replicated, instead
+   // of one setNextInt64() call per record.
    if ( isScaledInteger_ )
    {
-      for ( size_t i = 0; i < count; i++ )
-      {
-         destBuffer_->setNextInt64( minimum_, scale_, offset_ );
-      }
+      destBuffer_->setNextInt64Fill( minimum_, count, scale_, offset_ );
    }
    else
    {
-      for ( size_t i = 0; i < count; i++ )
-      {
-         destBuffer_->setNextInt64( minimum_ );
-      }
+      destBuffer_->setNextInt64Fill( minimum_, count );
    }
    currentRecordIndex_ += count;
    return ( count );
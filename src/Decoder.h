@@ -34,8 +34,11 @@ namespace e57
    class Decoder
    {
    public:
+      /// decodeNode is the field's node in cVector's prototype tree; the caller resolves
+      /// it (and caches the lookup, see CompressedVectorNodeImpl::decodePlanEntry()).
       static std::shared_ptr<Decoder> DecoderFactory( unsigned bytestreamNumber,
                                                       const CompressedVectorNodeImpl *cVector,
+                                                      const NodeImplSharedPtr &decodeNode,
                                                       std::vector<SourceDestBuffer> &dbufs,
                                                       const ustring &codecPath );
       Decoder() = delete;
@@ -46,11 +49,57 @@ namespace e57
       virtual size_t inputProcess( const char *source, size_t count ) = 0;
       virtual void stateReset() = 0;
 
+      /// True when every record consumes a fixed number of bits from the bytestream,
+      /// returned in bits (0 for constant streams, which consume no input at all).
+      /// Variable-length streams (strings) return false.  Lets packet walking code
+      /// turn per-packet byte counts into record counts without decoding.
+      virtual bool bitsPerRecord( unsigned &bits ) const = 0;
+
+      /// Arm the decoder to pass over the next recordCount records instead of
+      /// converting them into the destination buffer.  Fixed-width streams advance by
+      /// bit-position arithmetic only - skipped bytes are never copied or converted -
+      /// so discarding records costs a few integer operations per packet.  While
+      /// armed, inputProcess() produces no output; the caller disarms with
+      /// skipDisarm() once every channel is in place (see
+      /// CompressedVectorReaderImpl::discardRecords()).  Throws ErrorInternal for
+      /// variable-length streams (strings), whose record boundaries can only be
+      /// found by decoding.
+      virtual void skipRecords( uint64_t recordCount ) = 0;
+
+      /// Reposition the decoder so the next record it produces is recordNumber.  The
+      /// caller lands the channel on the packet holding that record's first bit and
+      /// passes the bit distance from the packet's stream start in dropBits; the drop
+      /// is consumed through the armed-skip path, so the caller must run its feed
+      /// loop and then disarm with skipDisarm(), exactly as for skipRecords().  Only
+      /// meaningful for fixed-width streams (see CompressedVectorReaderImpl::seek()).
+      virtual void seekToRecord( uint64_t recordNumber, uint64_t dropBits ) = 0;
+
+      /// Records still to pass over from the last skipRecords() call
+      virtual uint64_t skipRecordsPending() const = 0;
+
+      bool skipArmed() const
+      {
+         return skipArmed_;
+      }
+
+      /// Return to normal decoding once a skip has been fully consumed
+      void skipDisarm()
+      {
+         skipArmed_ = false;
+      }
+
       unsigned bytestreamNumber() const
       {
          return bytestreamNumber_;
       }
 
+      /// Bytes of staging buffer this decoder holds, for ImageFile::memoryUsage()
+      /// (constant streams hold none)
+      virtual size_t stagingBytes() const
+      {
+         return 0;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       virtual void dump( int indent = 0, std::ostream &os = std::cout ) = 0;
 #endif
@@ -59,6 +108,7 @@ namespace e57
       explicit Decoder( unsigned bytestreamNumber );
 
       unsigned int bytestreamNumber_;
+      bool skipArmed_ = false;
    };
 
    class BitpackDecoder : public Decoder
@@ -76,6 +126,24 @@ namespace e57
 
       void stateReset() override;
 
+      void skipRecords( uint64_t recordCount ) override;
+
+      void seekToRecord( uint64_t recordNumber, uint64_t dropBits ) override;
+
+      uint64_t skipRecordsPending() const override
+      {
+         unsigned bits = 0;
+
+         bitsPerRecord( bits ); // a skip is only ever armed for fixed-width streams
+
+         return ( bits == 0 ) ? 0 : ( skipBitsRemaining_ + bits - 1 ) / bits;
+      }
+
+      size_t stagingBytes() const override
+      {
+         return inBuffer_.capacity();
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) override;
 #endif
@@ -89,6 +157,9 @@ namespace e57
       uint64_t currentRecordIndex_ = 0;
       uint64_t maxRecordCount_ = 0;
 
+      /// Bits left to pass over for an armed skip (see skipRecords())
+      uint64_t skipBitsRemaining_ = 0;
+
       std::shared_ptr<SourceDestBufferImpl> destBuffer_;
 
       std::vector<char> inBuffer_;
@@ -107,6 +178,12 @@ namespace e57
 
       size_t inputProcessAligned( const char *inbuf, size_t firstBit, size_t endBit ) override;
 
+      bool bitsPerRecord( unsigned &bits ) const override
+      {
+         bits = ( precision_ == PrecisionSingle ) ? 32 : 64;
+         return true;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) override;
 #endif
@@ -123,6 +200,11 @@ namespace e57
 
       size_t inputProcessAligned( const char *inbuf, size_t firstBit, size_t endBit ) override;
 
+      bool bitsPerRecord( unsigned & /*bits*/ ) const override
+      {
+         return false; // strings are variable length
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) override;
 #endif
@@ -144,8 +226,16 @@ namespace e57
                              SourceDestBuffer &dbuf, int64_t minimum, int64_t maximum, double scale,
                              double offset, uint64_t maxRecordCount );
 
+      void destBufferSetNew( std::vector<SourceDestBuffer> &dbufs ) override;
+
       size_t inputProcessAligned( const char *inbuf, size_t firstBit, size_t endBit ) override;
 
+      bool bitsPerRecord( unsigned &bits ) const override
+      {
+         bits = bitsPerRecord_;
+         return true;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) override;
 #endif
@@ -159,6 +249,32 @@ namespace e57
       unsigned bitsPerRecord_;
       RegisterT destBitMask_;
       static constexpr size_t RegisterBits = sizeof( RegisterT ) * 8;
+
+      /// Number of records unpacked per inner-loop batch in inputProcessAligned().
+      /// Small enough to stay in L1, large enough for the extraction loop to vectorize.
+      static constexpr size_t UnpackBatchSize = 64;
+
+   private:
+      /// Monomorphized decode loop: extracts each bit-packed value and stores it
+      /// directly in the destination representation DestT, applying the scale and
+      /// offset when Scaled.  One instantiation exists per (register width,
+      /// destination type, scaling) combination, so the body is a single branch-free
+      /// loop the compiler can unroll and vectorize.
+      template <typename DestT, bool Scaled>
+      void unpackInto( const RegisterT *inp, size_t firstBit, size_t recordCount, char *dest );
+
+      /// Resolves which unpackInto instantiation (if any) fits the attached
+      /// destination buffer.  Stays nullptr when the destination needs the
+      /// per-value range checks or representations the direct loops omit, in
+      /// which case inputProcessAligned() uses the staged batch path.
+      void selectUnpackRoutine();
+
+      using UnpackRoutine = void ( BitpackIntegerDecoder::* )( const RegisterT *inp,
+                                                               size_t firstBit, size_t recordCount,
+                                                               char *dest );
+
+      /// Resolved once per destination buffer, not per packet or per value
+      UnpackRoutine unpackRoutine_ = nullptr;
    };
 
    class ConstantIntegerDecoder : public Decoder
@@ -177,6 +293,31 @@ namespace e57
       size_t inputProcess( const char *source, size_t availableByteCount ) override;
       void stateReset() override;
 
+      bool bitsPerRecord( unsigned &bits ) const override
+      {
+         bits = 0; // constant streams consume no input
+         return true;
+      }
+
+      void skipRecords( uint64_t recordCount ) override
+      {
+         // No input to pass over; just account for the records never materialized
+         skipArmed_ = true;
+         currentRecordIndex_ += recordCount;
+      }
+
+      void seekToRecord( uint64_t recordNumber, uint64_t /*dropBits*/ ) override
+      {
+         // No input stream to position within; just set the record position
+         skipArmed_ = true;
+         currentRecordIndex_ = recordNumber;
+      }
+
+      uint64_t skipRecordsPending() const override
+      {
+         return 0;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) override;
 #endif
@@ -7,6 +7,9 @@
 // NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c)
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <mutex>
+#include <new>
+#include <utility>
 
 #include "E57SimpleData.h"
 
@@ -15,6 +18,30 @@
 
 namespace e57
 {
+   namespace
+   {
+      std::mutex allocatorMutex;
+
+      /// Installed by SetPointBufferAllocator(); both empty by default (plain `new[]`)
+      PointBufferAllocator customAllocate;
+      PointBufferDeallocator customDeallocate;
+   }
+
+   void SetPointBufferAllocator( const PointBufferAllocator &allocate,
+                                 const PointBufferDeallocator &deallocate )
+   {
+      if ( static_cast<bool>( allocate ) != static_cast<bool>( deallocate ) )
+      {
+         throw E57_EXCEPTION2( ErrorBadAPIArgument,
+                               "allocate and deallocate must be set or cleared together" );
+      }
+
+      const std::lock_guard<std::mutex> lock( allocatorMutex );
+
+      customAllocate = allocate;
+      customDeallocate = deallocate;
+   }
+
    /// @private
    /// Validates a Data3D and throws on error.
    constexpr void _validateData3D( const Data3D &inData3D )
@@ -45,10 +72,18 @@ namespace e57
    }
 
    template <typename COORDTYPE>
-   Data3DPointsData_t<COORDTYPE>::Data3DPointsData_t( Data3D &data3D ) : _selfAllocated( true )
+   Data3DPointsData_t<COORDTYPE>::Data3DPointsData_t( Data3D &data3D )
+   {
+      resize( data3D, data3D.pointCount );
+   }
+
+   template <typename COORDTYPE>
+   void Data3DPointsData_t<COORDTYPE>::resize( Data3D &data3D, size_t pointCount )
    {
       static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
 
+      data3D.pointCount = pointCount;
+
       _validateData3D( data3D );
 
       constexpr bool cIsFloat = std::is_same<COORDTYPE, float>::value;
@@ -82,164 +117,336 @@ namespace e57
 
       const auto cPointCount = data3D.pointCount;
 
-      if ( data3D.pointFields.cartesianXField )
-      {
-         cartesianX = new COORDTYPE[cPointCount];
-      }
+      // All field arrays are carved out of one 64-byte-aligned slab: cache-line
+      // aligned starts for the conversion kernels, one allocation instead of two
+      // dozen, and no TLB-hostile scatter of separately new'd arrays.
+      constexpr size_t cAlignment = 64;
 
-      if ( data3D.pointFields.cartesianYField )
-      {
-         cartesianY = new COORDTYPE[cPointCount];
-      }
+      auto alignedSize = []( size_t bytes ) {
+         return ( bytes + cAlignment - 1 ) & ~( cAlignment - 1 );
+      };
 
-      if ( data3D.pointFields.cartesianZField )
-      {
-         cartesianZ = new COORDTYPE[cPointCount];
-      }
+      // Applies an action to every (availability flag, field pointer) pair
+      auto forEachField = [&]( auto &&action ) {
+         const PointStandardizedFieldsAvailable &fields = data3D.pointFields;
 
-      if ( data3D.pointFields.cartesianInvalidStateField )
-      {
-         cartesianInvalidState = new int8_t[cPointCount];
-      }
+         action( fields.cartesianXField, cartesianX );
+         action( fields.cartesianYField, cartesianY );
+         action( fields.cartesianZField, cartesianZ );
+         action( fields.cartesianInvalidStateField, cartesianInvalidState );
 
-      if ( data3D.pointFields.intensityField )
-      {
-         intensity = new double[cPointCount];
-      }
+         action( fields.intensityField, intensity );
+         action( fields.isIntensityInvalidField, isIntensityInvalid );
 
-      if ( data3D.pointFields.isIntensityInvalidField )
-      {
-         isIntensityInvalid = new int8_t[cPointCount];
-      }
+         action( fields.colorRedField, colorRed );
+         action( fields.colorGreenField, colorGreen );
+         action( fields.colorBlueField, colorBlue );
+         action( fields.isColorInvalidField, isColorInvalid );
 
-      if ( data3D.pointFields.colorRedField )
-      {
-         colorRed = new uint16_t[cPointCount];
-      }
+         action( fields.sphericalRangeField, sphericalRange );
+         action( fields.sphericalAzimuthField, sphericalAzimuth );
+         action( fields.sphericalElevationField, sphericalElevation );
+         action( fields.sphericalInvalidStateField, sphericalInvalidState );
 
-      if ( data3D.pointFields.colorGreenField )
-      {
-         colorGreen = new uint16_t[cPointCount];
-      }
+         action( fields.rowIndexField, rowIndex );
+         action( fields.columnIndexField, columnIndex );
 
-      if ( data3D.pointFields.colorBlueField )
-      {
-         colorBlue = new uint16_t[cPointCount];
-      }
+         action( fields.returnIndexField, returnIndex );
+         action( fields.returnCountField, returnCount );
 
-      if ( data3D.pointFields.isColorInvalidField )
-      {
-         isColorInvalid = new int8_t[cPointCount];
-      }
+         action( fields.timeStampField, timeStamp );
+         action( fields.isTimeStampInvalidField, isTimeStampInvalid );
 
-      if ( data3D.pointFields.sphericalRangeField )
-      {
-         sphericalRange = new COORDTYPE[cPointCount];
-      }
+         action( fields.normalXField, normalX );
+         action( fields.normalYField, normalY );
+         action( fields.normalZField, normalZ );
+      };
 
-      if ( data3D.pointFields.sphericalAzimuthField )
-      {
-         sphericalAzimuth = new COORDTYPE[cPointCount];
-      }
+      // Absent fields must not keep stale pointers from a previous layout
+      forEachField( []( bool, auto *&fieldPointer ) { fieldPointer = nullptr; } );
 
-      if ( data3D.pointFields.sphericalElevationField )
-      {
-         sphericalElevation = new COORDTYPE[cPointCount];
-      }
+      size_t totalBytes = 0;
 
-      if ( data3D.pointFields.sphericalInvalidStateField )
-      {
-         sphericalInvalidState = new int8_t[cPointCount];
-      }
+      forEachField( [&]( bool present, auto *&fieldPointer ) {
+         using ElementType = typename std::remove_pointer<
+            typename std::remove_reference<decltype( fieldPointer )>::type>::type;
 
-      if ( data3D.pointFields.rowIndexField )
-      {
-         rowIndex = new int32_t[cPointCount];
-      }
+         if ( present )
+         {
+            totalBytes += alignedSize( sizeof( ElementType ) * cPointCount );
+         }
+      } );
 
-      if ( data3D.pointFields.columnIndexField )
-      {
-         columnIndex = new int32_t[cPointCount];
-      }
+      // From here on the object owns whatever slab it holds, even if it was default
+      // constructed and used to wrap caller-owned pointers (those are dropped, never freed)
+      _selfAllocated = true;
 
-      if ( data3D.pointFields.returnIndexField )
+      if ( totalBytes == 0 )
       {
-         returnIndex = new int8_t[cPointCount];
+         // Keep any existing slab for later reuse
+         return;
       }
 
-      if ( data3D.pointFields.returnCountField )
+      // Capacity is monotonic: grow when needed, otherwise rebind into the existing slab
+      if ( totalBytes > _bufferBytes )
       {
-         returnCount = new int8_t[cPointCount];
+         _freeBuffer();
+         _buffer = nullptr; // stay consistent if the allocation below throws
+         _bufferBytes = 0;
+
+         // Snapshot the hooks so the slab is always freed by the deallocator matching
+         // the allocator it came from (see SetPointBufferAllocator())
+         PointBufferAllocator allocate;
+
+         {
+            const std::lock_guard<std::mutex> lock( allocatorMutex );
+
+            allocate = customAllocate;
+            _deallocate = customDeallocate;
+         }
+
+         if ( allocate )
+         {
+            _buffer = static_cast<char *>( allocate( totalBytes + cAlignment - 1 ) );
+
+            if ( _buffer == nullptr )
+            {
+               throw std::bad_alloc();
+            }
+         }
+         else
+         {
+            _buffer = new char[totalBytes + cAlignment - 1];
+         }
+
+         _bufferBytes = totalBytes;
       }
 
-      if ( data3D.pointFields.timeStampField )
-      {
-         timeStamp = new double[cPointCount];
-      }
+      char *cursor = reinterpret_cast<char *>(
+         ( reinterpret_cast<uintptr_t>( _buffer ) + cAlignment - 1 ) &
+         ~static_cast<uintptr_t>( cAlignment - 1 ) );
 
-      if ( data3D.pointFields.isTimeStampInvalidField )
-      {
-         isTimeStampInvalid = new int8_t[cPointCount];
-      }
+      forEachField( [&]( bool present, auto *&fieldPointer ) {
+         using ElementType = typename std::remove_pointer<
+            typename std::remove_reference<decltype( fieldPointer )>::type>::type;
 
-      if ( data3D.pointFields.normalXField )
-      {
-         normalX = new float[cPointCount];
-      }
+         if ( present )
+         {
+            fieldPointer = reinterpret_cast<ElementType *>( cursor );
+            cursor += alignedSize( sizeof( ElementType ) * cPointCount );
+         }
+      } );
+   }
 
-      if ( data3D.pointFields.normalYField )
-      {
-         normalY = new float[cPointCount];
-      }
+   template <typename COORDTYPE>
+   size_t Data3DPointsData_t<COORDTYPE>::estimatedSize( const Data3D &data3D, size_t pointCount )
+   {
+      // Must match the slab layout in resize(): one aligned run per enabled field
+      constexpr size_t cAlignment = 64;
 
-      if ( data3D.pointFields.normalZField )
+      auto alignedSize = []( size_t bytes ) {
+         return ( bytes + cAlignment - 1 ) & ~( cAlignment - 1 );
+      };
+
+      const PointStandardizedFieldsAvailable &fields = data3D.pointFields;
+
+      size_t totalBytes = 0;
+
+      auto addField = [&]( bool present, size_t elementSize ) {
+         if ( present )
+         {
+            totalBytes += alignedSize( elementSize * pointCount );
+         }
+      };
+
+      addField( fields.cartesianXField, sizeof( COORDTYPE ) );
+      addField( fields.cartesianYField, sizeof( COORDTYPE ) );
+      addField( fields.cartesianZField, sizeof( COORDTYPE ) );
+      addField( fields.cartesianInvalidStateField, sizeof( int8_t ) );
+
+      addField( fields.intensityField, sizeof( double ) );
+      addField( fields.isIntensityInvalidField, sizeof( int8_t ) );
+
+      addField( fields.colorRedField, sizeof( uint16_t ) );
+      addField( fields.colorGreenField, sizeof( uint16_t ) );
+      addField( fields.colorBlueField, sizeof( uint16_t ) );
+      addField( fields.isColorInvalidField, sizeof( int8_t ) );
+
+      addField( fields.sphericalRangeField, sizeof( COORDTYPE ) );
+      addField( fields.sphericalAzimuthField, sizeof( COORDTYPE ) );
+      addField( fields.sphericalElevationField, sizeof( COORDTYPE ) );
+      addField( fields.sphericalInvalidStateField, sizeof( int8_t ) );
+
+      addField( fields.rowIndexField, sizeof( int32_t ) );
+      addField( fields.columnIndexField, sizeof( int32_t ) );
+
+      addField( fields.returnIndexField, sizeof( int8_t ) );
+      addField( fields.returnCountField, sizeof( int8_t ) );
+
+      addField( fields.timeStampField, sizeof( double ) );
+      addField( fields.isTimeStampInvalidField, sizeof( int8_t ) );
+
+      addField( fields.normalXField, sizeof( float ) );
+      addField( fields.normalYField, sizeof( float ) );
+      addField( fields.normalZField, sizeof( float ) );
+
+      if ( totalBytes == 0 )
       {
-         normalZ = new float[cPointCount];
+         return 0;
       }
+
+      // The slab over-allocates by cAlignment - 1 bytes so its start can be aligned
+      return totalBytes + cAlignment - 1;
+   }
+
+   /// @private
+   /// Clears the field flags in data3D.pointFields which are not set in selectedFields, so only
+   /// the requested subset gets buffers and bytestream registrations.
+   static Data3D &_applyFieldSelection( Data3D &data3D,
+                                        const PointStandardizedFieldsAvailable &selectedFields )
+   {
+      PointStandardizedFieldsAvailable &fields = data3D.pointFields;
+
+      fields.cartesianXField &= selectedFields.cartesianXField;
+      fields.cartesianYField &= selectedFields.cartesianYField;
+      fields.cartesianZField &= selectedFields.cartesianZField;
+      fields.cartesianInvalidStateField &= selectedFields.cartesianInvalidStateField;
+
+      fields.sphericalRangeField &= selectedFields.sphericalRangeField;
+      fields.sphericalAzimuthField &= selectedFields.sphericalAzimuthField;
+      fields.sphericalElevationField &= selectedFields.sphericalElevationField;
+      fields.sphericalInvalidStateField &= selectedFields.sphericalInvalidStateField;
+
+      fields.rowIndexField &= selectedFields.rowIndexField;
+      fields.columnIndexField &= selectedFields.columnIndexField;
+
+      fields.returnIndexField &= selectedFields.returnIndexField;
+      fields.returnCountField &= selectedFields.returnCountField;
+
+      fields.timeStampField &= selectedFields.timeStampField;
+      fields.isTimeStampInvalidField &= selectedFields.isTimeStampInvalidField;
+
+      fields.intensityField &= selectedFields.intensityField;
+      fields.isIntensityInvalidField &= selectedFields.isIntensityInvalidField;
+
+      fields.colorRedField &= selectedFields.colorRedField;
+      fields.colorGreenField &= selectedFields.colorGreenField;
+      fields.colorBlueField &= selectedFields.colorBlueField;
+      fields.isColorInvalidField &= selectedFields.isColorInvalidField;
+
+      fields.normalXField &= selectedFields.normalXField;
+      fields.normalYField &= selectedFields.normalYField;
+      fields.normalZField &= selectedFields.normalZField;
+
+      return data3D;
+   }
+
+   template <typename COORDTYPE>
+   Data3DPointsData_t<COORDTYPE>::Data3DPointsData_t(
+      Data3D &data3D, const PointStandardizedFieldsAvailable &selectedFields ) :
+      Data3DPointsData_t( _applyFieldSelection( data3D, selectedFields ) )
+   {
    }
 
    template <typename COORDTYPE> Data3DPointsData_t<COORDTYPE>::~Data3DPointsData_t()
    {
       static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
 
-      if ( !_selfAllocated )
+      if ( _selfAllocated )
       {
-         return;
+         // All self-allocated field arrays live in the one slab
+         _freeBuffer();
       }
+   }
 
-      delete[] cartesianX;
-      delete[] cartesianY;
-      delete[] cartesianZ;
-      delete[] cartesianInvalidState;
+   template <typename COORDTYPE>
+   Data3DPointsData_t<COORDTYPE>::Data3DPointsData_t( Data3DPointsData_t &&other ) noexcept
+   {
+      // We start out empty, so the exchange leaves other empty and us with its buffers
+      _swap( other );
+   }
 
-      delete[] intensity;
-      delete[] isIntensityInvalid;
+   template <typename COORDTYPE>
+   Data3DPointsData_t<COORDTYPE> &Data3DPointsData_t<COORDTYPE>::operator=(
+      Data3DPointsData_t &&other ) noexcept
+   {
+      if ( this != &other )
+      {
+         if ( _selfAllocated )
+         {
+            _freeBuffer();
+         }
 
-      delete[] colorRed;
-      delete[] colorGreen;
-      delete[] colorBlue;
-      delete[] isColorInvalid;
+         // Reset to empty, then take other's members wholesale
+         _buffer = nullptr;
+         _bufferBytes = 0;
+         _selfAllocated = false;
+         _deallocate = PointBufferDeallocator();
 
-      delete[] sphericalRange;
-      delete[] sphericalAzimuth;
-      delete[] sphericalElevation;
-      delete[] sphericalInvalidState;
+         Data3DPointsData_t empty;
+
+         _swap( empty );
+         _swap( other );
+      }
+
+      return *this;
+   }
+
+   template <typename COORDTYPE>
+   void Data3DPointsData_t<COORDTYPE>::_swap( Data3DPointsData_t &other ) noexcept
+   {
+      std::swap( cartesianX, other.cartesianX );
+      std::swap( cartesianY, other.cartesianY );
+      std::swap( cartesianZ, other.cartesianZ );
+      std::swap( cartesianInvalidState, other.cartesianInvalidState );
 
-      delete[] rowIndex;
-      delete[] columnIndex;
+      std::swap( intensity, other.intensity );
+      std::swap( isIntensityInvalid, other.isIntensityInvalid );
 
-      delete[] returnIndex;
-      delete[] returnCount;
+      std::swap( colorRed, other.colorRed );
+      std::swap( colorGreen, other.colorGreen );
+      std::swap( colorBlue, other.colorBlue );
+      std::swap( isColorInvalid, other.isColorInvalid );
 
-      delete[] timeStamp;
-      delete[] isTimeStampInvalid;
+      std::swap( sphericalRange, other.sphericalRange );
+      std::swap( sphericalAzimuth, other.sphericalAzimuth );
+      std::swap( sphericalElevation, other.sphericalElevation );
+      std::swap( sphericalInvalidState, other.sphericalInvalidState );
 
-      delete[] normalX;
-      delete[] normalY;
-      delete[] normalZ;
+      std::swap( rowIndex, other.rowIndex );
+      std::swap( columnIndex, other.columnIndex );
 
-      // Set them all to nullptr.
-      *this = Data3DPointsData_t<COORDTYPE>();
+      std::swap( returnIndex, other.returnIndex );
+      std::swap( returnCount, other.returnCount );
+
+      std::swap( timeStamp, other.timeStamp );
+      std::swap( isTimeStampInvalid, other.isTimeStampInvalid );
+
+      std::swap( normalX, other.normalX );
+      std::swap( normalY, other.normalY );
+      std::swap( normalZ, other.normalZ );
+
+      std::swap( _selfAllocated, other._selfAllocated );
+      std::swap( _buffer, other._buffer );
+      std::swap( _bufferBytes, other._bufferBytes );
+      std::swap( _deallocate, other._deallocate );
+   }
+
+   template <typename COORDTYPE> void Data3DPointsData_t<COORDTYPE>::_freeBuffer() noexcept
+   {
+      if ( _buffer == nullptr )
+      {
+         return;
+      }
+
+      if ( _deallocate )
+      {
+         _deallocate( _buffer );
+      }
+      else
+      {
+         delete[] _buffer;
+      }
    }
 
 #if defined( _MSC_VER )
@@ -26,7 +26,12 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "E57SimpleReader.h"
+#include "Executor.h"
 #include "ReaderImpl.h"
 
 namespace e57
@@ -56,6 +61,15 @@ namespace e57
       return impl_->GetE57Root( fileHeader );
    }
 
+   /*!
+   @brief Returns runtime statistics accumulated while reading this file
+   @return Returns the current statistics snapshot
+   */
+   ReaderStats Reader::GetStats() const
+   {
+      return impl_->GetStats();
+   }
+
    int64_t Reader::GetImage2DCount() const
    {
       return impl_->GetImage2DCount();
@@ -88,6 +102,15 @@ namespace e57
       return static_cast<int64_t>( read );
    }
 
+   bool Reader::ReadAllImages2D(
+      unsigned parallelism,
+      const std::function<bool( int64_t imageIndex, const Image2D &imageHeader,
+                                Image2DProjection imageProjection, Image2DType imageType,
+                                const std::vector<uint8_t> &imageData )> &callback ) const
+   {
+      return impl_->ReadAllImages2D( parallelism, callback );
+   }
+
    int64_t Reader::GetData3DCount() const
    {
       return impl_->GetData3DCount();
@@ -118,6 +141,12 @@ namespace e57
       return impl_->ReadData3D( dataIndex, data3DHeader );
    }
 
+   bool Reader::ReadAllData3DHeaders( unsigned parallelism,
+                                      std::vector<Data3D> &data3DHeaders ) const
+   {
+      return impl_->ReadAllData3DHeaders( parallelism, data3DHeaders );
+   }
+
    bool Reader::GetData3DSizes( int64_t dataIndex, int64_t &rowMax, int64_t &columnMax,
                                 int64_t &pointsSize, int64_t &groupsSize, int64_t &countSize,
                                 bool &bColumnIndex ) const
@@ -144,4 +173,170 @@ namespace e57
    {
       return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers );
    }
+
+   CompressedVectorReader Reader::SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                         const Data3DPointsFloat &buffers,
+                                                         size_t stride ) const
+   {
+      return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers, stride );
+   }
+
+   CompressedVectorReader Reader::SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                         const Data3DPointsDouble &buffers,
+                                                         size_t stride ) const
+   {
+      return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers, stride );
+   }
+
+   bool Reader::ReadData3DChunks(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DChunks( dataIndex, chunkSize, callback, selectedFields );
+   }
+
+   bool Reader::ReadData3DChunks(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DChunks( dataIndex, chunkSize, callback, selectedFields );
+   }
+
+   bool Reader::ReadData3DFiltered(
+      int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+      const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DFiltered( dataIndex, chunkSize, filterBounds, callback,
+                                        selectedFields );
+   }
+
+   bool Reader::ReadData3DFiltered(
+      int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+      const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DFiltered( dataIndex, chunkSize, filterBounds, callback,
+                                        selectedFields );
+   }
+
+   bool Reader::ReadData3DCompacted(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DCompacted( dataIndex, chunkSize, callback, selectedFields );
+   }
+
+   bool Reader::ReadData3DCompacted(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DCompacted( dataIndex, chunkSize, callback, selectedFields );
+   }
+
+   bool Reader::ReadData3DPredicated(
+      int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+      const std::function<bool( const Data3DPointsFloat &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DPredicated( dataIndex, chunkSize, predicates, callback,
+                                          selectedFields );
+   }
+
+   bool Reader::ReadData3DPredicated(
+      int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+      const std::function<bool( const Data3DPointsDouble &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadData3DPredicated( dataIndex, chunkSize, predicates, callback,
+                                          selectedFields );
+   }
+
+   bool Reader::ReadAllData3D(
+      unsigned parallelism, size_t chunkSize,
+      const std::function<bool( int64_t dataIndex, const Data3DPointsFloat &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadAllData3D( parallelism, chunkSize, callback, selectedFields );
+   }
+
+   bool Reader::ReadAllData3D( unsigned parallelism, size_t chunkSize,
+                               const std::function<bool( int64_t dataIndex,
+                                                         const Data3DPointsDouble &buffers,
+                                                         size_t count )> &callback,
+                               const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      return impl_->ReadAllData3D( parallelism, chunkSize, callback, selectedFields );
+   }
+
+   std::vector<ProjectFile> OpenProject( const std::vector<ustring> &paths,
+                                         const ReaderOptions &options, unsigned parallelism )
+   {
+      std::vector<ProjectFile> files( paths.size() );
+
+      for ( size_t i = 0; i < paths.size(); ++i )
+      {
+         files[i].path = paths[i];
+      }
+
+      if ( files.empty() )
+      {
+         return files;
+      }
+
+      if ( parallelism == 0 )
+      {
+         parallelism = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      parallelism =
+         static_cast<unsigned>( std::min( static_cast<size_t>( parallelism ), files.size() ) );
+
+      // Files are claimed from a shared counter so a few slow-parsing project files
+      // don't serialize behind each other on one worker
+      std::atomic<size_t> nextFile( 0 );
+
+      Executor::run( parallelism, [&]( unsigned /*workerIndex*/ ) {
+         for ( ;; )
+         {
+            const size_t fileIndex = nextFile.fetch_add( 1 );
+
+            if ( fileIndex >= files.size() )
+            {
+               break;
+            }
+
+            ProjectFile &file = files[fileIndex];
+
+            // A failed file must not disturb the rest of the project
+            try
+            {
+               file.reader = std::make_shared<Reader>( file.path, options );
+
+               if ( !file.reader->IsOpen() )
+               {
+                  file.reader.reset();
+                  file.error = "open failed";
+               }
+            }
+            catch ( E57Exception &ex )
+            {
+               file.reader.reset();
+               file.error = ex.errorStr() + " (" + ex.context() + ")";
+            }
+            catch ( std::exception &ex )
+            {
+               file.reader.reset();
+               file.error = ex.what();
+            }
+         }
+      } );
+
+      return files;
+   }
 } // end namespace e57
@@ -39,12 +39,22 @@ namespace
    ///   - spherical points
    ///   - intensity
    ///   - time stamps
+   ///   - row/column/return index maxima (tightened so the prototype uses minimal bit
+   ///     widths instead of the 32-bit/8-bit worst case of the defaults)
    template <typename COORDTYPE>
    void _fillMinMaxData( e57::Data3D &ioData3DHeader,
-                         const e57::Data3DPointsData_t<COORDTYPE> &inBuffers )
+                         const e57::Data3DPointsData_t<COORDTYPE> &inBuffers, size_t stride = 0 )
    {
       static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
 
+      // stride == 0 means tightly packed per-field arrays; otherwise the pointers
+      // address fields inside interleaved records stride bytes apart.
+      auto fieldAt = [stride]( const auto *p, size_t i ) {
+         return ( stride == 0 ) ? p[i]
+                                : *reinterpret_cast<decltype( p )>(
+                                     reinterpret_cast<const char *>( p ) + ( i * stride ) );
+      };
+
       auto &pointFields = ioData3DHeader.pointFields;
 
       constexpr COORDTYPE cMin = std::numeric_limits<COORDTYPE>::lowest();
@@ -90,18 +100,40 @@ namespace
          ( pointFields.timeNodeType == e57::NumericalNodeType::ScaledInteger ) &&
          ( pointFields.timeMinimum == cMin ) && ( pointFields.timeMaximum == cMax );
 
+      // IF the row/column/return index fields are active
+      // AND the caller left their maxima at the all-ones defaults
+      // THEN tighten them from the points, so the prototype integer nodes get minimal
+      // bit widths (a 2000-column scan then costs 11 bits per columnIndex, not 32)
+      uint32_t rowIndexMaximum = 0;
+      uint32_t columnIndexMaximum = 0;
+      uint8_t returnMaximum = 0;
+
+      const bool writeRowIndex = pointFields.rowIndexField &&
+                                 ( pointFields.rowIndexMaximum == UINT32_MAX ) &&
+                                 ( inBuffers.rowIndex != nullptr );
+
+      const bool writeColumnIndex = pointFields.columnIndexField &&
+                                    ( pointFields.columnIndexMaximum == UINT32_MAX ) &&
+                                    ( inBuffers.columnIndex != nullptr );
+
+      const bool writeReturnMax =
+         ( pointFields.returnIndexField || pointFields.returnCountField ) &&
+         ( pointFields.returnMaximum == UINT8_MAX ) &&
+         ( !pointFields.returnIndexField || ( inBuffers.returnIndex != nullptr ) ) &&
+         ( !pointFields.returnCountField || ( inBuffers.returnCount != nullptr ) );
+
       // Now run through the points and set the things we need to
       for ( size_t i = 0; i < ioData3DHeader.pointCount; ++i )
       {
          if ( writePointRange && pointFields.cartesianXField )
          {
-            pointRangeMinimum = std::min( inBuffers.cartesianX[i], pointRangeMinimum );
-            pointRangeMinimum = std::min( inBuffers.cartesianY[i], pointRangeMinimum );
-            pointRangeMinimum = std::min( inBuffers.cartesianZ[i], pointRangeMinimum );
+            pointRangeMinimum = std::min( fieldAt( inBuffers.cartesianX, i ), pointRangeMinimum );
+            pointRangeMinimum = std::min( fieldAt( inBuffers.cartesianY, i ), pointRangeMinimum );
+            pointRangeMinimum = std::min( fieldAt( inBuffers.cartesianZ, i ), pointRangeMinimum );
 
-            pointRangeMaximum = std::max( inBuffers.cartesianX[i], pointRangeMaximum );
-            pointRangeMaximum = std::max( inBuffers.cartesianY[i], pointRangeMaximum );
-            pointRangeMaximum = std::max( inBuffers.cartesianZ[i], pointRangeMaximum );
+            pointRangeMaximum = std::max( fieldAt( inBuffers.cartesianX, i ), pointRangeMaximum );
+            pointRangeMaximum = std::max( fieldAt( inBuffers.cartesianY, i ), pointRangeMaximum );
+            pointRangeMaximum = std::max( fieldAt( inBuffers.cartesianZ, i ), pointRangeMaximum );
          }
 
          if ( writePointRange && pointFields.sphericalRangeField )
@@ -109,29 +141,56 @@ namespace
             // Note that the writer code uses pointRangeMinimum/pointRangeMaximum
             // (see WriterImpl::NewData3D()) instead of using the sphericalBounds which has
             // rangeMinimum and rangeMaximum.
-            pointRangeMinimum = std::min( inBuffers.sphericalRange[i], pointRangeMinimum );
-            pointRangeMaximum = std::max( inBuffers.sphericalRange[i], pointRangeMaximum );
+            pointRangeMinimum = std::min( fieldAt( inBuffers.sphericalRange, i ), pointRangeMinimum );
+            pointRangeMaximum = std::max( fieldAt( inBuffers.sphericalRange, i ), pointRangeMaximum );
          }
 
          if ( writeAngle )
          {
-            angleMinimum = std::min( inBuffers.sphericalAzimuth[i], angleMinimum );
-            angleMinimum = std::min( inBuffers.sphericalElevation[i], angleMinimum );
+            angleMinimum = std::min( fieldAt( inBuffers.sphericalAzimuth, i ), angleMinimum );
+            angleMinimum = std::min( fieldAt( inBuffers.sphericalElevation, i ), angleMinimum );
 
-            angleMaximum = std::max( inBuffers.sphericalAzimuth[i], angleMaximum );
-            angleMaximum = std::max( inBuffers.sphericalElevation[i], angleMaximum );
+            angleMaximum = std::max( fieldAt( inBuffers.sphericalAzimuth, i ), angleMaximum );
+            angleMaximum = std::max( fieldAt( inBuffers.sphericalElevation, i ), angleMaximum );
          }
 
          if ( writeIntensity )
          {
-            intensityMinimum = std::min( inBuffers.intensity[i], intensityMinimum );
-            intensityMaximum = std::max( inBuffers.intensity[i], intensityMaximum );
+            intensityMinimum = std::min( fieldAt( inBuffers.intensity, i ), intensityMinimum );
+            intensityMaximum = std::max( fieldAt( inBuffers.intensity, i ), intensityMaximum );
          }
 
          if ( writeTimeStamp )
          {
-            timeMinimum = std::min( inBuffers.timeStamp[i], timeMinimum );
-            timeMaximum = std::max( inBuffers.timeStamp[i], timeMaximum );
+            timeMinimum = std::min( fieldAt( inBuffers.timeStamp, i ), timeMinimum );
+            timeMaximum = std::max( fieldAt( inBuffers.timeStamp, i ), timeMaximum );
+         }
+
+         if ( writeRowIndex )
+         {
+            rowIndexMaximum = std::max(
+               static_cast<uint32_t>( fieldAt( inBuffers.rowIndex, i ) ), rowIndexMaximum );
+         }
+
+         if ( writeColumnIndex )
+         {
+            columnIndexMaximum = std::max(
+               static_cast<uint32_t>( fieldAt( inBuffers.columnIndex, i ) ), columnIndexMaximum );
+         }
+
+         if ( writeReturnMax )
+         {
+            if ( pointFields.returnIndexField )
+            {
+               returnMaximum = std::max(
+                  static_cast<uint8_t>( fieldAt( inBuffers.returnIndex, i ) ), returnMaximum );
+            }
+
+            if ( pointFields.returnCountField )
+            {
+               returnMaximum = std::max(
+                  static_cast<uint8_t>( fieldAt( inBuffers.returnCount, i ) ), returnMaximum );
+            }
          }
       }
 
@@ -158,11 +217,26 @@ namespace
          pointFields.timeMinimum = timeMinimum;
          pointFields.timeMaximum = timeMaximum;
       }
+
+      if ( writeRowIndex )
+      {
+         pointFields.rowIndexMaximum = rowIndexMaximum;
+      }
+
+      if ( writeColumnIndex )
+      {
+         pointFields.columnIndexMaximum = columnIndexMaximum;
+      }
+
+      if ( writeReturnMax )
+      {
+         pointFields.returnMaximum = returnMaximum;
+      }
    }
    template void _fillMinMaxData( e57::Data3D &ioData3DHeader,
-                                  const e57::Data3DPointsFloat &inBuffers );
+                                  const e57::Data3DPointsFloat &inBuffers, size_t stride );
    template void _fillMinMaxData( e57::Data3D &ioData3DHeader,
-                                  const e57::Data3DPointsDouble &inBuffers );
+                                  const e57::Data3DPointsDouble &inBuffers, size_t stride );
 }
 
 namespace e57
@@ -172,6 +246,11 @@ namespace e57
    {
    }
 
+   Writer::Writer( std::vector<char> &outBuffer, const WriterOptions &options ) :
+      impl_( new WriterImpl( outBuffer, options ) )
+   {
+   }
+
    // Note that this constructor is deprecated (see header).
    Writer::Writer( const ustring &filePath, const ustring &coordinateMetadata ) :
       Writer( filePath, WriterOptions{ {}, coordinateMetadata } )
@@ -251,11 +330,65 @@ namespace e57
       return scanIndex;
    }
 
+   int64_t Writer::WriteData3DData( Data3D &data3DHeader, const Data3DPointsFloat &buffers,
+                                    size_t stride )
+   {
+      _fillMinMaxData( data3DHeader, buffers, stride );
+
+      const int64_t scanIndex = impl_->NewData3D( data3DHeader );
+
+      e57::CompressedVectorWriter dataWriter =
+         impl_->SetUpData3DPointsData( scanIndex, data3DHeader.pointCount, buffers, stride );
+
+      dataWriter.write( data3DHeader.pointCount );
+      dataWriter.close();
+
+      return scanIndex;
+   }
+
+   int64_t Writer::WriteData3DData( Data3D &data3DHeader, const Data3DPointsDouble &buffers,
+                                    size_t stride )
+   {
+      _fillMinMaxData( data3DHeader, buffers, stride );
+
+      const int64_t scanIndex = impl_->NewData3D( data3DHeader );
+
+      e57::CompressedVectorWriter dataWriter =
+         impl_->SetUpData3DPointsData( scanIndex, data3DHeader.pointCount, buffers, stride );
+
+      dataWriter.write( data3DHeader.pointCount );
+      dataWriter.close();
+
+      return scanIndex;
+   }
+
    int64_t Writer::NewData3D( Data3D &data3DHeader )
    {
       return impl_->NewData3D( data3DHeader );
    }
 
+   int64_t Writer::BeginData3DData( Data3D &data3DHeader, const Data3DPointsFloat &chunkBuffers,
+                                    size_t chunkCapacity )
+   {
+      return impl_->BeginData3DData( data3DHeader, chunkBuffers, chunkCapacity );
+   }
+
+   int64_t Writer::BeginData3DData( Data3D &data3DHeader, const Data3DPointsDouble &chunkBuffers,
+                                    size_t chunkCapacity )
+   {
+      return impl_->BeginData3DData( data3DHeader, chunkBuffers, chunkCapacity );
+   }
+
+   bool Writer::AppendData3DPoints( size_t count )
+   {
+      return impl_->AppendData3DPoints( count );
+   }
+
+   int64_t Writer::EndData3DData()
+   {
+      return impl_->EndData3DData();
+   }
+
    CompressedVectorWriter Writer::SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
                                                          const Data3DPointsFloat &buffers )
    {
@@ -268,6 +401,20 @@ namespace e57
       return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers );
    }
 
+   CompressedVectorWriter Writer::SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                         const Data3DPointsFloat &buffers,
+                                                         size_t stride )
+   {
+      return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers, stride );
+   }
+
+   CompressedVectorWriter Writer::SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                         const Data3DPointsDouble &buffers,
+                                                         size_t stride )
+   {
+      return impl_->SetUpData3DPointsData( dataIndex, pointCount, buffers, stride );
+   }
+
    bool Writer::WriteData3DGroupsData( int64_t dataIndex, size_t groupCount,
                                        int64_t *idElementValue, int64_t *startPointIndex,
                                        int64_t *pointCount )
@@ -33,7 +33,6 @@
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 
 #include <xercesc/util/BinInputStream.hpp>
-#include <xercesc/util/TransService.hpp>
 
 #include "BlobNodeImpl.h"
 #include "CheckedFile.h"
@@ -77,6 +76,35 @@ static const XMLCh att_recordCount[] = { chLatin_r, chLatin_e, chLatin_c, chLati
                                          chLatin_r, chLatin_d, chLatin_C, chLatin_o,
                                          chLatin_u, chLatin_n, chLatin_t, chNull };
 
+// define convenient constants for the element type names, so the per-element type
+// dispatch can compare UTF-16 directly instead of transcoding every type attribute
+static const XMLCh type_Integer[] = { chLatin_I, chLatin_n, chLatin_t, chLatin_e,
+                                      chLatin_g, chLatin_e, chLatin_r, chNull };
+static const XMLCh type_ScaledInteger[] = { chLatin_S, chLatin_c, chLatin_a, chLatin_l, chLatin_e,
+                                            chLatin_d, chLatin_I, chLatin_n, chLatin_t, chLatin_e,
+                                            chLatin_g, chLatin_e, chLatin_r, chNull };
+static const XMLCh type_Float[] = { chLatin_F, chLatin_l, chLatin_o, chLatin_a, chLatin_t, chNull };
+static const XMLCh type_String[] = { chLatin_S, chLatin_t, chLatin_r, chLatin_i,
+                                     chLatin_n, chLatin_g, chNull };
+static const XMLCh type_Blob[] = { chLatin_B, chLatin_l, chLatin_o, chLatin_b, chNull };
+static const XMLCh type_Structure[] = { chLatin_S, chLatin_t, chLatin_r, chLatin_u, chLatin_c,
+                                        chLatin_t, chLatin_u, chLatin_r, chLatin_e, chNull };
+static const XMLCh type_Vector[] = { chLatin_V, chLatin_e, chLatin_c, chLatin_t,
+                                     chLatin_o, chLatin_r, chNull };
+static const XMLCh type_CompressedVector[] = { chLatin_C, chLatin_o, chLatin_m, chLatin_p,
+                                               chLatin_r, chLatin_e, chLatin_s, chLatin_s,
+                                               chLatin_e, chLatin_d, chLatin_V, chLatin_e,
+                                               chLatin_c, chLatin_t, chLatin_o, chLatin_r,
+                                               chNull };
+
+// element names that get compared per-element
+static const XMLCh elt_e57Root[] = { chLatin_e, chDigit_5, chDigit_7, chLatin_R,
+                                     chLatin_o, chLatin_o, chLatin_t, chNull };
+static const XMLCh elt_prototype[] = { chLatin_p, chLatin_r, chLatin_o, chLatin_t, chLatin_o,
+                                       chLatin_t, chLatin_y, chLatin_p, chLatin_e, chNull };
+static const XMLCh elt_codecs[] = { chLatin_c, chLatin_o, chLatin_d, chLatin_e,
+                                    chLatin_c, chLatin_s, chNull };
+
 static_assert( std::is_same<size_t, XMLSize_t>::value,
                "size_t and XMLSize_t should be the same type" );
 
@@ -93,31 +121,86 @@ namespace
 #endif
    }
 
+   /// Append the UTF-8 encoding of a UTF-16 buffer.  Converting directly is much cheaper
+   /// than a Xerces TranscodeToStr, which heap-allocates a transcoder plus a result buffer
+   /// on every call; the inner run loop also keeps the overwhelmingly common case (ASCII
+   /// names and numbers) on a straight-line byte copy.
+   void appendUTF8( ustring &out, const XMLCh *chars, size_t length )
+   {
+      size_t i = 0;
+
+      while ( i < length )
+      {
+         // Fast path: copy whole runs of ASCII in one resize
+         const size_t runStart = i;
+         while ( i < length && chars[i] < 0x80 )
+         {
+            ++i;
+         }
+
+         if ( i > runStart )
+         {
+            size_t outPos = out.length();
+            out.resize( outPos + ( i - runStart ) );
+            for ( size_t j = runStart; j < i; ++j )
+            {
+               out[outPos++] = static_cast<char>( chars[j] );
+            }
+            continue;
+         }
+
+         uint32_t codePoint = chars[i++];
+
+         // Combine a surrogate pair into the code point it encodes
+         if ( codePoint >= 0xD800 && codePoint <= 0xDBFF && i < length )
+         {
+            const uint32_t low = chars[i];
+            if ( low >= 0xDC00 && low <= 0xDFFF )
+            {
+               codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+               ++i;
+            }
+         }
+
+         if ( codePoint < 0x800 )
+         {
+            out += static_cast<char>( 0xC0 | ( codePoint >> 6 ) );
+            out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+         }
+         else if ( codePoint < 0x10000 )
+         {
+            out += static_cast<char>( 0xE0 | ( codePoint >> 12 ) );
+            out += static_cast<char>( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+         }
+         else
+         {
+            out += static_cast<char>( 0xF0 | ( codePoint >> 18 ) );
+            out += static_cast<char>( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+            out += static_cast<char>( 0x80 | ( codePoint & 0x3F ) );
+         }
+      }
+   }
+
    ustring toUString( const XMLCh *const xml_str )
    {
       ustring u_str;
       if ( ( xml_str != nullptr ) && *xml_str )
       {
-         TranscodeToStr UTF8Transcoder( xml_str, "UTF-8" );
-         u_str = ustring( reinterpret_cast<const char *>( UTF8Transcoder.str() ) );
+         appendUTF8( u_str, xml_str, XMLString::stringLen( xml_str ) );
       }
       return ( u_str );
    }
 
    ustring lookupAttribute( const Attributes &attributes, const XMLCh *attribute_name )
    {
-      XMLSize_t attr_index;
-      if ( !attributes.getIndex( attribute_name, attr_index ) )
+      const XMLCh *value = attributes.getValue( attribute_name );
+      if ( value == nullptr )
       {
          throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=" + toUString( attribute_name ) );
       }
-      return ( toUString( attributes.getValue( attr_index ) ) );
-   }
-
-   bool isAttributeDefined( const Attributes &attributes, const XMLCh *attribute_name )
-   {
-      XMLSize_t attr_index;
-      return ( attributes.getIndex( attribute_name, attr_index ) );
+      return ( toUString( value ) );
    }
 }
 
@@ -320,6 +403,25 @@ void E57XmlParser::parse( InputSource &inputSource )
    xmlReader->parse( inputSource );
 }
 
+const ustring &E57XmlParser::cachedUString( const XMLCh *name )
+{
+   for ( const auto &entry : nameCache_ )
+   {
+      if ( XMLString::equals( entry.first.data(), name ) )
+      {
+         return entry.second;
+      }
+   }
+
+   // First time we see this name: transcode it and remember it (with its terminator,
+   // so the cached key can be compared directly)
+   std::vector<XMLCh> key( name, name + XMLString::stringLen( name ) + 1 );
+
+   nameCache_.emplace_back( std::move( key ), toUString( name ) );
+
+   return nameCache_.back().second;
+}
+
 void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const localName,
                                  const XMLCh *const qName, const Attributes &attributes )
 {
@@ -341,14 +443,19 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
                 << std::endl;
    }
 #endif
-   // Get Type attribute
-   ustring node_type = lookupAttribute( attributes, att_type );
+   // Get Type attribute.  Compare it as UTF-16 below, so the once-per-element type
+   // dispatch doesn't transcode (and allocate) anything.
+   const XMLCh *node_type = attributes.getValue( att_type );
+   if ( node_type == nullptr )
+   {
+      throw E57_EXCEPTION2( ErrorBadXMLFormat, "attributeName=" + toUString( att_type ) );
+   }
 
    //??? check to make sure not in primitive type (can only nest inside compound types).
 
    ParseInfo pi;
 
-   if ( node_type == "Integer" )
+   if ( XMLString::equals( node_type, type_Integer ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a Integer" << std::endl;
@@ -356,11 +463,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       //??? check validity of numeric strings
       pi.nodeType = TypeInteger;
 
-      if ( isAttributeDefined( attributes, att_minimum ) )
+      if ( const XMLCh *minimum_str = attributes.getValue( att_minimum ) )
       {
-         ustring minimum_str = lookupAttribute( attributes, att_minimum );
-
-         pi.minimum = convertStrToLL( minimum_str );
+         pi.minimum = convertStrToLL( toUString( minimum_str ) );
       }
       else
       {
@@ -368,11 +473,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          pi.minimum = INT64_MIN;
       }
 
-      if ( isAttributeDefined( attributes, att_maximum ) )
+      if ( const XMLCh *maximum_str = attributes.getValue( att_maximum ) )
       {
-         ustring maximum_str = lookupAttribute( attributes, att_maximum );
-
-         pi.maximum = convertStrToLL( maximum_str );
+         pi.maximum = convertStrToLL( toUString( maximum_str ) );
       }
       else
       {
@@ -382,7 +485,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
 
       stack_.push( pi );
    }
-   else if ( node_type == "ScaledInteger" )
+   else if ( XMLString::equals( node_type, type_ScaledInteger ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a ScaledInteger" << std::endl;
@@ -390,11 +493,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       pi.nodeType = TypeScaledInteger;
 
       //??? check validity of numeric strings
-      if ( isAttributeDefined( attributes, att_minimum ) )
+      if ( const XMLCh *minimum_str = attributes.getValue( att_minimum ) )
       {
-         ustring minimum_str = lookupAttribute( attributes, att_minimum );
-
-         pi.minimum = convertStrToLL( minimum_str );
+         pi.minimum = convertStrToLL( toUString( minimum_str ) );
       }
       else
       {
@@ -402,11 +503,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          pi.minimum = INT64_MIN;
       }
 
-      if ( isAttributeDefined( attributes, att_maximum ) )
+      if ( const XMLCh *maximum_str = attributes.getValue( att_maximum ) )
       {
-         ustring maximum_str = lookupAttribute( attributes, att_maximum );
-
-         pi.maximum = convertStrToLL( maximum_str );
+         pi.maximum = convertStrToLL( toUString( maximum_str ) );
       }
       else
       {
@@ -414,10 +513,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          pi.maximum = INT64_MAX;
       }
 
-      if ( isAttributeDefined( attributes, att_scale ) )
+      if ( const XMLCh *scale_str = attributes.getValue( att_scale ) )
       {
-         ustring scale_str = lookupAttribute( attributes, att_scale );
-         pi.scale = strToDouble( scale_str ); //??? use exact rounding library
+         pi.scale = strToDouble( toUString( scale_str ) ); //??? use exact rounding library
       }
       else
       {
@@ -425,10 +523,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          pi.scale = 1.0;
       }
 
-      if ( isAttributeDefined( attributes, att_offset ) )
+      if ( const XMLCh *offset_str = attributes.getValue( att_offset ) )
       {
-         ustring offset_str = lookupAttribute( attributes, att_offset );
-         pi.offset = strToDouble( offset_str ); //??? use exact rounding library
+         pi.offset = strToDouble( toUString( offset_str ) ); //??? use exact rounding library
       }
       else
       {
@@ -438,14 +535,14 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
 
       stack_.push( pi );
    }
-   else if ( node_type == "Float" )
+   else if ( XMLString::equals( node_type, type_Float ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a Float" << std::endl;
 #endif
       pi.nodeType = TypeFloat;
 
-      if ( isAttributeDefined( attributes, att_precision ) )
+      if ( attributes.getValue( att_precision ) != nullptr )
       {
          ustring precision_str = lookupAttribute( attributes, att_precision );
          if ( precision_str == "single" )
@@ -471,10 +568,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          pi.precision = PrecisionDouble;
       }
 
-      if ( isAttributeDefined( attributes, att_minimum ) )
+      if ( const XMLCh *minimum_str = attributes.getValue( att_minimum ) )
       {
-         ustring minimum_str = lookupAttribute( attributes, att_minimum );
-         pi.floatMinimum = strToDouble( minimum_str ); //??? use exact rounding library
+         pi.floatMinimum = strToDouble( toUString( minimum_str ) ); //??? use exact rounding library
       }
       else
       {
@@ -489,10 +585,9 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
          }
       }
 
-      if ( isAttributeDefined( attributes, att_maximum ) )
+      if ( const XMLCh *maximum_str = attributes.getValue( att_maximum ) )
       {
-         ustring maximum_str = lookupAttribute( attributes, att_maximum );
-         pi.floatMaximum = strToDouble( maximum_str ); //??? use exact rounding library
+         pi.floatMaximum = strToDouble( toUString( maximum_str ) ); //??? use exact rounding library
       }
       else
       {
@@ -509,7 +604,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
 
       stack_.push( pi );
    }
-   else if ( node_type == "String" )
+   else if ( XMLString::equals( node_type, type_String ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a String" << std::endl;
@@ -518,7 +613,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
 
       stack_.push( pi );
    }
-   else if ( node_type == "Blob" )
+   else if ( XMLString::equals( node_type, type_Blob ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a Blob" << std::endl;
@@ -539,7 +634,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
 
       stack_.push( pi );
    }
-   else if ( node_type == "Structure" )
+   else if ( XMLString::equals( node_type, type_Structure ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a Structure" << std::endl;
@@ -547,7 +642,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       pi.nodeType = TypeStructure;
 
       // Read name space decls, if e57Root element
-      if ( toUString( localName ) == "e57Root" )
+      if ( XMLString::equals( localName, elt_e57Root ) )
       {
          // Search attributes for namespace declarations (only allowed in E57Root structure)
          bool gotDefault = false;
@@ -588,30 +683,28 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       }
 
       // Create container now, so can hold children
-      std::shared_ptr<StructureNodeImpl> s_ni( new StructureNodeImpl( imf_ ) );
+      std::shared_ptr<StructureNodeImpl> s_ni = makeNode<StructureNodeImpl>( imf_ );
       pi.container_ni = s_ni;
 
       // After have Structure, check again if E57Root, if so mark attached so all children will be
       // attached when added
-      if ( toUString( localName ) == "e57Root" )
+      if ( XMLString::equals( localName, elt_e57Root ) )
       {
          s_ni->setAttachedRecursive();
       }
 
       stack_.push( pi );
    }
-   else if ( node_type == "Vector" )
+   else if ( XMLString::equals( node_type, type_Vector ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a Vector" << std::endl;
 #endif
       pi.nodeType = TypeVector;
 
-      if ( isAttributeDefined( attributes, att_allowHeterogeneousChildren ) )
+      if ( const XMLCh *allowHetero_str = attributes.getValue( att_allowHeterogeneousChildren ) )
       {
-         ustring allowHetero_str = lookupAttribute( attributes, att_allowHeterogeneousChildren );
-
-         int64_t i64 = convertStrToLL( allowHetero_str );
+         int64_t i64 = convertStrToLL( toUString( allowHetero_str ) );
 
          if ( i64 == 0 )
          {
@@ -637,13 +730,21 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       }
 
       // Create container now, so can hold children
-      std::shared_ptr<VectorNodeImpl> v_ni(
-         new VectorNodeImpl( imf_, pi.allowHeterogeneousChildren ) );
+      std::shared_ptr<VectorNodeImpl> v_ni =
+         makeNode<VectorNodeImpl>( imf_, pi.allowHeterogeneousChildren );
       pi.container_ni = v_ni;
 
+      // During an async open, remember the root-level /data3D vector so each scan can
+      // be reported as it completes (stack_ holds only the root element here)
+      if ( imf_->scanDiscoveredCallback_ && ( stack_.size() == 1 ) &&
+           ( toUString( qName ) == "data3D" ) )
+      {
+         data3DVector_ni_ = v_ni;
+      }
+
       stack_.push( pi );
    }
-   else if ( node_type == "CompressedVector" )
+   else if ( XMLString::equals( node_type, type_CompressedVector ) )
    {
 #ifdef E57_VERBOSE
       std::cout << "got a CompressedVector" << std::endl;
@@ -661,7 +762,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
       pi.recordCount = convertStrToLL( recordCount_str );
 
       // Create container now, so can hold children
-      std::shared_ptr<CompressedVectorNodeImpl> cv_ni( new CompressedVectorNodeImpl( imf_ ) );
+      std::shared_ptr<CompressedVectorNodeImpl> cv_ni = makeNode<CompressedVectorNodeImpl>( imf_ );
       cv_ni->setRecordCount( pi.recordCount );
       cv_ni->setBinarySectionLogicalStart(
          imf_->file_->physicalToLogical( pi.fileOffset ) ); //??? what if file_ is NULL?
@@ -672,7 +773,7 @@ void E57XmlParser::startElement( const XMLCh *const uri, const XMLCh *const loca
    else
    {
       throw E57_EXCEPTION2( ErrorBadXMLFormat,
-                            "nodeType=" + node_type + " fileName=" + imf_->fileName() +
+                            "nodeType=" + toUString( node_type ) + " fileName=" + imf_->fileName() +
                                " uri=" + toUString( uri ) + " localName=" + toUString( localName ) +
                                " qName=" + toUString( qName ) );
    }
@@ -723,8 +824,8 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
             foundValue = true;
          }
 
-         std::shared_ptr<IntegerNodeImpl> i_ni(
-            new IntegerNodeImpl( imf_, intValue, pi.minimum, pi.maximum ) );
+         std::shared_ptr<IntegerNodeImpl> i_ni =
+            makeNode<IntegerNodeImpl>( imf_, intValue, pi.minimum, pi.maximum );
 
          if ( foundValue )
          {
@@ -746,8 +847,8 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
             foundValue = true;
          }
 
-         std::shared_ptr<ScaledIntegerNodeImpl> si_ni( new ScaledIntegerNodeImpl(
-            imf_, intValue, pi.minimum, pi.maximum, pi.scale, pi.offset ) );
+         std::shared_ptr<ScaledIntegerNodeImpl> si_ni = makeNode<ScaledIntegerNodeImpl>(
+            imf_, intValue, pi.minimum, pi.maximum, pi.scale, pi.offset );
 
          if ( foundValue )
          {
@@ -769,8 +870,8 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
             foundValue = true;
          }
 
-         std::shared_ptr<FloatNodeImpl> f_ni(
-            new FloatNodeImpl( imf_, floatValue, pi.precision, pi.floatMinimum, pi.floatMaximum ) );
+         std::shared_ptr<FloatNodeImpl> f_ni =
+            makeNode<FloatNodeImpl>( imf_, floatValue, pi.precision, pi.floatMinimum, pi.floatMaximum );
 
          if ( foundValue )
          {
@@ -782,13 +883,13 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
       break;
       case TypeString:
       {
-         std::shared_ptr<StringNodeImpl> s_ni( new StringNodeImpl( imf_, pi.childText ) );
+         std::shared_ptr<StringNodeImpl> s_ni = makeNode<StringNodeImpl>( imf_, pi.childText );
          current_ni = s_ni;
       }
       break;
       case TypeBlob:
       {
-         std::shared_ptr<BlobNodeImpl> b_ni( new BlobNodeImpl( imf_, pi.fileOffset, pi.length ) );
+         std::shared_ptr<BlobNodeImpl> b_ni = makeNode<BlobNodeImpl>( imf_, pi.fileOffset, pi.length );
          current_ni = b_ni;
       }
       break;
@@ -815,6 +916,10 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
                                                      " qName=" + toUString( qName ) );
       }
       imf_->root_ = std::static_pointer_cast<StructureNodeImpl>( current_ni );
+
+      // Keep a handle on the tree's storage pool so ImageFile::memoryUsage() can
+      // report its size
+      imf_->nodeArena_ = arena_;
       return;
    }
 
@@ -837,8 +942,8 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
          std::shared_ptr<StructureNodeImpl> struct_ni =
             std::static_pointer_cast<StructureNodeImpl>( parent_ni );
 
-         // Add named child to structure
-         struct_ni->set( toUString( qName ), current_ni );
+         // Add named child to structure (names recur constantly, so use the cache)
+         struct_ni->set( cachedUString( qName ), current_ni );
       }
       break;
       case TypeVector:
@@ -848,20 +953,27 @@ void E57XmlParser::endElement( const XMLCh *const uri, const XMLCh *const localN
 
          // Add unnamed child to vector
          vector_ni->append( current_ni );
+
+         // Async open progress: report each /data3D entry as soon as it is parsed
+         if ( data3DVector_ni_ && ( parent_ni == data3DVector_ni_ ) )
+         {
+            imf_->scanDiscoveredCallback_( imf_->scansDiscovered_++ );
+         }
       }
       break;
       case TypeCompressedVector:
       {
          std::shared_ptr<CompressedVectorNodeImpl> cv_ni =
             std::static_pointer_cast<CompressedVectorNodeImpl>( parent_ni );
-         ustring uQName = toUString( qName );
 
          // n can be either prototype or codecs
-         if ( uQName == "prototype" )
+         if ( XMLString::equals( qName, elt_prototype ) )
          {
-            cv_ni->setPrototype( current_ni );
+            // Scans of a project file usually share one prototype shape; attach the
+            // canonical instance so identical trees aren't kept once per scan
+            cv_ni->setPrototype( imf_->canonicalPrototype( current_ni ) );
          }
-         else if ( uQName == "codecs" )
+         else if ( XMLString::equals( qName, elt_codecs ) )
          {
             if ( current_ni->type() != TypeVector )
             {
@@ -911,8 +1023,6 @@ void E57XmlParser::characters( const XMLCh *const chars, const XMLSize_t length
 //??? use length to make ustring
 #ifdef E57_VERBOSE
    std::cout << "characters, chars=\"" << toUString( chars ) << "\" length=" << length << std::endl;
-#else
-   E57_UNUSED( length );
 #endif
 
    // Get active element
@@ -926,17 +1036,23 @@ void E57XmlParser::characters( const XMLCh *const chars, const XMLSize_t length
       case TypeCompressedVector:
       case TypeBlob:
       {
-         // If characters aren't whitespace, have an error, else ignore
-         ustring s = toUString( chars );
-         if ( s.find_first_not_of( " \t\n\r" ) != std::string::npos )
+         // If characters aren't whitespace, have an error, else ignore.
+         // Check the UTF-16 buffer directly so indented files don't transcode
+         // (and heap-allocate) every run of formatting whitespace.
+         for ( XMLSize_t i = 0; i < length; ++i )
          {
-            throw E57_EXCEPTION2( ErrorBadXMLFormat, "chars=" + toUString( chars ) );
+            const XMLCh c = chars[i];
+            if ( c != ' ' && c != '\t' && c != '\n' && c != '\r' )
+            {
+               throw E57_EXCEPTION2( ErrorBadXMLFormat, "chars=" + toUString( chars ) );
+            }
          }
       }
       break;
       default:
-         // Append to any previous characters
-         pi.childText += toUString( chars );
+         // Append to any previous characters, converting the whole buffer in one go
+         // using the length Xerces already gave us
+         appendUTF8( pi.childText, chars, length );
    }
 }
 
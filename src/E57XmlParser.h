@@ -28,11 +28,13 @@
 #pragma once
 
 #include <stack>
+#include <vector>
 
 #include <xercesc/sax/InputSource.hpp>
 #include <xercesc/sax2/DefaultHandler.hpp>
 
 #include "Common.h"
+#include "NodeArena.h"
 
 using namespace XERCES_CPP_NAMESPACE;
 
@@ -67,8 +69,27 @@ namespace e57
       void error( const SAXParseException &ex ) override;
       void fatalError( const SAXParseException &ex ) override;
 
+      /// Build a node of type T in the per-file arena (one bump allocation for the
+      /// node plus its control block, freed wholesale when the tree goes away).
+      template <typename T, typename... Args> std::shared_ptr<T> makeNode( Args &&...args )
+      {
+         return std::allocate_shared<T>( ArenaAllocator<T>( arena_ ),
+                                         std::forward<Args>( args )... );
+      }
+
+      /// Transcode a recurring element name once and reuse it.  A big file repeats the
+      /// same few dozen names (point field names, scan child names, ...) hundreds of
+      /// thousands of times.  The returned reference is only valid until the next call.
+      const ustring &cachedUString( const XMLCh *name );
+
       ImageFileImplSharedPtr imf_; /// Image file we are reading
 
+      /// Cache for cachedUString(); linear search is fine for the small closed name set
+      std::vector<std::pair<std::vector<XMLCh>, ustring>> nameCache_;
+
+      /// Owns the storage of every NodeImpl built during the parse
+      std::shared_ptr<NodeArena> arena_{ new NodeArena };
+
       struct ParseInfo
       {
          // All the fields need to remember while parsing the XML
@@ -99,6 +120,10 @@ namespace e57
 
       std::stack<ParseInfo> stack_; /// Stores the current path in tree we are reading
 
+      /// The root-level /data3D vector, remembered so an async open can report each
+      /// completed scan (see ImageFileImpl::scanDiscoveredCallback_)
+      NodeImplSharedPtr data3DVector_ni_;
+
       SAX2XMLReader *xmlReader;
    };
 
@@ -402,12 +402,17 @@ uint64_t BitpackFloatEncoder::processRecords( size_t recordCount )
              << std::endl; //???
 #endif
 
-   // Before we add any more, try to shift current contents of outBuffer_ down to beginning of
-   // buffer. This leaves outBufferEnd_ at a natural boundary.
-   outBufferShiftDown();
-
    size_t typeSize = ( precision_ == PrecisionSingle ) ? sizeof( float ) : sizeof( double );
 
+   // Reclaim space only when the end of outBuffer_ has been reached: a full drain
+   // resets the indexes for free, and a partial drain leaves the tail in place so
+   // drained bytes are never copied a second time.  outBufferEnd_ stays naturally
+   // aligned because appends always add whole elements.
+   if ( outBufferFirst_ == outBufferEnd_ || outBuffer_.size() - outBufferEnd_ < typeSize )
+   {
+      outBufferShiftDown();
+   }
+
 #if VALIDATE_BASIC
    // Verify that outBufferEnd_ is multiple of typeSize (so transfers of floats are aligned
    // naturally in memory).
@@ -432,14 +437,16 @@ uint64_t BitpackFloatEncoder::processRecords( size_t recordCount )
       // Form the starting address for next available location in outBuffer
       auto outp = reinterpret_cast<float *>( &outBuffer_[outBufferEnd_] );
 
-      // Copy floats from sourceBuffer_ to outBuffer_
+      // Copy floats from sourceBuffer_ to outBuffer_.  A contiguous, type-matched
+      // source is a single block copy (see getNextFloatArray); otherwise one
+      // conversion loop replaces the per-element call overhead.
+      sourceBuffer_->getNextFloatArray( outp, recordCount );
+#ifdef E57_VERBOSE
       for ( unsigned i = 0; i < recordCount; i++ )
       {
-         outp[i] = sourceBuffer_->getNextFloat();
-#ifdef E57_VERBOSE
          std::cout << "encoding float: " << outp[i] << std::endl;
-#endif
       }
+#endif
    }
    else
    {
@@ -447,14 +454,15 @@ uint64_t BitpackFloatEncoder::processRecords( size_t recordCount )
       // Form the starting address for next available location in outBuffer
       auto outp = reinterpret_cast<double *>( &outBuffer_[outBufferEnd_] );
 
-      // Copy doubles from sourceBuffer_ to outBuffer_
+      // Copy doubles from sourceBuffer_ to outBuffer_ (block copy when the source
+      // is contiguous and type-matched, see getNextDoubleArray)
+      sourceBuffer_->getNextDoubleArray( outp, recordCount );
+#ifdef E57_VERBOSE
       for ( unsigned i = 0; i < recordCount; i++ )
       {
-         outp[i] = sourceBuffer_->getNextDouble();
-#ifdef E57_VERBOSE
          std::cout << "encoding double: " << outp[i] << std::endl;
-#endif
       }
+#endif
    }
 
    // Update end of outBuffer
@@ -508,9 +516,13 @@ uint64_t BitpackStringEncoder::processRecords( size_t recordCount )
              << std::endl; //???
 #endif
 
-   // Before we add any more, try to shift current contents of outBuffer_ down to beginning of
-   // buffer.
-   outBufferShiftDown();
+   // Reclaim space only when the buffer is drained (free index reset) or the end
+   // has been reached (the record loop below needs room for a worst-case 8-byte
+   // length prefix); a partially drained tail stays in place, uncopied.
+   if ( outBufferFirst_ == outBufferEnd_ || outBuffer_.size() - outBufferEnd_ < 8 )
+   {
+      outBufferShiftDown();
+   }
 
    // Figure out how many bytes outBuffer can accept.
    size_t bytesFree = outBuffer_.size() - outBufferEnd_;
@@ -690,9 +702,15 @@ uint64_t BitpackIntegerEncoder<RegisterT>::processRecords( size_t recordCount )
    }
 #endif
 
-   // Before we add any more, try to shift current contents of outBuffer_ down to beginning of
-   // buffer. This leaves outBufferEnd_ at a natural boundary.
-   outBufferShiftDown();
+   // Reclaim space only when the end of outBuffer_ has been reached: a full drain
+   // resets the indexes for free, and a partial drain leaves the tail in place so
+   // drained bytes are never copied a second time.  outBufferEnd_ stays a multiple
+   // of sizeof(RegisterT) because appends always add whole registers.
+   if ( outBufferFirst_ == outBufferEnd_ ||
+        outBuffer_.size() - outBufferEnd_ < sizeof( RegisterT ) )
+   {
+      outBufferShiftDown();
+   }
 
 #ifdef VALIDATE_BASIC
    // Verify that outBufferEnd_ is multiple of sizeof(RegisterT) (so transfers of RegisterT are
@@ -723,100 +741,127 @@ uint64_t BitpackIntegerEncoder<RegisterT>::processRecords( size_t recordCount )
    auto outp = reinterpret_cast<RegisterT *>( &outBuffer_[outBufferEnd_] );
    unsigned outTransferred = 0;
 
-   // Copy bits from sourceBuffer_ to outBuffer_
-   for ( unsigned i = 0; i < recordCount; i++ )
+   // Copy bits from sourceBuffer_ to outBuffer_ in batches.  The source values
+   // are fetched and bounds-checked into a small local array first, so the
+   // packing loops below are free of function calls and the compiler can keep
+   // the shift/or chain in registers (and vectorize the full-width case).
+   int64_t rawBatch[PackBatchSize];
+   uint64_t batch[PackBatchSize];
+
+   for ( unsigned i = 0; i < recordCount; )
    {
-      int64_t rawValue;
+      size_t batchCount = std::min( recordCount - i, PackBatchSize );
 
-      // The parameter isScaledInteger_ determines which version of getNextInt64 gets called
+      // Fetch the next batch of raw values in one bulk conversion.
+      // The parameter isScaledInteger_ determines which version of getNextInt64Array gets called
       if ( isScaledInteger_ )
       {
-         rawValue = sourceBuffer_->getNextInt64( scale_, offset_ );
+         sourceBuffer_->getNextInt64Array( rawBatch, batchCount, scale_, offset_ );
       }
       else
       {
-         rawValue = sourceBuffer_->getNextInt64();
+         sourceBuffer_->getNextInt64Array( rawBatch, batchCount );
       }
 
-      // Enforce min/max specification on value
-      if ( rawValue < minimum_ || maximum_ < rawValue )
+      // Validate and bias the raw values
+      for ( size_t j = 0; j < batchCount; j++ )
       {
-         throw E57_EXCEPTION2( ErrorValueOutOfBounds, "rawValue=" + toString( rawValue ) +
-                                                         " minimum=" + toString( minimum_ ) +
-                                                         " maximum=" + toString( maximum_ ) );
-      }
+         int64_t rawValue = rawBatch[j];
 
-      auto uValue = static_cast<uint64_t>( rawValue - minimum_ );
+         // Enforce min/max specification on value
+         if ( rawValue < minimum_ || maximum_ < rawValue )
+         {
+            throw E57_EXCEPTION2( ErrorValueOutOfBounds, "rawValue=" + toString( rawValue ) +
+                                                            " minimum=" + toString( minimum_ ) +
+                                                            " maximum=" + toString( maximum_ ) );
+         }
 
-#ifdef E57_VERBOSE
-      std::cout << "encoding integer rawValue=" << binaryString( rawValue ) << " = "
-                << hexString( rawValue ) << std::endl;
-      std::cout << "                 uValue  =" << binaryString( uValue ) << " = "
-                << hexString( uValue ) << std::endl;
-#endif
-#ifdef VALIDATE_BASIC
-      // Double check that no bits outside of the mask are set
-      if ( uValue & ~static_cast<uint64_t>( sourceBitMask_ ) )
-      {
-         throw E57_EXCEPTION2( ErrorInternal, "uValue=" + toString( uValue ) );
-      }
-#endif
-      // Mask off upper bits (just in case)
-      uValue &= static_cast<uint64_t>( sourceBitMask_ );
+         auto uValue = static_cast<uint64_t>( rawValue - minimum_ );
 
-      // See if uValue bits will fit in register
-      unsigned newRegisterBitsUsed = registerBitsUsed_ + bitsPerRecord_;
 #ifdef E57_VERBOSE
-      std::cout << "  registerBitsUsed=" << registerBitsUsed_
-                << "  newRegisterBitsUsed=" << newRegisterBitsUsed << std::endl;
+         std::cout << "encoding integer rawValue=" << binaryString( rawValue ) << " = "
+                   << hexString( rawValue ) << std::endl;
+         std::cout << "                 uValue  =" << binaryString( uValue ) << " = "
+                   << hexString( uValue ) << std::endl;
 #endif
-      if ( newRegisterBitsUsed > 8 * sizeof( RegisterT ) )
-      {
-         // Have more than one registers worth, fill register, transfer, then fill some more
-         register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
 #ifdef VALIDATE_BASIC
-         // Before transfer, double check address within bounds
-         if ( outTransferred >= transferMax )
+         // Double check that no bits outside of the mask are set
+         if ( uValue & ~static_cast<uint64_t>( sourceBitMask_ ) )
          {
-            throw E57_EXCEPTION2( ErrorInternal, "outTransferred=" + toString( outTransferred ) +
-                                                    " transferMax" + toString( transferMax ) );
+            throw E57_EXCEPTION2( ErrorInternal, "uValue=" + toString( uValue ) );
          }
 #endif
-         outp[outTransferred] = register_;
-
-         outTransferred++;
-
-         register_ =
-            static_cast<RegisterT>( uValue ) >> ( 8 * sizeof( RegisterT ) - registerBitsUsed_ );
-         registerBitsUsed_ = newRegisterBitsUsed - 8 * sizeof( RegisterT );
+         // Mask off upper bits (just in case)
+         batch[j] = uValue & static_cast<uint64_t>( sourceBitMask_ );
       }
-      else if ( newRegisterBitsUsed == 8 * sizeof( RegisterT ) )
+
+      if ( ( bitsPerRecord_ == 8 * sizeof( RegisterT ) ) && ( registerBitsUsed_ == 0 ) )
       {
-         // Input will exactly fill register, insert value, then transfer
-         register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
-#ifdef VALIDATE_BASIC
-         // Before transfer, double check address within bounds
-         if ( outTransferred >= transferMax )
+         // Records exactly fill a register and we are word-aligned: a straight
+         // narrowing store loop (vectorizable on all register sizes).
+         for ( size_t j = 0; j < batchCount; j++ )
          {
-            throw E57_EXCEPTION2( ErrorInternal, "outTransferred=" + toString( outTransferred ) +
-                                                    " transferMax" + toString( transferMax ) );
+            outp[outTransferred + j] = static_cast<RegisterT>( batch[j] );
          }
-#endif
-         outp[outTransferred] = register_;
+         outTransferred += batchCount;
+      }
+      else
+      {
+         // General fixed-width case: values may straddle a register boundary.
+         for ( size_t j = 0; j < batchCount; j++ )
+         {
+            uint64_t uValue = batch[j];
 
-         outTransferred++;
+            // See if uValue bits will fit in register
+            unsigned newRegisterBitsUsed = registerBitsUsed_ + bitsPerRecord_;
 
-         register_ = 0;
-         registerBitsUsed_ = 0;
+            if ( newRegisterBitsUsed > 8 * sizeof( RegisterT ) )
+            {
+               // Have more than one registers worth, fill register, transfer, then fill some more
+               register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
+
+               outp[outTransferred] = register_;
+
+               outTransferred++;
+
+               register_ = static_cast<RegisterT>( uValue ) >>
+                           ( 8 * sizeof( RegisterT ) - registerBitsUsed_ );
+               registerBitsUsed_ = newRegisterBitsUsed - 8 * sizeof( RegisterT );
+            }
+            else if ( newRegisterBitsUsed == 8 * sizeof( RegisterT ) )
+            {
+               // Input will exactly fill register, insert value, then transfer
+               register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
+
+               outp[outTransferred] = register_;
+
+               outTransferred++;
+
+               register_ = 0;
+               registerBitsUsed_ = 0;
+            }
+            else
+            {
+               // There is extra room in register, insert value, but don't do transfer yet
+               register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
+               registerBitsUsed_ = newRegisterBitsUsed;
+            }
+         }
       }
-      else
+
+      i += batchCount;
+
+#ifdef VALIDATE_BASIC
+      // After each batch, double check addresses stayed within bounds.
+      // maxOutputRecords above guarantees this; belt and braces.
+      if ( outTransferred > transferMax )
       {
-         // There is extra room in register, insert value, but don't do transfer yet
-         register_ |= static_cast<RegisterT>( uValue ) << registerBitsUsed_;
-         registerBitsUsed_ = newRegisterBitsUsed;
+         throw E57_EXCEPTION2( ErrorInternal, "outTransferred=" + toString( outTransferred ) +
+                                                 " transferMax" + toString( transferMax ) );
       }
+#endif
 #ifdef E57_VERBOSE
-      std::cout << "  After " << outTransferred << " transfers and " << i + 1
+      std::cout << "  After " << outTransferred << " transfers and " << i
                 << " records, encoder:" << std::endl;
       dump( 4 );
 #endif
@@ -46,6 +46,16 @@ namespace e57
       virtual float bitsPerRecord() = 0;
       virtual bool registerFlushToOutput() = 0;
 
+      /// Get exact number of bits a single record occupies in the bytestream, when that
+      /// is a fixed amount (mirrors Decoder::bitsPerRecord()).  Returns false for
+      /// variable length streams (strings), whose record boundaries can't be computed
+      /// from byte counts; a constant stream reports true with bits = 0.  Used by the
+      /// writer to place record numbers on data packet boundaries for the index packets.
+      virtual bool fixedBitsPerRecord( unsigned & /*bits*/ )
+      {
+         return false;
+      }
+
       virtual size_t outputAvailable() const = 0; /// number of bytes that can be read
       virtual void outputRead( char *dest, size_t byteCount ) = 0; /// get data from encoder
       virtual void outputClear() = 0;
@@ -59,6 +69,13 @@ namespace e57
          return bytestreamNumber_;
       }
 
+      /// Bytes of staging buffer this encoder holds, for ImageFile::memoryUsage()
+      /// (constant streams hold none)
+      virtual size_t stagingBytes() const
+      {
+         return 0;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       virtual void dump( int indent = 0, std::ostream &os = std::cout ) const;
 #endif
@@ -86,6 +103,11 @@ namespace e57
       size_t outputGetMaxSize() override;
       void outputSetMaxSize( unsigned byteCount ) override;
 
+      size_t stagingBytes() const override
+      {
+         return outBuffer_.capacity();
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) const override;
 #endif
@@ -116,6 +138,13 @@ namespace e57
       bool registerFlushToOutput() override;
       float bitsPerRecord() override;
 
+      bool fixedBitsPerRecord( unsigned &bits ) override
+      {
+         bits = ( precision_ == PrecisionSingle ) ? 32 : 64;
+
+         return true;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) const override;
 #endif
@@ -157,6 +186,13 @@ namespace e57
       bool registerFlushToOutput() override;
       float bitsPerRecord() override;
 
+      bool fixedBitsPerRecord( unsigned &bits ) override
+      {
+         bits = bitsPerRecord_;
+
+         return true;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout ) const override;
 #endif
@@ -171,6 +207,10 @@ namespace e57
       uint64_t sourceBitMask_;
       unsigned registerBitsUsed_;
       RegisterT register_;
+
+      /// Number of records packed per inner-loop batch in processRecords().
+      /// Small enough to stay in L1, large enough for the packing loop to vectorize.
+      static constexpr size_t PackBatchSize = 64;
    };
 
    class ConstantIntegerEncoder : public Encoder
@@ -183,6 +223,13 @@ namespace e57
       float bitsPerRecord() override;
       bool registerFlushToOutput() override;
 
+      bool fixedBitsPerRecord( unsigned &bits ) override
+      {
+         bits = 0; // produces no output
+
+         return true;
+      }
+
       size_t outputAvailable() const override;                  /// number of bytes that can be read
       void outputRead( char *dest, size_t byteCount ) override; /// get data from encoder
       void outputClear() override;
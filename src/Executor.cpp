@@ -0,0 +1,265 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "E57Format.h"
+#include "Executor.h"
+
+namespace
+{
+   /// One batch of identical worker invocations, claimed index by index.  Lives on the
+   /// stack of the Executor::run() call that owns it; completedCount keeps it alive
+   /// until every claimed task has finished.
+   struct Batch
+   {
+      const e57::Executor::Work *work = nullptr;
+      unsigned count = 0;
+      unsigned nextIndex = 0; ///< next unclaimed worker index
+      unsigned completedCount = 0;
+      std::condition_variable finished;
+   };
+
+   /// The built-in process-wide pool.  Threads are started lazily on the first parallel
+   /// operation and sized to the hardware; every batch's calling thread also claims
+   /// tasks, so batches make progress even when all pool threads are busy elsewhere.
+   class SharedPool
+   {
+   public:
+      static SharedPool &instance()
+      {
+         static SharedPool pool;
+
+         return ( pool );
+      }
+
+      void run( unsigned workerCount, const e57::Executor::Work &work )
+      {
+         Batch batch;
+
+         batch.work = &work;
+         batch.count = workerCount;
+
+         std::unique_lock<std::mutex> lock( mutex_ );
+
+         startThreads();
+         openBatches_.push_back( &batch );
+         wake_.notify_all();
+
+         // The caller helps: claim tasks from our own batch until none are left.
+         while ( batch.nextIndex < batch.count )
+         {
+            claimAndRunOne( batch, lock );
+         }
+
+         batch.finished.wait( lock,
+                              [&batch] { return batch.completedCount == batch.count; } );
+      }
+
+   private:
+      SharedPool() = default;
+
+      ~SharedPool()
+      {
+         {
+            std::lock_guard<std::mutex> lock( mutex_ );
+
+            stopping_ = true;
+         }
+
+         wake_.notify_all();
+
+         for ( auto &thread : threads_ )
+         {
+            thread.join();
+         }
+      }
+
+      /// Caller holds mutex_
+      void startThreads()
+      {
+         if ( !threads_.empty() )
+         {
+            return;
+         }
+
+         const unsigned threadCount = std::max( 1U, std::thread::hardware_concurrency() );
+
+         threads_.reserve( threadCount );
+
+         for ( unsigned i = 0; i < threadCount; ++i )
+         {
+            threads_.emplace_back( [this] { workerLoop(); } );
+         }
+      }
+
+      /// Claims one task from batch and runs it.  Caller holds the lock on entry and
+      /// gets it back on exit; the task itself runs unlocked.  The task never throws
+      /// (Executor::run() wraps it in an error capture).
+      void claimAndRunOne( Batch &batch, std::unique_lock<std::mutex> &lock )
+      {
+         const unsigned index = batch.nextIndex++;
+
+         if ( batch.nextIndex == batch.count )
+         {
+            // Fully claimed; nothing left for other threads to pick up
+            openBatches_.erase(
+               std::find( openBatches_.begin(), openBatches_.end(), &batch ) );
+         }
+
+         lock.unlock();
+         ( *batch.work )( index );
+         lock.lock();
+
+         ++batch.completedCount;
+
+         if ( batch.completedCount == batch.count )
+         {
+            // Notified under the lock so the waiter can't destroy the batch mid-notify
+            batch.finished.notify_all();
+         }
+      }
+
+      void workerLoop()
+      {
+         std::unique_lock<std::mutex> lock( mutex_ );
+
+         for ( ;; )
+         {
+            wake_.wait( lock, [this] { return stopping_ || !openBatches_.empty(); } );
+
+            if ( stopping_ )
+            {
+               break;
+            }
+
+            claimAndRunOne( *openBatches_.front(), lock );
+         }
+      }
+
+      std::mutex mutex_;
+      std::condition_variable wake_;
+      std::vector<std::thread> threads_;
+
+      /// Batches that still have unclaimed tasks, oldest first
+      std::deque<Batch *> openBatches_;
+
+      bool stopping_ = false;
+   };
+
+   std::mutex &runnerMutex()
+   {
+      static std::mutex mutex;
+
+      return ( mutex );
+   }
+
+   /// Empty unless the application injected its own runner via SetTaskRunner()
+   e57::Executor::Runner &customRunner()
+   {
+      static e57::Executor::Runner runner;
+
+      return ( runner );
+   }
+}
+
+namespace e57
+{
+   void Executor::run( unsigned workerCount, const Work &work )
+   {
+      if ( workerCount == 0 )
+      {
+         return;
+      }
+
+      if ( workerCount == 1 )
+      {
+         work( 0 );
+         return;
+      }
+
+      // Capture errors here rather than in each runner, so injected runners never see
+      // a throwing task and every call site gets the same first-error-wins semantics
+      // the old per-site worker loops had.
+      std::mutex errorMutex;
+      std::exception_ptr firstError;
+
+      const Work guardedWork = [&]( unsigned workerIndex ) {
+         try
+         {
+            work( workerIndex );
+         }
+         catch ( ... )
+         {
+            std::lock_guard<std::mutex> lockGuard( errorMutex );
+
+            if ( !firstError )
+            {
+               firstError = std::current_exception();
+            }
+         }
+      };
+
+      Runner runner;
+
+      {
+         std::lock_guard<std::mutex> lockGuard( runnerMutex() );
+
+         runner = customRunner();
+      }
+
+      if ( runner )
+      {
+         runner( workerCount, guardedWork );
+      }
+      else
+      {
+         SharedPool::instance().run( workerCount, guardedWork );
+      }
+
+      if ( firstError )
+      {
+         std::rethrow_exception( firstError );
+      }
+   }
+
+   void Executor::setRunner( Runner runner )
+   {
+      std::lock_guard<std::mutex> lockGuard( runnerMutex() );
+
+      customRunner() = std::move( runner );
+   }
+
+   void SetTaskRunner( TaskRunner runner )
+   {
+      Executor::setRunner( std::move( runner ) );
+   }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace e57
+{
+   /// Routes the library's fan-out parallel work (parallel decode and encode, the
+   /// Reader::ReadAll* loops) through one process-wide thread pool instead of letting
+   /// every reader and writer spawn its own threads, so a process with many open files
+   /// keeps a bounded thread count while idle cores flow to whichever file is busiest.
+   /// The host application can replace the pool (see SetTaskRunner() in E57Format.h).
+   class Executor
+   {
+   public:
+      /// One task of a batch; workerIndex runs from 0 to workerCount - 1
+      using Work = std::function<void( unsigned workerIndex )>;
+
+      /// Same shape as e57::TaskRunner in E57Format.h
+      using Runner = std::function<void( unsigned workerCount, const Work &work )>;
+
+      /// Invokes work( 0 ) through work( workerCount - 1 ), each exactly once, and
+      /// returns once all of them have finished, rethrowing the first exception any
+      /// invocation threw.  A batch of one runs on the calling thread; the calling
+      /// thread also claims tasks from larger batches, so a saturated pool degrades to
+      /// inline execution instead of deadlocking (even when batches nest).
+      static void run( unsigned workerCount, const Work &work );
+
+      /// Replaces the built-in shared pool (an empty runner restores it)
+      static void setRunner( Runner runner );
+   };
+}
@@ -246,7 +246,8 @@ that files that meet all of the requirements for a legal ASTM E57 file format us
 ".e57". It is recommended that files that utilize the low-level E57 element data types, but do not
 have all the required element names required by ASTM E57 file format standard use the file extension
 @c "._e57".
-@param [in] mode Either "w" for writing or "r" for reading.
+@param [in] mode Either "w" for writing, "r" for reading, "rc" for reading via the sidecar
+metadata cache, or "a" for appending to an existing file.
 @param [in] checksumPolicy The percentage of checksums we compute and verify as an int. Clamped to
 0-100.
 
@@ -261,7 +262,26 @@ API operations are legal for an ImageFile opened in write mode.
 @par Read Mode
 Read mode files may be shared.
 Write API operations are not legal for an ImageFile opened in read mode (i.e. the ImageFile is
-read-only). There is no API support for appending data onto an existing E57 data file.
+read-only).
+A read-only ImageFile may be used from several threads at once: the element tree is immutable
+after open, file access goes through positionless reads, and every CompressedVectorReader owns a
+private packet cache, so metadata queries, Blob reads and multiple simultaneous
+CompressedVectorReader sessions (each on its own thread) do not need external locking. The same
+CompressedVectorReader must not be used by two threads at the same time.
+The "rc" mode behaves exactly like "r" but additionally maintains a binary sidecar file
+(@c "<fname>.e57cache") holding the parsed element tree: the first open writes it, and later
+opens load it and skip XML parsing entirely, which makes reopening a large project nearly
+instant. The sidecar is keyed to the file's header, so it is automatically ignored and
+rewritten when the E57 file changes; it may be deleted at any time.
+
+@par Append Mode
+In append mode, the file must already exist and contain a well-formed E57 file. The existing XML
+section is parsed into the element tree exactly as in read mode, and the ImageFile then behaves as
+if opened in write mode: new elements (including CompressedVector and Blob binary sections) may be
+added. Binary sections already in the file are preserved untouched; new sections are written over
+and beyond the old XML section, and a fresh XML section describing the combined tree is emitted at
+close(). The cost of appending is therefore proportional to the new data plus the XML, not to the
+size of the existing file.
 
 @post Resulting ImageFile is in @c open state if constructor succeeds (no exception thrown).
 
@@ -297,6 +317,130 @@ ImageFile::ImageFile( const char *input, const uint64_t size, ReadChecksumPolicy
    impl_->construct2( input, size );
 }
 
+/*!
+@brief Open a new ImageFile for writing into a memory buffer instead of a file.
+
+@param [in] outBuffer A caller-owned, growable buffer that will receive the E57 byte stream.
+@param [in] checksumPolicy The verification policy to use if the produced stream is read back.
+
+@details
+The ImageFile behaves exactly like one opened in write mode on a filesystem path, but all pages
+are written into @a outBuffer, so an E57 file can be produced without touching local disk (e.g.
+for streaming straight to object storage). The buffer is cleared on open, grows as data is
+written, and holds the complete, checksummed E57 file after close() - byte-identical to what the
+file-based writer would have produced. It can be read back with the
+ImageFile( const char *, uint64_t, ReadChecksumPolicy ) constructor. The buffer must outlive the
+ImageFile and must not be touched by the caller until close() has returned.
+
+@post The ImageFile is open in write mode (i.e. isOpen() && isWritable()).
+
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ImageFile::close, ImageFile::ImageFile( const char *, uint64_t, ReadChecksumPolicy )
+*/
+ImageFile::ImageFile( std::vector<char> &outBuffer, ReadChecksumPolicy checksumPolicy ) :
+   impl_( new ImageFileImpl( checksumPolicy ) )
+{
+   impl_->construct2( &outBuffer );
+}
+
+/*!
+@brief Open an existing E57 file for reading through a caller-supplied byte source.
+
+@param [in] backend Positionless byte source the file's pages are fetched from. Must stay usable
+until close() has returned.
+@param [in] checksumPolicy The percentage of checksums we compute and verify as an int. Clamped to
+0-100.
+
+@details
+The ImageFile behaves exactly like one opened in "r" mode on a filesystem path, but every page
+read is served by @a backend->readAt(), so the bytes can live anywhere the caller can fetch
+ranges from - object storage, a network service, an archive. Only the ranges actually touched
+are fetched: the header and XML section at open, then just the packets of the vectors being read,
+so reading one scan of a large remote file does not download the rest.
+
+Once open, readAt() may be invoked concurrently from several threads (parallel
+CompressedVectorReader sessions each miss the packet cache independently), so a remote backend
+can serve them as simultaneous range requests.
+
+@post Resulting ImageFile is in @c open state if constructor succeeds (no exception thrown).
+
+@throw ::ErrorBadChecksum
+@throw ::ErrorBadFileSignature
+@throw ::ErrorUnknownFileVersion
+@throw ::ErrorBadFileLength
+@throw ::ErrorXMLParser
+@throw ::ErrorBadXMLFormat
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReadBackend, ImageFile::ImageFile( const char *, uint64_t, ReadChecksumPolicy )
+*/
+ImageFile::ImageFile( const std::shared_ptr<ReadBackend> &backend,
+                      ReadChecksumPolicy checksumPolicy ) :
+   impl_( new ImageFileImpl( checksumPolicy ) )
+{
+   impl_->construct2( backend );
+}
+
+/*!
+@brief Open an existing E57 file for reading without blocking on the XML parse.
+
+@param [in] fname File name to open.
+@param [in] checksumPolicy The percentage of checksums we compute and verify as an int. Clamped
+to 0-100.
+@param [in] scanDiscovered Optional; invoked with 0, 1, 2, ... as each /data3D entry finishes
+parsing.
+
+@details
+The returned ImageFile is constructed as soon as the file header has been read and validated;
+the XML section continues parsing on a background task, so for large files the open latency is
+effectively just the header read. Readiness can be polled (or waited on) through
+xmlParseComplete(), whose future also holds any parse error. Every accessor that needs the tree
+(root() and everything reached through it) blocks until the parse has finished, so code that
+ignores the asynchrony behaves exactly as if the file had been opened with the ordinary
+constructor.
+
+@a scanDiscovered is called on the parse thread, so it must be quick and must not call back into
+this ImageFile. If the fast built-in XML parser gives up and the section is re-parsed (see
+E57_BUILTIN_XML_PARSER), the indices restart from 0 and the scans are reported again.
+
+@post Resulting ImageFile is in @c open state; its tree may still be loading.
+
+@throw ::ErrorOpenFailed
+@throw ::ErrorBadFileSignature
+@throw ::ErrorUnknownFileVersion
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ImageFile::xmlParseComplete, ImageFile::root
+*/
+ImageFile ImageFile::openAsync( const ustring &fname, ReadChecksumPolicy checksumPolicy,
+                                const std::function<void( int64_t scanIndex )> &scanDiscovered )
+{
+   std::shared_ptr<ImageFileImpl> imfi( new ImageFileImpl( checksumPolicy ) );
+
+   // Do second phase of construction, now that ImageFileImpl object is complete.
+   imfi->construct2Async( fname, scanDiscovered );
+
+   return ImageFile( imfi );
+}
+
+/*!
+@brief Readiness of an openAsync() file's background XML parse.
+
+@details
+The future becomes ready when the XML section has been completely parsed, or holds the parse's
+exception if it failed. For files opened with the ordinary constructors the returned future is
+already ready.
+
+@return A shared future that is (or becomes) ready when the file's tree is completely loaded.
+
+@see ImageFile::openAsync
+*/
+std::shared_future<void> ImageFile::xmlParseComplete() const
+{
+   return impl_->xmlParseComplete();
+}
+
 /*!
 @brief Get the pre-established root StructureNode of the E57 ImageFile.
 
@@ -464,6 +608,297 @@ int ImageFile::readerCount() const
    return impl_->readerCount();
 }
 
+/*!
+@brief Hint how large the finished file is expected to be.
+
+@param [in] expectedSizeBytes Rough expected size of the finished E57 file, in bytes.
+
+@details
+Asks the operating system to reserve (ideally contiguous) disk extents for the file up front.
+Without the hint, the file grows one 1024-byte page at a time as packets are written, which can
+fragment badly on some filesystems and degrade sequential read throughput of the finished file.
+The hint is best-effort: it does not change the visible file length, over-estimates are harmless
+(any unused reservation is released when the file is closed), and platforms or filesystems without
+preallocation support silently ignore it.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+@pre The ImageFile must have been opened in write mode (i.e. isWritable()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorFileReadOnly
+@throw ::ErrorInternal All objects in undocumented state
+*/
+void ImageFile::preallocate( uint64_t expectedSizeBytes )
+{
+   impl_->preallocate( expectedSizeBytes );
+}
+
+/*!
+@brief Set a rough cap on the memory readers of this ImageFile allocate for themselves.
+
+@param [in] budgetBytes Target cap, in bytes, on library-internal allocations; 0 (the default)
+removes the cap.
+
+@details
+When a budget is set, each CompressedVectorReader opened on this file sizes its packet cache to
+fit in half of the budget (it normally holds 32 packets of 64&nbsp;KiB each), leaving the other
+half for channel state and the caller's buffers. The Simple API additionally shrinks its
+chunked-read point buffers to fit (see ReaderOptions::memoryBudget, which sets this budget
+automatically).
+
+The cap is best-effort: it bounds the library's own buffering, not destination buffers the
+caller supplies, and small fixed-size allocations (the node tree, per-channel decode state) are
+not counted. It trades throughput for a predictable peak working set, which is the right trade
+on memory-constrained devices.
+
+The budget should be set before readers are created; readers already open keep their original
+cache sizes.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+*/
+void ImageFile::setMemoryBudget( uint64_t budgetBytes )
+{
+   impl_->setMemoryBudget( budgetBytes );
+}
+
+/*!
+@brief Get the memory cap set by setMemoryBudget().
+
+@return Returns the current budget in bytes; 0 means no cap.
+*/
+uint64_t ImageFile::memoryBudget() const
+{
+   return impl_->memoryBudget();
+}
+
+/*!
+@brief Set the handler invoked when background checksum verification finds a corrupt page.
+
+@param [in] callback Invoked once per corrupt page with the ::ErrorBadChecksum exception that
+describes it; an empty function removes the handler.
+
+@details
+Only meaningful with the ::ChecksumTiered policy. Under that policy the file header and XML
+section are verified synchronously at open, while data pages are verified on a background task
+after their contents have already been handed to the decoder, so a mismatch cannot be thrown at
+the read call that touched the page. It is delivered here instead, on the verifier's thread;
+the callback must be thread-safe with respect to the caller's own reading threads.
+
+If no handler is installed, the first mismatch found in the background is thrown from close(),
+so corruption never passes silently.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ::ChecksumTiered, ImageFile::checksumVerifyPending()
+*/
+void ImageFile::setChecksumMismatchCallback(
+   std::function<void( const E57Exception &ex )> callback )
+{
+   impl_->setChecksumMismatchCallback( std::move( callback ) );
+}
+
+/*!
+@brief Get the number of pages awaiting background checksum verification.
+
+@details
+Only nonzero with the ::ChecksumTiered policy. Returns the number of data pages that have been
+read and queued but not yet CRC-checked; 0 means every page read so far has been verified.
+Polling for 0 after the last read is the way to know verification has caught up without closing
+the file (close() always finishes the backlog before returning).
+
+@return Returns the number of pages queued for verification.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+*/
+uint64_t ImageFile::checksumVerifyPending() const
+{
+   return impl_->checksumVerifyPending();
+}
+
+/*!
+@brief Report the bytes this ImageFile currently holds, per subsystem.
+
+@details
+Returns live and peak byte counts for the file's metadata tree, the packet caches and decoder
+staging buffers of its open CompressedVectorReader sessions, and the encoder staging buffers of
+its open CompressedVectorWriter sessions. The counters are maintained at the allocation choke
+points, so calling this is cheap and imposes no cost on the read and write paths. Peak values
+are high-water marks since the file was opened.
+
+The destination buffers supplied by the caller are not included; they belong to the caller.
+
+@return Returns a MemoryUsage with the current live and peak byte counts.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ImageFile::setMemoryBudget
+*/
+MemoryUsage ImageFile::memoryUsage() const
+{
+   return impl_->memoryUsage();
+}
+
+/*!
+@brief Share this file's packet cache with other processes reading the same file.
+
+@details
+Attaches the ImageFile to a shared-memory cache of decoded packets, keyed to the identity of
+the underlying file, that every process (and every ImageFile within a process) reading that
+file can join. A packet read, CRC-verified and - for compressed packets - decompressed by one
+process is then available to all the others without touching the disk again, which removes
+most of the redundant I/O when many worker processes stream the same file.
+
+Lookups in the shared cache are lock-free and strictly best-effort: any contention or oddity
+falls back to reading the packet from the file, so enabling the cache never affects
+correctness. The shared cache supplements each CompressedVectorReader's private packet cache
+rather than replacing it.
+
+The feature is implemented with POSIX shared memory; on other platforms, and for ImageFiles
+backed by a caller-supplied memory buffer, this call returns false and the file keeps working
+with private caching only.
+
+@return Returns true if the shared cache was attached (or already was).
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReaderOptions::sharedPacketCache, SetPacketCacheBudget
+*/
+bool ImageFile::enableSharedPacketCache()
+{
+   return impl_->enableSharedPacketCache();
+}
+
+/*!
+@brief Read this file through a whole-file memory mapping instead of per-page reads.
+
+@details
+Maps the underlying file into memory (read-only), after which page access in the read paths is
+pointer arithmetic over the mapping - no syscall per 1024-byte physical page - and CRC
+verification happens in place on the mapped bytes. On large files read from fast storage this
+removes the per-page syscall overhead that otherwise dominates cold reads.
+
+The call is best-effort: it returns false - and the file keeps reading through the regular
+positioned-read path - for writable files, files backed by a caller-supplied memory buffer or a
+ReadBackend, 32-bit address spaces, and platforms without POSIX mmap().
+
+@return Returns true if the mapping is in place.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReaderOptions::mappedRead
+*/
+bool ImageFile::enableMappedRead()
+{
+   return impl_->enableMappedRead();
+}
+
+/*!
+@brief Read this file with direct I/O, bypassing the OS page cache.
+
+@details
+Switches the underlying descriptor to unbuffered (O_DIRECT) reads. A single-pass bulk
+conversion gains nothing from the page cache but still fills it, evicting hot data belonging to
+other processes on the same host; with direct reads the file's bytes never enter the cache.
+Alignment is handled internally - transfers are widened to the device block size through an
+aligned bounce buffer - so no caller-visible behavior changes.
+
+Expect direct reads of one page at a time to be slower than cached reads; the option pays off
+together with the bulk span reads the packet cache and the chunked read paths issue.
+
+The call is best-effort: it returns false - and the file keeps reading through the page cache -
+for writable files, files backed by a caller-supplied memory buffer or a ReadBackend, mapped
+files, and platforms without O_DIRECT.
+
+@return Returns true if direct reads are in effect.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReaderOptions::directRead, enableMappedRead
+*/
+bool ImageFile::enableDirectRead()
+{
+   return impl_->enableDirectRead();
+}
+
+/*!
+@brief Prefetch packets following each packet cache miss on a background thread.
+
+@details
+A compressed vector is laid out as consecutive packets, and a sequential read alternates
+between decoding one packet and waiting for the next to come off the disk. With read-ahead
+enabled, each cache miss points a background thread at the packets that follow; it stages up to
+packetCount of them (including their CRC verification) while the caller decodes, so on
+sequential scans the next packet is usually already in memory. The staged images live beside
+the packet cache and cost packetCount * 64 KB per open CompressedVectorReader.
+
+Random access gains nothing and wastes some disk bandwidth on unconsumed packets; the setting
+applies to CompressedVectorReader objects created after the call.
+
+@param [in] packetCount Packets to stage ahead of each miss; 0 (the default) disables
+read-ahead.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReaderOptions::packetReadAhead, SetPacketCacheBudget
+*/
+void ImageFile::setPacketReadAhead( unsigned packetCount )
+{
+   impl_->setPacketReadAhead( packetCount );
+}
+
+/*!
+@brief Set the capacity of the packet cache behind each CompressedVectorReader.
+
+@details
+Every CompressedVectorReader keeps recently used 64 KB packets in a cache; interleaved reads of
+wide prototypes (many bytestreams) revisit packets quickly, and with the default capacity of 32
+packets they can evict entries that are needed again moments later. Packet lookup is O(1)
+regardless of capacity, so large caches cost only their memory: packetCount * 64 KB per open
+CompressedVectorReader.
+
+The setting applies to CompressedVectorReader objects created after the call. A process-wide
+cap set with SetPacketCacheBudget() and a file-level ImageFile::setMemoryBudget() still shrink
+what each cache actually claims.
+
+@param [in] packetCount Packets each cache can hold; 0 (the default) keeps the default
+capacity.
+
+@pre The ImageFile must be open (i.e. isOpen()).
+
+@throw ::ErrorImageFileNotOpen
+@throw ::ErrorInternal All objects in undocumented state
+
+@see ReaderOptions::packetCacheSize, SetPacketCacheBudget, setMemoryBudget
+*/
+void ImageFile::setPacketCacheSize( unsigned packetCount )
+{
+   impl_->setPacketCacheSize( packetCount );
+}
+
 /*!
 @brief Declare the use of an E57 extension in an ImageFile being written.
 
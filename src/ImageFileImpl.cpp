@@ -27,8 +27,12 @@
 
 #include "ImageFileImpl.h"
 #include "ASTMVersion.h"
+#include "BuiltinXmlParser.h"
 #include "CheckedFile.h"
 #include "E57XmlParser.h"
+#include "NodeArena.h"
+#include "SharedPacketCache.h"
+#include "SidecarCache.h"
 #include "StringFunctions.h"
 #include "StructureNodeImpl.h"
 
@@ -76,7 +80,10 @@ namespace e57
 
    ImageFileImpl::ImageFileImpl( ReadChecksumPolicy policy ) :
       isWriter_( false ), writerCount_( 0 ), readerCount_( 0 ),
-      checksumPolicy( std::max( 0, std::min( policy, 100 ) ) ), file_( nullptr ),
+      checksumPolicy( ( policy == ChecksumTiered || policy == ChecksumParallel )
+                         ? policy
+                         : std::max( 0, std::min( policy, 100 ) ) ),
+      file_( nullptr ),
       xmlLogicalOffset_( 0 ), xmlLogicalLength_( 0 ), unusedLogicalStart_( 0 )
    {
       // First phase of construction, can't do much until have the ImageFile object. See
@@ -96,10 +103,14 @@ namespace e57
       // Get shared_ptr to this object
       ImageFileImplSharedPtr imf = shared_from_this();
 
-      // Accept "w" or "r" modes
+      // Accept "w", "r", "rc" (read via the sidecar metadata cache) or "a" (append) modes
       isWriter_ = ( mode == "w" );
 
-      if ( !isWriter_ && ( mode != "r" ) )
+      const bool isAppender = ( mode == "a" );
+
+      useSidecarCache_ = ( mode == "rc" );
+
+      if ( !isWriter_ && !isAppender && !useSidecarCache_ && ( mode != "r" ) )
       {
          throw E57_EXCEPTION2( ErrorBadAPIArgument, "mode=" + ustring( mode ) );
       }
@@ -133,11 +144,15 @@ namespace e57
          return;
       }
 
-      // Reading
+      // Reading or appending: both start by parsing the existing file's XML section
       try
       {
-         // Open file for reading.
-         file_ = new CheckedFile( fileName_, CheckedFile::Read, checksumPolicy );
+         // Appending keeps the file's contents and reopens it read-write; the parsed
+         // XML section is overwritten by new binary sections and a fresh XML section
+         // is emitted at close().
+         file_ = new CheckedFile(
+            fileName_, isAppender ? CheckedFile::WriteExisting : CheckedFile::Read,
+            checksumPolicy );
 
          std::shared_ptr<StructureNodeImpl> root( new StructureNodeImpl( imf ) );
          root_ = root;
@@ -159,18 +174,156 @@ namespace e57
 
       try
       {
-         // Create parser state, attach its event handers to the SAX2 reader
-         E57XmlParser parser( imf );
+         unusedLogicalStart_ = sizeof( E57FileHeader );
 
-         parser.init();
+         // Do the parse, building up the node tree
+         readXmlSection();
 
-         // Create input source (XML section of E57 file turned into a stream).
-         E57XmlFileInputSource xmlSection( file_, xmlLogicalOffset_, xmlLogicalLength_ );
+         // Freeze the lazy lookup structures now, so a read-only tree is immutable from
+         // here on and can be queried from several threads without locking
+         root_->buildLookupIndexesRecursive();
 
-         unusedLogicalStart_ = sizeof( E57FileHeader );
+         // The header and XML section above were verified eagerly; with the tiered
+         // policy the data pages read from here on are verified in the background
+         if ( checksumPolicy == ChecksumTiered )
+         {
+            file_->beginDeferredVerification();
+         }
+      }
+      catch ( ... )
+      {
+         delete file_;
+         file_ = nullptr;
+
+         throw;
+      }
+
+      if ( isAppender )
+      {
+         // Become a writer now that the existing tree is loaded.  The binary
+         // sections already in the file stay untouched: new sections start where
+         // the old XML section began, and close() rewrites the XML after them.
+         isWriter_ = true;
+         unusedLogicalStart_ = xmlLogicalOffset_;
+      }
+   }
+
+   void ImageFileImpl::construct2Async(
+      const ustring &fileName, const std::function<void( int64_t scanIndex )> &scanDiscovered )
+   {
+      // Second phase of an async read-only open: the synchronous part stops once the
+      // header is validated, so obviously bad files still fail inside the constructor.
+
+      unusedLogicalStart_ = sizeof( E57FileHeader );
+      fileName_ = fileName;
+      isWriter_ = false;
+
+      // Never combined with the sidecar cache: SidecarCache::save() walks the tree via
+      // root(), which on the parse thread would wait on its own future
+      useSidecarCache_ = false;
+
+      ImageFileImplSharedPtr imf = shared_from_this();
+
+      file_ = nullptr;
+
+      try
+      {
+         file_ = new CheckedFile( fileName_, CheckedFile::Read, checksumPolicy );
 
+         std::shared_ptr<StructureNodeImpl> root( new StructureNodeImpl( imf ) );
+         root_ = root;
+         root_->setAttachedRecursive();
+
+         E57FileHeader header;
+         readFileHeader( file_, header );
+
+         xmlLogicalOffset_ = file_->physicalToLogical( header.xmlPhysicalOffset );
+         xmlLogicalLength_ = header.xmlLogicalLength;
+      }
+      catch ( ... )
+      {
+         delete file_;
+         file_ = nullptr;
+
+         throw;
+      }
+
+      scanDiscoveredCallback_ = scanDiscovered;
+
+      // The XML parse continues on a background task.  The captured shared_ptr keeps
+      // this object alive until the parse lands; tree accessors block on the future
+      // (see waitForXmlParse()), so from their point of view the open was synchronous.
+      xmlParseFuture_ = std::async( std::launch::async, [imf]() {
          // Do the parse, building up the node tree
-         parser.parse( xmlSection );
+         imf->readXmlSection();
+
+         // Freeze the lazy lookup structures now, so a read-only tree is immutable from
+         // here on and can be queried from several threads without locking
+         imf->root_->buildLookupIndexesRecursive();
+
+         // The header and XML section above were verified eagerly; with the tiered
+         // policy the data pages read from here on are verified in the background
+         if ( imf->checksumPolicy == ChecksumTiered )
+         {
+            imf->file_->beginDeferredVerification();
+         }
+
+         imf->scanDiscoveredCallback_ = nullptr;
+      } ).share();
+   }
+
+   std::shared_future<void> ImageFileImpl::xmlParseComplete() const
+   {
+      if ( xmlParseFuture_.valid() )
+      {
+         return xmlParseFuture_;
+      }
+
+      // Ordinary opens parsed in the constructor, so hand back an already-ready future
+      std::promise<void> alreadyDone;
+
+      alreadyDone.set_value();
+
+      return alreadyDone.get_future().share();
+   }
+
+   void ImageFileImpl::waitForXmlParse() const
+   {
+      if ( xmlParseFuture_.valid() )
+      {
+         // Rethrows the background parse's error on every access, so a file whose
+         // parse failed stays unusable just like a failed synchronous open
+         xmlParseFuture_.get();
+      }
+   }
+
+   void ImageFileImpl::construct2( std::vector<char> *outBuffer )
+   {
+      // Second phase of construction: write a new E57 stream into a caller-owned memory
+      // buffer instead of a filesystem path (e.g. to hand straight to object storage).
+      // Mirrors the "w" branch of the file-based construct2().
+
+#ifdef E57_VERBOSE
+      std::cout << "ImageFileImpl() called, fileName=<MemoryBuffer> mode=w" << std::endl;
+#endif
+      unusedLogicalStart_ = sizeof( E57FileHeader );
+      fileName_ = "<MemoryBuffer>";
+      isWriter_ = true;
+
+      ImageFileImplSharedPtr imf = shared_from_this();
+
+      file_ = nullptr;
+
+      try
+      {
+         file_ = new CheckedFile( outBuffer, checksumPolicy );
+
+         std::shared_ptr<StructureNodeImpl> root( new StructureNodeImpl( imf ) );
+         root_ = root;
+         root_->setAttachedRecursive();
+
+         xmlLogicalOffset_ = 0;
+         xmlLogicalLength_ = 0;
       }
       catch ( ... )
       {
@@ -222,18 +375,89 @@ namespace e57
 
       try
       {
-         // Create parser state, attach its event handers to the SAX2 reader
-         E57XmlParser parser( imf );
+         unusedLogicalStart_ = sizeof( E57FileHeader );
 
-         parser.init();
+         // Do the parse, building up the node tree
+         readXmlSection();
 
-         // Create input source (XML section of E57 file turned into a stream).
-         E57XmlFileInputSource xmlSection( file_, xmlLogicalOffset_, xmlLogicalLength_ );
+         // Freeze the lazy lookup structures now, so a read-only tree is immutable from
+         // here on and can be queried from several threads without locking
+         root_->buildLookupIndexesRecursive();
+
+         // The header and XML section above were verified eagerly; with the tiered
+         // policy the data pages read from here on are verified in the background
+         if ( checksumPolicy == ChecksumTiered )
+         {
+            file_->beginDeferredVerification();
+         }
+      }
+      catch ( ... )
+      {
+         delete file_;
+         file_ = nullptr;
+
+         throw;
+      }
+   }
+
+   void ImageFileImpl::construct2( const std::shared_ptr<ReadBackend> &backend )
+   {
+      // Second phase of construction: read through a caller-supplied byte source
+      // (e.g. object storage range requests).  Mirrors the "r" branch of the
+      // file-based construct2().
+
+#ifdef E57_VERBOSE
+      std::cout << "ImageFileImpl() called, fileName=<ReadBackend> mode=r" << std::endl;
+#endif
+      unusedLogicalStart_ = sizeof( E57FileHeader );
+      fileName_ = "<ReadBackend>";
+
+      // Get shared_ptr to this object
+      ImageFileImplSharedPtr imf = shared_from_this();
+
+      isWriter_ = false;
+      file_ = nullptr;
+
+      try
+      {
+         // Open file for reading.
+         file_ = new CheckedFile( backend, checksumPolicy );
+
+         std::shared_ptr<StructureNodeImpl> root( new StructureNodeImpl( imf ) );
+         root_ = root;
+         root_->setAttachedRecursive();
+
+         E57FileHeader header;
+         readFileHeader( file_, header );
+
+         xmlLogicalOffset_ = file_->physicalToLogical( header.xmlPhysicalOffset );
+         xmlLogicalLength_ = header.xmlLogicalLength;
+      }
+      catch ( ... )
+      {
+         delete file_;
+         file_ = nullptr;
+
+         throw;
+      }
 
+      try
+      {
          unusedLogicalStart_ = sizeof( E57FileHeader );
 
          // Do the parse, building up the node tree
-         parser.parse( xmlSection );
+         readXmlSection();
+
+         // Freeze the lazy lookup structures now, so a read-only tree is immutable from
+         // here on and can be queried from several threads without locking
+         root_->buildLookupIndexesRecursive();
+
+         // The header and XML section above were verified eagerly; with the tiered
+         // policy the data pages read from here on are verified in the background
+         if ( checksumPolicy == ChecksumTiered )
+         {
+            file_->beginDeferredVerification();
+         }
       }
       catch ( ... )
       {
@@ -244,15 +468,109 @@ namespace e57
       }
    }
 
+   /// Parse the XML section of the file into the node tree rooted at root_.
+   /// When the built-in subset parser is enabled it is tried first; Xerces remains the
+   /// conformance fallback for any file the built-in parser can't tokenize.
+   void ImageFileImpl::readXmlSection()
+   {
+      ImageFileImplSharedPtr imf = shared_from_this();
+
+      ustring cachePath;
+      E57FileHeader header;
+
+      if ( useSidecarCache_ )
+      {
+         cachePath = fileName_ + ".e57cache";
+
+         // The raw file header (physical length, XML section offsets) identifies the
+         // source file; any rewrite of the file changes it and invalidates the sidecar.
+         readFileHeader( file_, header );
+
+         std::shared_ptr<StructureNodeImpl> cachedRoot = SidecarCache::load(
+            imf, cachePath, reinterpret_cast<const char *>( &header ), sizeof( header ) );
+
+         if ( cachedRoot )
+         {
+            root_ = cachedRoot;
+            return;
+         }
+
+         // A rejected sidecar may have registered some extensions before it was found bad
+         nameSpaces_.clear();
+      }
+
+      bool parsed = false;
+
+#ifdef E57_BUILTIN_XML_PARSER
+      try
+      {
+         BuiltinXmlParser parser( imf );
+
+         parser.parse( file_, xmlLogicalOffset_, xmlLogicalLength_ );
+
+         parsed = true;
+      }
+      catch ( E57Exception &ex )
+      {
+         // ErrorXMLParser marks a construct outside the E57 subset (or bad XML); either
+         // way Xerces is authoritative, so undo any partial state and re-parse with it.
+         if ( ex.errorCode() != ErrorXMLParser )
+         {
+            throw;
+         }
+
+         nameSpaces_.clear();
+
+         // Scans reported by the abandoned parse get reported again by the re-parse
+         scansDiscovered_ = 0;
+      }
+#endif
+
+      if ( !parsed )
+      {
+         // Create parser state, attach its event handers to the SAX2 reader
+         E57XmlParser parser( imf );
+
+         parser.init();
+
+         // Create input source (XML section of E57 file turned into a stream).
+         E57XmlFileInputSource xmlSection( file_, xmlLogicalOffset_, xmlLogicalLength_ );
+
+         // Do the parse, building up the node tree
+         parser.parse( xmlSection );
+      }
+
+      if ( useSidecarCache_ )
+      {
+         // First open (or stale sidecar): remember the tree for the next open
+         SidecarCache::save( imf, cachePath, reinterpret_cast<const char *>( &header ),
+                             sizeof( header ) );
+      }
+   }
+
    std::shared_ptr<StructureNodeImpl> ImageFileImpl::root()
    {
       checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+      waitForXmlParse();
 
       return root_;
    }
 
    void ImageFileImpl::close()
    {
+      // An in-flight background parse must land before we tear anything down; its
+      // error (if any) no longer matters since the tree is going away
+      if ( xmlParseFuture_.valid() )
+      {
+         try
+         {
+            xmlParseFuture_.get();
+         }
+         catch ( ... )
+         {
+         }
+      }
+
       // If file already closed, have nothing to do
       if ( file_ == nullptr )
       {
@@ -265,6 +583,11 @@ namespace e57
          xmlLogicalOffset_ = unusedLogicalStart_;
          file_->seek( xmlLogicalOffset_, CheckedFile::Logical );
          uint64_t xmlPhysicalOffset = file_->position( CheckedFile::Physical );
+
+         // The XML section is emitted as many small tokens; stream them through a
+         // bounded buffer so each token doesn't pay a full page checksum cycle
+         file_->beginBufferedWrites();
+
          *file_ << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
 
          //??? need to add name space attributes to e57Root
@@ -276,6 +599,8 @@ namespace e57
             *file_ << " ";
          }
 
+         file_->endBufferedWrites();
+
          // Note logical length
          xmlLogicalLength_ = file_->position( CheckedFile::Logical ) - xmlLogicalOffset_;
 
@@ -307,6 +632,18 @@ namespace e57
 
    void ImageFileImpl::cancel()
    {
+      // As in close(), wait out any background parse before touching the file
+      if ( xmlParseFuture_.valid() )
+      {
+         try
+         {
+            xmlParseFuture_.get();
+         }
+         catch ( ... )
+         {
+         }
+      }
+
       // If file already closed, have nothing to do
       if ( file_ == nullptr )
       {
@@ -383,6 +720,102 @@ namespace e57
       return oldLogicalStart;
    }
 
+   void ImageFileImpl::preallocate( uint64_t expectedSizeBytes )
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      if ( !isWriter_ )
+      {
+         throw E57_EXCEPTION2( ErrorFileReadOnly, "fileName=" + fileName_ );
+      }
+
+      file_->preallocate( expectedSizeBytes );
+   }
+
+   void ImageFileImpl::setMemoryBudget( uint64_t budgetBytes )
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      memoryBudget_ = budgetBytes;
+   }
+
+   uint64_t ImageFileImpl::memoryBudget() const
+   {
+      return memoryBudget_;
+   }
+
+   void ImageFileImpl::setPacketReadAhead( unsigned packetCount )
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      packetReadAhead_ = packetCount;
+   }
+
+   void ImageFileImpl::setPacketCacheSize( unsigned packetCount )
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      packetCacheSize_ = packetCount;
+   }
+
+   void ImageFileImpl::setChecksumMismatchCallback(
+      std::function<void( const E57Exception &ex )> callback )
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      file_->setChecksumMismatchCallback( std::move( callback ) );
+   }
+
+   uint64_t ImageFileImpl::checksumVerifyPending() const
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      return file_->pendingVerifyCount();
+   }
+
+   MemoryUsage ImageFileImpl::memoryUsage() const
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      MemoryUsage usage;
+
+      // The arena only grows, so its current size is also its peak
+      if ( nodeArena_ != nullptr )
+      {
+         usage.nodeTreeBytes = nodeArena_->totalBytes();
+         usage.nodeTreePeakBytes = usage.nodeTreeBytes;
+      }
+
+      usage.packetCacheBytes = packetCacheMem_.live.load();
+      usage.packetCachePeakBytes = packetCacheMem_.peak.load();
+      usage.decodeBufferBytes = decodeBufferMem_.live.load();
+      usage.decodeBufferPeakBytes = decodeBufferMem_.peak.load();
+      usage.encodeBufferBytes = encodeBufferMem_.live.load();
+      usage.encodeBufferPeakBytes = encodeBufferMem_.peak.load();
+
+      return usage;
+   }
+
+   NodeImplSharedPtr ImageFileImpl::canonicalPrototype( const NodeImplSharedPtr &prototype )
+   {
+      // don't checkImageFileOpen, called from the parse itself
+
+      // The cache stays tiny (one entry per distinct prototype), and
+      // isTypeEquivalent() rejects mismatched candidates on its cheap leading
+      // checks (node type, child count) before walking any subtree.
+      for ( const auto &candidate : prototypeCache_ )
+      {
+         if ( candidate->isTypeEquivalent( prototype ) )
+         {
+            return candidate;
+         }
+      }
+
+      prototypeCache_.push_back( prototype );
+
+      return prototype;
+   }
+
    CheckedFile *ImageFileImpl::file() const
    {
       return file_;
@@ -394,6 +827,75 @@ namespace e57
       return fileName_;
    }
 
+   void ImageFileImpl::accumulateReadStats( uint64_t cacheHits, uint64_t cacheMisses,
+                                            uint64_t sharedHits,
+                                            const std::vector<uint64_t> &bytesDecoded )
+   {
+      // don't checkImageFileOpen, called while the file is being torn down
+
+      packetCacheHits_ += cacheHits;
+      packetCacheMisses_ += cacheMisses;
+      packetCacheSharedHits_ += sharedHits;
+
+      if ( bytesDecodedPerChannel_.size() < bytesDecoded.size() )
+      {
+         bytesDecodedPerChannel_.resize( bytesDecoded.size(), 0 );
+      }
+
+      for ( size_t i = 0; i < bytesDecoded.size(); ++i )
+      {
+         bytesDecodedPerChannel_[i] += bytesDecoded[i];
+      }
+   }
+
+   uint64_t ImageFileImpl::packetCacheHits() const
+   {
+      return packetCacheHits_;
+   }
+
+   uint64_t ImageFileImpl::packetCacheMisses() const
+   {
+      return packetCacheMisses_;
+   }
+
+   uint64_t ImageFileImpl::packetCacheSharedHits() const
+   {
+      return packetCacheSharedHits_;
+   }
+
+   bool ImageFileImpl::enableSharedPacketCache()
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      if ( sharedPacketCache_ )
+      {
+         return true;
+      }
+
+      sharedPacketCache_ = SharedPacketCache::attach( file_ );
+
+      return sharedPacketCache_ != nullptr;
+   }
+
+   bool ImageFileImpl::enableMappedRead()
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      return file_->mapForReading();
+   }
+
+   bool ImageFileImpl::enableDirectRead()
+   {
+      checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
+
+      return file_->enableDirectRead();
+   }
+
+   const std::vector<uint64_t> &ImageFileImpl::bytesDecodedPerChannel() const
+   {
+      return bytesDecodedPerChannel_;
+   }
+
    void ImageFileImpl::extensionsAdd( const ustring &prefix, const ustring &uri )
    {
       checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
 
 #include "Common.h"
@@ -34,6 +37,8 @@
 namespace e57
 {
    class CheckedFile;
+   class NodeArena;
+   class SharedPacketCache;
 
    struct E57FileHeader;
    struct NameSpace;
@@ -45,6 +50,16 @@ namespace e57
 
       void construct2( const ustring &fileName, const ustring &mode );
       void construct2( const char *input, uint64_t size );
+      void construct2( std::vector<char> *outBuffer );
+      void construct2( const std::shared_ptr<ReadBackend> &backend );
+
+      /// Read-only open that returns after the header is validated and parses the XML
+      /// section on a background task (see ImageFile::openAsync())
+      void construct2Async( const ustring &fileName,
+                            const std::function<void( int64_t scanIndex )> &scanDiscovered );
+
+      /// Readiness of the background XML parse; already ready for ordinary opens
+      std::shared_future<void> xmlParseComplete() const;
 
       std::shared_ptr<StructureNodeImpl> root();
 
@@ -57,9 +72,48 @@ namespace e57
       ~ImageFileImpl();
 
       uint64_t allocateSpace( uint64_t byteCount, bool doExtendNow );
+      void preallocate( uint64_t expectedSizeBytes );
+      void setMemoryBudget( uint64_t budgetBytes );
+      uint64_t memoryBudget() const;
+      void setPacketReadAhead( unsigned packetCount );
+      void setPacketCacheSize( unsigned packetCount );
+      void setChecksumMismatchCallback( std::function<void( const E57Exception &ex )> callback );
+      uint64_t checksumVerifyPending() const;
+      MemoryUsage memoryUsage() const;
       CheckedFile *file() const;
       ustring fileName() const;
 
+      /// Deduplicate a freshly parsed CompressedVector prototype: if a structurally
+      /// identical tree (per NodeImpl::isTypeEquivalent()) was already seen in this
+      /// file, return that shared instance instead.  Project files repeat one
+      /// prototype across hundreds of scans, so this collapses thousands of duplicate
+      /// Float/ScaledInteger/Structure nodes to one subtree.  Only used at parse
+      /// time, where prototypes are immutable once attached.
+      NodeImplSharedPtr canonicalPrototype( const NodeImplSharedPtr &prototype );
+
+      /// Roll up counters from a closing CompressedVectorReaderImpl (see Reader::GetStats())
+      void accumulateReadStats( uint64_t cacheHits, uint64_t cacheMisses, uint64_t sharedHits,
+                                const std::vector<uint64_t> &bytesDecoded );
+      uint64_t packetCacheHits() const;
+      uint64_t packetCacheMisses() const;
+      uint64_t packetCacheSharedHits() const;
+      const std::vector<uint64_t> &bytesDecodedPerChannel() const;
+
+      /// Attach this file to the cross-process packet cache keyed to its identity (see
+      /// SharedPacketCache).  False when the feature is unavailable; the file keeps
+      /// working with private caching only.
+      bool enableSharedPacketCache();
+
+      /// Switch the underlying read-only file to a whole-file memory mapping (see
+      /// CheckedFile::mapForReading()).  False when the feature is unavailable; the
+      /// file keeps reading through pread().
+      bool enableMappedRead();
+
+      /// Switch the underlying read-only file to page-cache-bypassing direct I/O (see
+      /// CheckedFile::enableDirectRead()).  False when the feature is unavailable; the
+      /// file keeps reading through the page cache.
+      bool enableDirectRead();
+
       /// Manipulate registered extensions in the file
       void extensionsAdd( const ustring &prefix, const ustring &uri );
       bool extensionsLookupPrefix( const ustring &prefix, ustring &uri ) const;
@@ -95,19 +149,31 @@ namespace e57
 
    private:
       friend class E57XmlParser;
+      friend class BuiltinXmlParser;
       friend class BlobNodeImpl;
       friend class CompressedVectorWriterImpl;
       friend class CompressedVectorReaderImpl;
 
       static void readFileHeader( CheckedFile *file, E57FileHeader &header );
 
+      void readXmlSection();
+
+      /// Blocks until a background XML parse (if any) finishes, rethrowing its error.
+      /// Every accessor that touches the tree or the parse products calls this, so an
+      /// openAsync() file behaves exactly like a synchronous open from then on.
+      void waitForXmlParse() const;
+
       void checkImageFileOpen( const char *srcFileName, int srcLineNumber,
                                const char *srcFunctionName ) const;
 
       ustring fileName_;
       bool isWriter_;
-      int writerCount_;
-      int readerCount_;
+      bool useSidecarCache_ = false;
+
+      /// Atomic so CompressedVectorReader sessions can open and close on different
+      /// threads of a read-only file without a data race
+      std::atomic<int> writerCount_;
+      std::atomic<int> readerCount_;
 
       ReadChecksumPolicy checksumPolicy;
 
@@ -125,5 +191,67 @@ namespace e57
 
       /// Smart pointer to metadata tree
       std::shared_ptr<StructureNodeImpl> root_;
+
+      /// Valid only while/after an openAsync(); holds the background parse's outcome
+      std::shared_future<void> xmlParseFuture_;
+
+      /// Set only during an openAsync(); the XML parsers invoke it (on the parse
+      /// thread) as each /data3D entry finishes parsing
+      std::function<void( int64_t scanIndex )> scanDiscoveredCallback_;
+      int64_t scansDiscovered_ = 0;
+
+      /// Rough cap on the memory readers on this file allocate; 0 means no cap
+      uint64_t memoryBudget_ = 0;
+
+      /// Distinct prototype trees seen so far, one entry each (see canonicalPrototype())
+      std::vector<NodeImplSharedPtr> prototypeCache_;
+
+      /// Read statistics accumulated by compressed vector readers as they close
+      uint64_t packetCacheHits_ = 0;
+      uint64_t packetCacheMisses_ = 0;
+      uint64_t packetCacheSharedHits_ = 0;
+      std::vector<uint64_t> bytesDecodedPerChannel_;
+
+      /// Cross-process packet cache every reader session on this file hands to its
+      /// PacketReadCache; null unless enableSharedPacketCache() succeeded
+      std::shared_ptr<SharedPacketCache> sharedPacketCache_;
+
+      /// Packets of background read-ahead each PacketReadCache runs; 0 = off
+      unsigned packetReadAhead_ = 0;
+
+      /// Capacity each PacketReadCache is created with; 0 = the historical default
+      unsigned packetCacheSize_ = 0;
+
+      /// One live/peak byte pair of ImageFile::memoryUsage().  Atomic so reader and
+      /// writer sessions opening and closing on worker threads can bump it directly.
+      struct MemoryCounter
+      {
+         std::atomic<uint64_t> live{ 0 };
+         std::atomic<uint64_t> peak{ 0 };
+
+         void add( uint64_t byteCount )
+         {
+            const uint64_t now = live.fetch_add( byteCount ) + byteCount;
+            uint64_t seenPeak = peak.load();
+
+            while ( now > seenPeak && !peak.compare_exchange_weak( seenPeak, now ) )
+            {
+            }
+         }
+
+         void subtract( uint64_t byteCount )
+         {
+            live.fetch_sub( byteCount );
+         }
+      };
+
+      /// Bumped by reader/writer sessions at their allocation choke points
+      MemoryCounter packetCacheMem_;
+      MemoryCounter decodeBufferMem_;
+      MemoryCounter encodeBufferMem_;
+
+      /// Storage pool of a parsed metadata tree, kept so memoryUsage() can report its
+      /// size; empty for write-mode files (set by the XML parsers)
+      std::shared_ptr<NodeArena> nodeArena_;
    };
 }
@@ -0,0 +1,157 @@
+#pragma once
+/*
+ * Original work Copyright 2009 - 2010 Kevin Ackley (kackley@gwi.net)
+ * Modified work Copyright 2018 - 2020 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "Common.h"
+
+namespace e57
+{
+   /// Bump-pointer storage pool for the NodeImpl tree of one ImageFile.
+   ///
+   /// A big file turns every XML element into a separate heap allocation, which is
+   /// slow to build, slow to traverse (pointer chasing across the heap), and slow
+   /// to tear down at close.  Nodes allocated through an ArenaAllocator instead
+   /// come out of large contiguous blocks; freeing an individual node is a no-op
+   /// and the blocks are released wholesale when the last node referencing the
+   /// arena goes away.
+   ///
+   /// Not thread safe: the arena is only bump-allocated from the single thread
+   /// that parses the XML section.
+   class NodeArena
+   {
+   public:
+      static constexpr size_t BlockSize = 64 * 1024;
+
+      NodeArena() = default;
+
+      NodeArena( const NodeArena & ) = delete;
+      NodeArena &operator=( const NodeArena & ) = delete;
+
+      ~NodeArena()
+      {
+         for ( char *block : blocks_ )
+         {
+            internalDeallocate( block, BlockSize );
+         }
+
+         for ( const auto &entry : oversized_ )
+         {
+            internalDeallocate( entry.first, entry.second );
+         }
+      }
+
+      void *allocate( size_t byteCount, size_t alignment )
+      {
+         // Don't try to pack oversized requests into a block
+         if ( byteCount > BlockSize / 4 )
+         {
+            oversized_.emplace_back( static_cast<char *>( internalAllocate( byteCount ) ),
+                                     byteCount );
+            return oversized_.back().first;
+         }
+
+         // Bump nextByte_ up to the requested alignment (blocks themselves are
+         // aligned for any fundamental type by the underlying allocator)
+         size_t alignedByte = ( nextByte_ + alignment - 1 ) & ~( alignment - 1 );
+
+         if ( blocks_.empty() || alignedByte + byteCount > BlockSize )
+         {
+            blocks_.push_back( static_cast<char *>( internalAllocate( BlockSize ) ) );
+            alignedByte = 0;
+         }
+
+         nextByte_ = alignedByte + byteCount;
+
+         return blocks_.back() + alignedByte;
+      }
+
+      /// Total bytes held by the arena's blocks (see ImageFile::memoryUsage()).  The
+      /// arena never shrinks, so this is both the live count and the high-water mark.
+      size_t totalBytes() const
+      {
+         size_t total = blocks_.size() * BlockSize;
+
+         for ( const auto &entry : oversized_ )
+         {
+            total += entry.second;
+         }
+
+         return total;
+      }
+
+   private:
+      std::vector<char *> blocks_;
+      std::vector<std::pair<char *, size_t>> oversized_;
+      size_t nextByte_ = 0;
+   };
+
+   /// Minimal std allocator over a NodeArena, for use with std::allocate_shared so a
+   /// node and its shared_ptr control block land in one contiguous arena slot.  Each
+   /// allocator copy holds a shared_ptr to the arena, so the arena outlives every
+   /// node allocated from it no matter which one is destroyed last.
+   template <typename T> class ArenaAllocator
+   {
+   public:
+      using value_type = T;
+
+      explicit ArenaAllocator( std::shared_ptr<NodeArena> arena ) : arena_( std::move( arena ) )
+      {
+      }
+
+      template <typename U>
+      ArenaAllocator( const ArenaAllocator<U> &that ) : arena_( that.arena_ )
+      {
+      }
+
+      T *allocate( size_t n )
+      {
+         return static_cast<T *>( arena_->allocate( n * sizeof( T ), alignof( T ) ) );
+      }
+
+      void deallocate( T *, size_t )
+      {
+         // Freed wholesale when the last node referencing the arena goes away
+      }
+
+      std::shared_ptr<NodeArena> arena_;
+   };
+
+   template <typename T, typename U>
+   bool operator==( const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs )
+   {
+      return lhs.arena_ == rhs.arena_;
+   }
+
+   template <typename T, typename U>
+   bool operator!=( const ArenaAllocator<T> &lhs, const ArenaAllocator<U> &rhs )
+   {
+      return lhs.arena_ != rhs.arena_;
+   }
+}
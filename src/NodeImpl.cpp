@@ -147,6 +147,12 @@ void NodeImpl::setAttachedRecursive()
    isAttached_ = true;
 }
 
+void NodeImpl::buildLookupIndexesRecursive()
+{
+   // Terminal node types have no lazy lookup structures; non-terminal types override
+   // this to build theirs and descend
+}
+
 ustring NodeImpl::imageFileName() const
 {
    // don't checkImageFileOpen
@@ -54,6 +54,11 @@ namespace e57
       bool isAttached() const;
       virtual void setAttachedRecursive();
 
+      /// Build any lazy lookup structures now, so a read-only tree is truly immutable
+      /// afterwards and can be queried from several threads without synchronization.
+      /// Called once after the XML section has been parsed.
+      virtual void buildLookupIndexesRecursive();
+
       void setParent( NodeImplSharedPtr parent, const ustring &elementName );
       bool isTypeConstrained();
 
@@ -96,6 +101,13 @@ namespace e57
          return {};
       }
 
+      /// Parsed-path variant used for the descent, so a multi-level pathName is
+      /// only parsed once (instead of unparsed/reparsed at every level).
+      virtual NodeImplSharedPtr lookup( const StringList & /*fields*/, size_t /*level*/ )
+      {
+         return {};
+      }
+
       NodeImplSharedPtr getRoot();
 
       ImageFileImplWeakPtr destImageFile_;
@@ -25,11 +25,19 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 
+#ifdef E57_ZSTD
+#include <zstd.h>
+#endif
+
 #include "CheckedFile.h"
 #include "Packet.h"
+#include "SharedPacketCache.h"
 #include "StringFunctions.h"
+#include "Trace.h"
 
 using namespace e57;
 
@@ -47,16 +55,119 @@ struct EmptyPacketHeader
 #endif
 };
 
+//=============================================================================
+// Process-wide packet cache budget (see SetPacketCacheBudget() in E57Format.h)
+
+namespace
+{
+   /// 0 = unlimited.  Relaxed consistency is fine: the budget is an RSS target, not a
+   /// hard allocation limit.
+   std::atomic<uint64_t> gPacketCacheBudget( 0 );
+   std::atomic<uint64_t> gPacketCacheBytesInUse( 0 );
+
+   /// Floor below which a cache stops shrinking, so interleaved multi-stream reads
+   /// keep working even when the budget is exhausted
+   constexpr unsigned cMinCachePacketCount = 4;
+}
+
+void e57::SetPacketCacheBudget( uint64_t bytes )
+{
+   gPacketCacheBudget.store( bytes );
+}
+
 //=============================================================================
 // PacketReadCache
 
-PacketReadCache::PacketReadCache( CheckedFile *cFile, unsigned packetCount ) :
-   cFile_( cFile ), entries_( packetCount )
+PacketReadCache::PacketReadCache( CheckedFile *cFile, unsigned packetCount,
+                                  std::shared_ptr<SharedPacketCache> sharedCache,
+                                  unsigned readAheadCount ) :
+   cFile_( cFile ), sharedCache_( std::move( sharedCache ) ), readAheadCount_( readAheadCount )
 {
+   prefetchSlots_.resize( readAheadCount_ );
+
    if ( packetCount == 0 )
    {
       throw E57_EXCEPTION2( ErrorInternal, "packetCount=" + toString( packetCount ) );
    }
+
+   // Fit into the process-wide budget, if one is set: claim as many of the requested
+   // buffers as are left, but never fewer than the floor
+   const uint64_t budget = gPacketCacheBudget.load();
+
+   if ( budget != 0 )
+   {
+      const unsigned floor = std::min( packetCount, cMinCachePacketCount );
+      uint64_t used = gPacketCacheBytesInUse.load();
+
+      for ( ;; )
+      {
+         const uint64_t available = ( used < budget ) ? ( budget - used ) : 0;
+         const auto affordable = static_cast<unsigned>(
+            std::min<uint64_t>( packetCount, available / DATA_PACKET_MAX ) );
+         const unsigned claimed = std::max( affordable, floor );
+         const uint64_t claimedBytes = static_cast<uint64_t>( claimed ) * DATA_PACKET_MAX;
+
+         if ( gPacketCacheBytesInUse.compare_exchange_weak( used, used + claimedBytes ) )
+         {
+            packetCount = claimed;
+            budgetedBytes_ = claimedBytes;
+            break;
+         }
+      }
+   }
+
+   entries_.resize( packetCount );
+
+   // Allocate all the packet buffers in one block, aligned to the page size (DATA_PACKET_MAX
+   // is a multiple of it, so aligning the base aligns every buffer).  The bytes are not
+   // initialized here on purpose; see the bufferStorage_ comment in the header.
+   constexpr size_t cPageSize = 4096;
+
+   bufferStorageBytes_ = static_cast<size_t>( packetCount ) * DATA_PACKET_MAX + cPageSize;
+   bufferStorage_ = static_cast<char *>( internalAllocate( bufferStorageBytes_ ) );
+
+   const auto base = reinterpret_cast<uintptr_t>( bufferStorage_ );
+   const uintptr_t alignedBase =
+      ( base + cPageSize - 1 ) & ~static_cast<uintptr_t>( cPageSize - 1 );
+
+   auto buffers = reinterpret_cast<char *>( alignedBase );
+
+   for ( unsigned i = 0; i < packetCount; ++i )
+   {
+      entries_[i].buffer_ = &buffers[static_cast<size_t>( i ) * DATA_PACKET_MAX];
+   }
+
+   // Chain the (all empty) entries into the LRU list; misses recycle from the tail
+   for ( unsigned i = 0; i < packetCount; ++i )
+   {
+      entries_[i].lruPrev_ = ( i == 0 ) ? cNoEntry : ( i - 1 );
+      entries_[i].lruNext_ = ( i == packetCount - 1 ) ? cNoEntry : ( i + 1 );
+   }
+
+   lruHead_ = 0;
+   lruTail_ = packetCount - 1;
+
+   index_.reserve( packetCount );
+}
+
+PacketReadCache::~PacketReadCache()
+{
+   if ( prefetchThread_.joinable() )
+   {
+      {
+         std::lock_guard<std::mutex> lock( prefetchMutex_ );
+
+         prefetchStop_ = true;
+      }
+
+      prefetchCV_.notify_one();
+      prefetchThread_.join();
+   }
+
+   internalDeallocate( bufferStorage_, bufferStorageBytes_ );
+
+   // Hand our claim back to the process-wide budget
+   gPacketCacheBytesInUse.fetch_sub( budgetedBytes_ );
 }
 
 std::unique_ptr<PacketLock> PacketReadCache::lock( uint64_t packetLogicalOffset, char *&pkt )
@@ -66,6 +177,8 @@ std::unique_ptr<PacketLock> PacketReadCache::lock( uint64_t packetLogicalOffset,
              << std::endl;
 #endif
 
+   std::lock_guard<std::mutex> lockGuard( mutex_ );
+
    // Only allow one locked packet at a time.
    if ( lockCount_ > 0 )
    {
@@ -79,54 +192,62 @@ std::unique_ptr<PacketLock> PacketReadCache::lock( uint64_t packetLogicalOffset,
                             "packetLogicalOffset=" + toString( packetLogicalOffset ) );
    }
 
-   // Linear scan for matching packet offset in cache
-   for ( unsigned i = 0; i < entries_.size(); ++i )
+   // O(1) lookup for a matching packet offset in the cache
+   const auto match = index_.find( packetLogicalOffset );
+
+   if ( match != index_.end() )
    {
+      const unsigned i = match->second;
       auto &entry = entries_[i];
 
-      if ( packetLogicalOffset == entry.logicalOffset_ )
-      {
-         // Found a match, so don't have to read anything
+      // Found a match, so don't have to read anything
 #ifdef E57_VERBOSE
-         std::cout << "  Found matching cache entry, index=" << i << std::endl;
+      std::cout << "  Found matching cache entry, index=" << i << std::endl;
 #endif
-         // Mark entry with current useCount (keeps track of age of entry).
-         entry.lastUsed_ = ++useCount_;
+      // Mark entry with current useCount (keeps track of age of entry).
+      entry.lastUsed_ = ++useCount_;
 
-         // Publish buffer address to caller
-         pkt = entry.buffer_;
+      touchEntry( i );
 
-         // Create lock so we are sure that we will be unlocked when use is finished.
-         std::unique_ptr<PacketLock> plock( new PacketLock( this, i ) );
+      ++cacheHits_;
 
-         // Increment cache lock just before return
-         ++lockCount_;
+      // Publish buffer address to caller
+      pkt = entry.buffer_;
 
-         return plock;
-      }
+      // Create lock so we are sure that we will be unlocked when use is finished.
+      std::unique_ptr<PacketLock> plock( new PacketLock( this, i ) );
+
+      // Increment cache lock just before return
+      ++lockCount_;
+
+      return plock;
    }
    // Get here if didn't find a match already in cache.
 
-   // Find least recently used (LRU) packet buffer
-   unsigned oldestEntry = 0;
-   unsigned oldestUsed = entries_.at( 0 ).lastUsed_;
+   // Recycle the least recently used packet buffer: the tail of the LRU list
+   const unsigned oldestEntry = lruTail_;
 
-   for ( unsigned i = 0; i < entries_.size(); ++i )
-   {
-      const auto &entry = entries_[i];
-
-      if ( entry.lastUsed_ < oldestUsed )
-      {
-         oldestEntry = i;
-         oldestUsed = entry.lastUsed_;
-      }
-   }
 #ifdef E57_VERBOSE
-   std::cout << "  Oldest entry=" << oldestEntry << " lastUsed=" << oldestUsed << std::endl;
+   std::cout << "  Oldest entry=" << oldestEntry << std::endl;
 #endif
 
+   ++cacheMisses_;
+
+   // Drop the victim's old mapping before its buffer is overwritten; if the read below
+   // throws, the entry stays unmapped and the next miss recycles it again
+   auto &victim = entries_[oldestEntry];
+
+   if ( victim.logicalOffset_ != 0 )
+   {
+      index_.erase( victim.logicalOffset_ );
+      victim.logicalOffset_ = 0;
+   }
+
    readPacket( oldestEntry, packetLogicalOffset );
 
+   index_[packetLogicalOffset] = oldestEntry;
+   touchEntry( oldestEntry );
+
    // Publish buffer address to caller
    pkt = entries_[oldestEntry].buffer_;
 
@@ -139,6 +260,58 @@ std::unique_ptr<PacketLock> PacketReadCache::lock( uint64_t packetLogicalOffset,
    return plock;
 }
 
+unsigned PacketReadCache::packetLengthOnDisk( uint64_t packetLogicalOffset )
+{
+   char *anyPacket = nullptr;
+
+   // Pin the packet so its entry can't be recycled while we look up the length.  A cache hit
+   // is just a scan of entries_, so this costs little when the caller examined the packet
+   // moments ago (the usual case while walking a section).
+   std::unique_ptr<PacketLock> packetLock = lock( packetLogicalOffset, anyPacket );
+
+   const auto match = index_.find( packetLogicalOffset );
+
+   if ( match != index_.end() )
+   {
+      return entries_[match->second].diskLength_;
+   }
+
+   throw E57_EXCEPTION2( ErrorInternal,
+                         "packetLogicalOffset=" + toString( packetLogicalOffset ) );
+}
+
+void PacketReadCache::touchEntry( unsigned index )
+{
+   if ( lruHead_ == index )
+   {
+      return;
+   }
+
+   auto &entry = entries_[index];
+
+   // Unlink from the current position
+   if ( entry.lruPrev_ != cNoEntry )
+   {
+      entries_[entry.lruPrev_].lruNext_ = entry.lruNext_;
+   }
+
+   if ( entry.lruNext_ != cNoEntry )
+   {
+      entries_[entry.lruNext_].lruPrev_ = entry.lruPrev_;
+   }
+
+   if ( lruTail_ == index )
+   {
+      lruTail_ = entry.lruPrev_;
+   }
+
+   // Push onto the front (most recently used end)
+   entry.lruPrev_ = cNoEntry;
+   entry.lruNext_ = lruHead_;
+   entries_[lruHead_].lruPrev_ = index;
+   lruHead_ = index;
+}
+
 void PacketReadCache::unlock( unsigned cacheIndex )
 {
    //??? why lockedEntry not used?
@@ -148,6 +321,8 @@ void PacketReadCache::unlock( unsigned cacheIndex )
    E57_UNUSED( cacheIndex );
 #endif
 
+   std::lock_guard<std::mutex> lockGuard( mutex_ );
+
    if ( lockCount_ != 1 )
    {
       throw E57_EXCEPTION2( ErrorInternal, "lockCount=" + toString( lockCount_ ) );
@@ -156,6 +331,38 @@ void PacketReadCache::unlock( unsigned cacheIndex )
    --lockCount_;
 }
 
+namespace
+{
+   /// Structural checks on a packet image fetched from the shared-memory cache.  The
+   /// bytes were CRC-verified by whichever process read them from disk, but a slot can
+   /// still hold a torn or foreign image, so validate its shape before anything
+   /// downstream trusts its length fields.  A ZSTD_PACKET is cached in decompressed
+   /// form, so only the three plain image types can appear here.
+   void verifyCachedPacketImage( char *buffer, unsigned dataLength )
+   {
+      switch ( static_cast<uint8_t>( buffer[0] ) )
+      {
+         case DATA_PACKET:
+            reinterpret_cast<DataPacket *>( buffer )->verify( dataLength );
+            break;
+
+         case INDEX_PACKET:
+            reinterpret_cast<IndexPacket *>( buffer )->verify( dataLength );
+            break;
+
+         case EMPTY_PACKET:
+            reinterpret_cast<EmptyPacketHeader *>( buffer )->verify( dataLength );
+            break;
+
+         default:
+            throw E57_EXCEPTION2( ErrorBadCVPacket,
+                                  "packetType=" +
+                                     toString( static_cast<unsigned>(
+                                        static_cast<uint8_t>( buffer[0] ) ) ) );
+      }
+   }
+}
+
 void PacketReadCache::readPacket( unsigned oldestEntry, uint64_t packetLogicalOffset )
 {
 #ifdef E57_VERBOSE
@@ -163,27 +370,78 @@ void PacketReadCache::readPacket( unsigned oldestEntry, uint64_t packetLogicalOf
              << " packetLogicalOffset=" << packetLogicalOffset << std::endl;
 #endif
 
+   auto &entry = entries_.at( oldestEntry );
+
+   // When a shared-memory cache is attached, another process may already have read (and
+   // for a ZSTD_PACKET, decompressed) this packet; a successful fetch skips the disk
+   // entirely.
+   if ( sharedCache_ )
+   {
+      unsigned dataLength = 0;
+      unsigned diskLength = 0;
+
+      if ( sharedCache_->fetch( packetLogicalOffset, entry.buffer_, dataLength, diskLength ) )
+      {
+         try
+         {
+            verifyCachedPacketImage( entry.buffer_, dataLength );
+
+            entry.logicalOffset_ = packetLogicalOffset;
+            entry.diskLength_ = diskLength;
+            entry.lastUsed_ = ++useCount_;
+
+            ++sharedCacheHits_;
+
+            return;
+         }
+         catch ( E57Exception & )
+         {
+            // The slot held something we can't make sense of; treat the fetch as a miss
+            // and read the packet from the file below
+         }
+      }
+   }
+
    // Read header of packet first to get length.  Use EmptyPacketHeader since  it has the fields
    // common to all packets.
    EmptyPacketHeader header;
 
-   cFile_->seek( packetLogicalOffset, CheckedFile::Logical );
-   cFile_->read( reinterpret_cast<char *>( &header ), sizeof( header ) );
+   // A staged read-ahead image satisfies the miss without touching the file
+   unsigned packetLength = takePrefetched( packetLogicalOffset, entry.buffer_ );
 
-   // Can't verify packet header here, because it is not really an EmptyPacketHeader.
-   unsigned packetLength = header.packetLogicalLengthMinus1 + 1;
+   if ( packetLength == 0 )
+   {
+      cFile_->readAt( reinterpret_cast<char *>( &header ), sizeof( header ),
+                      packetLogicalOffset );
+
+      // Can't verify packet header here, because it is not really an EmptyPacketHeader.
+      packetLength = header.packetLogicalLengthMinus1 + 1;
+
+      // Be paranoid about packetLength before read
+      if ( packetLength > DATA_PACKET_MAX )
+      {
+         throw E57_EXCEPTION2( ErrorBadCVPacket, "packetLength=" + toString( packetLength ) );
+      }
+
+      // Now read in whole packet into preallocated buffer_.  Note buffer is
+      cFile_->readAt( entry.buffer_, packetLength, packetLogicalOffset );
 
-   // Be paranoid about packetLength before read
-   if ( packetLength > DATA_PACKET_MAX )
+      trace::emit( TraceEvent::PacketRead, packetLogicalOffset, packetLength );
+   }
+   else
    {
-      throw E57_EXCEPTION2( ErrorBadCVPacket, "packetLength=" + toString( packetLength ) );
+      // The staged image starts with the packet's real header
+      memcpy( reinterpret_cast<char *>( &header ), entry.buffer_, sizeof( header ) );
    }
 
-   auto &entry = entries_.at( oldestEntry );
+   // Keep the prefetcher a few packets ahead of this read
+   if ( readAheadCount_ != 0 )
+   {
+      schedulePrefetch( packetLogicalOffset + packetLength );
+   }
 
-   // Now read in whole packet into preallocated buffer_.  Note buffer is
-   cFile_->seek( packetLogicalOffset, CheckedFile::Logical );
-   cFile_->read( entry.buffer_, packetLength );
+   // Bytes of buffer_ worth sharing; a ZSTD_PACKET bumps this to its decompressed length
+   unsigned cachedLength = packetLength;
 
    // Verify that packet is good.
    switch ( header.packetType )
@@ -221,15 +479,224 @@ void PacketReadCache::readPacket( unsigned oldestEntry, uint64_t packetLogicalOf
 #endif
       }
       break;
+      case ZSTD_PACKET:
+#ifdef E57_ZSTD
+      {
+         auto zh = reinterpret_cast<ZstdPacketHeader *>( entry.buffer_ );
+
+         zh->verify( packetLength );
+
+         const unsigned uncompressedLength = zh->uncompressedLengthMinus1 + 1;
+         const unsigned compressedLength = zh->compressedLengthMinus1 + 1;
+
+         // Move the compressed bytes aside, then decompress the original DataPacket image
+         // into the cache buffer so downstream code never sees the compressed form.
+         std::vector<char> compressed( &entry.buffer_[sizeof( ZstdPacketHeader )],
+                                       &entry.buffer_[sizeof( ZstdPacketHeader ) +
+                                                      compressedLength] );
+
+         const size_t result = ZSTD_decompress( entry.buffer_, uncompressedLength,
+                                                compressed.data(), compressedLength );
+
+         if ( ZSTD_isError( result ) || result != uncompressedLength )
+         {
+            throw E57_EXCEPTION2( ErrorBadCVPacket, "zstd decompression failed; packetLength=" +
+                                                       toString( packetLength ) );
+         }
+
+         cachedLength = uncompressedLength;
+
+         auto dpkt = reinterpret_cast<DataPacket *>( entry.buffer_ );
+
+         dpkt->verify( uncompressedLength );
+#ifdef E57_VERBOSE
+         std::cout << "  zstd data packet:" << std::endl;
+         dpkt->dump( 4 ); //???
+#endif
+      }
+      break;
+#else
+         // Graceful rejection: the file was written with the zstd packet extension (see
+         // ZSTD_PACKETS_URI) but this library was built without the E57_ZSTD option.
+         throw E57_EXCEPTION2( ErrorBadCVPacket,
+                               "file uses the zstd packet extension; rebuild with E57_ZSTD" );
+#endif
       default:
          throw E57_EXCEPTION2( ErrorInternal, "packetType=" + toString( header.packetType ) );
    }
 
    entry.logicalOffset_ = packetLogicalOffset;
 
+   // Remember how long the packet is on disk; for a ZSTD_PACKET this differs from the
+   // length field of the (decompressed) header now in buffer_.
+   entry.diskLength_ = packetLength;
+
    // Mark entry with current useCount (keeps track of age of entry).
    // This is a cache, so a small hiccup when useCount_ overflows won't hurt.
    entry.lastUsed_ = ++useCount_;
+
+   // Offer the verified (and, for zstd, decompressed) image to the other processes
+   if ( sharedCache_ )
+   {
+      sharedCache_->publish( packetLogicalOffset, entry.buffer_, cachedLength, packetLength );
+   }
+}
+
+/// Consume a staged read-ahead image: copy it into dest and return its on-disk logical
+/// length, or return 0 when the packet is not staged (including when read-ahead is off)
+unsigned PacketReadCache::takePrefetched( uint64_t packetLogicalOffset, char *dest )
+{
+   if ( readAheadCount_ == 0 )
+   {
+      return 0;
+   }
+
+   std::lock_guard<std::mutex> lock( prefetchMutex_ );
+
+   for ( auto &slot : prefetchSlots_ )
+   {
+      if ( ( slot.length_ != 0 ) && ( slot.offset_ == packetLogicalOffset ) )
+      {
+         const unsigned length = slot.length_;
+
+         memcpy( dest, slot.bytes_.data(), length );
+         slot.length_ = 0;
+
+         return length;
+      }
+   }
+
+   return 0;
+}
+
+/// Point the prefetcher at the packet following the one just read.  The thread starts
+/// lazily on the first call, so caches that never miss never pay for it.
+void PacketReadCache::schedulePrefetch( uint64_t packetLogicalOffset )
+{
+   {
+      std::lock_guard<std::mutex> lock( prefetchMutex_ );
+
+      prefetchFrom_ = packetLogicalOffset;
+
+      if ( !prefetchThread_.joinable() )
+      {
+         prefetchThread_ = std::thread( [this]() { prefetcherLoop(); } );
+      }
+   }
+
+   prefetchCV_.notify_one();
+}
+
+/// Walk up to readAheadCount_ packets forward from the last requested offset, staging
+/// each raw on-disk image in the ring.  The section's end isn't known here, so the walk
+/// just stops at anything that doesn't look like a packet (or at the end of the file);
+/// a stray staged image is harmless because takePrefetched() matches exact offsets.
+void PacketReadCache::prefetcherLoop()
+{
+   std::vector<char> image( DATA_PACKET_MAX );
+
+   std::unique_lock<std::mutex> lock( prefetchMutex_ );
+
+   for ( ;; )
+   {
+      prefetchCV_.wait( lock, [this] { return prefetchStop_ || ( prefetchFrom_ != 0 ); } );
+
+      if ( prefetchStop_ )
+      {
+         return;
+      }
+
+      uint64_t offset = prefetchFrom_;
+
+      prefetchFrom_ = 0;
+
+      for ( unsigned i = 0; i < readAheadCount_; ++i )
+      {
+         // Already staged from an earlier walk; just skip over it
+         unsigned stagedLength = 0;
+
+         for ( const auto &slot : prefetchSlots_ )
+         {
+            if ( ( slot.length_ != 0 ) && ( slot.offset_ == offset ) )
+            {
+               stagedLength = slot.length_;
+               break;
+            }
+         }
+
+         if ( stagedLength != 0 )
+         {
+            offset += stagedLength;
+            continue;
+         }
+
+         lock.unlock();
+
+         unsigned packetLength = 0;
+
+         try
+         {
+            EmptyPacketHeader header;
+
+            cFile_->readAt( reinterpret_cast<char *>( &header ), sizeof( header ), offset );
+
+            packetLength = header.packetLogicalLengthMinus1 + 1;
+
+            if ( packetLength > DATA_PACKET_MAX )
+            {
+               // Not a packet header; probably walked past the section's end
+               packetLength = 0;
+            }
+            else
+            {
+               cFile_->readAt( image.data(), packetLength, offset );
+            }
+         }
+         catch ( E57Exception & )
+         {
+            // Off the end of the file, or a bad page; the foreground read will
+            // surface any real error to the caller
+            packetLength = 0;
+         }
+
+         lock.lock();
+
+         if ( prefetchStop_ )
+         {
+            return;
+         }
+
+         if ( packetLength == 0 )
+         {
+            break;
+         }
+
+         const auto type = static_cast<uint8_t>( image[0] );
+
+         if ( ( type != DATA_PACKET ) && ( type != INDEX_PACKET ) && ( type != EMPTY_PACKET ) &&
+              ( type != ZSTD_PACKET ) )
+         {
+            break;
+         }
+
+         auto &slot = prefetchSlots_[prefetchNextSlot_];
+
+         prefetchNextSlot_ = ( prefetchNextSlot_ + 1 ) % readAheadCount_;
+
+         slot.bytes_.resize( DATA_PACKET_MAX );
+         memcpy( slot.bytes_.data(), image.data(), packetLength );
+         slot.offset_ = offset;
+         slot.length_ = packetLength;
+
+         offset += packetLength;
+
+         // A newer request supersedes the rest of this walk
+         if ( prefetchFrom_ != 0 )
+         {
+            break;
+         }
+      }
+   }
 }
 
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
@@ -525,6 +992,65 @@ void DataPacket::dump( int indent, std::ostream &os ) const
 }
 #endif
 
+//=============================================================================
+// ZstdPacketHeader
+
+ZstdPacketHeader::ZstdPacketHeader()
+{
+   // Double check that packet struct is correct length.  Watch out for RTTI increasing the size.
+   static_assert( sizeof( ZstdPacketHeader ) == 8, "Unexpected size of ZstdPacketHeader" );
+}
+
+void ZstdPacketHeader::verify( unsigned bufferLength ) const
+{
+   // Verify that packet is correct type
+   // cppcheck-suppress knownConditionTrueFalse; (data is read as a blob, so the const might not
+   // be valid)
+   if ( packetType != ZSTD_PACKET )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket,
+                            "expected Zstd; packetType=" + toString( packetType ) );
+   }
+
+   const unsigned packetLength = packetLogicalLengthMinus1 + 1;
+   const unsigned compressedLength = compressedLengthMinus1 + 1;
+   const unsigned uncompressedLength = uncompressedLengthMinus1 + 1;
+
+   // Check packetLength is at least large enough to hold header
+   if ( packetLength < sizeof( *this ) )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket, "ZSTD; packetLength=" + toString( packetLength ) );
+   }
+
+   // Check packet length is multiple of 4
+   if ( packetLength % 4 )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket, "ZSTD; packetLength=" + toString( packetLength ) );
+   }
+
+   // Check actual packet length is large enough.
+   if ( bufferLength > 0 && packetLength > bufferLength )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket, "ZSTD; packetLength=" + toString( packetLength ) +
+                                                 " bufferLength=" + toString( bufferLength ) );
+   }
+
+   // The compressed bytes must fit inside the on-disk packet...
+   if ( sizeof( *this ) + compressedLength > packetLength )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket,
+                            "ZSTD; compressedLength=" + toString( compressedLength ) +
+                               " packetLength=" + toString( packetLength ) );
+   }
+
+   // ...and the decompressed DataPacket image must fit in a packet buffer
+   if ( uncompressedLength > DATA_PACKET_MAX )
+   {
+      throw E57_EXCEPTION2( ErrorBadCVPacket,
+                            "ZSTD; uncompressedLength=" + toString( uncompressedLength ) );
+   }
+}
+
 //=============================================================================
 // IndexPacket
 IndexPacket::IndexPacket()
@@ -27,7 +27,12 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
@@ -36,6 +41,7 @@ namespace e57
 {
    class CheckedFile;
    class PacketLock;
+   class SharedPacketCache;
 
    // Packet types (in a compressed vector section)
    enum
@@ -43,6 +49,11 @@ namespace e57
       INDEX_PACKET = 0,
       DATA_PACKET,
       EMPTY_PACKET,
+
+      // Vendor extension (see ZSTD_PACKETS_URI and the E57_ZSTD build option): a whole
+      // DataPacket image compressed with zstd.  The value is deliberately far away from the
+      // ASTM-assigned types so a future revision of the standard is unlikely to collide.
+      ZSTD_PACKET = 0x5a,
    };
 
    // Maximum size of CompressedVector binary data packet
@@ -51,11 +62,54 @@ namespace e57
    class PacketReadCache
    {
    public:
-      PacketReadCache( CheckedFile *cFile, unsigned packetCount );
+      /// packetCount is a request: when a process-wide budget is set (see
+      /// SetPacketCacheBudget()), the cache claims only its share of what is left,
+      /// down to a small floor.  sharedCache, when non-null, is consulted before the
+      /// file on every miss and fed on every disk read (see SharedPacketCache).
+      /// readAheadCount, when nonzero, turns on background read-ahead: after each miss
+      /// a prefetcher thread stages up to that many following packets, overlapping
+      /// their I/O (and CRC work) with the caller's decoding.
+      PacketReadCache( CheckedFile *cFile, unsigned packetCount,
+                       std::shared_ptr<SharedPacketCache> sharedCache = nullptr,
+                       unsigned readAheadCount = 0 );
+      ~PacketReadCache();
 
       std::unique_ptr<PacketLock> lock( uint64_t packetLogicalOffset,
                                         char *&pkt ); //??? pkt could be const
 
+      /// On-disk logical length of the packet at packetLogicalOffset.  For most packets this
+      /// equals the length field of the cached header, but a ZSTD_PACKET is cached in
+      /// decompressed form, so packet walking code must ask here instead of the cached header.
+      /// Must not be called while a PacketLock is held.
+      unsigned packetLengthOnDisk( uint64_t packetLogicalOffset );
+
+      /// Cheap always-on counters feeding Reader::GetStats().  Every miss fetches one
+      /// packet from outside this cache (the file, or the shared-memory cache when one
+      /// is attached - see sharedCacheHits()).
+      uint64_t cacheHits() const
+      {
+         return cacheHits_;
+      }
+
+      uint64_t cacheMisses() const
+      {
+         return cacheMisses_;
+      }
+
+      /// Of the misses, how many were satisfied from the shared-memory cache instead of
+      /// the file (always 0 without a SharedPacketCache)
+      uint64_t sharedCacheHits() const
+      {
+         return sharedCacheHits_;
+      }
+
+      /// Bytes held by the entry buffers, fixed at construction (feeds
+      /// ImageFile::memoryUsage())
+      size_t storageBytes() const
+      {
+         return bufferStorageBytes_;
+      }
+
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
       void dump( int indent = 0, std::ostream &os = std::cout );
 #endif
@@ -68,18 +122,85 @@ namespace e57
 
       void readPacket( unsigned oldestEntry, uint64_t packetLogicalOffset );
 
+      /// Background read-ahead (see readAheadCount in the constructor).  The prefetcher
+      /// walks the packets following the last miss - each packet carries its own length,
+      /// and the section lays them out back to back - and stages their raw on-disk
+      /// images in a small ring; readPacket() then consumes a staged image instead of
+      /// issuing file reads.
+      void schedulePrefetch( uint64_t packetLogicalOffset );
+      unsigned takePrefetched( uint64_t packetLogicalOffset, char *dest );
+      void prefetcherLoop();
+
+      struct PrefetchSlot
+      {
+         uint64_t offset_ = 0;
+         unsigned length_ = 0; // on-disk logical length; 0 marks the slot empty
+         std::vector<char> bytes_;
+      };
+
+      /// Marks an absent neighbor in the intrusive LRU list below
+      static constexpr unsigned cNoEntry = 0xFFFFFFFFu;
+
       struct CacheEntry
       {
          uint64_t logicalOffset_ = 0;
-         char buffer_[DATA_PACKET_MAX]; // No need to init since it's a data buffer
+         char *buffer_ = nullptr; // DATA_PACKET_MAX bytes inside bufferStorage_
          unsigned lastUsed_ = 0;
+         unsigned diskLength_ = 0; // on-disk logical length (buffer_ may hold more, see lock())
+
+         // Intrusive doubly-linked LRU list threaded through entries_ by index, so
+         // picking a victim is O(1) however large the cache is configured
+         unsigned lruPrev_ = cNoEntry;
+         unsigned lruNext_ = cNoEntry;
       };
 
+      /// Move an entry to the front (most recently used end) of the LRU list
+      void touchEntry( unsigned index );
+
       unsigned lockCount_ = 0;
       unsigned useCount_ = 0;
+      uint64_t cacheHits_ = 0;
+      uint64_t cacheMisses_ = 0;
+      uint64_t sharedCacheHits_ = 0;
       CheckedFile *cFile_ = nullptr;
 
+      /// Optional cross-process cache, shared with every reader of this file
+      std::shared_ptr<SharedPacketCache> sharedCache_;
+
+      /// Bytes claimed from the process-wide cache budget, released by the destructor
+      uint64_t budgetedBytes_ = 0;
+
       std::vector<CacheEntry> entries_;
+
+      /// O(1) lookup by packet offset; holds exactly the entries with a valid
+      /// logicalOffset_.  lruHead_/lruTail_ are the most/least recently used entry.
+      std::unordered_map<uint64_t, unsigned> index_;
+      unsigned lruHead_ = 0;
+      unsigned lruTail_ = 0;
+
+      /// Backing store for all the entry buffers, kept separate from the metadata so the LRU
+      /// scan over entries_ doesn't pull packet bytes through the cache, and each buffer can
+      /// be aligned to a page boundary.  The bytes are deliberately left uninitialized: the
+      /// pages are first touched by whichever thread reads a packet into them, which places
+      /// them on that thread's NUMA node under a first-touch allocation policy.  Owned raw
+      /// so it can come from the hooks installed with SetMemoryAllocator(); released by the
+      /// destructor via internalDeallocate().
+      char *bufferStorage_ = nullptr;
+      size_t bufferStorageBytes_ = 0;
+
+      /// Serializes lock()/unlock() so packets can be pinned from worker threads
+      std::mutex mutex_;
+
+      /// Read-ahead state, all under its own lock so the prefetcher never contends
+      /// with lock()/unlock().  The thread starts lazily on the first miss.
+      unsigned readAheadCount_ = 0;
+      std::vector<PrefetchSlot> prefetchSlots_;
+      unsigned prefetchNextSlot_ = 0;
+      uint64_t prefetchFrom_ = 0; // next offset to walk from; 0 = nothing requested
+      bool prefetchStop_ = false;
+      std::mutex prefetchMutex_;
+      std::condition_variable prefetchCV_;
+      std::thread prefetchThread_;
    };
 
    class PacketLock
@@ -148,6 +269,25 @@ namespace e57
       uint8_t payload[PayloadSize]; // No need to init since it's a data buffer
    };
 
+   /// Header of a ZSTD_PACKET: a whole DataPacket image (header, bytestream buffer lengths,
+   /// payload and zero padding) compressed with zstd.  packetLogicalLengthMinus1 covers the
+   /// on-disk packet (this header + compressed bytes + zero padding to a multiple of 4), so
+   /// packet walking code can skip one without understanding its contents.
+   class ZstdPacketHeader
+   {
+   public:
+      ZstdPacketHeader();
+
+      void verify( unsigned bufferLength = 0 ) const;
+
+      const uint8_t packetType = ZSTD_PACKET;
+
+      uint8_t packetFlags = 0;
+      uint16_t packetLogicalLengthMinus1 = 0;
+      uint16_t uncompressedLengthMinus1 = 0;
+      uint16_t compressedLengthMinus1 = 0;
+   };
+
    class IndexPacketHeader
    {
    public:
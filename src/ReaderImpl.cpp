@@ -26,8 +26,18 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
-#include "ReaderImpl.h"
+#include <atomic>
+#include <thread>
+
+// Common.h must precede ReaderImpl.h so E57_INTERNAL_IMPLEMENTATION_ENABLE is
+// defined before E57Format.h is pulled in (GetStats() needs ImageFile::impl()).
 #include "Common.h"
+
+#include "ReaderImpl.h"
+#include "CheckedFile.h"
+#include "CompressedVectorReaderImpl.h"
+#include "Executor.h"
+#include "ImageFileImpl.h"
 #include "StringFunctions.h"
 
 namespace e57
@@ -189,10 +199,44 @@ namespace e57
    }
 
    ReaderImpl::ReaderImpl( const ustring &filePath, const ReaderOptions &options ) :
-      imf_( filePath, "r", options.checksumPolicy ), root_( imf_.root() ),
+      imf_( filePath, options.sidecarMetadataCache ? "rc" : "r", options.checksumPolicy ),
+      root_( imf_.root() ),
       data3D_( root_.isDefined( "/data3D" ) ? root_.get( "/data3D" ) : VectorNode( imf_ ) ),
-      images2D_( root_.isDefined( "/images2D" ) ? root_.get( "/images2D" ) : VectorNode( imf_ ) )
+      images2D_( root_.isDefined( "/images2D" ) ? root_.get( "/images2D" ) : VectorNode( imf_ ) ),
+      options_( options )
    {
+      if ( options.memoryBudget != 0 )
+      {
+         imf_.setMemoryBudget( options.memoryBudget );
+      }
+
+      if ( options.sharedPacketCache )
+      {
+         // Best-effort: where shared memory is unavailable, stay on private caching
+         imf_.enableSharedPacketCache();
+      }
+
+      if ( options.mappedRead )
+      {
+         // Best-effort: where mmap is unavailable, stay on the positioned-read path
+         imf_.enableMappedRead();
+      }
+
+      if ( options.directRead )
+      {
+         // Best-effort: where direct I/O is unavailable, stay on cached reads
+         imf_.enableDirectRead();
+      }
+
+      if ( options.packetReadAhead != 0 )
+      {
+         imf_.setPacketReadAhead( options.packetReadAhead );
+      }
+
+      if ( options.packetCacheSize != 0 )
+      {
+         imf_.setPacketCacheSize( options.packetCacheSize );
+      }
    }
 
    ReaderImpl::~ReaderImpl()
@@ -265,6 +309,32 @@ namespace e57
       return true;
    }
 
+   // Returns runtime statistics accumulated while reading this file
+   ReaderStats ReaderImpl::GetStats() const
+   {
+      ReaderStats stats;
+
+      if ( !IsOpen() )
+      {
+         return stats;
+      }
+
+      const ImageFileImplSharedPtr imfImpl = imf_.impl();
+
+      stats.packetCacheHits = imfImpl->packetCacheHits();
+      stats.packetCacheMisses = imfImpl->packetCacheMisses();
+      stats.packetCacheSharedHits = imfImpl->packetCacheSharedHits();
+      stats.bytesDecodedPerChannel = imfImpl->bytesDecodedPerChannel();
+
+      const CheckedFile *file = imfImpl->file();
+
+      stats.crcVerifications = file->crcVerifyCount();
+      stats.seekCount = file->seekCount();
+      stats.bytesRead = file->bytesRead();
+
+      return stats;
+   }
+
    int64_t ReaderImpl::GetImage2DCount() const
    {
       return images2D_.childCount();
@@ -613,6 +683,118 @@ namespace e57
       return 0;
    }
 
+   // Reads all images, distributing them over worker threads
+   bool ReaderImpl::ReadAllImages2D(
+      unsigned parallelism,
+      const std::function<bool( int64_t imageIndex, const Image2D &imageHeader,
+                                Image2DProjection imageProjection, Image2DType imageType,
+                                const std::vector<uint8_t> &imageData )> &callback ) const
+   {
+      if ( !callback )
+      {
+         return false;
+      }
+
+      const int64_t imageCount = images2D_.childCount();
+
+      if ( imageCount == 0 )
+      {
+         return true;
+      }
+
+      if ( parallelism == 0 )
+      {
+         parallelism = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      parallelism = static_cast<unsigned>(
+         std::min( static_cast<int64_t>( parallelism ), imageCount ) );
+
+      // Images are claimed from a shared counter so large panoramas and small thumbnails
+      // balance across workers; stopRequested lets a callback cancel the whole read.
+      std::atomic<int64_t> nextImage( 0 );
+      std::atomic<bool> stopRequested( false );
+
+      std::atomic<bool> allOK( true );
+
+      const ustring filePath = imf_.fileName();
+
+      auto readImages = [&]( const ReaderImpl &reader ) {
+         // One blob buffer per worker, reused (and only grown) across its images
+         std::vector<uint8_t> imageData;
+
+         for ( ;; )
+         {
+            const int64_t imageIndex = nextImage.fetch_add( 1 );
+
+            if ( ( imageIndex >= imageCount ) || stopRequested.load() )
+            {
+               break;
+            }
+
+            Image2D imageHeader;
+            Image2DProjection imageProjection = ProjectionNone;
+            Image2DType imageType = ImageNone;
+            Image2DType imageMaskType = ImageNone;
+            Image2DType imageVisualType = ImageNone;
+            int64_t imageWidth = 0;
+            int64_t imageHeight = 0;
+            int64_t imageSize = 0;
+
+            if ( !reader.ReadImage2D( imageIndex, imageHeader ) ||
+                 !reader.GetImage2DSizes( imageIndex, imageProjection, imageType, imageWidth,
+                                          imageHeight, imageSize, imageMaskType,
+                                          imageVisualType ) )
+            {
+               allOK.store( false );
+               continue;
+            }
+
+            imageData.resize( static_cast<size_t>( imageSize ) );
+
+            const size_t bytesRead = reader.ReadImage2DData(
+               imageIndex, imageProjection, imageType, imageData.data(), 0, imageData.size() );
+
+            if ( bytesRead != imageData.size() )
+            {
+               allOK.store( false );
+               continue;
+            }
+
+            if ( !callback( imageIndex, imageHeader, imageProjection, imageType, imageData ) )
+            {
+               stopRequested.store( true );
+               break;
+            }
+         }
+      };
+
+      if ( parallelism <= 1 )
+      {
+         readImages( *this );
+         return allOK.load();
+      }
+
+      Executor::run( parallelism, [&]( unsigned /*workerIndex*/ ) {
+         try
+         {
+            // Every worker opens its own view of the file, so no CheckedFile
+            // seek position or other state is shared between threads.
+            const ReaderImpl reader( filePath, options_ );
+
+            readImages( reader );
+         }
+         catch ( ... )
+         {
+            // Stop the sibling workers promptly; Executor::run() rethrows this
+            stopRequested.store( true );
+            throw;
+         }
+      } );
+
+      return allOK.load();
+   }
+
    bool ReaderImpl::ReadData3D( int64_t dataIndex, Data3D &data3DHeader ) const
    {
       if ( !IsOpen() || ( dataIndex < 0 ) || ( dataIndex >= data3D_.childCount() ) )
@@ -1378,6 +1560,84 @@ namespace e57
       return true;
    }
 
+   bool ReaderImpl::ReadAllData3DHeaders( unsigned parallelism,
+                                          std::vector<Data3D> &data3DHeaders ) const
+   {
+      if ( !IsOpen() )
+      {
+         return false;
+      }
+
+      const int64_t scanCount = data3D_.childCount();
+
+      data3DHeaders.clear();
+      data3DHeaders.resize( static_cast<size_t>( scanCount ) );
+
+      if ( scanCount == 0 )
+      {
+         return true;
+      }
+
+      if ( parallelism == 0 )
+      {
+         parallelism = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      parallelism =
+         static_cast<unsigned>( std::min( static_cast<int64_t>( parallelism ), scanCount ) );
+
+      // Scans are claimed from a shared counter so sparse and richly-attributed scan
+      // headers balance across workers; each header parses into its own output slot.
+      std::atomic<int64_t> nextScan( 0 );
+      std::atomic<bool> stopRequested( false );
+
+      std::atomic<bool> allOK( true );
+
+      const ustring filePath = imf_.fileName();
+
+      auto readHeaders = [&]( const ReaderImpl &reader ) {
+         for ( ;; )
+         {
+            const int64_t dataIndex = nextScan.fetch_add( 1 );
+
+            if ( ( dataIndex >= scanCount ) || stopRequested.load() )
+            {
+               break;
+            }
+
+            if ( !reader.ReadData3D( dataIndex, data3DHeaders[static_cast<size_t>( dataIndex )] ) )
+            {
+               allOK.store( false );
+            }
+         }
+      };
+
+      if ( parallelism <= 1 )
+      {
+         readHeaders( *this );
+         return allOK.load();
+      }
+
+      Executor::run( parallelism, [&]( unsigned /*workerIndex*/ ) {
+         try
+         {
+            // Every worker opens its own view of the file, so no CheckedFile
+            // seek position or other state is shared between threads.
+            const ReaderImpl reader( filePath, options_ );
+
+            readHeaders( reader );
+         }
+         catch ( ... )
+         {
+            // Stop the sibling workers promptly; Executor::run() rethrows this
+            stopRequested.store( true );
+            throw;
+         }
+      } );
+
+      return allOK.load();
+   }
+
    // This function returns the size of the point data
    bool ReaderImpl::GetData3DSizes( int64_t dataIndex, int64_t &row, int64_t &column,
                                     int64_t &pointsSize, int64_t &groupsSize, int64_t &countSize,
@@ -1552,6 +1812,7 @@ namespace e57
 
       CompressedVectorReader reader = groups.reader( groupSDBuffers );
 
+      reader.setDecodeThreadCount( options_.decodeThreadCount );
       reader.read();
       reader.close();
 
@@ -1560,10 +1821,19 @@ namespace e57
 
    template <typename COORDTYPE>
    CompressedVectorReader ReaderImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t count, const Data3DPointsData_t<COORDTYPE> &buffers ) const
+      int64_t dataIndex, size_t count, const Data3DPointsData_t<COORDTYPE> &buffers,
+      size_t stride ) const
    {
       static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
 
+      // stride == 0 means each field is a tightly packed array (the SoA layout of
+      // Data3DPointsData_t).  A nonzero stride means the field pointers address the
+      // fields of the first record in one interleaved (AoS) buffer, with consecutive
+      // records stride bytes apart, so points decode into their final layout.
+      auto fieldStride = [stride]( size_t elementSize ) {
+         return ( stride != 0 ) ? stride : elementSize;
+      };
+
       const StructureNode scan( data3D_.get( dataIndex ) );
       CompressedVectorNode points( scan.get( "points" ) );
       const StructureNode proto( points.prototype() );
@@ -1583,134 +1853,1101 @@ namespace e57
          if ( ( name == "cartesianX" ) && proto.isDefined( "cartesianX" ) &&
               ( buffers.cartesianX != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "cartesianX", buffers.cartesianX, count, true, scaled );
+            destBuffers.emplace_back( imf_, "cartesianX", buffers.cartesianX, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.cartesianX ) ) );
          }
          else if ( ( name == "cartesianY" ) && proto.isDefined( "cartesianY" ) &&
                    ( buffers.cartesianY != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "cartesianY", buffers.cartesianY, count, true, scaled );
+            destBuffers.emplace_back( imf_, "cartesianY", buffers.cartesianY, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.cartesianY ) ) );
          }
          else if ( ( name == "cartesianZ" ) && proto.isDefined( "cartesianZ" ) &&
                    ( buffers.cartesianZ != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "cartesianZ", buffers.cartesianZ, count, true, scaled );
+            destBuffers.emplace_back( imf_, "cartesianZ", buffers.cartesianZ, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.cartesianZ ) ) );
          }
          else if ( ( name == "cartesianInvalidState" ) &&
                    proto.isDefined( "cartesianInvalidState" ) &&
                    ( buffers.cartesianInvalidState != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "cartesianInvalidState", buffers.cartesianInvalidState,
-                                      count, true );
+                                      count, true, false,
+                                      fieldStride( sizeof( *buffers.cartesianInvalidState ) ) );
          }
          else if ( ( name == "sphericalRange" ) && proto.isDefined( "sphericalRange" ) &&
                    ( buffers.sphericalRange != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "sphericalRange", buffers.sphericalRange, count, true,
-                                      scaled );
+                                      scaled, fieldStride( sizeof( *buffers.sphericalRange ) ) );
          }
          else if ( ( name == "sphericalAzimuth" ) && proto.isDefined( "sphericalAzimuth" ) &&
                    ( buffers.sphericalAzimuth != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "sphericalAzimuth", buffers.sphericalAzimuth, count,
-                                      true, scaled );
+                                      true, scaled,
+                                      fieldStride( sizeof( *buffers.sphericalAzimuth ) ) );
          }
          else if ( ( name == "sphericalElevation" ) && proto.isDefined( "sphericalElevation" ) &&
                    ( buffers.sphericalElevation != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "sphericalElevation", buffers.sphericalElevation, count,
-                                      true, scaled );
+                                      true, scaled,
+                                      fieldStride( sizeof( *buffers.sphericalElevation ) ) );
          }
          else if ( ( name == "sphericalInvalidState" ) &&
                    proto.isDefined( "sphericalInvalidState" ) &&
                    ( buffers.sphericalInvalidState != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "sphericalInvalidState", buffers.sphericalInvalidState,
-                                      count, true );
+                                      count, true, false,
+                                      fieldStride( sizeof( *buffers.sphericalInvalidState ) ) );
          }
          else if ( ( name == "rowIndex" ) && proto.isDefined( "rowIndex" ) &&
                    ( buffers.rowIndex != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "rowIndex", buffers.rowIndex, count, true );
+            destBuffers.emplace_back( imf_, "rowIndex", buffers.rowIndex, count, true, false,
+                                      fieldStride( sizeof( *buffers.rowIndex ) ) );
          }
          else if ( ( name == "columnIndex" ) && proto.isDefined( "columnIndex" ) &&
                    ( buffers.columnIndex != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "columnIndex", buffers.columnIndex, count, true );
+            destBuffers.emplace_back( imf_, "columnIndex", buffers.columnIndex, count, true, false,
+                                      fieldStride( sizeof( *buffers.columnIndex ) ) );
          }
          else if ( ( name == "returnIndex" ) && proto.isDefined( "returnIndex" ) &&
                    ( buffers.returnIndex != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "returnIndex", buffers.returnIndex, count, true );
+            destBuffers.emplace_back( imf_, "returnIndex", buffers.returnIndex, count, true, false,
+                                      fieldStride( sizeof( *buffers.returnIndex ) ) );
          }
          else if ( ( name == "returnCount" ) && proto.isDefined( "returnCount" ) &&
                    ( buffers.returnCount != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "returnCount", buffers.returnCount, count, true );
+            destBuffers.emplace_back( imf_, "returnCount", buffers.returnCount, count, true, false,
+                                      fieldStride( sizeof( *buffers.returnCount ) ) );
          }
          else if ( ( name == "timeStamp" ) && proto.isDefined( "timeStamp" ) &&
                    ( buffers.timeStamp != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "timeStamp", buffers.timeStamp, count, true, scaled );
+            destBuffers.emplace_back( imf_, "timeStamp", buffers.timeStamp, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.timeStamp ) ) );
          }
          else if ( ( name == "isTimeStampInvalid" ) && proto.isDefined( "isTimeStampInvalid" ) &&
                    ( buffers.isTimeStampInvalid != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "isTimeStampInvalid", buffers.isTimeStampInvalid, count,
-                                      true );
+                                      true, false,
+                                      fieldStride( sizeof( *buffers.isTimeStampInvalid ) ) );
          }
          else if ( ( name == "intensity" ) && proto.isDefined( "intensity" ) &&
                    ( buffers.intensity != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "intensity", buffers.intensity, count, true, scaled );
+            destBuffers.emplace_back( imf_, "intensity", buffers.intensity, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.intensity ) ) );
          }
          else if ( ( name == "isIntensityInvalid" ) && proto.isDefined( "isIntensityInvalid" ) &&
                    ( buffers.isIntensityInvalid != nullptr ) )
          {
             destBuffers.emplace_back( imf_, "isIntensityInvalid", buffers.isIntensityInvalid, count,
-                                      true );
+                                      true, false,
+                                      fieldStride( sizeof( *buffers.isIntensityInvalid ) ) );
          }
          else if ( ( name == "colorRed" ) && proto.isDefined( "colorRed" ) &&
                    ( buffers.colorRed != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "colorRed", buffers.colorRed, count, true, scaled );
+            destBuffers.emplace_back( imf_, "colorRed", buffers.colorRed, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.colorRed ) ) );
          }
          else if ( ( name == "colorGreen" ) && proto.isDefined( "colorGreen" ) &&
                    ( buffers.colorGreen != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "colorGreen", buffers.colorGreen, count, true, scaled );
+            destBuffers.emplace_back( imf_, "colorGreen", buffers.colorGreen, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.colorGreen ) ) );
          }
          else if ( ( name == "colorBlue" ) && proto.isDefined( "colorBlue" ) &&
                    ( buffers.colorBlue != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "colorBlue", buffers.colorBlue, count, true, scaled );
+            destBuffers.emplace_back( imf_, "colorBlue", buffers.colorBlue, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.colorBlue ) ) );
          }
          else if ( ( name == "isColorInvalid" ) && proto.isDefined( "isColorInvalid" ) &&
                    ( buffers.isColorInvalid != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "isColorInvalid", buffers.isColorInvalid, count, true );
+            destBuffers.emplace_back( imf_, "isColorInvalid", buffers.isColorInvalid, count, true,
+                                      false, fieldStride( sizeof( *buffers.isColorInvalid ) ) );
          }
          else if ( haveNormalsExt && ( name == "nor:normalX" ) &&
                    proto.isDefined( "nor:normalX" ) && ( buffers.normalX != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "nor:normalX", buffers.normalX, count, true, scaled );
+            destBuffers.emplace_back( imf_, "nor:normalX", buffers.normalX, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.normalX ) ) );
          }
          else if ( haveNormalsExt && ( name == "nor:normalY" ) &&
                    proto.isDefined( "nor:normalY" ) && ( buffers.normalY != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "nor:normalY", buffers.normalY, count, true, scaled );
+            destBuffers.emplace_back( imf_, "nor:normalY", buffers.normalY, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.normalY ) ) );
          }
          else if ( haveNormalsExt && ( name == "nor:normalZ" ) &&
                    proto.isDefined( "nor:normalZ" ) && ( buffers.normalZ != nullptr ) )
          {
-            destBuffers.emplace_back( imf_, "nor:normalZ", buffers.normalZ, count, true, scaled );
+            destBuffers.emplace_back( imf_, "nor:normalZ", buffers.normalZ, count, true, scaled,
+                                      fieldStride( sizeof( *buffers.normalZ ) ) );
          }
       }
 
       CompressedVectorReader reader = points.reader( destBuffers );
 
+      reader.setDecodeThreadCount( options_.decodeThreadCount );
+
       return reader;
    }
 
+   // Reads a whole scan through one chunk-sized buffer set
+   template <typename COORDTYPE>
+   bool ReaderImpl::ReadData3DChunks(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      if ( ( dataIndex < 0 ) || ( dataIndex >= data3D_.childCount() ) )
+      {
+         return false;
+      }
+
+      if ( ( chunkSize == 0 ) || !callback )
+      {
+         return false;
+      }
+
+      Data3D header;
+
+      if ( !ReadData3D( dataIndex, header ) )
+      {
+         return false;
+      }
+
+      // Allocate one buffer set sized for a single chunk and stream the whole
+      // compressed vector through it.
+      header.pointCount = std::min( chunkSize, header.pointCount );
+
+      if ( options_.memoryBudget != 0 )
+      {
+         // Leave half the budget for the packet cache and decode state, and shrink the
+         // chunk until the point buffers fit in the rest. Smaller batches cost some
+         // throughput but keep the peak working set where the caller put it.
+         constexpr size_t cMinChunkPointCount = 1024;
+
+         const uint64_t bufferBudget = options_.memoryBudget / 2;
+
+         while ( ( header.pointCount > cMinChunkPointCount ) &&
+                 ( Data3DPointsData_t<COORDTYPE>::estimatedSize( header, header.pointCount ) >
+                   bufferBudget ) )
+         {
+            header.pointCount /= 2;
+         }
+      }
+
+      auto streamThrough = [&]( const Data3DPointsData_t<COORDTYPE> &buffers ) {
+         CompressedVectorReader reader =
+            SetUpData3DPointsData( dataIndex, header.pointCount, buffers );
+
+         unsigned count = 0;
+
+         while ( ( count = reader.read() ) > 0 )
+         {
+            if ( !callback( buffers, count ) )
+            {
+               break;
+            }
+         }
+
+         reader.close();
+      };
+
+      if ( selectedFields != nullptr )
+      {
+         // Only allocate and decode the requested subset of fields
+         const Data3DPointsData_t<COORDTYPE> buffers( header, *selectedFields );
+
+         streamThrough( buffers );
+      }
+      else
+      {
+         const Data3DPointsData_t<COORDTYPE> buffers( header );
+
+         streamThrough( buffers );
+      }
+
+      return true;
+   }
+
+   /// @private
+   /// True when the two boxes share any volume. Default-constructed bounds cover
+   /// everything, so scans or groups with unknown bounds are never culled.
+   static bool _boundsOverlap( const CartesianBounds &a, const CartesianBounds &b )
+   {
+      return ( a.xMinimum <= b.xMaximum ) && ( b.xMinimum <= a.xMaximum ) &&
+             ( a.yMinimum <= b.yMaximum ) && ( b.yMinimum <= a.yMaximum ) &&
+             ( a.zMinimum <= b.zMaximum ) && ( b.zMinimum <= a.zMaximum );
+   }
+
+   /// @private
+   /// Moves the kept elements of one field array to the front, preserving order
+   template <typename T>
+   static void _compactField( T *fieldArray, const std::vector<unsigned> &keepIndices )
+   {
+      if ( fieldArray == nullptr )
+      {
+         return;
+      }
+
+      for ( size_t k = 0; k < keepIndices.size(); ++k )
+      {
+         fieldArray[k] = fieldArray[keepIndices[k]];
+      }
+   }
+
+   /// @private
+   /// Compacts the survivors to the front of every delivered field array
+   template <typename COORDTYPE>
+   static void _compactAllFields( const Data3DPointsData_t<COORDTYPE> &buffers,
+                                  const std::vector<unsigned> &keepIndices )
+   {
+      _compactField( buffers.cartesianX, keepIndices );
+      _compactField( buffers.cartesianY, keepIndices );
+      _compactField( buffers.cartesianZ, keepIndices );
+      _compactField( buffers.cartesianInvalidState, keepIndices );
+
+      _compactField( buffers.intensity, keepIndices );
+      _compactField( buffers.isIntensityInvalid, keepIndices );
+
+      _compactField( buffers.colorRed, keepIndices );
+      _compactField( buffers.colorGreen, keepIndices );
+      _compactField( buffers.colorBlue, keepIndices );
+      _compactField( buffers.isColorInvalid, keepIndices );
+
+      _compactField( buffers.sphericalRange, keepIndices );
+      _compactField( buffers.sphericalAzimuth, keepIndices );
+      _compactField( buffers.sphericalElevation, keepIndices );
+      _compactField( buffers.sphericalInvalidState, keepIndices );
+
+      _compactField( buffers.rowIndex, keepIndices );
+      _compactField( buffers.columnIndex, keepIndices );
+
+      _compactField( buffers.returnIndex, keepIndices );
+      _compactField( buffers.returnCount, keepIndices );
+
+      _compactField( buffers.timeStamp, keepIndices );
+      _compactField( buffers.isTimeStampInvalid, keepIndices );
+
+      _compactField( buffers.normalX, keepIndices );
+      _compactField( buffers.normalY, keepIndices );
+      _compactField( buffers.normalZ, keepIndices );
+   }
+
+   /// @private
+   /// Tight per-type loop of ReadData3DPredicated(): clears keep[i] for records whose
+   /// value falls outside [minimum, maximum].  The compiler vectorizes the comparisons.
+   template <typename T>
+   static void _applyPredicate( const T *values, unsigned count, double minimum, double maximum,
+                                uint8_t *keep )
+   {
+      for ( unsigned i = 0; i < count; ++i )
+      {
+         const double value = static_cast<double>( values[i] );
+
+         keep[i] = static_cast<uint8_t>(
+            keep[i] & static_cast<uint8_t>( ( value >= minimum ) && ( value <= maximum ) ) );
+      }
+   }
+
+   /// @private
+   /// Marks pathName's field in selection so the predicate reader decodes it; false
+   /// when the name is not a standardized numeric field or the scan does not carry it
+   static bool _enablePredicateField( PointStandardizedFieldsAvailable &selection,
+                                      const PointStandardizedFieldsAvailable &available,
+                                      const ustring &pathName )
+   {
+      using FieldsAvailable = PointStandardizedFieldsAvailable;
+
+      struct NamedFlag
+      {
+         const char *name;
+         bool FieldsAvailable::*flag;
+      };
+
+      static const NamedFlag cNamedFlags[] = {
+         { "cartesianX", &FieldsAvailable::cartesianXField },
+         { "cartesianY", &FieldsAvailable::cartesianYField },
+         { "cartesianZ", &FieldsAvailable::cartesianZField },
+         { "sphericalRange", &FieldsAvailable::sphericalRangeField },
+         { "sphericalAzimuth", &FieldsAvailable::sphericalAzimuthField },
+         { "sphericalElevation", &FieldsAvailable::sphericalElevationField },
+         { "intensity", &FieldsAvailable::intensityField },
+         { "colorRed", &FieldsAvailable::colorRedField },
+         { "colorGreen", &FieldsAvailable::colorGreenField },
+         { "colorBlue", &FieldsAvailable::colorBlueField },
+         { "rowIndex", &FieldsAvailable::rowIndexField },
+         { "columnIndex", &FieldsAvailable::columnIndexField },
+         { "returnIndex", &FieldsAvailable::returnIndexField },
+         { "returnCount", &FieldsAvailable::returnCountField },
+         { "timeStamp", &FieldsAvailable::timeStampField },
+         { "nor:normalX", &FieldsAvailable::normalXField },
+         { "nor:normalY", &FieldsAvailable::normalYField },
+         { "nor:normalZ", &FieldsAvailable::normalZField },
+      };
+
+      for ( const NamedFlag &namedFlag : cNamedFlags )
+      {
+         if ( pathName == namedFlag.name )
+         {
+            if ( !( available.*( namedFlag.flag ) ) )
+            {
+               return false;
+            }
+
+            selection.*( namedFlag.flag ) = true;
+            return true;
+         }
+      }
+
+      return false;
+   }
+
+   /// @private
+   /// Resolves one predicate against the decoded field arrays once per scan; the
+   /// returned callable culls a whole batch with one typed pass over the values
+   /// (empty when the field has no buffer)
+   template <typename COORDTYPE>
+   static std::function<void( unsigned count, uint8_t *keep )> _predicateEvaluator(
+      const Data3DPointsData_t<COORDTYPE> &buffers, const FieldPredicate &predicate )
+   {
+      const double minimum = predicate.minimum;
+      const double maximum = predicate.maximum;
+
+      auto makeEvaluator =
+         [minimum, maximum]( const auto *values ) -> std::function<void( unsigned, uint8_t * )> {
+         if ( values == nullptr )
+         {
+            return {};
+         }
+
+         return [values, minimum, maximum]( unsigned count, uint8_t *keep ) {
+            _applyPredicate( values, count, minimum, maximum, keep );
+         };
+      };
+
+      const ustring &pathName = predicate.pathName;
+
+      if ( pathName == "cartesianX" )
+      {
+         return makeEvaluator( buffers.cartesianX );
+      }
+      if ( pathName == "cartesianY" )
+      {
+         return makeEvaluator( buffers.cartesianY );
+      }
+      if ( pathName == "cartesianZ" )
+      {
+         return makeEvaluator( buffers.cartesianZ );
+      }
+      if ( pathName == "sphericalRange" )
+      {
+         return makeEvaluator( buffers.sphericalRange );
+      }
+      if ( pathName == "sphericalAzimuth" )
+      {
+         return makeEvaluator( buffers.sphericalAzimuth );
+      }
+      if ( pathName == "sphericalElevation" )
+      {
+         return makeEvaluator( buffers.sphericalElevation );
+      }
+      if ( pathName == "intensity" )
+      {
+         return makeEvaluator( buffers.intensity );
+      }
+      if ( pathName == "colorRed" )
+      {
+         return makeEvaluator( buffers.colorRed );
+      }
+      if ( pathName == "colorGreen" )
+      {
+         return makeEvaluator( buffers.colorGreen );
+      }
+      if ( pathName == "colorBlue" )
+      {
+         return makeEvaluator( buffers.colorBlue );
+      }
+      if ( pathName == "rowIndex" )
+      {
+         return makeEvaluator( buffers.rowIndex );
+      }
+      if ( pathName == "columnIndex" )
+      {
+         return makeEvaluator( buffers.columnIndex );
+      }
+      if ( pathName == "returnIndex" )
+      {
+         return makeEvaluator( buffers.returnIndex );
+      }
+      if ( pathName == "returnCount" )
+      {
+         return makeEvaluator( buffers.returnCount );
+      }
+      if ( pathName == "timeStamp" )
+      {
+         return makeEvaluator( buffers.timeStamp );
+      }
+      if ( pathName == "nor:normalX" )
+      {
+         return makeEvaluator( buffers.normalX );
+      }
+      if ( pathName == "nor:normalY" )
+      {
+         return makeEvaluator( buffers.normalY );
+      }
+      if ( pathName == "nor:normalZ" )
+      {
+         return makeEvaluator( buffers.normalZ );
+      }
+
+      return {};
+   }
+
+   bool ReaderImpl::_groupCandidateRanges( int64_t dataIndex, const CartesianBounds &filterBounds,
+                                           std::vector<std::pair<size_t, size_t>> &ranges ) const
+   {
+      const StructureNode scan( data3D_.get( dataIndex ) );
+
+      if ( !scan.isDefined( "pointGroupingSchemes" ) )
+      {
+         return false;
+      }
+
+      const StructureNode pointGroupingSchemes( scan.get( "pointGroupingSchemes" ) );
+
+      if ( !pointGroupingSchemes.isDefined( "groupingByLine" ) )
+      {
+         return false;
+      }
+
+      const StructureNode groupingByLine( pointGroupingSchemes.get( "groupingByLine" ) );
+      CompressedVectorNode groups( groupingByLine.get( "groups" ) );
+      const StructureNode lineGroupRecord( groups.prototype() );
+
+      // Per-group bounds are optional in the standard (and this library's writer does
+      // not produce them); without them there is nothing spatial to push the filter into
+      if ( !lineGroupRecord.isDefined( "startPointIndex" ) ||
+           !lineGroupRecord.isDefined( "pointCount" ) ||
+           !lineGroupRecord.isDefined( "cartesianBounds" ) )
+      {
+         return false;
+      }
+
+      static const char *cBoundsNames[6] = { "xMinimum", "xMaximum", "yMinimum",
+                                             "yMaximum", "zMinimum", "zMaximum" };
+
+      const StructureNode boundsProto( lineGroupRecord.get( "cartesianBounds" ) );
+
+      for ( const char *name : cBoundsNames )
+      {
+         if ( !boundsProto.isDefined( name ) )
+         {
+            return false;
+         }
+      }
+
+      const auto groupCount = static_cast<size_t>( groups.childCount() );
+
+      if ( groupCount == 0 )
+      {
+         return false;
+      }
+
+      std::vector<int64_t> startPointIndex( groupCount );
+      std::vector<int64_t> pointCount( groupCount );
+      std::vector<double> bounds[6];
+
+      std::vector<SourceDestBuffer> groupSDBuffers;
+
+      groupSDBuffers.emplace_back( imf_, "startPointIndex", startPointIndex.data(), groupCount,
+                                   true );
+      groupSDBuffers.emplace_back( imf_, "pointCount", pointCount.data(), groupCount, true );
+
+      for ( int i = 0; i < 6; ++i )
+      {
+         bounds[i].resize( groupCount );
+
+         groupSDBuffers.emplace_back( imf_, ustring( "cartesianBounds/" ) + cBoundsNames[i],
+                                      bounds[i].data(), groupCount, true );
+      }
+
+      CompressedVectorReader groupReader = groups.reader( groupSDBuffers );
+
+      groupReader.read();
+      groupReader.close();
+
+      for ( size_t group = 0; group < groupCount; ++group )
+      {
+         CartesianBounds groupBox;
+
+         groupBox.xMinimum = bounds[0][group];
+         groupBox.xMaximum = bounds[1][group];
+         groupBox.yMinimum = bounds[2][group];
+         groupBox.yMaximum = bounds[3][group];
+         groupBox.zMinimum = bounds[4][group];
+         groupBox.zMaximum = bounds[5][group];
+
+         if ( ( pointCount[group] > 0 ) && _boundsOverlap( groupBox, filterBounds ) )
+         {
+            ranges.emplace_back( static_cast<size_t>( startPointIndex[group] ),
+                                 static_cast<size_t>( pointCount[group] ) );
+         }
+      }
+
+      // Merge touching ranges so the chunk walk below sees few, ordered spans
+      std::sort( ranges.begin(), ranges.end() );
+
+      std::vector<std::pair<size_t, size_t>> merged;
+
+      for ( const auto &range : ranges )
+      {
+         if ( !merged.empty() &&
+              ( range.first <= ( merged.back().first + merged.back().second ) ) )
+         {
+            const size_t end = std::max( merged.back().first + merged.back().second,
+                                         range.first + range.second );
+
+            merged.back().second = end - merged.back().first;
+         }
+         else
+         {
+            merged.push_back( range );
+         }
+      }
+
+      ranges.swap( merged );
+
+      return true;
+   }
+
+   // Decodes only the parts of a scan that can contain points inside filterBounds
+   template <typename COORDTYPE>
+   bool ReaderImpl::ReadData3DFiltered(
+      int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+      const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      if ( ( dataIndex < 0 ) || ( dataIndex >= data3D_.childCount() ) )
+      {
+         return false;
+      }
+
+      if ( ( chunkSize == 0 ) || !callback )
+      {
+         return false;
+      }
+
+      Data3D header;
+
+      if ( !ReadData3D( dataIndex, header ) )
+      {
+         return false;
+      }
+
+      // The filter has nothing to test without cartesian coordinates
+      if ( !header.pointFields.cartesianXField || !header.pointFields.cartesianYField ||
+           !header.pointFields.cartesianZField )
+      {
+         return false;
+      }
+
+      // 1. Cull the whole scan on its own bounds
+      if ( !_boundsOverlap( header.cartesianBounds, filterBounds ) )
+      {
+         return true;
+      }
+
+      // 2. Narrow to the record ranges whose group bounds can intersect the filter
+      std::vector<std::pair<size_t, size_t>> ranges;
+
+      if ( !_groupCandidateRanges( dataIndex, filterBounds, ranges ) )
+      {
+         ranges.assign( 1, std::make_pair( static_cast<size_t>( 0 ), header.pointCount ) );
+      }
+
+      if ( ranges.empty() )
+      {
+         // Every group was culled
+         return true;
+      }
+
+      const size_t lastCandidateEnd =
+         std::min( header.pointCount, ranges.back().first + ranges.back().second );
+
+      // The coordinate (and validity) buffers must exist for the in-box test, even when
+      // the caller selected a field subset without them
+      PointStandardizedFieldsAvailable fieldSelection =
+         ( selectedFields != nullptr ) ? *selectedFields : header.pointFields;
+
+      fieldSelection.cartesianXField = true;
+      fieldSelection.cartesianYField = true;
+      fieldSelection.cartesianZField = true;
+      fieldSelection.cartesianInvalidStateField = header.pointFields.cartesianInvalidStateField;
+
+      header.pointCount = std::min( chunkSize, header.pointCount );
+
+      if ( options_.memoryBudget != 0 )
+      {
+         // Budgeted readers shrink the chunk just like ReadData3DChunks()
+         constexpr size_t cMinChunkPointCount = 1024;
+
+         const uint64_t bufferBudget = options_.memoryBudget / 2;
+
+         while ( ( header.pointCount > cMinChunkPointCount ) &&
+                 ( Data3DPointsData_t<COORDTYPE>::estimatedSize( header, header.pointCount ) >
+                   bufferBudget ) )
+         {
+            header.pointCount /= 2;
+         }
+      }
+
+      Data3DPointsData_t<COORDTYPE> buffers( header, fieldSelection );
+
+      CompressedVectorReader reader =
+         SetUpData3DPointsData( dataIndex, header.pointCount, buffers );
+
+      std::vector<unsigned> keepIndices;
+
+      keepIndices.reserve( header.pointCount );
+
+      size_t chunkStart = 0;
+      size_t rangeIndex = 0;
+      bool keepGoing = true;
+      unsigned count = 0;
+
+      // 3. Stream the candidate part of the scan, stopping after the last candidate
+      // record instead of decoding the tail
+      while ( keepGoing && ( chunkStart < lastCandidateEnd ) && ( ( count = reader.read() ) > 0 ) )
+      {
+         keepIndices.clear();
+
+         for ( unsigned i = 0; i < count; ++i )
+         {
+            const size_t record = chunkStart + i;
+
+            while ( ( rangeIndex < ranges.size() ) &&
+                    ( record >= ( ranges[rangeIndex].first + ranges[rangeIndex].second ) ) )
+            {
+               ++rangeIndex;
+            }
+
+            if ( ( rangeIndex >= ranges.size() ) || ( record < ranges[rangeIndex].first ) )
+            {
+               continue;
+            }
+
+            if ( ( buffers.cartesianInvalidState != nullptr ) &&
+                 ( buffers.cartesianInvalidState[i] != 0 ) )
+            {
+               continue;
+            }
+
+            // Plain branch-per-point test; the compiler vectorizes the comparisons
+            const double x = buffers.cartesianX[i];
+            const double y = buffers.cartesianY[i];
+            const double z = buffers.cartesianZ[i];
+
+            if ( ( x >= filterBounds.xMinimum ) && ( x <= filterBounds.xMaximum ) &&
+                 ( y >= filterBounds.yMinimum ) && ( y <= filterBounds.yMaximum ) &&
+                 ( z >= filterBounds.zMinimum ) && ( z <= filterBounds.zMaximum ) )
+            {
+               keepIndices.push_back( i );
+            }
+         }
+
+         chunkStart += count;
+
+         if ( keepIndices.empty() )
+         {
+            continue;
+         }
+
+         // Compact the survivors to the front of every delivered field array
+         _compactAllFields( buffers, keepIndices );
+
+         if ( !callback( buffers, keepIndices.size() ) )
+         {
+            keepGoing = false;
+         }
+      }
+
+      reader.close();
+
+      return true;
+   }
+
+   // Delivers only the valid points of a scan, compacted to the front of the buffers
+   template <typename COORDTYPE>
+   bool ReaderImpl::ReadData3DCompacted(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      if ( ( dataIndex < 0 ) || ( dataIndex >= data3D_.childCount() ) )
+      {
+         return false;
+      }
+
+      if ( ( chunkSize == 0 ) || !callback )
+      {
+         return false;
+      }
+
+      Data3D header;
+
+      if ( !ReadData3D( dataIndex, header ) )
+      {
+         return false;
+      }
+
+      // The mask channel must be decoded even when the caller selected a field subset
+      // without it.  Cartesian validity wins when both parameterizations carry one.
+      PointStandardizedFieldsAvailable fieldSelection =
+         ( selectedFields != nullptr ) ? *selectedFields : header.pointFields;
+
+      fieldSelection.cartesianInvalidStateField = header.pointFields.cartesianInvalidStateField;
+      fieldSelection.sphericalInvalidStateField = header.pointFields.sphericalInvalidStateField;
+
+      header.pointCount = std::min( chunkSize, header.pointCount );
+
+      if ( options_.memoryBudget != 0 )
+      {
+         // Budgeted readers shrink the chunk just like ReadData3DChunks()
+         constexpr size_t cMinChunkPointCount = 1024;
+
+         const uint64_t bufferBudget = options_.memoryBudget / 2;
+
+         while ( ( header.pointCount > cMinChunkPointCount ) &&
+                 ( Data3DPointsData_t<COORDTYPE>::estimatedSize( header, header.pointCount ) >
+                   bufferBudget ) )
+         {
+            header.pointCount /= 2;
+         }
+      }
+
+      Data3DPointsData_t<COORDTYPE> buffers( header, fieldSelection );
+
+      CompressedVectorReader reader =
+         SetUpData3DPointsData( dataIndex, header.pointCount, buffers );
+
+      const int8_t *mask = ( buffers.cartesianInvalidState != nullptr )
+                              ? buffers.cartesianInvalidState
+                              : buffers.sphericalInvalidState;
+
+      std::vector<unsigned> keepIndices;
+
+      keepIndices.reserve( header.pointCount );
+
+      bool keepGoing = true;
+      unsigned count = 0;
+
+      while ( keepGoing && ( ( count = reader.read() ) > 0 ) )
+      {
+         // A scan with no invalid-state channel has no invalid points; deliver as-is
+         if ( mask == nullptr )
+         {
+            keepGoing = callback( buffers, count );
+            continue;
+         }
+
+         keepIndices.clear();
+
+         // Gather the mask first, then compact; the branchless index gather and the
+         // per-field moves are both tight loops the compiler vectorizes
+         for ( unsigned i = 0; i < count; ++i )
+         {
+            if ( mask[i] == 0 )
+            {
+               keepIndices.push_back( i );
+            }
+         }
+
+         if ( keepIndices.empty() )
+         {
+            continue;
+         }
+
+         if ( keepIndices.size() < count )
+         {
+            _compactAllFields( buffers, keepIndices );
+         }
+
+         keepGoing = callback( buffers, keepIndices.size() );
+      }
+
+      reader.close();
+
+      return true;
+   }
+
+   // Decodes the predicate fields of each batch first and converts the remaining
+   // channels only for batches with survivors
+   template <typename COORDTYPE>
+   bool ReaderImpl::ReadData3DPredicated(
+      int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+      const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      if ( ( dataIndex < 0 ) || ( dataIndex >= data3D_.childCount() ) )
+      {
+         return false;
+      }
+
+      if ( ( chunkSize == 0 ) || !callback || predicates.empty() )
+      {
+         return false;
+      }
+
+      Data3D header;
+
+      if ( !ReadData3D( dataIndex, header ) )
+      {
+         return false;
+      }
+
+      // The predicate pass decodes only the tested fields
+      PointStandardizedFieldsAvailable predicateSelection;
+
+      for ( const FieldPredicate &predicate : predicates )
+      {
+         if ( !_enablePredicateField( predicateSelection, header.pointFields,
+                                      predicate.pathName ) )
+         {
+            // Unknown field name, or the scan does not carry the field
+            return false;
+         }
+      }
+
+      const PointStandardizedFieldsAvailable fieldSelection =
+         ( selectedFields != nullptr ) ? *selectedFields : header.pointFields;
+
+      header.pointCount = std::min( chunkSize, header.pointCount );
+
+      if ( options_.memoryBudget != 0 )
+      {
+         // Budgeted readers shrink the chunk just like ReadData3DChunks()
+         constexpr size_t cMinChunkPointCount = 1024;
+
+         const uint64_t bufferBudget = options_.memoryBudget / 2;
+
+         while ( ( header.pointCount > cMinChunkPointCount ) &&
+                 ( Data3DPointsData_t<COORDTYPE>::estimatedSize( header, header.pointCount ) >
+                   bufferBudget ) )
+         {
+            header.pointCount /= 2;
+         }
+      }
+
+      // Two sessions walk the scan in lockstep: predicateReader converts only the
+      // tested channels, and reader either converts a batch's remaining channels or
+      // passes over it without converting anything (the packets predicateReader pulled
+      // in are still warm in the cache either way)
+      Data3DPointsData_t<COORDTYPE> predicateBuffers( header, predicateSelection );
+      Data3DPointsData_t<COORDTYPE> buffers( header, fieldSelection );
+
+      CompressedVectorReader predicateReader =
+         SetUpData3DPointsData( dataIndex, header.pointCount, predicateBuffers );
+      CompressedVectorReader reader =
+         SetUpData3DPointsData( dataIndex, header.pointCount, buffers );
+
+      // Resolve each predicate to a typed batch evaluator once
+      std::vector<std::function<void( unsigned, uint8_t * )>> evaluators;
+
+      evaluators.reserve( predicates.size() );
+
+      for ( const FieldPredicate &predicate : predicates )
+      {
+         evaluators.push_back( _predicateEvaluator( predicateBuffers, predicate ) );
+
+         if ( !evaluators.back() )
+         {
+            predicateReader.close();
+            reader.close();
+
+            return false;
+         }
+      }
+
+      std::vector<uint8_t> keep;
+      std::vector<unsigned> keepIndices;
+
+      keepIndices.reserve( header.pointCount );
+
+      bool keepGoing = true;
+      unsigned count = 0;
+
+      while ( keepGoing && ( ( count = predicateReader.read() ) > 0 ) )
+      {
+         keep.assign( count, 1 );
+
+         for ( const auto &evaluator : evaluators )
+         {
+            evaluator( count, keep.data() );
+         }
+
+         keepIndices.clear();
+
+         for ( unsigned i = 0; i < count; ++i )
+         {
+            if ( keep[i] != 0 )
+            {
+               keepIndices.push_back( i );
+            }
+         }
+
+         if ( keepIndices.empty() )
+         {
+            // Nothing survived: skip the batch without converting the other channels
+            reader.impl()->discardRecords( count );
+            continue;
+         }
+
+         const unsigned delivered = reader.read();
+
+         if ( delivered != count )
+         {
+            throw E57_EXCEPTION2( ErrorInternal, "delivered=" + toString( delivered ) +
+                                                    " expected=" + toString( count ) );
+         }
+
+         if ( keepIndices.size() < count )
+         {
+            _compactAllFields( buffers, keepIndices );
+         }
+
+         keepGoing = callback( buffers, keepIndices.size() );
+      }
+
+      predicateReader.close();
+      reader.close();
+
+      return true;
+   }
+
+   // Reads all scans, distributing them over worker threads
+   template <typename COORDTYPE>
+   bool ReaderImpl::ReadAllData3D(
+      unsigned parallelism, size_t chunkSize,
+      const std::function<bool( int64_t dataIndex, const Data3DPointsData_t<COORDTYPE> &buffers,
+                                size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const
+   {
+      if ( ( chunkSize == 0 ) || !callback )
+      {
+         return false;
+      }
+
+      const int64_t scanCount = data3D_.childCount();
+
+      if ( scanCount == 0 )
+      {
+         return true;
+      }
+
+      if ( parallelism == 0 )
+      {
+         parallelism = std::max( 1U, std::thread::hardware_concurrency() );
+      }
+
+      parallelism = static_cast<unsigned>(
+         std::min( static_cast<int64_t>( parallelism ), scanCount ) );
+
+      // Scans are claimed from a shared counter so large and small scans balance
+      // across workers; stopRequested lets a callback cancel the whole read.
+      std::atomic<int64_t> nextScan( 0 );
+      std::atomic<bool> stopRequested( false );
+
+      std::atomic<bool> allOK( true );
+
+      const ustring filePath = imf_.fileName();
+
+      auto readScans = [&]( const ReaderImpl &reader ) {
+         for ( ;; )
+         {
+            const int64_t scanIndex = nextScan.fetch_add( 1 );
+
+            if ( ( scanIndex >= scanCount ) || stopRequested.load() )
+            {
+               break;
+            }
+
+            const bool scanOK = reader.ReadData3DChunks<COORDTYPE>(
+               scanIndex, chunkSize,
+               [&]( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count ) {
+                  if ( !callback( scanIndex, buffers, count ) )
+                  {
+                     stopRequested.store( true );
+                     return false;
+                  }
+
+                  return true;
+               },
+               selectedFields );
+
+            if ( !scanOK )
+            {
+               allOK.store( false );
+            }
+         }
+      };
+
+      if ( parallelism <= 1 )
+      {
+         readScans( *this );
+         return allOK.load();
+      }
+
+      // Each worker is a full reader with its own packet cache and chunk buffers, so
+      // a memory budget is split between them to keep the total where the caller set it.
+      ReaderOptions workerOptions = options_;
+
+      if ( workerOptions.memoryBudget != 0 )
+      {
+         constexpr uint64_t cMinWorkerBudget = 256 * 1024;
+
+         workerOptions.memoryBudget =
+            std::max( cMinWorkerBudget, workerOptions.memoryBudget / parallelism );
+      }
+
+      Executor::run( parallelism, [&]( unsigned /*workerIndex*/ ) {
+         try
+         {
+            // Every worker opens its own view of the file, so no CheckedFile
+            // seek position or other state is shared between threads.
+            const ReaderImpl reader( filePath, workerOptions );
+
+            readScans( reader );
+         }
+         catch ( ... )
+         {
+            // Stop the sibling workers promptly; Executor::run() rethrows this
+            stopRequested.store( true );
+            throw;
+         }
+      } );
+
+      return allOK.load();
+   }
+
    int64_t ReaderImpl::GetData3DCount() const
    {
       return data3D_.childCount();
@@ -1738,9 +2975,66 @@ namespace e57
 
    // Explicit template instantiation
    template CompressedVectorReader ReaderImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<float> &buffers ) const;
+      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<float> &buffers,
+      size_t stride ) const;
 
    template CompressedVectorReader ReaderImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<double> &buffers ) const;
+      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<double> &buffers,
+      size_t stride ) const;
+
+   template bool ReaderImpl::ReadData3DChunks(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<float> &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DChunks(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<double> &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DFiltered(
+      int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+      const std::function<bool( const Data3DPointsData_t<float> &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DFiltered(
+      int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+      const std::function<bool( const Data3DPointsData_t<double> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DCompacted(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<float> &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DCompacted(
+      int64_t dataIndex, size_t chunkSize,
+      const std::function<bool( const Data3DPointsData_t<double> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DPredicated(
+      int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+      const std::function<bool( const Data3DPointsData_t<float> &buffers, size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadData3DPredicated(
+      int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+      const std::function<bool( const Data3DPointsData_t<double> &buffers, size_t count )>
+         &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadAllData3D(
+      unsigned parallelism, size_t chunkSize,
+      const std::function<bool( int64_t dataIndex, const Data3DPointsData_t<float> &buffers,
+                                size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
+
+   template bool ReaderImpl::ReadAllData3D(
+      unsigned parallelism, size_t chunkSize,
+      const std::function<bool( int64_t dataIndex, const Data3DPointsData_t<double> &buffers,
+                                size_t count )> &callback,
+      const PointStandardizedFieldsAvailable *selectedFields ) const;
 
 } // end namespace e57
@@ -51,6 +51,8 @@ namespace e57
 
       bool GetE57Root( E57Root &fileHeader ) const;
 
+      ReaderStats GetStats() const;
+
       int64_t GetImage2DCount() const;
 
       bool ReadImage2D( int64_t imageIndex, Image2D &Image2DHeader ) const;
@@ -64,10 +66,18 @@ namespace e57
                               Image2DType imageType, uint8_t *pBuffer, int64_t start,
                               size_t count ) const;
 
+      bool ReadAllImages2D(
+         unsigned parallelism,
+         const std::function<bool( int64_t imageIndex, const Image2D &imageHeader,
+                                   Image2DProjection imageProjection, Image2DType imageType,
+                                   const std::vector<uint8_t> &imageData )> &callback ) const;
+
       int64_t GetData3DCount() const;
 
       bool ReadData3D( int64_t dataIndex, Data3D &data3DHeader ) const;
 
+      bool ReadAllData3DHeaders( unsigned parallelism, std::vector<Data3D> &data3DHeaders ) const;
+
       bool GetData3DSizes( int64_t dataIndex, int64_t &rowMax, int64_t &columnMax,
                            int64_t &pointsSize, int64_t &groupsSize, int64_t &countSize,
                            bool &bColumnIndex ) const;
@@ -76,8 +86,44 @@ namespace e57
                                  int64_t *startPointIndex, int64_t *pointCount ) const;
 
       template <typename COORDTYPE>
-      CompressedVectorReader SetUpData3DPointsData(
-         int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<COORDTYPE> &buffers ) const;
+      CompressedVectorReader SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
+                                                    const Data3DPointsData_t<COORDTYPE> &buffers,
+                                                    size_t stride = 0 ) const;
+
+      template <typename COORDTYPE>
+      bool ReadData3DChunks(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+            &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      template <typename COORDTYPE>
+      bool ReadData3DFiltered(
+         int64_t dataIndex, size_t chunkSize, const CartesianBounds &filterBounds,
+         const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+            &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      template <typename COORDTYPE>
+      bool ReadData3DCompacted(
+         int64_t dataIndex, size_t chunkSize,
+         const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+            &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      template <typename COORDTYPE>
+      bool ReadData3DPredicated(
+         int64_t dataIndex, size_t chunkSize, const std::vector<FieldPredicate> &predicates,
+         const std::function<bool( const Data3DPointsData_t<COORDTYPE> &buffers, size_t count )>
+            &callback,
+         const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
+
+      template <typename COORDTYPE>
+      bool ReadAllData3D( unsigned parallelism, size_t chunkSize,
+                          const std::function<bool( int64_t dataIndex,
+                                                    const Data3DPointsData_t<COORDTYPE> &buffers,
+                                                    size_t count )> &callback,
+                          const PointStandardizedFieldsAvailable *selectedFields = nullptr ) const;
 
       StructureNode GetRawE57Root() const;
 
@@ -88,11 +134,19 @@ namespace e57
       ImageFile GetRawIMF() const;
 
    private:
+      /// Builds the merged, ascending record ranges whose per-group bounds intersect
+      /// filterBounds; false when the file has no per-group cartesianBounds to push into
+      bool _groupCandidateRanges( int64_t dataIndex, const CartesianBounds &filterBounds,
+                                  std::vector<std::pair<size_t, size_t>> &ranges ) const;
+
       ImageFile imf_;
       StructureNode root_;
 
       VectorNode data3D_;
 
       VectorNode images2D_;
+
+      /// Kept so parallel readers can reopen the file with the same options
+      ReaderOptions options_;
    }; // end Reader class
 } // end namespace e57
@@ -0,0 +1,355 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <cstring>
+
+#include "CheckedFile.h"
+#include "Packet.h"
+#include "SharedPacketCache.h"
+#include "StringFunctions.h"
+
+// POSIX shared memory is the only implemented backend; everywhere else attach()
+// returns nullptr and callers stay on the private cache.
+#if defined( __GNUC__ ) && !defined( _WIN32 )
+#define E57_POSIX_SHARED_PACKET_CACHE
+
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+using namespace e57;
+
+namespace
+{
+   constexpr uint32_t cSegmentMagic = 0x45355043; // "E5PC", stored last to publish the header
+   constexpr uint32_t cSegmentVersion = 1;
+
+   /// Direct-mapped slot count per distinct file.  512 slots of DATA_PACKET_MAX bytes is
+   /// 32 MiB - sized for nodes where many processes stream the same project files, where
+   /// it replaces that many bytes of disk reads per attached process.
+   constexpr uint32_t cSlotCount = 512;
+}
+
+/// Placed at the start of the segment.  magic is written last by the creating process
+/// (release order), so any process that sees it set also sees the rest initialized.
+struct SharedPacketCache::SegmentHeader
+{
+   std::atomic<uint32_t> magic;
+   uint32_t version;
+   uint32_t slotCount;
+   uint32_t reserved;
+
+   /// Processes currently attached; the one that drops it to zero unlinks the name
+   std::atomic<uint32_t> attachCount;
+};
+
+/// One cached packet.  seq is a per-slot seqlock: even = stable, odd = a writer is
+/// inside.  Readers copy the bytes out and re-check seq afterwards; any change means
+/// the copy may be torn and is discarded.
+struct SharedPacketCache::Slot
+{
+   std::atomic<uint64_t> seq;
+   std::atomic<uint64_t> logicalOffset; // 0 = empty (packets never live at offset 0)
+   uint32_t dataLength;                 // valid bytes (decompressed length for zstd)
+   uint32_t diskLength;                 // on-disk logical length of the packet
+   char bytes[DATA_PACKET_MAX];
+};
+
+std::shared_ptr<SharedPacketCache> SharedPacketCache::attach( CheckedFile *cFile )
+{
+#ifndef E57_POSIX_SHARED_PACKET_CACHE
+   E57_UNUSED( cFile );
+
+   return nullptr;
+#else
+   // The seqlock protocol needs genuinely atomic 64-bit loads/stores across processes
+   if ( !std::atomic<uint64_t>().is_lock_free() )
+   {
+      return nullptr;
+   }
+
+   const int fd = cFile->fileDescriptor();
+
+   if ( fd < 0 ) // memory-buffer file
+   {
+      return nullptr;
+   }
+
+   // Name the segment after the file's identity.  The modification time keeps a file
+   // that was rewritten in place (same inode, new contents) from matching a stale
+   // segment left behind by a crashed process.
+   struct stat st;
+
+   if ( ::fstat( fd, &st ) != 0 )
+   {
+      return nullptr;
+   }
+
+   const std::string name = "/e57pkt-" + toString( static_cast<uint64_t>( st.st_dev ) ) + "-" +
+                            toString( static_cast<uint64_t>( st.st_ino ) ) + "-" +
+                            toString( static_cast<uint64_t>( st.st_mtime ) ) + "-" +
+                            toString( static_cast<uint64_t>( st.st_size ) );
+
+   const size_t segmentBytes = sizeof( SegmentHeader ) + cSlotCount * sizeof( Slot );
+
+   // First process in creates the name exclusively and sizes it; everyone else opens the
+   // existing name and waits (briefly) for the creator to finish.
+   bool creator = false;
+   int shm = ::shm_open( name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+
+   if ( shm >= 0 )
+   {
+      creator = true;
+
+      if ( ::ftruncate( shm, static_cast<off_t>( segmentBytes ) ) != 0 )
+      {
+         ::close( shm );
+         ::shm_unlink( name.c_str() );
+
+         return nullptr;
+      }
+   }
+   else if ( errno == EEXIST )
+   {
+      shm = ::shm_open( name.c_str(), O_RDWR, 0600 );
+
+      if ( shm < 0 )
+      {
+         return nullptr;
+      }
+
+      // Don't map past the end of a segment the creator hasn't sized yet (touching
+      // unbacked pages raises SIGBUS)
+      struct stat shmStat;
+      bool sized = false;
+
+      for ( int i = 0; i < 1000; ++i )
+      {
+         if ( ::fstat( shm, &shmStat ) != 0 )
+         {
+            break;
+         }
+
+         if ( static_cast<size_t>( shmStat.st_size ) >= segmentBytes )
+         {
+            sized = true;
+            break;
+         }
+
+         std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+      }
+
+      if ( !sized )
+      {
+         ::close( shm );
+
+         return nullptr;
+      }
+   }
+   else
+   {
+      return nullptr;
+   }
+
+   void *mem = ::mmap( nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, shm, 0 );
+
+   ::close( shm );
+
+   if ( mem == MAP_FAILED )
+   {
+      if ( creator )
+      {
+         ::shm_unlink( name.c_str() );
+      }
+
+      return nullptr;
+   }
+
+   auto header = static_cast<SegmentHeader *>( mem );
+
+   if ( creator )
+   {
+      // ftruncate() zero-filled everything (all slots read as empty); publish via magic
+      header->version = cSegmentVersion;
+      header->slotCount = cSlotCount;
+      header->attachCount.store( 1, std::memory_order_relaxed );
+      header->magic.store( cSegmentMagic, std::memory_order_release );
+   }
+   else
+   {
+      bool initialized = false;
+
+      for ( int i = 0; i < 1000; ++i )
+      {
+         if ( header->magic.load( std::memory_order_acquire ) == cSegmentMagic )
+         {
+            initialized = true;
+            break;
+         }
+
+         std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+      }
+
+      if ( !initialized || header->version != cSegmentVersion ||
+           header->slotCount != cSlotCount )
+      {
+         ::munmap( mem, segmentBytes );
+
+         return nullptr;
+      }
+
+      header->attachCount.fetch_add( 1 );
+   }
+
+   std::shared_ptr<SharedPacketCache> cache( new SharedPacketCache );
+
+   cache->segment_ = mem;
+   cache->segmentBytes_ = segmentBytes;
+   cache->name_ = name;
+
+   return cache;
+#endif
+}
+
+SharedPacketCache::~SharedPacketCache()
+{
+#ifdef E57_POSIX_SHARED_PACKET_CACHE
+   auto header = static_cast<SegmentHeader *>( segment_ );
+
+   const uint32_t remaining = header->attachCount.fetch_sub( 1 ) - 1;
+
+   ::munmap( segment_, segmentBytes_ );
+
+   if ( remaining == 0 )
+   {
+      // Last one out removes the name.  A process attaching at exactly this moment just
+      // creates a fresh segment; mapped pages stay valid until everyone's munmap().
+      ::shm_unlink( name_.c_str() );
+   }
+#endif
+}
+
+SharedPacketCache::Slot *SharedPacketCache::slot( uint64_t packetLogicalOffset ) const
+{
+   // Packet offsets are multiples of 4 that cluster within sections, so mix the bits
+   // (Fibonacci hashing) before the direct-map reduction
+   const uint64_t hash = packetLogicalOffset * UINT64_C( 0x9E3779B97F4A7C15 );
+
+   auto header = static_cast<SegmentHeader *>( segment_ );
+   auto slots = reinterpret_cast<Slot *>( header + 1 );
+
+   return &slots[( hash >> 32 ) % header->slotCount];
+}
+
+bool SharedPacketCache::fetch( uint64_t packetLogicalOffset, char *buffer, unsigned &dataLength,
+                               unsigned &diskLength )
+{
+#ifndef E57_POSIX_SHARED_PACKET_CACHE
+   E57_UNUSED( packetLogicalOffset );
+   E57_UNUSED( buffer );
+   E57_UNUSED( dataLength );
+   E57_UNUSED( diskLength );
+
+   return false;
+#else
+   Slot *s = slot( packetLogicalOffset );
+
+   const uint64_t seqBefore = s->seq.load( std::memory_order_acquire );
+
+   if ( ( seqBefore & 1 ) != 0 ||
+        s->logicalOffset.load( std::memory_order_relaxed ) != packetLogicalOffset )
+   {
+      return false;
+   }
+
+   const uint32_t cachedDataLength = s->dataLength;
+   const uint32_t cachedDiskLength = s->diskLength;
+
+   // The lengths may be torn mid-update; bound them before they size a copy.  The
+   // re-check below rejects the whole fetch if anything moved.
+   if ( cachedDataLength == 0 || cachedDataLength > DATA_PACKET_MAX )
+   {
+      return false;
+   }
+
+   memcpy( buffer, s->bytes, cachedDataLength );
+
+   std::atomic_thread_fence( std::memory_order_acquire );
+
+   if ( s->seq.load( std::memory_order_relaxed ) != seqBefore )
+   {
+      return false;
+   }
+
+   dataLength = cachedDataLength;
+   diskLength = cachedDiskLength;
+
+   return true;
+#endif
+}
+
+void SharedPacketCache::publish( uint64_t packetLogicalOffset, const char *buffer,
+                                 unsigned dataLength, unsigned diskLength )
+{
+#ifndef E57_POSIX_SHARED_PACKET_CACHE
+   E57_UNUSED( packetLogicalOffset );
+   E57_UNUSED( buffer );
+   E57_UNUSED( dataLength );
+   E57_UNUSED( diskLength );
+#else
+   if ( dataLength == 0 || dataLength > DATA_PACKET_MAX )
+   {
+      return;
+   }
+
+   Slot *s = slot( packetLogicalOffset );
+
+   uint64_t seq = s->seq.load( std::memory_order_relaxed );
+
+   if ( ( seq & 1 ) != 0 )
+   {
+      return; // another process is mid-publish; ours is already cached privately
+   }
+
+   if ( !s->seq.compare_exchange_strong( seq, seq + 1, std::memory_order_acquire ) )
+   {
+      return;
+   }
+
+   s->logicalOffset.store( packetLogicalOffset, std::memory_order_relaxed );
+   s->dataLength = dataLength;
+   s->diskLength = diskLength;
+   memcpy( s->bytes, buffer, dataLength );
+
+   s->seq.store( seq + 2, std::memory_order_release );
+#endif
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Common.h"
+
+namespace e57
+{
+   class CheckedFile;
+
+   /// A cache of decoded packets in a named shared-memory segment, keyed to the identity
+   /// of the E57 file, so several processes reading the same file share one set of disk
+   /// reads, CRC verifications and zstd decompressions.
+   ///
+   /// The segment holds a fixed number of direct-mapped slots.  Each slot is guarded by a
+   /// per-slot sequence counter (a seqlock): readers never block or take a lock - a lookup
+   /// that races with a writer simply reports a miss and the caller reads the packet from
+   /// the file as usual.  Everything about the cache is best-effort; it only ever removes
+   /// work, never correctness, and every failure path falls back to the private
+   /// PacketReadCache behavior.
+   ///
+   /// Slots hold packets in the same form PacketReadCache buffers them (a ZSTD_PACKET is
+   /// stored decompressed), so a fetch also skips decompression, and the bytes were
+   /// CRC-verified by whichever process originally read them from disk - attaching
+   /// processes get verified-once semantics without re-verifying.
+   ///
+   /// Only POSIX shared memory is implemented; attach() reports the feature unavailable
+   /// elsewhere (and for memory-buffer files, which have no cross-process identity).
+   class SharedPacketCache
+   {
+   public:
+      /// Attach to the segment for cFile's file, creating it if this is the first process
+      /// to ask.  Returns nullptr when shared caching is unavailable: unsupported
+      /// platform, a memory-buffer file, or any failure creating or validating the
+      /// segment.  Callers treat nullptr as "use private caching only".
+      static std::shared_ptr<SharedPacketCache> attach( CheckedFile *cFile );
+
+      ~SharedPacketCache();
+
+      // disallow copying
+      SharedPacketCache( const SharedPacketCache & ) = delete;
+      SharedPacketCache &operator=( const SharedPacketCache & ) = delete;
+
+      /// Lock-free lookup of the packet at packetLogicalOffset.  On a hit the packet
+      /// image is copied into buffer (which must hold DATA_PACKET_MAX bytes) and the
+      /// valid byte count and on-disk length are returned.  A miss, a slot mid-update or
+      /// implausible slot contents all return false.
+      bool fetch( uint64_t packetLogicalOffset, char *buffer, unsigned &dataLength,
+                  unsigned &diskLength );
+
+      /// Best-effort insert of a packet another process may want.  Silently does nothing
+      /// when the slot is being written by someone else - the packet is already in the
+      /// caller's private cache, so losing the publication costs at most a re-read.
+      void publish( uint64_t packetLogicalOffset, const char *buffer, unsigned dataLength,
+                    unsigned diskLength );
+
+   private:
+      SharedPacketCache() = default;
+
+      struct SegmentHeader;
+      struct Slot;
+
+      Slot *slot( uint64_t packetLogicalOffset ) const;
+
+      void *segment_ = nullptr;
+      size_t segmentBytes_ = 0;
+
+      /// Segment name, kept so the last detaching process can shm_unlink() it
+      std::string name_;
+   };
+}
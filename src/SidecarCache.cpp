@@ -0,0 +1,493 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "BlobNodeImpl.h"
+#include "CheckedFile.h"
+#include "CompressedVectorNodeImpl.h"
+#include "FloatNodeImpl.h"
+#include "ImageFileImpl.h"
+#include "IntegerNodeImpl.h"
+#include "NodeArena.h"
+#include "ScaledIntegerNodeImpl.h"
+#include "SidecarCache.h"
+#include "StringNodeImpl.h"
+#include "StructureNodeImpl.h"
+#include "VectorNodeImpl.h"
+
+using namespace e57;
+
+namespace
+{
+   // Bump the version whenever the serialized layout changes; old sidecars then
+   // simply miss and get rewritten.
+   constexpr char cMagic[8] = { 'E', '5', '7', 'S', 'C', 'M', 'D', '1' };
+
+   // Don't let a corrupt sidecar recurse us off the stack
+   constexpr int cMaxDepth = 256;
+
+   uint64_t fnv1a64( const char *data, size_t length )
+   {
+      uint64_t hash = UINT64_C( 0xCBF29CE484222325 );
+
+      for ( size_t i = 0; i < length; ++i )
+      {
+         hash ^= static_cast<unsigned char>( data[i] );
+         hash *= UINT64_C( 0x100000001B3 );
+      }
+
+      return hash;
+   }
+
+   //=== serialization ========================================================
+
+   void putBytes( std::vector<char> &out, const void *data, size_t length )
+   {
+      const char *bytes = static_cast<const char *>( data );
+      out.insert( out.end(), bytes, bytes + length );
+   }
+
+   template <typename T> void put( std::vector<char> &out, T value )
+   {
+      putBytes( out, &value, sizeof( T ) );
+   }
+
+   void putString( std::vector<char> &out, const ustring &str )
+   {
+      put( out, static_cast<uint32_t>( str.length() ) );
+      putBytes( out, str.data(), str.length() );
+   }
+
+   void serializeNode( const NodeImplSharedPtr &ni, std::vector<char> &out )
+   {
+      put( out, static_cast<uint8_t>( ni->type() ) );
+
+      switch ( ni->type() )
+      {
+         case TypeStructure:
+         {
+            auto s_ni = std::static_pointer_cast<StructureNodeImpl>( ni );
+
+            const int64_t childCount = s_ni->childCount();
+            put( out, static_cast<uint64_t>( childCount ) );
+
+            for ( int64_t i = 0; i < childCount; ++i )
+            {
+               NodeImplSharedPtr child = s_ni->get( i );
+               putString( out, child->elementName() );
+               serializeNode( child, out );
+            }
+         }
+         break;
+         case TypeVector:
+         {
+            auto v_ni = std::static_pointer_cast<VectorNodeImpl>( ni );
+
+            put( out, static_cast<uint8_t>( v_ni->allowHeteroChildren() ? 1 : 0 ) );
+
+            const int64_t childCount = v_ni->childCount();
+            put( out, static_cast<uint64_t>( childCount ) );
+
+            for ( int64_t i = 0; i < childCount; ++i )
+            {
+               serializeNode( v_ni->get( i ), out );
+            }
+         }
+         break;
+         case TypeCompressedVector:
+         {
+            auto cv_ni = std::static_pointer_cast<CompressedVectorNodeImpl>( ni );
+
+            put( out, cv_ni->getRecordCount() );
+            put( out, cv_ni->getBinarySectionLogicalStart() );
+
+            NodeImplSharedPtr prototype = cv_ni->getPrototype();
+            put( out, static_cast<uint8_t>( prototype ? 1 : 0 ) );
+            if ( prototype )
+            {
+               serializeNode( prototype, out );
+            }
+
+            std::shared_ptr<VectorNodeImpl> codecs = cv_ni->getCodecs();
+            put( out, static_cast<uint8_t>( codecs ? 1 : 0 ) );
+            if ( codecs )
+            {
+               serializeNode( codecs, out );
+            }
+         }
+         break;
+         case TypeInteger:
+         {
+            auto i_ni = std::static_pointer_cast<IntegerNodeImpl>( ni );
+
+            put( out, i_ni->value() );
+            put( out, i_ni->minimum() );
+            put( out, i_ni->maximum() );
+         }
+         break;
+         case TypeScaledInteger:
+         {
+            auto si_ni = std::static_pointer_cast<ScaledIntegerNodeImpl>( ni );
+
+            put( out, si_ni->rawValue() );
+            put( out, si_ni->minimum() );
+            put( out, si_ni->maximum() );
+            put( out, si_ni->scale() );
+            put( out, si_ni->offset() );
+         }
+         break;
+         case TypeFloat:
+         {
+            auto f_ni = std::static_pointer_cast<FloatNodeImpl>( ni );
+
+            put( out, static_cast<uint8_t>( f_ni->precision() ) );
+            put( out, f_ni->value() );
+            put( out, f_ni->minimum() );
+            put( out, f_ni->maximum() );
+         }
+         break;
+         case TypeString:
+            putString( out, std::static_pointer_cast<StringNodeImpl>( ni )->value() );
+            break;
+         case TypeBlob:
+         {
+            auto b_ni = std::static_pointer_cast<BlobNodeImpl>( ni );
+
+            put( out, b_ni->binarySectionLogicalStart() );
+            put( out, b_ni->blobLogicalLength() );
+         }
+         break;
+      }
+   }
+
+   //=== deserialization ======================================================
+
+   /// Bounds-checked read cursor; any overrun flips ok and sticks
+   struct Cursor
+   {
+      const char *cur = nullptr;
+      const char *end = nullptr;
+      bool ok = true;
+
+      bool getBytes( void *data, size_t length )
+      {
+         if ( !ok || static_cast<size_t>( end - cur ) < length )
+         {
+            ok = false;
+            return false;
+         }
+
+         std::memcpy( data, cur, length );
+         cur += length;
+         return true;
+      }
+
+      template <typename T> T get()
+      {
+         T value{};
+         getBytes( &value, sizeof( T ) );
+         return value;
+      }
+
+      ustring getString()
+      {
+         const uint32_t length = get<uint32_t>();
+
+         if ( !ok || static_cast<size_t>( end - cur ) < length )
+         {
+            ok = false;
+            return {};
+         }
+
+         ustring str( cur, cur + length );
+         cur += length;
+         return str;
+      }
+   };
+
+   template <typename T, typename... Args>
+   std::shared_ptr<T> makeNode( const std::shared_ptr<NodeArena> &arena, Args &&...args )
+   {
+      return std::allocate_shared<T>( ArenaAllocator<T>( arena ),
+                                      std::forward<Args>( args )... );
+   }
+
+   NodeImplSharedPtr deserializeNode( Cursor &in, const ImageFileImplSharedPtr &imf,
+                                      const std::shared_ptr<NodeArena> &arena, int depth )
+   {
+      if ( !in.ok || depth > cMaxDepth )
+      {
+         in.ok = false;
+         return nullptr;
+      }
+
+      const auto nodeType = in.get<uint8_t>();
+
+      switch ( nodeType )
+      {
+         case TypeStructure:
+         {
+            auto s_ni = makeNode<StructureNodeImpl>( arena, imf );
+
+            const auto childCount = in.get<uint64_t>();
+            for ( uint64_t i = 0; in.ok && i < childCount; ++i )
+            {
+               const ustring name = in.getString();
+               NodeImplSharedPtr child = deserializeNode( in, imf, arena, depth + 1 );
+               if ( !child )
+               {
+                  return nullptr;
+               }
+               s_ni->set( name, child );
+            }
+
+            return s_ni;
+         }
+         case TypeVector:
+         {
+            const bool allowHetero = ( in.get<uint8_t>() != 0 );
+
+            auto v_ni = makeNode<VectorNodeImpl>( arena, imf, allowHetero );
+
+            const auto childCount = in.get<uint64_t>();
+            for ( uint64_t i = 0; in.ok && i < childCount; ++i )
+            {
+               NodeImplSharedPtr child = deserializeNode( in, imf, arena, depth + 1 );
+               if ( !child )
+               {
+                  return nullptr;
+               }
+               v_ni->append( child );
+            }
+
+            return v_ni;
+         }
+         case TypeCompressedVector:
+         {
+            auto cv_ni = makeNode<CompressedVectorNodeImpl>( arena, imf );
+
+            cv_ni->setRecordCount( in.get<int64_t>() );
+            cv_ni->setBinarySectionLogicalStart( in.get<uint64_t>() );
+
+            if ( in.get<uint8_t>() != 0 )
+            {
+               NodeImplSharedPtr prototype = deserializeNode( in, imf, arena, depth + 1 );
+               if ( !prototype )
+               {
+                  return nullptr;
+               }
+               // Share one instance across structurally identical scan prototypes,
+               // just like the XML parsers do
+               cv_ni->setPrototype( imf->canonicalPrototype( prototype ) );
+            }
+
+            if ( in.get<uint8_t>() != 0 )
+            {
+               NodeImplSharedPtr codecs = deserializeNode( in, imf, arena, depth + 1 );
+               if ( !codecs || codecs->type() != TypeVector )
+               {
+                  in.ok = false;
+                  return nullptr;
+               }
+               cv_ni->setCodecs( std::static_pointer_cast<VectorNodeImpl>( codecs ) );
+            }
+
+            return cv_ni;
+         }
+         case TypeInteger:
+         {
+            const auto value = in.get<int64_t>();
+            const auto minimum = in.get<int64_t>();
+            const auto maximum = in.get<int64_t>();
+
+            return makeNode<IntegerNodeImpl>( arena, imf, value, minimum, maximum );
+         }
+         case TypeScaledInteger:
+         {
+            const auto value = in.get<int64_t>();
+            const auto minimum = in.get<int64_t>();
+            const auto maximum = in.get<int64_t>();
+            const auto scale = in.get<double>();
+            const auto offset = in.get<double>();
+
+            return makeNode<ScaledIntegerNodeImpl>( arena, imf, value, minimum, maximum, scale,
+                                                    offset );
+         }
+         case TypeFloat:
+         {
+            const auto precision = static_cast<FloatPrecision>( in.get<uint8_t>() );
+            const auto value = in.get<double>();
+            const auto minimum = in.get<double>();
+            const auto maximum = in.get<double>();
+
+            return makeNode<FloatNodeImpl>( arena, imf, value, precision, minimum, maximum );
+         }
+         case TypeString:
+            return makeNode<StringNodeImpl>( arena, imf, in.getString() );
+         case TypeBlob:
+         {
+            const auto sectionLogicalStart = in.get<uint64_t>();
+            const auto logicalLength = in.get<uint64_t>();
+
+            // The XML-style ctor takes the physical offset of the blob section header
+            return makeNode<BlobNodeImpl>(
+               arena, imf,
+               static_cast<int64_t>( CheckedFile::logicalToPhysical( sectionLogicalStart ) ),
+               static_cast<int64_t>( logicalLength ) );
+         }
+         default:
+            in.ok = false;
+            return nullptr;
+      }
+   }
+}
+
+//=============================================================================
+// SidecarCache
+
+std::shared_ptr<StructureNodeImpl> SidecarCache::load( const ImageFileImplSharedPtr &imf,
+                                                       const ustring &cachePath,
+                                                       const char *identity,
+                                                       size_t identityLength )
+{
+   std::ifstream file( cachePath.c_str(), std::ifstream::binary | std::ifstream::ate );
+   if ( !file.good() )
+   {
+      return nullptr;
+   }
+
+   const std::streamoff fileLength = file.tellg();
+
+   // magic + payload hash + identity must fit before we look at anything
+   const size_t prologueLength = sizeof( cMagic ) + sizeof( uint64_t ) + identityLength;
+   if ( fileLength < static_cast<std::streamoff>( prologueLength ) )
+   {
+      return nullptr;
+   }
+
+   std::vector<char> content( static_cast<size_t>( fileLength ) );
+   file.seekg( 0 );
+   file.read( content.data(), fileLength );
+   if ( !file.good() )
+   {
+      return nullptr;
+   }
+
+   // Wrong library version or wrong source file: miss, reparse, rewrite
+   if ( std::memcmp( content.data(), cMagic, sizeof( cMagic ) ) != 0 ||
+        std::memcmp( content.data() + sizeof( cMagic ) + sizeof( uint64_t ), identity,
+                     identityLength ) != 0 )
+   {
+      return nullptr;
+   }
+
+   uint64_t storedHash = 0;
+   std::memcpy( &storedHash, content.data() + sizeof( cMagic ), sizeof( storedHash ) );
+
+   const char *payload = content.data() + prologueLength;
+   const size_t payloadLength = content.size() - prologueLength;
+
+   if ( fnv1a64( payload, payloadLength ) != storedHash )
+   {
+      return nullptr;
+   }
+
+   Cursor in;
+   in.cur = payload;
+   in.end = payload + payloadLength;
+
+   // Registered extensions
+   const auto extensionCount = in.get<uint32_t>();
+   for ( uint32_t i = 0; in.ok && i < extensionCount; ++i )
+   {
+      const ustring prefix = in.getString();
+      const ustring uri = in.getString();
+
+      if ( in.ok )
+      {
+         imf->extensionsAdd( prefix, uri );
+      }
+   }
+
+   // The node tree itself
+   std::shared_ptr<NodeArena> arena( new NodeArena );
+
+   NodeImplSharedPtr root = deserializeNode( in, imf, arena, 0 );
+
+   if ( !in.ok || in.cur != in.end || !root || root->type() != TypeStructure )
+   {
+      return nullptr;
+   }
+
+   auto rootStructure = std::static_pointer_cast<StructureNodeImpl>( root );
+   rootStructure->setAttachedRecursive();
+
+   return rootStructure;
+}
+
+void SidecarCache::save( const ImageFileImplSharedPtr &imf, const ustring &cachePath,
+                         const char *identity, size_t identityLength )
+{
+   std::vector<char> payload;
+
+   // Registered extensions
+   const size_t extensionCount = imf->extensionsCount();
+   put( payload, static_cast<uint32_t>( extensionCount ) );
+
+   for ( size_t i = 0; i < extensionCount; ++i )
+   {
+      putString( payload, imf->extensionsPrefix( i ) );
+      putString( payload, imf->extensionsUri( i ) );
+   }
+
+   // The node tree itself
+   serializeNode( imf->root(), payload );
+
+   std::vector<char> content;
+   content.reserve( sizeof( cMagic ) + sizeof( uint64_t ) + identityLength + payload.size() );
+
+   putBytes( content, cMagic, sizeof( cMagic ) );
+   put( content, fnv1a64( payload.data(), payload.size() ) );
+   putBytes( content, identity, identityLength );
+   putBytes( content, payload.data(), payload.size() );
+
+   // Write to a temp name then rename, so a crash can't leave a torn sidecar behind
+   const ustring tempPath = cachePath + ".tmp";
+
+   std::ofstream file( tempPath.c_str(), std::ofstream::binary | std::ofstream::trunc );
+
+   file.write( content.data(), static_cast<std::streamsize>( content.size() ) );
+   file.close();
+
+   if ( !file.good() || std::rename( tempPath.c_str(), cachePath.c_str() ) != 0 )
+   {
+      // Best effort only; clean up and let the next open parse the XML again
+      std::remove( tempPath.c_str() );
+   }
+}
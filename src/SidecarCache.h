@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "Common.h"
+
+namespace e57
+{
+   class StructureNodeImpl;
+
+   /// Binary sidecar cache of the parsed metadata of an E57 file ("<file>.e57cache").
+   ///
+   /// Reopening a big project re-parses an identical XML section into an identical node
+   /// tree every time.  When a file is opened with mode "rc", the materialized tree and
+   /// the registered extensions are serialized to a compact flat sidecar on first open;
+   /// subsequent opens load the sidecar and skip XML parsing entirely.
+   ///
+   /// The cache is keyed by the file's identity (its raw E57FileHeader, which includes the
+   /// physical length and the XML section offsets) plus a content hash of the serialized
+   /// payload, so a rewritten or truncated source file or a damaged sidecar simply misses
+   /// and falls back to the normal XML parse.  The format is an internal, machine-local
+   /// dump — it is versioned but deliberately not portable across library versions.
+   class SidecarCache
+   {
+   public:
+      /// Try to load the node tree from the sidecar at cachePath.
+      /// Registers the cached extensions on imf and returns the root on success; returns
+      /// an empty pointer on any identity/version/hash mismatch or malformed content.
+      static std::shared_ptr<StructureNodeImpl> load( const ImageFileImplSharedPtr &imf,
+                                                      const ustring &cachePath,
+                                                      const char *identity,
+                                                      size_t identityLength );
+
+      /// Serialize the file's parsed tree to the sidecar at cachePath (best effort:
+      /// failures are ignored, the next open just parses the XML again).
+      static void save( const ImageFileImplSharedPtr &imf, const ustring &cachePath,
+                        const char *identity, size_t identityLength );
+   };
+}
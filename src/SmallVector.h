@@ -0,0 +1,187 @@
+#pragma once
+/*
+ * Original work Copyright 2009 - 2010 Kevin Ackley (kackley@gwi.net)
+ * Modified work Copyright 2018 - 2020 Andy Maloney <asmaloney@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person or organization
+ * obtaining a copy of the software and accompanying documentation covered by
+ * this license (the "Software") to use, reproduce, display, distribute,
+ * execute, and transmit the Software, and to prepare derivative works of the
+ * Software, and to permit third-parties to whom the Software is furnished to
+ * do so, all subject to the following:
+ *
+ * The copyright notices in the Software and this entire statement, including
+ * the above license grant, this restriction and the following disclaimer,
+ * must be included in all copies of the Software, in whole or in part, and
+ * all derivative works of the Software, unless such copies or derivative
+ * works are solely in the form of machine-executable object code generated by
+ * a source language processor.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+ * SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+ * FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Common.h"
+#include "E57Exception.h"
+#include "StringFunctions.h"
+
+namespace e57
+{
+   /// Append-only vector with inline storage for the first InlineCapacity elements.
+   ///
+   /// Used for NodeImpl child lists: a typical E57 structure has a handful of
+   /// children, so keeping them inline in the node (which itself sits in the
+   /// per-file NodeArena) means a metadata traversal walks contiguous slabs
+   /// instead of chasing a separately allocated array per structure.  Only the
+   /// few big vectors (/data3D, /images2D, prototypes) spill to the heap, via
+   /// the pluggable allocator hooks.
+   ///
+   /// Supports just what the child lists need: push_back, indexing, and
+   /// iteration.  Elements are never erased (the node tree is append-only).
+   template <typename T, size_t InlineCapacity> class SmallVector
+   {
+   public:
+      SmallVector() = default;
+
+      SmallVector( const SmallVector & ) = delete;
+      SmallVector &operator=( const SmallVector & ) = delete;
+
+      ~SmallVector()
+      {
+         for ( size_t i = 0; i < size_; ++i )
+         {
+            data_[i].~T();
+         }
+
+         if ( data_ != inlineData() )
+         {
+            internalDeallocate( data_, capacity_ * sizeof( T ) );
+         }
+      }
+
+      size_t size() const
+      {
+         return size_;
+      }
+
+      bool empty() const
+      {
+         return size_ == 0;
+      }
+
+      void push_back( const T &value )
+      {
+         if ( size_ == capacity_ )
+         {
+            grow();
+         }
+
+         new ( data_ + size_ ) T( value );
+         ++size_;
+      }
+
+      void push_back( T &&value )
+      {
+         if ( size_ == capacity_ )
+         {
+            grow();
+         }
+
+         new ( data_ + size_ ) T( std::move( value ) );
+         ++size_;
+      }
+
+      T &operator[]( size_t index )
+      {
+         return data_[index];
+      }
+
+      const T &operator[]( size_t index ) const
+      {
+         return data_[index];
+      }
+
+      T &at( size_t index )
+      {
+         checkIndex( index );
+         return data_[index];
+      }
+
+      const T &at( size_t index ) const
+      {
+         checkIndex( index );
+         return data_[index];
+      }
+
+      T *begin()
+      {
+         return data_;
+      }
+
+      T *end()
+      {
+         return data_ + size_;
+      }
+
+      const T *begin() const
+      {
+         return data_;
+      }
+
+      const T *end() const
+      {
+         return data_ + size_;
+      }
+
+   private:
+      T *inlineData()
+      {
+         return reinterpret_cast<T *>( &inlineStorage_ );
+      }
+
+      void checkIndex( size_t index ) const
+      {
+         if ( index >= size_ )
+         {
+            throw E57_EXCEPTION2( ErrorInternal,
+                                  "index=" + toString( index ) + " size=" + toString( size_ ) );
+         }
+      }
+
+      void grow()
+      {
+         const size_t newCapacity = capacity_ * 2;
+         T *newData = static_cast<T *>( internalAllocate( newCapacity * sizeof( T ) ) );
+
+         for ( size_t i = 0; i < size_; ++i )
+         {
+            new ( newData + i ) T( std::move( data_[i] ) );
+            data_[i].~T();
+         }
+
+         if ( data_ != inlineData() )
+         {
+            internalDeallocate( data_, capacity_ * sizeof( T ) );
+         }
+
+         data_ = newData;
+         capacity_ = newCapacity;
+      }
+
+      typename std::aligned_storage<sizeof( T ) * InlineCapacity, alignof( T )>::type
+         inlineStorage_;
+
+      T *data_{ inlineData() };
+      size_t size_{ 0 };
+      size_t capacity_{ InlineCapacity };
+   };
+}
@@ -25,7 +25,9 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "ImageFileImpl.h"
 #include "SourceDestBufferImpl.h"
@@ -314,6 +316,69 @@ void SourceDestBufferImpl::checkState_() const
    }
 }
 
+namespace
+{
+   /// One tight loop per element type; the conversion to double happens in registers
+   template <typename T>
+   void accumulateTyped( const char *base, size_t stride, size_t count, double &minimum,
+                         double &maximum )
+   {
+      for ( size_t i = 0; i < count; ++i )
+      {
+         const double value =
+            static_cast<double>( *reinterpret_cast<const T *>( base + ( i * stride ) ) );
+
+         minimum = std::min( minimum, value );
+         maximum = std::max( maximum, value );
+      }
+   }
+}
+
+void SourceDestBufferImpl::accumulateMinMax( size_t count, double &minimum,
+                                             double &maximum ) const
+{
+   if ( ( base_ == nullptr ) || ( count == 0 ) )
+   {
+      return;
+   }
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         accumulateTyped<int8_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case UInt8:
+         accumulateTyped<uint8_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case Int16:
+         accumulateTyped<int16_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case UInt16:
+         accumulateTyped<uint16_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case Int32:
+         accumulateTyped<int32_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case UInt32:
+         accumulateTyped<uint32_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case Int64:
+         accumulateTyped<int64_t>( base_, stride_, count, minimum, maximum );
+         break;
+      case Bool:
+         accumulateTyped<bool>( base_, stride_, count, minimum, maximum );
+         break;
+      case Real32:
+         accumulateTyped<float>( base_, stride_, count, minimum, maximum );
+         break;
+      case Real64:
+         accumulateTyped<double>( base_, stride_, count, minimum, maximum );
+         break;
+      case UString:
+         break;
+   }
+}
+
 int64_t SourceDestBufferImpl::getNextInt64()
 {
    /// don't checkImageFileOpen
@@ -939,34 +1004,838 @@ void SourceDestBufferImpl::setNextInt64( int64_t value, double scale, double off
    nextIndex_++;
 }
 
-void SourceDestBufferImpl::setNextFloat( float value )
+template <typename T> void SourceDestBufferImpl::_getNextInt64Array( int64_t *values, size_t count )
 {
-   _setNextReal( value );
+   const char *p = &base_[nextIndex_ * stride_];
+
+   for ( size_t i = 0; i < count; i++ )
+   {
+      values[i] = static_cast<int64_t>( *reinterpret_cast<const T *>( p ) );
+      p += stride_;
+   }
+
+   nextIndex_ += static_cast<unsigned>( count );
 }
 
-void SourceDestBufferImpl::setNextDouble( double value )
+template <typename T>
+void SourceDestBufferImpl::_getNextInt64ArrayScaled( int64_t *values, size_t count, double scale,
+                                                     double offset )
 {
-   _setNextReal( value );
+   const char *p = &base_[nextIndex_ * stride_];
+
+   for ( size_t i = 0; i < count; i++ )
+   {
+      /// Calc (x-offset)/scale rounded to nearest integer, but keep in
+      /// floating point until sure is in bounds
+      double doubleRawValue =
+         floor( ( *reinterpret_cast<const T *>( p ) - offset ) / scale + 0.5 );
+
+      /// Make sure that value is representable in an int64_t
+      if ( doubleRawValue < INT64_MIN || ( doubleRawValue > ( static_cast<double>( INT64_MAX ) ) ) )
+      {
+         throw E57_EXCEPTION2( ErrorScaledValueNotRepresentable,
+                               "pathName=" + pathName_ + " value=" + toString( doubleRawValue ) );
+      }
+
+      values[i] = static_cast<int64_t>( doubleRawValue );
+      p += stride_;
+      nextIndex_++;
+   }
 }
 
-void SourceDestBufferImpl::setNextString( const ustring &value )
+void SourceDestBufferImpl::getNextInt64Array( int64_t *values, size_t count )
 {
    /// don't checkImageFileOpen
 
-   if ( memoryRepresentation_ != UString )
+   /// Verify the whole run is within bounds
+   if ( count > capacity_ - nextIndex_ )
    {
-      throw E57_EXCEPTION2( ErrorExpectingUString, "pathName=" + pathName_ );
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
    }
 
-   /// Verify have room.
-   if ( nextIndex_ >= capacity_ )
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _getNextInt64Array<int8_t>( values, count );
+         break;
+      case UInt8:
+         _getNextInt64Array<uint8_t>( values, count );
+         break;
+      case Int16:
+         _getNextInt64Array<int16_t>( values, count );
+         break;
+      case UInt16:
+         _getNextInt64Array<uint16_t>( values, count );
+         break;
+      case Int32:
+         _getNextInt64Array<int32_t>( values, count );
+         break;
+      case UInt32:
+         _getNextInt64Array<uint32_t>( values, count );
+         break;
+      case Int64:
+         _getNextInt64Array<int64_t>( values, count );
+         break;
+      case Bool:
+      {
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         /// Convert bool to 0/1, all non-zero values map to 1
+         const char *p = &base_[nextIndex_ * stride_];
+         for ( size_t i = 0; i < count; i++ )
+         {
+            values[i] = ( *reinterpret_cast<const bool *>( p ) ) ? 1 : 0;
+            p += stride_;
+         }
+         nextIndex_ += static_cast<unsigned>( count );
+         break;
+      }
+      case Real32:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         //??? fault if get special value: NaN, NegInf...
+         _getNextInt64Array<float>( values, count );
+         break;
+      case Real64:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         //??? fault if get special value: NaN, NegInf...
+         _getNextInt64Array<double>( values, count );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+      default:
+         throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+}
+
+void SourceDestBufferImpl::getNextInt64Array( int64_t *values, size_t count, double scale,
+                                              double offset )
+{
+   /// don't checkImageFileOpen
+
+   /// Incorporating the scale is optional (requested by user when constructing
+   /// the sdbuf). If the user did not request scaling, then we get raw values
+   /// from user's buffer.
+   if ( !doScaling_ )
+   {
+      /// Just get raw values.
+      getNextInt64Array( values, count );
+      return;
+   }
+
+   /// Double check non-zero scale.  Going to divide by it below.
+   if ( scale == 0 )
    {
       throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
    }
 
-   /// Assign to already initialized element in vector
-   ( *ustrings_ )[nextIndex_] = value;
-   nextIndex_++;
+   /// Verify the whole run is within bounds
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _getNextInt64ArrayScaled<int8_t>( values, count, scale, offset );
+         break;
+      case UInt8:
+         _getNextInt64ArrayScaled<uint8_t>( values, count, scale, offset );
+         break;
+      case Int16:
+         _getNextInt64ArrayScaled<int16_t>( values, count, scale, offset );
+         break;
+      case UInt16:
+         _getNextInt64ArrayScaled<uint16_t>( values, count, scale, offset );
+         break;
+      case Int32:
+         _getNextInt64ArrayScaled<int32_t>( values, count, scale, offset );
+         break;
+      case UInt32:
+         _getNextInt64ArrayScaled<uint32_t>( values, count, scale, offset );
+         break;
+      case Int64:
+         _getNextInt64ArrayScaled<int64_t>( values, count, scale, offset );
+         break;
+      case Bool:
+      {
+         const char *p = &base_[nextIndex_ * stride_];
+         for ( size_t i = 0; i < count; i++ )
+         {
+            double x = ( *reinterpret_cast<const bool *>( p ) ) ? 1 : 0;
+            values[i] = static_cast<int64_t>( floor( ( x - offset ) / scale + 0.5 ) );
+            p += stride_;
+         }
+         nextIndex_ += static_cast<unsigned>( count );
+         break;
+      }
+      case Real32:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         //??? fault if get special value: NaN, NegInf...
+         _getNextInt64ArrayScaled<float>( values, count, scale, offset );
+         break;
+      case Real64:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         //??? fault if get special value: NaN, NegInf...
+         _getNextInt64ArrayScaled<double>( values, count, scale, offset );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+      default:
+         throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+}
+
+template <typename T>
+void SourceDestBufferImpl::_setNextInt64Array( const int64_t *values, size_t count, int64_t minimum,
+                                               int64_t maximum )
+{
+   char *p = &base_[nextIndex_ * stride_];
+
+   for ( size_t i = 0; i < count; i++ )
+   {
+      const int64_t value = values[i];
+
+      if ( value < minimum || maximum < value )
+      {
+         throw E57_EXCEPTION2( ErrorValueNotRepresentable,
+                               "pathName=" + pathName_ + " value=" + toString( value ) );
+      }
+
+      *reinterpret_cast<T *>( p ) = static_cast<T>( value );
+      p += stride_;
+      nextIndex_++;
+   }
+}
+
+template <typename T>
+void SourceDestBufferImpl::_setNextInt64ArrayScaled( const int64_t *values, size_t count,
+                                                     double scale, double offset, double minimum,
+                                                     double maximum )
+{
+   char *p = &base_[nextIndex_ * stride_];
+
+   for ( size_t i = 0; i < count; i++ )
+   {
+      /// Calc x*scale+offset
+      double scaledValue;
+      if ( std::is_floating_point<T>::value )
+      {
+         /// Value will be stored in some floating point rep in user's buffer,
+         /// so keep full resolution here.
+         scaledValue = values[i] * scale + offset;
+      }
+      else
+      {
+         /// Value will represented as some integer in user's buffer, so round
+         /// to nearest integer here. But keep in floating point rep until we
+         /// know that the value is representable in the user's buffer.
+         scaledValue = floor( values[i] * scale + offset + 0.5 );
+      }
+
+      if ( scaledValue < minimum || maximum < scaledValue )
+      {
+         throw E57_EXCEPTION2( ErrorScaledValueNotRepresentable,
+                               "pathName=" + pathName_ + " scaledValue=" + toString( scaledValue ) );
+      }
+
+      *reinterpret_cast<T *>( p ) = static_cast<T>( scaledValue );
+      p += stride_;
+      nextIndex_++;
+   }
+}
+
+void SourceDestBufferImpl::getNextFloatArray( float *values, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify the whole run is within bounds
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Zero-copy fast path: source is a contiguous float array with the same
+   /// representation as the bytestream, so the run is just raw bytes.
+   if ( memoryRepresentation_ == Real32 && stride_ == sizeof( float ) )
+   {
+      memcpy( values, &base_[nextIndex_ * stride_], count * sizeof( float ) );
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   /// Block-conversion path: contiguous double source feeding a float bytestream.
+   /// Keeps getNextFloat()'s exponent check but narrows the whole run in one cast loop.
+   if ( memoryRepresentation_ == Real64 && stride_ == sizeof( double ) )
+   {
+      const auto *source = reinterpret_cast<const double *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+         /// Check that exponent of user's value is not too large for single
+         /// precision number in file.
+         if ( source[i] < DOUBLE_MIN || DOUBLE_MAX < source[i] )
+         {
+            throw E57_EXCEPTION2( ErrorReal64TooLarge,
+                                  "pathName=" + pathName_ + " value=" + toString( source[i] ) );
+         }
+
+         values[i] = static_cast<float>( source[i] );
+      }
+
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   for ( size_t i = 0; i < count; ++i )
+   {
+      values[i] = getNextFloat();
+   }
+}
+
+void SourceDestBufferImpl::getNextDoubleArray( double *values, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify the whole run is within bounds
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Zero-copy fast path: source is a contiguous double array with the same
+   /// representation as the bytestream, so the run is just raw bytes.
+   if ( memoryRepresentation_ == Real64 && stride_ == sizeof( double ) )
+   {
+      memcpy( values, &base_[nextIndex_ * stride_], count * sizeof( double ) );
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   /// Block-conversion path: contiguous float source feeding a double bytestream.
+   /// Widening needs no range check, so this is a plain cast loop the compiler can vectorize.
+   if ( memoryRepresentation_ == Real32 && stride_ == sizeof( float ) )
+   {
+      const auto *source = reinterpret_cast<const float *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+         values[i] = static_cast<double>( source[i] );
+      }
+
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   for ( size_t i = 0; i < count; ++i )
+   {
+      values[i] = getNextDouble();
+   }
+}
+
+void SourceDestBufferImpl::setNextInt64Array( const int64_t *values, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify the whole run will fit
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _setNextInt64Array<int8_t>( values, count, INT8_MIN, INT8_MAX );
+         break;
+      case UInt8:
+         _setNextInt64Array<uint8_t>( values, count, UINT8_MIN, UINT8_MAX );
+         break;
+      case Int16:
+         _setNextInt64Array<int16_t>( values, count, INT16_MIN, INT16_MAX );
+         break;
+      case UInt16:
+         _setNextInt64Array<uint16_t>( values, count, UINT16_MIN, UINT16_MAX );
+         break;
+      case Int32:
+         _setNextInt64Array<int32_t>( values, count, INT32_MIN, INT32_MAX );
+         break;
+      case UInt32:
+         _setNextInt64Array<uint32_t>( values, count, UINT32_MIN, UINT32_MAX );
+         break;
+      case Int64:
+         _setNextInt64Array<int64_t>( values, count, INT64_MIN, INT64_MAX );
+         break;
+      case Bool:
+      {
+         char *p = &base_[nextIndex_ * stride_];
+         for ( size_t i = 0; i < count; i++ )
+         {
+            *reinterpret_cast<bool *>( p ) = ( values[i] ? false : true );
+            p += stride_;
+         }
+         nextIndex_ += static_cast<unsigned>( count );
+         break;
+      }
+      case Real32:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         //??? very large integers may lose some lowest bits here. error?
+         _setNextInt64Array<float>( values, count, INT64_MIN, INT64_MAX );
+         break;
+      case Real64:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         _setNextInt64Array<double>( values, count, INT64_MIN, INT64_MAX );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+   }
+}
+
+void SourceDestBufferImpl::setNextInt64Array( const int64_t *values, size_t count, double scale,
+                                              double offset )
+{
+   /// don't checkImageFileOpen
+
+   /// Incorporating the scale is optional (requested by user when constructing
+   /// the sdbuf). If the user did not request scaling, then we send raw values
+   /// to user's buffer.
+   if ( !doScaling_ )
+   {
+      /// Use raw value routine, then bail out.
+      setNextInt64Array( values, count );
+      return;
+   }
+
+   /// Verify the whole run will fit
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Fused fast paths for the overwhelmingly common case: ScaledInteger fields
+   /// landing in a contiguous float/double destination (laser-scanner x/y/z).
+   /// The multiply-add loops have no per-element state updates so the compiler
+   /// can turn them into packed fused multiply-adds.
+   if ( memoryRepresentation_ == Real64 && doConversion_ && stride_ == sizeof( double ) )
+   {
+      auto out = reinterpret_cast<double *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; i++ )
+      {
+         out[i] = values[i] * scale + offset;
+      }
+
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   if ( memoryRepresentation_ == Real32 && doConversion_ && stride_ == sizeof( float ) )
+   {
+      auto out = reinterpret_cast<float *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; i++ )
+      {
+         double scaledValue = values[i] * scale + offset;
+
+         /// Check that exponent of result is not too big for single precision
+         /// float
+         if ( scaledValue < DOUBLE_MIN || DOUBLE_MAX < scaledValue )
+         {
+            nextIndex_ += static_cast<unsigned>( i );
+            throw E57_EXCEPTION2( ErrorScaledValueNotRepresentable,
+                                  "pathName=" + pathName_ +
+                                     " scaledValue=" + toString( scaledValue ) );
+         }
+
+         out[i] = static_cast<float>( scaledValue );
+      }
+
+      nextIndex_ += static_cast<unsigned>( count );
+      return;
+   }
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _setNextInt64ArrayScaled<int8_t>( values, count, scale, offset, INT8_MIN, INT8_MAX );
+         break;
+      case UInt8:
+         _setNextInt64ArrayScaled<uint8_t>( values, count, scale, offset, UINT8_MIN, UINT8_MAX );
+         break;
+      case Int16:
+         _setNextInt64ArrayScaled<int16_t>( values, count, scale, offset, INT16_MIN, INT16_MAX );
+         break;
+      case UInt16:
+         _setNextInt64ArrayScaled<uint16_t>( values, count, scale, offset, UINT16_MIN, UINT16_MAX );
+         break;
+      case Int32:
+         _setNextInt64ArrayScaled<int32_t>( values, count, scale, offset, INT32_MIN, INT32_MAX );
+         break;
+      case UInt32:
+         _setNextInt64ArrayScaled<uint32_t>( values, count, scale, offset, UINT32_MIN, UINT32_MAX );
+         break;
+      case Int64:
+         /// No bounds enforced here, matching the single-element path.
+         _setNextInt64ArrayScaled<int64_t>( values, count, scale, offset, -HUGE_VAL, HUGE_VAL );
+         break;
+      case Bool:
+      {
+         char *p = &base_[nextIndex_ * stride_];
+         for ( size_t i = 0; i < count; i++ )
+         {
+            double scaledValue = floor( values[i] * scale + offset + 0.5 );
+            *reinterpret_cast<bool *>( p ) = ( scaledValue ? false : true );
+            p += stride_;
+         }
+         nextIndex_ += static_cast<unsigned>( count );
+         break;
+      }
+      case Real32:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         /// Check that exponent of result is not too big for single precision
+         /// float
+         _setNextInt64ArrayScaled<float>( values, count, scale, offset, DOUBLE_MIN, DOUBLE_MAX );
+         break;
+      case Real64:
+         if ( !doConversion_ )
+         {
+            throw E57_EXCEPTION2( ErrorConversionRequired, "pathName=" + pathName_ );
+         }
+         _setNextInt64ArrayScaled<double>( values, count, scale, offset, -HUGE_VAL, HUGE_VAL );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+   }
+}
+
+template <typename T> void SourceDestBufferImpl::_setNextFill( T convertedValue, size_t count )
+{
+   char *p = &base_[nextIndex_ * stride_];
+
+   if ( stride_ == sizeof( T ) )
+   {
+      std::fill_n( reinterpret_cast<T *>( p ), count, convertedValue );
+   }
+   else
+   {
+      for ( size_t i = 0; i < count; i++ )
+      {
+         *reinterpret_cast<T *>( p ) = convertedValue;
+         p += stride_;
+      }
+   }
+
+   nextIndex_ += static_cast<unsigned>( count );
+}
+
+void SourceDestBufferImpl::setNextInt64Fill( int64_t value, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   if ( count == 0 )
+   {
+      return;
+   }
+
+   /// Verify the whole run will fit
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Validate and convert the constant once by sending the first element
+   /// through the scalar path (which carries all the range checks), then
+   /// replicate the converted element over the rest of the run.
+   setNextInt64( value );
+
+   if ( --count == 0 )
+   {
+      return;
+   }
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _setNextFill<int8_t>( static_cast<int8_t>( value ), count );
+         break;
+      case UInt8:
+         _setNextFill<uint8_t>( static_cast<uint8_t>( value ), count );
+         break;
+      case Int16:
+         _setNextFill<int16_t>( static_cast<int16_t>( value ), count );
+         break;
+      case UInt16:
+         _setNextFill<uint16_t>( static_cast<uint16_t>( value ), count );
+         break;
+      case Int32:
+         _setNextFill<int32_t>( static_cast<int32_t>( value ), count );
+         break;
+      case UInt32:
+         _setNextFill<uint32_t>( static_cast<uint32_t>( value ), count );
+         break;
+      case Int64:
+         _setNextFill<int64_t>( value, count );
+         break;
+      case Bool:
+         _setNextFill<bool>( value ? false : true, count );
+         break;
+      case Real32:
+         _setNextFill<float>( static_cast<float>( value ), count );
+         break;
+      case Real64:
+         _setNextFill<double>( static_cast<double>( value ), count );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+   }
+}
+
+void SourceDestBufferImpl::setNextInt64Fill( int64_t value, size_t count, double scale,
+                                             double offset )
+{
+   /// don't checkImageFileOpen
+
+   /// If the user did not request scaling, then we send raw values to user's buffer.
+   if ( !doScaling_ )
+   {
+      setNextInt64Fill( value, count );
+      return;
+   }
+
+   if ( count == 0 )
+   {
+      return;
+   }
+
+   /// Verify the whole run will fit
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Validate and convert the constant once via the scalar path, then replicate
+   setNextInt64( value, scale, offset );
+
+   if ( --count == 0 )
+   {
+      return;
+   }
+
+   /// Same scaled value the scalar path just stored (full resolution for float
+   /// representations, rounded to nearest integer otherwise)
+   const double scaledFloat = value * scale + offset;
+   const double scaledRounded = floor( scaledFloat + 0.5 );
+
+   switch ( memoryRepresentation_ )
+   {
+      case Int8:
+         _setNextFill<int8_t>( static_cast<int8_t>( scaledRounded ), count );
+         break;
+      case UInt8:
+         _setNextFill<uint8_t>( static_cast<uint8_t>( scaledRounded ), count );
+         break;
+      case Int16:
+         _setNextFill<int16_t>( static_cast<int16_t>( scaledRounded ), count );
+         break;
+      case UInt16:
+         _setNextFill<uint16_t>( static_cast<uint16_t>( scaledRounded ), count );
+         break;
+      case Int32:
+         _setNextFill<int32_t>( static_cast<int32_t>( scaledRounded ), count );
+         break;
+      case UInt32:
+         _setNextFill<uint32_t>( static_cast<uint32_t>( scaledRounded ), count );
+         break;
+      case Int64:
+         _setNextFill<int64_t>( static_cast<int64_t>( scaledRounded ), count );
+         break;
+      case Bool:
+         _setNextFill<bool>( scaledRounded != 0.0 ? false : true, count );
+         break;
+      case Real32:
+         _setNextFill<float>( static_cast<float>( scaledFloat ), count );
+         break;
+      case Real64:
+         _setNextFill<double>( scaledFloat, count );
+         break;
+      case UString:
+         throw E57_EXCEPTION2( ErrorExpectingNumeric, "pathName=" + pathName_ );
+   }
+}
+
+void SourceDestBufferImpl::setNextFloat( float value )
+{
+   _setNextReal( value );
+}
+
+void SourceDestBufferImpl::setNextDouble( double value )
+{
+   _setNextReal( value );
+}
+
+void SourceDestBufferImpl::setNextFloatArray( const float *values, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify have room for the whole run
+   if ( nextIndex_ + count > capacity_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Zero-copy fast path: destination is a contiguous float array with the
+   /// same representation as the bytestream, so the run is just raw bytes.
+   if ( memoryRepresentation_ == Real32 && stride_ == sizeof( float ) )
+   {
+      memcpy( &base_[nextIndex_ * stride_], values, count * sizeof( float ) );
+      nextIndex_ += count;
+      return;
+   }
+
+   /// Block-conversion path: float bytestream feeding a contiguous double destination.
+   /// Widening needs no range check, so this is a plain cast loop the compiler can vectorize.
+   if ( memoryRepresentation_ == Real64 && stride_ == sizeof( double ) )
+   {
+      auto dest = reinterpret_cast<double *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+         dest[i] = static_cast<double>( values[i] );
+      }
+
+      nextIndex_ += count;
+      return;
+   }
+
+   for ( size_t i = 0; i < count; ++i )
+   {
+      _setNextReal( values[i] );
+   }
+}
+
+void SourceDestBufferImpl::setNextDoubleArray( const double *values, size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify have room for the whole run
+   if ( nextIndex_ + count > capacity_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Zero-copy fast path: destination is a contiguous double array with the
+   /// same representation as the bytestream, so the run is just raw bytes.
+   if ( memoryRepresentation_ == Real64 && stride_ == sizeof( double ) )
+   {
+      memcpy( &base_[nextIndex_ * stride_], values, count * sizeof( double ) );
+      nextIndex_ += count;
+      return;
+   }
+
+   /// Block-conversion path: double bytestream feeding a contiguous float destination.
+   /// Keeps _setNextReal()'s exponent check but narrows the whole run in one cast loop.
+   if ( memoryRepresentation_ == Real32 && stride_ == sizeof( float ) )
+   {
+      auto dest = reinterpret_cast<float *>( &base_[nextIndex_ * stride_] );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+         /// Check for really large exponents that can't fit in a single precision
+         if ( values[i] < DOUBLE_MIN || DOUBLE_MAX < values[i] )
+         {
+            throw E57_EXCEPTION2( ErrorValueNotRepresentable,
+                                  "pathName=" + pathName_ + " value=" + toString( values[i] ) );
+         }
+
+         dest[i] = static_cast<float>( values[i] );
+      }
+
+      nextIndex_ += count;
+      return;
+   }
+
+   for ( size_t i = 0; i < count; ++i )
+   {
+      _setNextReal( values[i] );
+   }
+}
+
+void SourceDestBufferImpl::setNextString( const ustring &value )
+{
+   /// don't checkImageFileOpen
+
+   if ( memoryRepresentation_ != UString )
+   {
+      throw E57_EXCEPTION2( ErrorExpectingUString, "pathName=" + pathName_ );
+   }
+
+   /// Verify have room.
+   if ( nextIndex_ >= capacity_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Assign to already initialized element in vector
+   ( *ustrings_ )[nextIndex_] = value;
+   nextIndex_++;
+}
+
+void SourceDestBufferImpl::setNextString( const char *chars, size_t length )
+{
+   /// don't checkImageFileOpen
+
+   if ( memoryRepresentation_ != UString )
+   {
+      throw E57_EXCEPTION2( ErrorExpectingUString, "pathName=" + pathName_ );
+   }
+
+   /// Verify have room.
+   if ( nextIndex_ >= capacity_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   /// Assign characters in place: the element in the user's vector keeps (and
+   /// reuses) its allocation, so repeated reads into the same buffer stop
+   /// allocating once the elements have grown to their working size.
+   ( *ustrings_ )[nextIndex_].assign( chars, length );
+   nextIndex_++;
+}
+
+void SourceDestBufferImpl::advanceNextIndex( size_t count )
+{
+   /// don't checkImageFileOpen
+
+   /// Verify the caller's direct writes stayed within the buffer
+   if ( count > capacity_ - nextIndex_ )
+   {
+      throw E57_EXCEPTION2( ErrorInternal, "pathName=" + pathName_ );
+   }
+
+   nextIndex_ += static_cast<unsigned>( count );
 }
 
 void SourceDestBufferImpl::checkCompatible(
@@ -99,6 +99,10 @@ namespace e57
          nextIndex_ = 0;
       }
 
+      /// Folds elements [0, count) into the running minimum/maximum, converting each
+      /// to double. String buffers have no numeric range and are left untouched.
+      void accumulateMinMax( size_t count, double &minimum, double &maximum ) const;
+
       int64_t getNextInt64();
       int64_t getNextInt64( double scale, double offset );
       float getNextFloat();
@@ -110,6 +114,44 @@ namespace e57
       void setNextDouble( double value );
       void setNextString( const ustring &value );
 
+      /// Character-range variant that assigns in place into the destination
+      /// element, reusing its existing allocation instead of constructing a
+      /// temporary ustring per record
+      void setNextString( const char *chars, size_t length );
+
+      /// Bulk variants of the single-element accessors above.  These hoist the
+      /// switch on memoryRepresentation_ (and the scaling decision) out of the
+      /// per-element loop so a contiguous run of values is converted by one
+      /// tight, auto-vectorizable loop per memory representation.
+      void getNextInt64Array( int64_t *values, size_t count );
+      void getNextInt64Array( int64_t *values, size_t count, double scale, double offset );
+      void setNextInt64Array( const int64_t *values, size_t count );
+      void setNextInt64Array( const int64_t *values, size_t count, double scale, double offset );
+
+      /// Bulk fetch of IEEE floats/doubles (the encode-side mirror of the stores
+      /// below).  When the source has the same representation and is contiguous
+      /// (stride == element size) the run is a single memcpy; otherwise falls
+      /// back to per-element conversion.
+      void getNextFloatArray( float *values, size_t count );
+      void getNextDoubleArray( double *values, size_t count );
+
+      /// Bulk store of IEEE floats/doubles.  When the destination has the same
+      /// representation and is contiguous (stride == element size) the run is a
+      /// single memcpy; otherwise falls back to per-element conversion.
+      void setNextFloatArray( const float *values, size_t count );
+      void setNextDoubleArray( const double *values, size_t count );
+
+      /// Bulk fill with one repeated value (constant channels).  The value is
+      /// validated and converted once, then replicated by a std::fill-style loop,
+      /// so a constant field costs O(1) conversions however long the run is.
+      void setNextInt64Fill( int64_t value, size_t count );
+      void setNextInt64Fill( int64_t value, size_t count, double scale, double offset );
+
+      /// Marks count elements as filled by a caller that converted and stored
+      /// them directly through base() (the monomorphized decode loops do this).
+      /// Bounds-checked like the setNext routines.
+      void advanceNextIndex( size_t count );
+
       void checkCompatible( const std::shared_ptr<SourceDestBufferImpl> &newBuf ) const;
 
 #ifdef E57_ENABLE_DIAGNOSTIC_OUTPUT
@@ -119,6 +161,18 @@ namespace e57
    private:
       template <typename T> void _setNextReal( T inValue );
 
+      /// Per-type conversion loops for the bulk accessors
+      template <typename T> void _getNextInt64Array( int64_t *values, size_t count );
+      template <typename T>
+      void _getNextInt64ArrayScaled( int64_t *values, size_t count, double scale, double offset );
+      template <typename T>
+      void _setNextInt64Array( const int64_t *values, size_t count, int64_t minimum,
+                               int64_t maximum );
+      template <typename T>
+      void _setNextInt64ArrayScaled( const int64_t *values, size_t count, double scale,
+                                     double offset, double minimum, double maximum );
+      template <typename T> void _setNextFill( T convertedValue, size_t count );
+
       /// Common routine to check that constructor arguments were ok, throws if not
       void checkState_() const;
 
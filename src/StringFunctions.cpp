@@ -1,6 +1,9 @@
 #include "StringFunctions.h"
 
 #include <cassert>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
 #include <locale>
 
 namespace e57
@@ -9,52 +12,59 @@ namespace e57
    {
       static_assert( std::is_floating_point<FTYPE>::value, "Floating point type required." );
 
-      std::stringstream ss;
-      ss.imbue( std::locale::classic() );
+      // This runs once per Float/ScaledInteger attribute while writing the XML
+      // section, so format with snprintf instead of constructing a stringstream
+      // (which dominated serialization time for files with many scans).
+      char buffer[64];
+      const int length = std::snprintf( buffer, sizeof( buffer ), "%.*e", precision,
+                                        static_cast<double>( value ) );
+      assert( length > 0 && length < static_cast<int>( sizeof( buffer ) ) );
 
-      ss << std::scientific << std::setprecision( precision ) << value;
+      // snprintf honours the global C locale, but the E57 XML section requires '.'
+      const char decimalPoint = *std::localeconv()->decimal_point;
+      if ( decimalPoint != '.' )
+      {
+         for ( int i = 0; i < length; ++i )
+         {
+            if ( buffer[i] == decimalPoint )
+            {
+               buffer[i] = '.';
+            }
+         }
+      }
 
       // Try to remove trailing zeroes and decimal point
       // e.g. 1.23456000000000000e+005  ==> 1.23456e+005
       // e.g. 2.00000000000000000e+005  ==> 2e+005
 
-      std::string s = ss.str();
-
       // Split into mantissa and exponent
       // e.g. 1.23456000000000000e+005  ==> "1.23456000000000000" + "e+005"
-      auto index = s.find_last_of( 'e' );
-      assert( index != std::string::npos ); // should not be possible
+      const char *exponent = static_cast<const char *>( memchr( buffer, 'e', length ) );
+      assert( exponent != nullptr ); // should not be possible
 
-      std::string mantissa = s.substr( 0, index );
-      const std::string exponent = s.substr( index );
+      size_t mantissaLength = exponent - buffer;
 
-      // Double check that we understand the formatting
-      if ( exponent[0] == 'e' )
+      // Trim trailing zeros from mantissa
+      while ( mantissaLength > 0 && buffer[mantissaLength - 1] == '0' )
       {
-         // Trim trailing zeros from mantissa
-         while ( mantissa.back() == '0' )
-         {
-            mantissa.pop_back();
-         }
+         --mantissaLength;
+      }
 
-         // Trim trailing decimal point if possible
-         if ( mantissa.back() == '.' )
-         {
-            mantissa.pop_back();
-         }
+      // Trim trailing decimal point if possible
+      if ( mantissaLength > 0 && buffer[mantissaLength - 1] == '.' )
+      {
+         --mantissaLength;
+      }
 
-         // Reassemble whole floating point number
-         // Check if can drop exponent.
-         if ( ( exponent == "e+00" ) || ( exponent == "e+000" ) )
-         {
-            s = mantissa;
-         }
-         else
-         {
-            s = mantissa + exponent;
-         }
+      // Reassemble whole floating point number
+      // Check if can drop exponent.
+      if ( ( strcmp( exponent, "e+00" ) == 0 ) || ( strcmp( exponent, "e+000" ) == 0 ) )
+      {
+         return std::string( buffer, mantissaLength );
       }
 
+      std::string s( buffer, mantissaLength );
+      s.append( exponent );
       return s;
    }
 
@@ -115,6 +115,27 @@ void StructureNodeImpl::setAttachedRecursive()
    }
 }
 
+void StructureNodeImpl::buildLookupIndexesRecursive()
+{
+   // Build the name index findChild() would otherwise build on first use, so lookups
+   // in a read-only tree never write to the node (and are safe from several threads)
+   if ( children_.size() >= cMinChildrenToIndex )
+   {
+      childNameIndex_.clear();
+      childNameIndex_.reserve( children_.size() );
+
+      for ( size_t i = 0; i < children_.size(); ++i )
+      {
+         childNameIndex_.emplace( children_[i]->elementName(), i );
+      }
+   }
+
+   for ( auto &child : children_ )
+   {
+      child->buildLookupIndexesRecursive();
+   }
+}
+
 int64_t StructureNodeImpl::childCount() const
 {
    checkImageFileOpen( __FILE__, __LINE__, static_cast<const char *>( __FUNCTION__ ) );
@@ -150,7 +171,6 @@ NodeImplSharedPtr StructureNodeImpl::get( const ustring &pathName )
 NodeImplSharedPtr StructureNodeImpl::lookup( const ustring &pathName )
 {
    // don't checkImageFileOpen
-   //??? use lookup(fields, level) instead, for speed.
    bool isRelative;
    std::vector<ustring> fields;
    ImageFileImplSharedPtr imf( destImageFile_ );
@@ -169,39 +189,75 @@ NodeImplSharedPtr StructureNodeImpl::lookup( const ustring &pathName )
          return ( root );
       }
 
-      // Find child with elementName that matches first field in path
-      unsigned i;
-      for ( i = 0; i < children_.size(); i++ )
+      // Parse once, then descend level by level on the parsed fields
+      return lookup( fields, 0 );
+   }
+
+   // Absolute pathname and we aren't at the root
+   // Find root of the tree
+   NodeImplSharedPtr root( getRoot() );
+
+   // Call lookup on root
+   return ( root->lookup( pathName ) );
+}
+
+NodeImplSharedPtr StructureNodeImpl::lookup( const StringList &fields, size_t level )
+{
+   // don't checkImageFileOpen
+
+   // Find child with elementName that matches current field in path
+   NodeImplSharedPtr child = findChild( fields.at( level ) );
+   if ( !child )
+   {
+      return {}; // empty pointer
+   }
+
+   if ( level == fields.size() - 1 )
+   {
+      return ( child );
+   }
+
+   // Descend into child with the remaining fields (non-container children return
+   // an empty pointer from the base class, as before)
+   return child->lookup( fields, level + 1 );
+}
+
+NodeImplSharedPtr StructureNodeImpl::findChild( const ustring &fieldName )
+{
+   // Small structures aren't worth indexing, just scan
+   if ( children_.size() < cMinChildrenToIndex )
+   {
+      for ( auto &child : children_ )
       {
-         if ( fields.at( 0 ) == children_.at( i )->elementName() )
+         if ( fieldName == child->elementName() )
          {
-            break;
+            return ( child );
          }
       }
-      if ( i == children_.size() )
-      {
-         return {}; // empty pointer
-      }
 
-      if ( fields.size() == 1 )
-      {
-         return ( children_.at( i ) );
-      }
+      return {}; // empty pointer
+   }
 
-      //??? use level here rather than unparse
-      // Remove first field in path
-      fields.erase( fields.begin() );
+   // (Re)build the name index lazily; children are append-only and never renamed,
+   // so a size mismatch is the only way the index can be stale
+   if ( childNameIndex_.size() != children_.size() )
+   {
+      childNameIndex_.clear();
+      childNameIndex_.reserve( children_.size() );
 
-      // Call lookup on child object with remaining fields in path name
-      return children_.at( i )->lookup( imf->pathNameUnparse( true, fields ) );
+      for ( size_t i = 0; i < children_.size(); ++i )
+      {
+         childNameIndex_.emplace( children_[i]->elementName(), i );
+      }
    }
 
-   // Absolute pathname and we aren't at the root
-   // Find root of the tree
-   NodeImplSharedPtr root( getRoot() );
+   const auto found = childNameIndex_.find( fieldName );
+   if ( found == childNameIndex_.end() )
+   {
+      return {}; // empty pointer
+   }
 
-   // Call lookup on root
-   return ( root->lookup( pathName ) );
+   return ( children_[found->second] );
 }
 
 void StructureNodeImpl::set( int64_t index64, NodeImplSharedPtr ni )
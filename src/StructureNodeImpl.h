@@ -27,7 +27,10 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "NodeImpl.h"
+#include "SmallVector.h"
 
 namespace e57
 {
@@ -42,6 +45,7 @@ namespace e57
       bool isTypeEquivalent( NodeImplSharedPtr ni ) override;
       bool isDefined( const ustring &pathName ) override;
       void setAttachedRecursive() override;
+      void buildLookupIndexesRecursive() override;
 
       virtual int64_t childCount() const;
 
@@ -68,7 +72,22 @@ namespace e57
       friend class CompressedVectorReaderImpl;
 
       NodeImplSharedPtr lookup( const ustring &pathName ) override;
+      NodeImplSharedPtr lookup( const StringList &fields, size_t level ) override;
+
+      /// Find direct child by elementName (empty pointer if no match)
+      NodeImplSharedPtr findChild( const ustring &fieldName );
+
+      /// Structures smaller than this aren't worth indexing; findChild() just scans them
+      static constexpr size_t cMinChildrenToIndex = 8;
+
+      /// Child lists stay inline in the node up to the typical structure size, so
+      /// traversals (XML serialization, prototype walks, header reads) touch the
+      /// arena slabs the nodes already live in instead of a heap array per structure
+      SmallVector<NodeImplSharedPtr, 16> children_;
 
-      std::vector<NodeImplSharedPtr> children_;
+      /// elementName -> index in children_, built lazily once a structure has enough
+      /// children that the linear scan in findChild() starts to matter (e.g. the
+      /// root-level vectors of a multi-thousand-scan project)
+      std::unordered_map<ustring, size_t> childNameIndex_;
    };
 }
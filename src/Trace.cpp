@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "Trace.h"
+
+namespace e57
+{
+   namespace trace
+   {
+      std::atomic<TraceHandler> handler{ nullptr };
+      std::atomic<void *> userData{ nullptr };
+   }
+
+   /*!
+   @brief Registers a process-wide tracing callback, replacing any previous one
+   @details Intended for correlating E57 activity with external profiling or storage-layer
+   traces without recompiling. Pass nullptr to disable tracing (the default).
+   @param [in] handler The callback to invoke, or nullptr to disable
+   @param [in] userData Opaque pointer passed unchanged to every callback invocation
+   */
+   void SetTraceHandler( TraceHandler handler, void *userData )
+   {
+      // Order matters for a handler installed while another thread is reading: publish
+      // the user data first so the new handler never sees the old pointer.
+      trace::userData.store( userData, std::memory_order_relaxed );
+      trace::handler.store( handler, std::memory_order_release );
+   }
+}
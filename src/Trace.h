@@ -0,0 +1,29 @@
+#pragma once
+// SPDX-License-Identifier: BSL-1.0
+
+#include <atomic>
+
+#include "Common.h"
+
+namespace e57
+{
+   namespace trace
+   {
+      /// Process-wide handler state set by SetTraceHandler().  The handler is stored with
+      /// release and loaded with acquire so a newly installed handler always sees the user
+      /// data published alongside it.
+      extern std::atomic<TraceHandler> handler;
+      extern std::atomic<void *> userData;
+
+      /// Fire an instrumentation point; one predictable branch when tracing is disabled
+      inline void emit( TraceEvent event, uint64_t offset, uint64_t count )
+      {
+         TraceHandler h = handler.load( std::memory_order_acquire );
+
+         if ( h != nullptr )
+         {
+            h( event, offset, count, userData.load( std::memory_order_relaxed ) );
+         }
+      }
+   }
+}
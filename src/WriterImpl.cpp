@@ -126,7 +126,47 @@ namespace e57
    }
 
    WriterImpl::WriterImpl( const ustring &filePath, const WriterOptions &options ) :
-      imf_( filePath, "w" ), root_( imf_.root() ), data3D_( imf_, true ), images2D_( imf_, true )
+      imf_( filePath, options.append ? "a" : "w" ), root_( imf_.root() ),
+      data3D_( ( options.append && root_.isDefined( "data3D" ) )
+                  ? VectorNode( root_.get( "data3D" ) )
+                  : VectorNode( imf_, true ) ),
+      images2D_( ( options.append && root_.isDefined( "images2D" ) )
+                    ? VectorNode( root_.get( "images2D" ) )
+                    : VectorNode( imf_, true ) )
+   {
+      if ( options.expectedFileSizeHint > 0 )
+      {
+         imf_.preallocate( options.expectedFileSizeHint );
+      }
+
+      if ( options.append )
+      {
+         // The reopened file already carries its per-file metadata; just make sure the
+         // data3D/images2D containers exist so new scans and images have a home.
+         if ( !root_.isDefined( "data3D" ) )
+         {
+            root_.set( "data3D", data3D_ );
+         }
+
+         if ( !root_.isDefined( "images2D" ) )
+         {
+            root_.set( "images2D", images2D_ );
+         }
+
+         return;
+      }
+
+      initNewFile( options );
+   }
+
+   WriterImpl::WriterImpl( std::vector<char> &outBuffer, const WriterOptions &options ) :
+      imf_( outBuffer ), root_( imf_.root() ), data3D_( imf_, true ), images2D_( imf_, true )
+   {
+      initNewFile( options );
+   }
+
+   /// Set the per-file properties of a freshly created (empty) image file
+   void WriterImpl::initNewFile( const WriterOptions &options )
    {
       // We are using the E57 v1.0 data format standard field names.
       // The standard field names are used without an extension prefix (in the default namespace).
@@ -1157,10 +1197,19 @@ namespace e57
 
    template <typename COORDTYPE>
    CompressedVectorWriter WriterImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t count, const Data3DPointsData_t<COORDTYPE> &buffers )
+      int64_t dataIndex, size_t count, const Data3DPointsData_t<COORDTYPE> &buffers,
+      size_t stride )
    {
       static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
 
+      // stride == 0 means each field is a tightly packed array (the SoA layout of
+      // Data3DPointsData_t).  A nonzero stride means the field pointers address the
+      // fields of the first record in one interleaved (AoS) buffer, with consecutive
+      // records stride bytes apart, so points are encoded straight from that layout.
+      auto fieldStride = [stride]( size_t elementSize ) {
+         return ( stride != 0 ) ? stride : elementSize;
+      };
+
       const StructureNode scan( data3D_.get( dataIndex ) );
       CompressedVectorNode points( scan.get( "points" ) );
       const StructureNode proto( points.prototype() );
@@ -1168,111 +1217,130 @@ namespace e57
 
       if ( proto.isDefined( "cartesianX" ) && ( buffers.cartesianX != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "cartesianX", buffers.cartesianX, count, true, true );
+         sourceBuffers.emplace_back( imf_, "cartesianX", buffers.cartesianX, count, true, true,
+                                        fieldStride( sizeof( *buffers.cartesianX ) ) );
       }
 
       if ( proto.isDefined( "cartesianY" ) && ( buffers.cartesianY != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "cartesianY", buffers.cartesianY, count, true, true );
+         sourceBuffers.emplace_back( imf_, "cartesianY", buffers.cartesianY, count, true, true,
+                                        fieldStride( sizeof( *buffers.cartesianY ) ) );
       }
 
       if ( proto.isDefined( "cartesianZ" ) && ( buffers.cartesianZ != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "cartesianZ", buffers.cartesianZ, count, true, true );
+         sourceBuffers.emplace_back( imf_, "cartesianZ", buffers.cartesianZ, count, true, true,
+                                        fieldStride( sizeof( *buffers.cartesianZ ) ) );
       }
 
       if ( proto.isDefined( "sphericalRange" ) && ( buffers.sphericalRange != nullptr ) )
       {
          sourceBuffers.emplace_back( imf_, "sphericalRange", buffers.sphericalRange, count, true,
-                                     true );
+                                        true, fieldStride( sizeof( *buffers.sphericalRange ) ) );
       }
 
       if ( proto.isDefined( "sphericalAzimuth" ) && ( buffers.sphericalAzimuth != nullptr ) )
       {
          sourceBuffers.emplace_back( imf_, "sphericalAzimuth", buffers.sphericalAzimuth, count,
-                                     true, true );
+                                        true, true,
+                                        fieldStride( sizeof( *buffers.sphericalAzimuth ) ) );
       }
 
       if ( proto.isDefined( "sphericalElevation" ) && ( buffers.sphericalElevation != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "sphericalElevation", buffers.sphericalElevation, count,
-                                     true, true );
+         sourceBuffers.emplace_back( imf_, "sphericalElevation", buffers.sphericalElevation,
+                                        count, true, true,
+                                        fieldStride( sizeof( *buffers.sphericalElevation ) ) );
       }
 
       if ( proto.isDefined( "intensity" ) && ( buffers.intensity != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "intensity", buffers.intensity, count, true, true );
+         sourceBuffers.emplace_back( imf_, "intensity", buffers.intensity, count, true, true,
+                                        fieldStride( sizeof( *buffers.intensity ) ) );
       }
 
       if ( proto.isDefined( "colorRed" ) && ( buffers.colorRed != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "colorRed", buffers.colorRed, count, true );
+         sourceBuffers.emplace_back( imf_, "colorRed", buffers.colorRed, count, true, false,
+                                        fieldStride( sizeof( *buffers.colorRed ) ) );
       }
 
       if ( proto.isDefined( "colorGreen" ) && ( buffers.colorGreen != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "colorGreen", buffers.colorGreen, count, true );
+         sourceBuffers.emplace_back( imf_, "colorGreen", buffers.colorGreen, count, true, false,
+                                        fieldStride( sizeof( *buffers.colorGreen ) ) );
       }
 
       if ( proto.isDefined( "colorBlue" ) && ( buffers.colorBlue != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "colorBlue", buffers.colorBlue, count, true );
+         sourceBuffers.emplace_back( imf_, "colorBlue", buffers.colorBlue, count, true, false,
+                                        fieldStride( sizeof( *buffers.colorBlue ) ) );
       }
 
       if ( proto.isDefined( "returnIndex" ) && ( buffers.returnIndex != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "returnIndex", buffers.returnIndex, count, true );
+         sourceBuffers.emplace_back( imf_, "returnIndex", buffers.returnIndex, count, true,
+                                        false, fieldStride( sizeof( *buffers.returnIndex ) ) );
       }
 
       if ( proto.isDefined( "returnCount" ) && ( buffers.returnCount != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "returnCount", buffers.returnCount, count, true );
+         sourceBuffers.emplace_back( imf_, "returnCount", buffers.returnCount, count, true,
+                                        false, fieldStride( sizeof( *buffers.returnCount ) ) );
       }
 
       if ( proto.isDefined( "rowIndex" ) && ( buffers.rowIndex != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "rowIndex", buffers.rowIndex, count, true );
+         sourceBuffers.emplace_back( imf_, "rowIndex", buffers.rowIndex, count, true, false,
+                                        fieldStride( sizeof( *buffers.rowIndex ) ) );
       }
 
       if ( proto.isDefined( "columnIndex" ) && ( buffers.columnIndex != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "columnIndex", buffers.columnIndex, count, true );
+         sourceBuffers.emplace_back( imf_, "columnIndex", buffers.columnIndex, count, true,
+                                        false, fieldStride( sizeof( *buffers.columnIndex ) ) );
       }
 
       if ( proto.isDefined( "timeStamp" ) && ( buffers.timeStamp != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "timeStamp", buffers.timeStamp, count, true, true );
+         sourceBuffers.emplace_back( imf_, "timeStamp", buffers.timeStamp, count, true, true,
+                                        fieldStride( sizeof( *buffers.timeStamp ) ) );
       }
 
       if ( proto.isDefined( "cartesianInvalidState" ) &&
            ( buffers.cartesianInvalidState != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "cartesianInvalidState", buffers.cartesianInvalidState,
-                                     count, true );
+         sourceBuffers.emplace_back( imf_, "cartesianInvalidState",
+                                        buffers.cartesianInvalidState, count, true, false,
+                                        fieldStride( sizeof( *buffers.cartesianInvalidState ) ) );
       }
 
       if ( proto.isDefined( "sphericalInvalidState" ) &&
            ( buffers.sphericalInvalidState != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "sphericalInvalidState", buffers.sphericalInvalidState,
-                                     count, true );
+         sourceBuffers.emplace_back( imf_, "sphericalInvalidState",
+                                        buffers.sphericalInvalidState, count, true, false,
+                                        fieldStride( sizeof( *buffers.sphericalInvalidState ) ) );
       }
 
       if ( proto.isDefined( "isIntensityInvalid" ) && ( buffers.isIntensityInvalid != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "isIntensityInvalid", buffers.isIntensityInvalid, count,
-                                     true );
+         sourceBuffers.emplace_back( imf_, "isIntensityInvalid", buffers.isIntensityInvalid,
+                                        count, true, false,
+                                        fieldStride( sizeof( *buffers.isIntensityInvalid ) ) );
       }
 
       if ( proto.isDefined( "isColorInvalid" ) && ( buffers.isColorInvalid != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "isColorInvalid", buffers.isColorInvalid, count, true );
+         sourceBuffers.emplace_back( imf_, "isColorInvalid", buffers.isColorInvalid, count, true,
+                                        false, fieldStride( sizeof( *buffers.isColorInvalid ) ) );
       }
 
       if ( proto.isDefined( "isTimeStampInvalid" ) && ( buffers.isTimeStampInvalid != nullptr ) )
       {
-         sourceBuffers.emplace_back( imf_, "isTimeStampInvalid", buffers.isTimeStampInvalid, count,
-                                     true );
+         sourceBuffers.emplace_back( imf_, "isTimeStampInvalid", buffers.isTimeStampInvalid,
+                                        count, true, false,
+                                        fieldStride( sizeof( *buffers.isTimeStampInvalid ) ) );
       }
 
       // E57_EXT_surface_normals
@@ -1280,17 +1348,20 @@ namespace e57
       {
          if ( proto.isDefined( "nor:normalX" ) && ( buffers.normalX != nullptr ) )
          {
-            sourceBuffers.emplace_back( imf_, "nor:normalX", buffers.normalX, count, true, true );
+            sourceBuffers.emplace_back( imf_, "nor:normalX", buffers.normalX, count, true, true,
+                                        fieldStride( sizeof( *buffers.normalX ) ) );
          }
 
          if ( proto.isDefined( "nor:normalY" ) && ( buffers.normalY != nullptr ) )
          {
-            sourceBuffers.emplace_back( imf_, "nor:normalY", buffers.normalY, count, true, true );
+            sourceBuffers.emplace_back( imf_, "nor:normalY", buffers.normalY, count, true, true,
+                                        fieldStride( sizeof( *buffers.normalY ) ) );
          }
 
          if ( proto.isDefined( "nor:normalZ" ) && ( buffers.normalZ != nullptr ) )
          {
-            sourceBuffers.emplace_back( imf_, "nor:normalZ", buffers.normalZ, count, true, true );
+            sourceBuffers.emplace_back( imf_, "nor:normalZ", buffers.normalZ, count, true, true,
+                                        fieldStride( sizeof( *buffers.normalZ ) ) );
          }
       }
 
@@ -1302,10 +1373,78 @@ namespace e57
 
    // Explicit template instantiation
    template CompressedVectorWriter WriterImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<float> &buffers );
+      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<float> &buffers,
+      size_t stride );
 
    template CompressedVectorWriter WriterImpl::SetUpData3DPointsData(
-      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<double> &buffers );
+      int64_t dataIndex, size_t pointCount, const Data3DPointsData_t<double> &buffers,
+      size_t stride );
+
+   template <typename COORDTYPE>
+   int64_t WriterImpl::BeginData3DData( Data3D &data3DHeader,
+                                        const Data3DPointsData_t<COORDTYPE> &chunkBuffers,
+                                        size_t chunkCapacity )
+   {
+      static_assert( std::is_floating_point<COORDTYPE>::value, "Floating point type required." );
+
+      if ( streamDataWriter_ )
+      {
+         throw E57_EXCEPTION2( ErrorInternal, "BeginData3DData called while a stream is open" );
+      }
+
+      if ( chunkCapacity == 0 )
+      {
+         return -1;
+      }
+
+      const int64_t scanIndex = NewData3D( data3DHeader );
+
+      streamDataWriter_.reset( new CompressedVectorWriter(
+         SetUpData3DPointsData( scanIndex, chunkCapacity, chunkBuffers ) ) );
+      streamDataIndex_ = scanIndex;
+      streamChunkCapacity_ = chunkCapacity;
+
+      return scanIndex;
+   }
+
+   // Explicit template instantiation
+   template int64_t WriterImpl::BeginData3DData( Data3D &data3DHeader,
+                                                 const Data3DPointsData_t<float> &chunkBuffers,
+                                                 size_t chunkCapacity );
+
+   template int64_t WriterImpl::BeginData3DData( Data3D &data3DHeader,
+                                                 const Data3DPointsData_t<double> &chunkBuffers,
+                                                 size_t chunkCapacity );
+
+   bool WriterImpl::AppendData3DPoints( size_t count )
+   {
+      if ( !streamDataWriter_ || ( count > streamChunkCapacity_ ) )
+      {
+         return false;
+      }
+
+      streamDataWriter_->write( count );
+
+      return true;
+   }
+
+   int64_t WriterImpl::EndData3DData()
+   {
+      if ( !streamDataWriter_ )
+      {
+         return -1;
+      }
+
+      streamDataWriter_->close();
+      streamDataWriter_.reset();
+
+      const int64_t scanIndex = streamDataIndex_;
+
+      streamDataIndex_ = -1;
+      streamChunkCapacity_ = 0;
+
+      return scanIndex;
+   }
 
    // This function writes out the group data
    bool WriterImpl::WriteData3DGroupsData( int64_t dataIndex, size_t groupCount,
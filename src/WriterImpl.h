@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "E57SimpleData.h"
 #include "E57SimpleWriter.h"
 
@@ -37,6 +39,7 @@ namespace e57
    {
    public:
       WriterImpl( const ustring &filePath, const WriterOptions &options );
+      WriterImpl( std::vector<char> &outBuffer, const WriterOptions &options );
       ~WriterImpl();
 
       // disallow copying a WriterImpl
@@ -59,7 +62,17 @@ namespace e57
 
       template <typename COORDTYPE>
       CompressedVectorWriter SetUpData3DPointsData( int64_t dataIndex, size_t pointCount,
-                                                    const Data3DPointsData_t<COORDTYPE> &buffers );
+                                                    const Data3DPointsData_t<COORDTYPE> &buffers,
+                                                    size_t stride = 0 );
+
+      template <typename COORDTYPE>
+      int64_t BeginData3DData( Data3D &data3DHeader,
+                               const Data3DPointsData_t<COORDTYPE> &chunkBuffers,
+                               size_t chunkCapacity );
+
+      bool AppendData3DPoints( size_t count );
+
+      int64_t EndData3DData();
 
       bool WriteData3DGroupsData( int64_t dataIndex, size_t groupCount, int64_t *idElementValue,
                                   int64_t *startPointIndex, int64_t *pointCount );
@@ -73,11 +86,18 @@ namespace e57
       ImageFile GetRawIMF();
 
    private:
+      void initNewFile( const WriterOptions &options );
+
       ImageFile imf_;
       StructureNode root_;
 
       VectorNode data3D_;
 
       VectorNode images2D_;
+
+      // State of an in-progress BeginData3DData()/AppendData3DPoints() stream
+      std::unique_ptr<CompressedVectorWriter> streamDataWriter_;
+      int64_t streamDataIndex_ = -1;
+      size_t streamChunkCapacity_ = 0;
    }; // end Writer class
 } // end namespace e57
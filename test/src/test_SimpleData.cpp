@@ -1,6 +1,14 @@
 // libE57Format testing Copyright © 2022 Andy Maloney <asmaloney@gmail.com>
 // SPDX-License-Identifier: BSL-1.0
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 #include "E57SimpleData.h"
@@ -276,3 +284,2441 @@ TEST( SimpleData, ReadWrite )
    delete originalReader;
    delete copyReader;
 }
+
+// Write from and read into an interleaved (AoS) point struct using the stride overloads.
+TEST( SimpleData, InterleavedReadWrite )
+{
+   struct PointXYZI
+   {
+      float x = 0.0f;
+      float y = 0.0f;
+      float z = 0.0f;
+      double intensity = 0.0;
+   };
+
+   constexpr int64_t cNumPoints = 1025;
+
+   std::vector<PointXYZI> points( cNumPoints );
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      auto floati = static_cast<float>( i );
+
+      points[i].x = floati;
+      points[i].y = floati * 2.0f;
+      points[i].z = floati * 3.0f;
+      points[i].intensity = static_cast<double>( i ) / cNumPoints;
+   }
+
+   // 1. Write the points straight from the interleaved buffer
+   {
+      e57::WriterOptions options;
+      options.guid = "Interleaved Points File GUID";
+
+      e57::Writer *writer = nullptr;
+      E57_ASSERT_NO_THROW( writer = new e57::Writer( "./InterleavedPoints.e57", options ) );
+
+      e57::Data3D header;
+      header.guid = "Interleaved Points Header GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+      header.pointFields.intensityField = true;
+
+      e57::Data3DPointsFloat pointsData;
+      pointsData.cartesianX = &points[0].x;
+      pointsData.cartesianY = &points[0].y;
+      pointsData.cartesianZ = &points[0].z;
+      pointsData.intensity = &points[0].intensity;
+
+      writer->WriteData3DData( header, pointsData, sizeof( PointXYZI ) );
+
+      delete writer;
+   }
+
+   // 2. Read them back into another interleaved buffer
+   {
+      e57::Reader *reader = nullptr;
+      E57_ASSERT_NO_THROW( reader = new e57::Reader( "./InterleavedPoints.e57", {} ) );
+
+      e57::Data3D header;
+      ASSERT_TRUE( reader->ReadData3D( 0, header ) );
+      ASSERT_EQ( header.pointCount, static_cast<uint64_t>( cNumPoints ) );
+
+      std::vector<PointXYZI> readPoints( cNumPoints );
+
+      e57::Data3DPointsFloat pointsData;
+      pointsData.cartesianX = &readPoints[0].x;
+      pointsData.cartesianY = &readPoints[0].y;
+      pointsData.cartesianZ = &readPoints[0].z;
+      pointsData.intensity = &readPoints[0].intensity;
+
+      auto vectorReader =
+         reader->SetUpData3DPointsData( 0, cNumPoints, pointsData, sizeof( PointXYZI ) );
+
+      const uint64_t cNumRead = vectorReader.read();
+
+      vectorReader.close();
+
+      EXPECT_EQ( cNumRead, static_cast<uint64_t>( cNumPoints ) );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         EXPECT_FLOAT_EQ( readPoints[i].x, points[i].x );
+         EXPECT_FLOAT_EQ( readPoints[i].y, points[i].y );
+         EXPECT_FLOAT_EQ( readPoints[i].z, points[i].z );
+         EXPECT_NEAR( readPoints[i].intensity, points[i].intensity, 1E-6 );
+      }
+
+      delete reader;
+   }
+}
+
+// Stream a scan in chunks through BeginData3DData/AppendData3DPoints/EndData3DData.
+TEST( SimpleData, StreamedWrite )
+{
+   constexpr int64_t cNumPoints = 1000;
+   constexpr size_t cChunkSize = 128;
+
+   int64_t scanIndex = -1;
+
+   // 1. Write the points a chunk at a time through one reused buffer set
+   {
+      e57::WriterOptions options;
+      options.guid = "Streamed Write File GUID";
+
+      e57::Writer *writer = nullptr;
+      E57_ASSERT_NO_THROW( writer = new e57::Writer( "./StreamedWrite.e57", options ) );
+
+      e57::Data3D header;
+      header.guid = "Streamed Write Header GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      std::vector<float> chunkX( cChunkSize );
+      std::vector<float> chunkY( cChunkSize );
+      std::vector<float> chunkZ( cChunkSize );
+
+      e57::Data3DPointsFloat chunkBuffers;
+      chunkBuffers.cartesianX = chunkX.data();
+      chunkBuffers.cartesianY = chunkY.data();
+      chunkBuffers.cartesianZ = chunkZ.data();
+
+      scanIndex = writer->BeginData3DData( header, chunkBuffers, cChunkSize );
+      ASSERT_GE( scanIndex, 0 );
+
+      int64_t pointsWritten = 0;
+
+      while ( pointsWritten < cNumPoints )
+      {
+         const size_t count =
+            std::min( cChunkSize, static_cast<size_t>( cNumPoints - pointsWritten ) );
+
+         for ( size_t i = 0; i < count; ++i )
+         {
+            auto floati = static_cast<float>( pointsWritten + static_cast<int64_t>( i ) );
+
+            chunkX[i] = floati;
+            chunkY[i] = floati * 2.0f;
+            chunkZ[i] = floati * 3.0f;
+         }
+
+         ASSERT_TRUE( writer->AppendData3DPoints( count ) );
+
+         pointsWritten += count;
+      }
+
+      EXPECT_EQ( writer->EndData3DData(), scanIndex );
+
+      // No stream is open any more
+      EXPECT_FALSE( writer->AppendData3DPoints( 1 ) );
+      EXPECT_EQ( writer->EndData3DData(), -1 );
+
+      delete writer;
+   }
+
+   // 2. Read the whole scan back and check it
+   {
+      e57::Reader *reader = nullptr;
+      E57_ASSERT_NO_THROW( reader = new e57::Reader( "./StreamedWrite.e57", {} ) );
+
+      e57::Data3D header;
+      ASSERT_TRUE( reader->ReadData3D( scanIndex, header ) );
+      ASSERT_EQ( header.pointCount, static_cast<uint64_t>( cNumPoints ) );
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      auto vectorReader = reader->SetUpData3DPointsData( scanIndex, cNumPoints, pointsData );
+
+      const uint64_t cNumRead = vectorReader.read();
+
+      vectorReader.close();
+
+      EXPECT_EQ( cNumRead, static_cast<uint64_t>( cNumPoints ) );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         auto floati = static_cast<float>( i );
+
+         EXPECT_FLOAT_EQ( pointsData.cartesianX[i], floati );
+         EXPECT_FLOAT_EQ( pointsData.cartesianY[i], floati * 2.0f );
+         EXPECT_FLOAT_EQ( pointsData.cartesianZ[i], floati * 3.0f );
+      }
+
+      delete reader;
+   }
+}
+
+// Reopen an existing file in append mode and add a second scan; the first scan's
+// binary section is untouched and only the XML section is rewritten.
+TEST( SimpleData, AppendToExistingFile )
+{
+   constexpr int64_t cNumPoints = 512;
+
+   auto writeScan = [=]( e57::Writer &writer, const e57::ustring &guid, float offset ) {
+      e57::Data3D header;
+      header.guid = guid;
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         auto floati = static_cast<float>( i ) + offset;
+
+         pointsData.cartesianX[i] = floati;
+         pointsData.cartesianY[i] = floati;
+         pointsData.cartesianZ[i] = floati;
+      }
+
+      return writer.WriteData3DData( header, pointsData );
+   };
+
+   // 1. Create a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Append Test File GUID";
+
+      e57::Writer writer( "./AppendTest.e57", options );
+
+      EXPECT_EQ( writeScan( writer, "Append Test Scan 1 GUID", 0.0f ), 0 );
+   }
+
+   // 2. Reopen it in append mode and add a second scan
+   {
+      e57::WriterOptions options;
+      options.append = true;
+
+      e57::Writer *writer = nullptr;
+      E57_ASSERT_NO_THROW( writer = new e57::Writer( "./AppendTest.e57", options ) );
+
+      EXPECT_EQ( writeScan( *writer, "Append Test Scan 2 GUID", 1000.0f ), 1 );
+
+      delete writer;
+   }
+
+   // 3. Read both scans back and check them
+   {
+      e57::Reader *reader = nullptr;
+      E57_ASSERT_NO_THROW( reader = new e57::Reader( "./AppendTest.e57", {} ) );
+
+      e57::E57Root fileHeader;
+      ASSERT_TRUE( reader->GetE57Root( fileHeader ) );
+      EXPECT_EQ( fileHeader.guid, "Append Test File GUID" );
+
+      ASSERT_EQ( reader->GetData3DCount(), 2 );
+
+      const float cOffsets[] = { 0.0f, 1000.0f };
+
+      for ( int64_t scanIndex = 0; scanIndex < 2; ++scanIndex )
+      {
+         e57::Data3D header;
+         ASSERT_TRUE( reader->ReadData3D( scanIndex, header ) );
+         ASSERT_EQ( header.pointCount, static_cast<uint64_t>( cNumPoints ) );
+
+         e57::Data3DPointsFloat pointsData( header );
+
+         auto vectorReader =
+            reader->SetUpData3DPointsData( scanIndex, cNumPoints, pointsData );
+
+         const uint64_t cNumRead = vectorReader.read();
+
+         vectorReader.close();
+
+         EXPECT_EQ( cNumRead, static_cast<uint64_t>( cNumPoints ) );
+
+         for ( int64_t i = 0; i < cNumPoints; i += 64 )
+         {
+            EXPECT_FLOAT_EQ( pointsData.cartesianX[i],
+                             static_cast<float>( i ) + cOffsets[scanIndex] );
+         }
+      }
+
+      delete reader;
+   }
+}
+
+TEST( SimpleData, PacketLevelScanCopy )
+{
+   constexpr int64_t cNumPoints = 1234;
+
+   // 1. Create a source file with one scan
+   {
+      e57::Data3D header;
+      header.guid = "Packet Copy Source Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsDouble pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<double>( i ) * 0.1;
+         pointsData.cartesianY[i] = static_cast<double>( i ) * 0.2;
+         pointsData.cartesianZ[i] = static_cast<double>( i ) * 0.3;
+      }
+
+      e57::WriterOptions options;
+      options.guid = "Packet Copy Source File GUID";
+
+      e57::Writer writer( "./PacketCopySource.e57", options );
+
+      EXPECT_EQ( writer.WriteData3DData( header, pointsData ), 0 );
+   }
+
+   // 2. Transplant the points CompressedVectorNode into a new file without decoding
+   {
+      e57::ImageFile sourceFile( "./PacketCopySource.e57", "r" );
+      e57::ImageFile destFile( "./PacketCopyDest.e57", "w" );
+
+      const e57::VectorNode data3D( sourceFile.root().get( "data3D" ) );
+      const e57::StructureNode scan( data3D.get( 0 ) );
+      const e57::CompressedVectorNode points( scan.get( "points" ) );
+
+      e57::CompressedVectorNode pointsCopy = points.copyTo( destFile );
+
+      EXPECT_EQ( pointsCopy.childCount(), cNumPoints );
+
+      e57::VectorNode destData3D( destFile, true );
+      destFile.root().set( "data3D", destData3D );
+
+      e57::StructureNode destScan( destFile );
+      destScan.set( "points", pointsCopy );
+      destData3D.append( destScan );
+
+      destFile.close();
+      sourceFile.close();
+   }
+
+   // 3. Read the copied scan back through the Foundation API and check the points
+   {
+      e57::ImageFile destFile( "./PacketCopyDest.e57", "r" );
+
+      const e57::VectorNode data3D( destFile.root().get( "data3D" ) );
+      const e57::StructureNode scan( data3D.get( 0 ) );
+      e57::CompressedVectorNode points( scan.get( "points" ) );
+
+      ASSERT_EQ( points.childCount(), cNumPoints );
+
+      std::vector<double> xData( cNumPoints );
+      std::vector<double> yData( cNumPoints );
+      std::vector<double> zData( cNumPoints );
+
+      std::vector<e57::SourceDestBuffer> dbufs;
+      dbufs.emplace_back( destFile, "cartesianX", xData.data(), cNumPoints, true, true );
+      dbufs.emplace_back( destFile, "cartesianY", yData.data(), cNumPoints, true, true );
+      dbufs.emplace_back( destFile, "cartesianZ", zData.data(), cNumPoints, true, true );
+
+      e57::CompressedVectorReader vectorReader = points.reader( dbufs );
+
+      EXPECT_EQ( vectorReader.read(), static_cast<unsigned>( cNumPoints ) );
+
+      vectorReader.close();
+      destFile.close();
+
+      for ( int64_t i = 0; i < cNumPoints; i += 100 )
+      {
+         EXPECT_DOUBLE_EQ( xData[i], static_cast<double>( i ) * 0.1 );
+         EXPECT_DOUBLE_EQ( yData[i], static_cast<double>( i ) * 0.2 );
+         EXPECT_DOUBLE_EQ( zData[i], static_cast<double>( i ) * 0.3 );
+      }
+   }
+}
+
+TEST( SimpleData, ReadAllImages2D )
+{
+   constexpr int64_t cNumImages = 4;
+   constexpr size_t cImageSize = 4096;
+
+   // 1. Create a file with several image blobs with distinct contents
+   {
+      e57::WriterOptions options;
+      options.guid = "Read All Images File GUID";
+
+      e57::Writer writer( "./ReadAllImages.e57", options );
+
+      for ( int64_t imageIndex = 0; imageIndex < cNumImages; ++imageIndex )
+      {
+         std::vector<char> imageBuffer( cImageSize );
+
+         for ( size_t i = 0; i < cImageSize; ++i )
+         {
+            imageBuffer[i] = static_cast<char>( ( i + imageIndex ) & 0xFF );
+         }
+
+         e57::Image2D header;
+         header.name = "Image " + std::to_string( imageIndex );
+         header.guid = "Read All Images GUID " + std::to_string( imageIndex );
+         header.visualReferenceRepresentation.imageWidth = 32;
+         header.visualReferenceRepresentation.imageHeight = 32;
+         header.visualReferenceRepresentation.jpegImageSize = cImageSize;
+
+         writer.WriteImage2DData( header, e57::ImageJPEG, e57::ProjectionVisual, 0,
+                                  imageBuffer.data(), cImageSize );
+      }
+   }
+
+   // 2. Read them all back in parallel and check each one against its pattern
+   e57::Reader reader( "./ReadAllImages.e57", {} );
+
+   ASSERT_EQ( reader.GetImage2DCount(), cNumImages );
+
+   std::mutex resultsMutex;
+   int64_t imagesRead = 0;
+   bool contentsOK = true;
+
+   const bool allOK = reader.ReadAllImages2D(
+      2, [&]( int64_t imageIndex, const e57::Image2D &imageHeader,
+              e57::Image2DProjection imageProjection, e57::Image2DType imageType,
+              const std::vector<uint8_t> &imageData ) {
+         bool imageOK = ( imageProjection == e57::ProjectionVisual ) &&
+                        ( imageType == e57::ImageJPEG ) && ( imageData.size() == cImageSize ) &&
+                        ( imageHeader.name == "Image " + std::to_string( imageIndex ) );
+
+         for ( size_t i = 0; imageOK && ( i < imageData.size() ); i += 256 )
+         {
+            imageOK = ( imageData[i] == static_cast<uint8_t>( ( i + imageIndex ) & 0xFF ) );
+         }
+
+         std::lock_guard<std::mutex> lock( resultsMutex );
+
+         ++imagesRead;
+         contentsOK = contentsOK && imageOK;
+
+         return true;
+      } );
+
+   EXPECT_TRUE( allOK );
+   EXPECT_TRUE( contentsOK );
+   EXPECT_EQ( imagesRead, cNumImages );
+}
+
+TEST( SimpleData, BlobPhysicalExtent )
+{
+   constexpr size_t cBlobSize = 3000;
+
+   // 1. Create a file with one image blob holding a known pattern
+   {
+      std::vector<char> imageBuffer( cBlobSize );
+
+      for ( size_t i = 0; i < cBlobSize; ++i )
+      {
+         imageBuffer[i] = static_cast<char>( ( i * 7 ) & 0xFF );
+      }
+
+      e57::WriterOptions options;
+      options.guid = "Blob Extent File GUID";
+
+      e57::Writer writer( "./BlobExtent.e57", options );
+
+      e57::Image2D header;
+      header.name = "Blob Extent Image";
+      header.guid = "Blob Extent Image GUID";
+      header.visualReferenceRepresentation.imageWidth = 32;
+      header.visualReferenceRepresentation.imageHeight = 32;
+      header.visualReferenceRepresentation.jpegImageSize = cBlobSize;
+
+      writer.WriteImage2DData( header, e57::ImageJPEG, e57::ProjectionVisual, 0,
+                               imageBuffer.data(), cBlobSize );
+   }
+
+   // 2. Locate the blob through the Foundation API and read it back whole
+   e57::ImageFile file( "./BlobExtent.e57", "r" );
+
+   const e57::VectorNode images2D( file.root().get( "images2D" ) );
+   const e57::StructureNode image( images2D.get( 0 ) );
+   const e57::StructureNode representation( image.get( "visualReferenceRepresentation" ) );
+   e57::BlobNode blob( representation.get( "jpegImage" ) );
+
+   ASSERT_EQ( blob.byteCount(), static_cast<int64_t>( cBlobSize ) );
+
+   const std::vector<uint8_t> blobData = blob.readAll();
+
+   ASSERT_EQ( blobData.size(), cBlobSize );
+
+   for ( size_t i = 0; i < cBlobSize; i += 100 )
+   {
+      EXPECT_EQ( blobData[i], static_cast<uint8_t>( ( i * 7 ) & 0xFF ) );
+   }
+
+   // 3. Check that the physical extent plus the documented CRC page structure reproduces the
+   // blob without going through BlobNode::read()
+   const uint64_t physicalOffset = blob.physicalOffset();
+   const uint64_t physicalLength = blob.physicalLength();
+
+   file.close();
+
+   EXPECT_GE( physicalLength, cBlobSize );
+
+   std::ifstream rawFile( "./BlobExtent.e57", std::ifstream::binary );
+
+   ASSERT_EQ( rawFile.rdstate(), std::ios_base::goodbit );
+
+   rawFile.seekg( static_cast<std::streamoff>( physicalOffset ) );
+
+   std::vector<char> region( physicalLength );
+
+   rawFile.read( region.data(), static_cast<std::streamsize>( physicalLength ) );
+
+   ASSERT_EQ( rawFile.rdstate(), std::ios_base::goodbit );
+
+   // Every 1024-byte physical page ends with a 4-byte CRC that is not blob data
+   std::vector<uint8_t> destriped;
+
+   destriped.reserve( cBlobSize );
+
+   uint64_t physicalPosition = physicalOffset;
+   size_t regionIndex = 0;
+
+   while ( destriped.size() < cBlobSize )
+   {
+      ASSERT_LT( regionIndex, region.size() );
+
+      if ( ( physicalPosition & 1023 ) >= 1020 )
+      {
+         ++physicalPosition;
+         ++regionIndex;
+         continue;
+      }
+
+      destriped.push_back( static_cast<uint8_t>( region[regionIndex] ) );
+      ++physicalPosition;
+      ++regionIndex;
+   }
+
+   EXPECT_EQ( destriped, blobData );
+}
+
+TEST( SimpleData, ConcurrentImageWrites )
+{
+   constexpr int64_t cNumImages = 4;
+   constexpr int64_t cImageSize = 8192;
+
+   // 1. Create the image headers up front (which preallocates the blob extents), then write
+   // every image's data from its own thread
+   {
+      e57::WriterOptions options;
+      options.guid = "Concurrent Image Writes File GUID";
+
+      e57::Writer writer( "./ConcurrentImageWrites.e57", options );
+
+      std::vector<int64_t> imageIndices;
+
+      for ( int64_t imageNumber = 0; imageNumber < cNumImages; ++imageNumber )
+      {
+         e57::Image2D header;
+         header.name = "Image " + std::to_string( imageNumber );
+         header.guid = "Concurrent Image Writes GUID " + std::to_string( imageNumber );
+         header.visualReferenceRepresentation.imageWidth = 64;
+         header.visualReferenceRepresentation.imageHeight = 32;
+         header.visualReferenceRepresentation.jpegImageSize = cImageSize;
+
+         imageIndices.push_back( writer.NewImage2D( header ) );
+      }
+
+      std::vector<std::thread> writers;
+
+      for ( int64_t imageNumber = 0; imageNumber < cNumImages; ++imageNumber )
+      {
+         writers.emplace_back( [&writer, &imageIndices, imageNumber]() {
+            std::vector<char> imageBuffer( cImageSize );
+
+            for ( int64_t i = 0; i < cImageSize; ++i )
+            {
+               imageBuffer[i] = static_cast<char>( ( i + imageNumber ) & 0xFF );
+            }
+
+            writer.WriteImage2DData( imageIndices[imageNumber], e57::ImageJPEG,
+                                     e57::ProjectionVisual, imageBuffer.data(), 0, cImageSize );
+         } );
+      }
+
+      for ( auto &thread : writers )
+      {
+         thread.join();
+      }
+   }
+
+   // 2. Read every image back and check it against its thread's pattern
+   e57::Reader reader( "./ConcurrentImageWrites.e57", {} );
+
+   ASSERT_EQ( reader.GetImage2DCount(), cNumImages );
+
+   for ( int64_t imageNumber = 0; imageNumber < cNumImages; ++imageNumber )
+   {
+      e57::Image2D header;
+
+      ASSERT_TRUE( reader.ReadImage2D( imageNumber, header ) );
+
+      std::vector<uint8_t> imageBuffer( cImageSize );
+
+      const int64_t bytesRead =
+         reader.ReadImage2DData( imageNumber, e57::ProjectionVisual, e57::ImageJPEG,
+                                 imageBuffer.data(), 0, cImageSize );
+
+      ASSERT_EQ( bytesRead, cImageSize );
+
+      for ( int64_t i = 0; i < cImageSize; i += 128 )
+      {
+         ASSERT_EQ( imageBuffer[i], static_cast<uint8_t>( ( i + imageNumber ) & 0xFF ) );
+      }
+   }
+}
+
+// The sidecar metadata cache must be transparent: the second open loads the tree from the
+// sidecar instead of parsing XML, and both opens must see identical metadata.
+TEST( SimpleData, SidecarMetadataCache )
+{
+   constexpr uint16_t cNumPoints = 32;
+
+   {
+      e57::WriterOptions options;
+      options.guid = "Sidecar Cache File GUID";
+
+      e57::Writer writer( "./SidecarCache.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Sidecar Cache Header GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( uint16_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   std::remove( "./SidecarCache.e57.e57cache" );
+
+   // First open parses the XML and writes the sidecar
+   {
+      e57::ImageFile imf( "./SidecarCache.e57", "rc" );
+
+      EXPECT_EQ( e57::StringNode( imf.root().get( "guid" ) ).value(), "Sidecar Cache File GUID" );
+
+      imf.close();
+   }
+
+   std::ifstream sidecar( "./SidecarCache.e57.e57cache", std::ifstream::binary );
+   ASSERT_TRUE( sidecar.good() );
+   sidecar.close();
+
+   // Second open loads the sidecar; the tree must be identical, including binary reads
+   e57::ReaderOptions readerOptions;
+   readerOptions.sidecarMetadataCache = true;
+
+   e57::Reader reader( "./SidecarCache.e57", readerOptions );
+
+   ASSERT_EQ( reader.GetData3DCount(), 1 );
+
+   e57::Data3D data3DHeader;
+   ASSERT_TRUE( reader.ReadData3D( 0, data3DHeader ) );
+
+   EXPECT_EQ( data3DHeader.guid, "Sidecar Cache Header GUID" );
+   EXPECT_EQ( data3DHeader.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( data3DHeader );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   EXPECT_FLOAT_EQ( pointsData.cartesianX[cNumPoints - 1],
+                    static_cast<float>( cNumPoints - 1 ) );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+// Re-reading the same pages must not re-verify their CRCs: a read-only file tracks
+// verified pages, so the second pass over identical packets adds no verifications.
+TEST( SimpleData, VerifiedPageBitmap )
+{
+   constexpr uint16_t cNumPoints = 2048;
+
+   {
+      e57::WriterOptions options;
+      options.guid = "Verified Page Bitmap File GUID";
+
+      e57::Writer writer( "./VerifiedPageBitmap.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Verified Page Bitmap Header GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( uint16_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   e57::Reader reader( "./VerifiedPageBitmap.e57", e57::ReaderOptions() );
+
+   e57::Data3D data3DHeader;
+   ASSERT_TRUE( reader.ReadData3D( 0, data3DHeader ) );
+
+   e57::Data3DPointsFloat pointsData( data3DHeader );
+
+   auto readPass = [&]() {
+      auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+      EXPECT_EQ( vectorReader.read(), cNumPoints );
+      vectorReader.close();
+   };
+
+   readPass();
+   const uint64_t verificationsAfterFirstPass = reader.GetStats().crcVerifications;
+
+   readPass();
+   const uint64_t verificationsAfterSecondPass = reader.GetStats().crcVerifications;
+
+   EXPECT_GT( verificationsAfterFirstPass, 0u );
+   EXPECT_EQ( verificationsAfterSecondPass, verificationsAfterFirstPass );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, PartitionPoints )
+{
+   constexpr int64_t cNumPoints = 1024;
+
+   // Write a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Partition Points File GUID";
+
+      e57::Writer writer( "./PartitionPoints.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Partition Points Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   e57::ImageFile imf( "./PartitionPoints.e57", "r" );
+
+   const e57::VectorNode data3D( imf.root().get( "data3D" ) );
+   const e57::StructureNode scan( data3D.get( 0 ) );
+   const e57::CompressedVectorNode points( scan.get( "points" ) );
+
+   const std::vector<e57::RecordSplitPoint> splitPoints = points.partitionPoints();
+
+   // Files written by this library carry a one-entry index, so the plan has (at least) one
+   // point, and the first point always starts the section at record 0.
+   ASSERT_GE( splitPoints.size(), 1u );
+   EXPECT_EQ( splitPoints[0].recordNumber, 0u );
+   EXPECT_GT( splitPoints[0].chunkPhysicalOffset, 0u );
+
+   for ( size_t i = 1; i < splitPoints.size(); ++i )
+   {
+      EXPECT_GT( splitPoints[i].recordNumber, splitPoints[i - 1].recordNumber );
+      EXPECT_GT( splitPoints[i].chunkPhysicalOffset, splitPoints[i - 1].chunkPhysicalOffset );
+   }
+
+   imf.close();
+}
+
+TEST( SimpleData, ReadAllData3DHeaders )
+{
+   constexpr int64_t cNumScans = 4;
+   constexpr int64_t cNumPoints = 8;
+
+   // 1. Create a file with several small scans with distinct headers
+   {
+      e57::WriterOptions options;
+      options.guid = "Read All Headers File GUID";
+
+      e57::Writer writer( "./ReadAllHeaders.e57", options );
+
+      e57::Data3D header;
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      for ( int64_t scan = 0; scan < cNumScans; ++scan )
+      {
+         header.guid = "Read All Headers Scan " + std::to_string( scan ) + " GUID";
+         header.name = "Scan " + std::to_string( scan );
+
+         writer.WriteData3DData( header, pointsData );
+      }
+   }
+
+   e57::Reader reader( "./ReadAllHeaders.e57", {} );
+
+   std::vector<e57::Data3D> headers;
+
+   ASSERT_TRUE( reader.ReadAllData3DHeaders( 2, headers ) );
+   ASSERT_EQ( headers.size(), static_cast<size_t>( cNumScans ) );
+
+   // 2. The bulk result must match per-index ReadData3D(), in file order
+   for ( int64_t scan = 0; scan < cNumScans; ++scan )
+   {
+      e57::Data3D expected;
+
+      ASSERT_TRUE( reader.ReadData3D( scan, expected ) );
+
+      const e57::Data3D &actual = headers[static_cast<size_t>( scan )];
+
+      EXPECT_EQ( actual.guid, expected.guid );
+      EXPECT_EQ( actual.name, expected.name );
+      EXPECT_EQ( actual.pointCount, expected.pointCount );
+      EXPECT_EQ( actual.pointFields.cartesianXField, expected.pointFields.cartesianXField );
+   }
+}
+
+TEST( SimpleData, OpenProject )
+{
+   constexpr int64_t cNumFiles = 3;
+   constexpr int64_t cNumPoints = 8;
+
+   // 1. Create a small "project" of files
+   std::vector<e57::ustring> paths;
+
+   for ( int64_t fileIndex = 0; fileIndex < cNumFiles; ++fileIndex )
+   {
+      const e57::ustring path = "./Project" + std::to_string( fileIndex ) + ".e57";
+
+      e57::WriterOptions options;
+      options.guid = "Project File " + std::to_string( fileIndex ) + " GUID";
+
+      e57::Writer writer( path, options );
+
+      e57::Data3D header;
+      header.guid = "Project File " + std::to_string( fileIndex ) + " Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( fileIndex );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      writer.WriteData3DData( header, pointsData );
+
+      paths.push_back( path );
+   }
+
+   // A missing file must not disturb the rest of the project
+   paths.push_back( "./ProjectDoesNotExist.e57" );
+
+   // 2. Open them all at once under a shared packet cache budget
+   e57::SetPacketCacheBudget( 8 * 1024 * 1024 );
+
+   const std::vector<e57::ProjectFile> project = e57::OpenProject( paths, {}, 2 );
+
+   ASSERT_EQ( project.size(), paths.size() );
+
+   for ( int64_t fileIndex = 0; fileIndex < cNumFiles; ++fileIndex )
+   {
+      const e57::ProjectFile &file = project[static_cast<size_t>( fileIndex )];
+
+      ASSERT_NE( file.reader, nullptr );
+      EXPECT_EQ( file.path, paths[static_cast<size_t>( fileIndex )] );
+      EXPECT_EQ( file.reader->GetData3DCount(), 1 );
+
+      // Each reader must see its own file's points
+      e57::Data3D header;
+
+      ASSERT_TRUE( file.reader->ReadData3D( 0, header ) );
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      e57::CompressedVectorReader vectorReader = file.reader->SetUpData3DPointsData(
+         0, static_cast<size_t>( header.pointCount ), pointsData );
+
+      const unsigned readCount = vectorReader.read();
+
+      vectorReader.close();
+
+      ASSERT_EQ( readCount, static_cast<unsigned>( cNumPoints ) );
+      EXPECT_FLOAT_EQ( pointsData.cartesianX[0], static_cast<float>( fileIndex ) );
+   }
+
+   // 3. The missing file reports its failure without a reader
+   const e57::ProjectFile &missing = project.back();
+
+   EXPECT_EQ( missing.reader, nullptr );
+   EXPECT_FALSE( missing.error.empty() );
+
+   e57::SetPacketCacheBudget( 0 );
+}
+
+TEST( SimpleData, ReusablePointBuffers )
+{
+   constexpr int64_t cNumScans = 3;
+   constexpr int64_t cNumPoints = 32;
+
+   // 1. Create a file with a few scans of different sizes
+   {
+      e57::WriterOptions options;
+      options.guid = "Reusable Point Buffers File GUID";
+
+      e57::Writer writer( "./ReusableBuffers.e57", options );
+
+      for ( int64_t scan = 0; scan < cNumScans; ++scan )
+      {
+         e57::Data3D header;
+         header.guid = "Reusable Point Buffers Scan " + std::to_string( scan ) + " GUID";
+         header.pointCount = cNumPoints - ( scan * 8 );
+         header.pointFields.cartesianXField = true;
+         header.pointFields.cartesianYField = true;
+         header.pointFields.cartesianZField = true;
+
+         e57::Data3DPointsFloat pointsData( header );
+
+         for ( int64_t i = 0; i < header.pointCount; ++i )
+         {
+            pointsData.cartesianX[i] = static_cast<float>( scan * 1000 + i );
+            pointsData.cartesianY[i] = static_cast<float>( i );
+            pointsData.cartesianZ[i] = static_cast<float>( i );
+         }
+
+         writer.WriteData3DData( header, pointsData );
+      }
+   }
+
+   e57::Reader reader( "./ReusableBuffers.e57", {} );
+
+   ASSERT_EQ( reader.GetData3DCount(), cNumScans );
+
+   // 2. One buffer set serves every scan: the first (largest) scan allocates, the
+   //    smaller ones rebind into the same slab
+   e57::Data3DPointsFloat pointsData;
+
+   const float *firstScanBuffer = nullptr;
+
+   for ( int64_t scan = 0; scan < cNumScans; ++scan )
+   {
+      e57::Data3D header;
+
+      ASSERT_TRUE( reader.ReadData3D( scan, header ) );
+
+      pointsData.resize( header, static_cast<size_t>( header.pointCount ) );
+
+      if ( scan == 0 )
+      {
+         firstScanBuffer = pointsData.cartesianX;
+      }
+      else
+      {
+         // Monotonic capacity: smaller scans must reuse the first allocation
+         EXPECT_EQ( pointsData.cartesianX, firstScanBuffer );
+      }
+
+      e57::CompressedVectorReader vectorReader = reader.SetUpData3DPointsData(
+         scan, static_cast<size_t>( header.pointCount ), pointsData );
+
+      ASSERT_EQ( vectorReader.read(), static_cast<unsigned>( header.pointCount ) );
+      vectorReader.close();
+
+      EXPECT_FLOAT_EQ( pointsData.cartesianX[0], static_cast<float>( scan * 1000 ) );
+   }
+
+   // 3. Moving transfers ownership and empties the source
+   e57::Data3DPointsFloat movedTo( std::move( pointsData ) );
+
+   EXPECT_EQ( movedTo.cartesianX, firstScanBuffer );
+   EXPECT_EQ( pointsData.cartesianX, nullptr );
+}
+
+TEST( SimpleData, AsyncOpen )
+{
+   constexpr int64_t cNumScans = 3;
+   constexpr int64_t cNumPoints = 8;
+
+   // 1. Create a file with several small scans
+   {
+      e57::WriterOptions options;
+      options.guid = "Async Open File GUID";
+
+      e57::Writer writer( "./AsyncOpen.e57", options );
+
+      e57::Data3D header;
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      for ( int64_t scan = 0; scan < cNumScans; ++scan )
+      {
+         header.guid = "Async Open Scan " + std::to_string( scan ) + " GUID";
+
+         writer.WriteData3DData( header, pointsData );
+      }
+   }
+
+   // 2. Open asynchronously, collecting the per-scan discovery callbacks
+   std::vector<int64_t> discovered;
+
+   e57::ImageFile imf = e57::ImageFile::openAsync(
+      "./AsyncOpen.e57", e57::ChecksumAll,
+      [&discovered]( int64_t scanIndex ) { discovered.push_back( scanIndex ); } );
+
+   ASSERT_TRUE( imf.isOpen() );
+
+   imf.xmlParseComplete().wait();
+
+   // 3. Every scan must have been reported, in file order
+   ASSERT_EQ( discovered.size(), static_cast<size_t>( cNumScans ) );
+
+   for ( int64_t scan = 0; scan < cNumScans; ++scan )
+   {
+      EXPECT_EQ( discovered[static_cast<size_t>( scan )], scan );
+   }
+
+   // 4. The tree must be complete and usable, exactly like a synchronous open
+   const e57::StructureNode root = imf.root();
+
+   ASSERT_TRUE( root.isDefined( "/data3D" ) );
+
+   const e57::VectorNode data3D( root.get( "/data3D" ) );
+
+   EXPECT_EQ( data3D.childCount(), cNumScans );
+
+   imf.close();
+}
+
+TEST( SimpleData, InjectedTaskRunner )
+{
+   constexpr int64_t cNumScans = 3;
+   constexpr int64_t cNumPoints = 8;
+
+   // 1. Create a file with several small scans
+   {
+      e57::WriterOptions options;
+      options.guid = "Injected Task Runner File GUID";
+
+      e57::Writer writer( "./InjectedTaskRunner.e57", options );
+
+      e57::Data3D header;
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      for ( int64_t scan = 0; scan < cNumScans; ++scan )
+      {
+         header.guid = "Injected Task Runner Scan " + std::to_string( scan ) + " GUID";
+
+         writer.WriteData3DData( header, pointsData );
+      }
+   }
+
+   // 2. Route the library's parallel work through our own (sequential) runner
+   unsigned tasksRun = 0;
+
+   e57::SetTaskRunner(
+      [&tasksRun]( unsigned taskCount, const std::function<void( unsigned )> &task ) {
+         for ( unsigned taskIndex = 0; taskIndex < taskCount; ++taskIndex )
+         {
+            task( taskIndex );
+            ++tasksRun;
+         }
+      } );
+
+   e57::Reader reader( "./InjectedTaskRunner.e57", {} );
+
+   std::vector<e57::Data3D> headers;
+
+   ASSERT_TRUE( reader.ReadAllData3DHeaders( 2, headers ) );
+   ASSERT_EQ( headers.size(), static_cast<size_t>( cNumScans ) );
+
+   // 3. The injected runner must have been handed the whole batch
+   EXPECT_EQ( tasksRun, 2U );
+
+   // 4. Restore the built-in pool for the rest of the suite
+   e57::SetTaskRunner( {} );
+}
+
+TEST( SimpleData, ConcurrentReaderSessions )
+{
+   constexpr int64_t cNumScans = 2;
+   constexpr int64_t cNumPoints = 512;
+
+   // 1. Create a file with two scans holding distinguishable coordinates
+   {
+      e57::WriterOptions options;
+      options.guid = "Concurrent Reader File GUID";
+
+      e57::Writer writer( "./ConcurrentReaders.e57", options );
+
+      e57::Data3D header;
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t scan = 0; scan < cNumScans; ++scan )
+      {
+         header.guid = "Concurrent Reader Scan " + std::to_string( scan ) + " GUID";
+
+         for ( int64_t i = 0; i < cNumPoints; ++i )
+         {
+            pointsData.cartesianX[i] = static_cast<float>( i + scan * cNumPoints );
+            pointsData.cartesianY[i] = 0.0f;
+            pointsData.cartesianZ[i] = 0.0f;
+         }
+
+         writer.WriteData3DData( header, pointsData );
+      }
+   }
+
+   // 2. One read-only ImageFile, one CompressedVectorReader session per thread
+   e57::ImageFile imf( "./ConcurrentReaders.e57", "r" );
+
+   const e57::VectorNode data3D( imf.root().get( "data3D" ) );
+
+   // Not vector<bool>: each thread needs its own addressable element to write
+   std::vector<char> scanOK( cNumScans, 0 );
+   std::vector<std::thread> threads;
+
+   for ( int64_t scan = 0; scan < cNumScans; ++scan )
+   {
+      threads.emplace_back( [&, scan]() {
+         const e57::StructureNode scanNode( data3D.get( scan ) );
+         e57::CompressedVectorNode points( scanNode.get( "points" ) );
+
+         std::vector<float> xData( cNumPoints );
+
+         std::vector<e57::SourceDestBuffer> dbufs;
+         dbufs.emplace_back( imf, "cartesianX", xData.data(), cNumPoints, true );
+
+         e57::CompressedVectorReader vectorReader = points.reader( dbufs );
+
+         bool ok = ( vectorReader.read() == static_cast<unsigned>( cNumPoints ) );
+
+         vectorReader.close();
+
+         for ( int64_t i = 0; ok && ( i < cNumPoints ); i += 16 )
+         {
+            ok = ( xData[i] == static_cast<float>( i + scan * cNumPoints ) );
+         }
+
+         scanOK[static_cast<size_t>( scan )] = ok;
+      } );
+   }
+
+   for ( auto &thread : threads )
+   {
+      thread.join();
+   }
+
+   imf.close();
+
+   for ( int64_t scan = 0; scan < cNumScans; ++scan )
+   {
+      EXPECT_TRUE( scanOK[static_cast<size_t>( scan )] ) << "scan " << scan;
+   }
+}
+
+TEST( SimpleData, MemoryBudget )
+{
+   constexpr size_t cNumPoints = 20000;
+   constexpr uint64_t cBudget = 64 * 1024;
+
+   // 1. Create a file with one scan too large for the budgeted chunk buffers
+   {
+      e57::WriterOptions options;
+      options.guid = "Memory Budget File GUID";
+
+      e57::Writer writer( "./MemoryBudget.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Memory Budget Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( size_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   e57::ReaderOptions options;
+   options.memoryBudget = cBudget;
+
+   const e57::Reader reader( "./MemoryBudget.e57", options );
+
+   // 2. The budget must reach the underlying ImageFile
+   EXPECT_EQ( reader.GetRawIMF().memoryBudget(), cBudget );
+
+   // 3. estimatedSize() grows with the point count and covers the enabled fields
+   e57::Data3D header;
+
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+
+   const size_t bytesFor1K = e57::Data3DPointsFloat::estimatedSize( header, 1024 );
+
+   EXPECT_GE( bytesFor1K, 3 * sizeof( float ) * 1024 );
+   EXPECT_GT( e57::Data3DPointsFloat::estimatedSize( header, 2048 ), bytesFor1K );
+
+   // 4. A whole-scan chunk request degrades to budget-sized chunks, losing no points
+   size_t totalPoints = 0;
+   size_t largestChunk = 0;
+
+   const bool readOK = reader.ReadData3DChunks(
+      0, cNumPoints, [&]( const e57::Data3DPointsFloat &buffers, size_t count ) {
+         // Points must still arrive in order across the smaller chunks
+         EXPECT_FLOAT_EQ( buffers.cartesianX[0], static_cast<float>( totalPoints ) );
+
+         totalPoints += count;
+         largestChunk = std::max( largestChunk, count );
+
+         return true;
+      } );
+
+   ASSERT_TRUE( readOK );
+   EXPECT_EQ( totalPoints, cNumPoints );
+
+   // Each chunk's buffers must fit in half the budget
+   EXPECT_LT( largestChunk, cNumPoints );
+   EXPECT_LE( e57::Data3DPointsFloat::estimatedSize( header, largestChunk ), cBudget / 2 );
+}
+
+TEST( SimpleData, PointBufferAllocator )
+{
+   // Setting only one hook is an error
+   EXPECT_THROW(
+      e57::SetPointBufferAllocator( []( size_t bytes ) -> void * { return new char[bytes]; }, {} ),
+      e57::E57Exception );
+
+   int allocations = 0;
+   int deallocations = 0;
+
+   // 1. Route slab allocations through counting hooks
+   e57::SetPointBufferAllocator(
+      [&allocations]( size_t bytes ) -> void * {
+         ++allocations;
+         return new char[bytes];
+      },
+      [&deallocations]( void *buffer ) {
+         ++deallocations;
+         delete[] static_cast<char *>( buffer );
+      } );
+
+   {
+      e57::Data3D header;
+      header.pointCount = 128;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      EXPECT_EQ( allocations, 1 );
+      ASSERT_NE( pointsData.cartesianX, nullptr );
+
+      // The hooked slab must be usable like any other
+      pointsData.cartesianX[127] = 1.0f;
+      EXPECT_FLOAT_EQ( pointsData.cartesianX[127], 1.0f );
+
+      // 2. Restore default allocation while the slab is still alive; the slab must
+      // still be released through the deallocator it was allocated with
+      e57::SetPointBufferAllocator( {}, {} );
+   }
+
+   EXPECT_EQ( deallocations, 1 );
+}
+
+TEST( SimpleData, FilteredRead )
+{
+   constexpr int64_t cNumPoints = 1000;
+
+   // 1. Create a scan laid out along X with its true bounds in the header
+   {
+      e57::WriterOptions options;
+      options.guid = "Filtered Read File GUID";
+
+      e57::Writer writer( "./FilteredRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Filtered Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      header.cartesianBounds.xMinimum = 0.0;
+      header.cartesianBounds.xMaximum = 0.1 * ( cNumPoints - 1 );
+      header.cartesianBounds.yMinimum = 0.0;
+      header.cartesianBounds.yMaximum = 0.0;
+      header.cartesianBounds.zMinimum = 0.0;
+      header.cartesianBounds.zMaximum = 0.0;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i ) * 0.1f;
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   const e57::Reader reader( "./FilteredRead.e57", {} );
+
+   // 2. A box overlapping part of the scan delivers exactly the in-box points
+   e57::CartesianBounds filterBounds;
+   filterBounds.xMinimum = 2.05;
+   filterBounds.xMaximum = 5.05;
+   filterBounds.yMinimum = -1.0;
+   filterBounds.yMaximum = 1.0;
+   filterBounds.zMinimum = -1.0;
+   filterBounds.zMaximum = 1.0;
+
+   size_t deliveredPoints = 0;
+   bool allInBox = true;
+
+   bool readOK = reader.ReadData3DFiltered(
+      0, 128, filterBounds, [&]( const e57::Data3DPointsFloat &buffers, size_t count ) {
+         for ( size_t i = 0; i < count; ++i )
+         {
+            allInBox = allInBox && ( buffers.cartesianX[i] >= filterBounds.xMinimum ) &&
+                       ( buffers.cartesianX[i] <= filterBounds.xMaximum );
+         }
+
+         deliveredPoints += count;
+
+         return true;
+      } );
+
+   ASSERT_TRUE( readOK );
+   EXPECT_TRUE( allInBox );
+
+   // x = 2.1, 2.2, ..., 5.0
+   EXPECT_EQ( deliveredPoints, 30U );
+
+   // 3. A box disjoint from the scan bounds is culled without delivering anything
+   filterBounds.xMinimum = 1000.0;
+   filterBounds.xMaximum = 2000.0;
+
+   size_t culledDeliveries = 0;
+
+   readOK = reader.ReadData3DFiltered(
+      0, 128, filterBounds, [&]( const e57::Data3DPointsFloat &, size_t ) {
+         ++culledDeliveries;
+         return true;
+      } );
+
+   ASSERT_TRUE( readOK );
+   EXPECT_EQ( culledDeliveries, 0U );
+}
+
+TEST( SimpleData, ReadStatistics )
+{
+   constexpr int64_t cNumPoints = 256;
+
+   // 1. Create a file with known coordinate ranges
+   {
+      e57::WriterOptions options;
+      options.guid = "Read Statistics File GUID";
+
+      e57::Writer writer( "./ReadStatistics.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Read Statistics Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = -static_cast<float>( i );
+         pointsData.cartesianZ[i] = 5.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back with fused statistics enabled
+   e57::ImageFile imf( "./ReadStatistics.e57", "r" );
+
+   const e57::StructureNode scanNode( e57::VectorNode( imf.root().get( "data3D" ) ).get( 0 ) );
+   e57::CompressedVectorNode points( scanNode.get( "points" ) );
+
+   std::vector<float> xData( cNumPoints );
+   std::vector<float> yData( cNumPoints );
+
+   std::vector<e57::SourceDestBuffer> dbufs;
+   dbufs.emplace_back( imf, "cartesianX", xData.data(), 64, true );
+   dbufs.emplace_back( imf, "cartesianY", yData.data(), 64, true );
+
+   e57::CompressedVectorReader vectorReader = points.reader( dbufs );
+
+   vectorReader.setStatisticsEnabled( true );
+
+   // Statistics must accumulate across multiple read() calls
+   uint64_t totalRead = 0;
+   unsigned readCount = 0;
+
+   while ( ( readCount = vectorReader.read() ) > 0 )
+   {
+      totalRead += readCount;
+   }
+
+   const std::vector<e57::FieldStatistics> stats = vectorReader.statistics();
+
+   vectorReader.close();
+   imf.close();
+
+   EXPECT_EQ( totalRead, static_cast<uint64_t>( cNumPoints ) );
+
+   ASSERT_EQ( stats.size(), 2U );
+
+   EXPECT_EQ( stats[0].pathName, "cartesianX" );
+   EXPECT_EQ( stats[0].count, static_cast<uint64_t>( cNumPoints ) );
+   EXPECT_DOUBLE_EQ( stats[0].minimum, 0.0 );
+   EXPECT_DOUBLE_EQ( stats[0].maximum, static_cast<double>( cNumPoints - 1 ) );
+
+   EXPECT_EQ( stats[1].pathName, "cartesianY" );
+   EXPECT_DOUBLE_EQ( stats[1].minimum, -static_cast<double>( cNumPoints - 1 ) );
+   EXPECT_DOUBLE_EQ( stats[1].maximum, 0.0 );
+}
+
+TEST( SimpleData, MemoryUsage )
+{
+   constexpr int64_t cNumPoints = 512;
+
+   // 1. Create a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Memory Usage File GUID";
+
+      e57::Writer writer( "./MemoryUsage.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Memory Usage Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. A freshly opened file holds only its parsed metadata tree
+   e57::ImageFile imf( "./MemoryUsage.e57", "r" );
+
+   e57::MemoryUsage atOpen = imf.memoryUsage();
+
+   EXPECT_GT( atOpen.nodeTreeBytes, 0U );
+   EXPECT_EQ( atOpen.packetCacheBytes, 0U );
+   EXPECT_EQ( atOpen.decodeBufferBytes, 0U );
+
+   // 3. An open reader session adds its packet cache and decoder staging buffers
+   const e57::StructureNode scanNode( e57::VectorNode( imf.root().get( "data3D" ) ).get( 0 ) );
+   e57::CompressedVectorNode points( scanNode.get( "points" ) );
+
+   std::vector<float> xData( cNumPoints );
+
+   std::vector<e57::SourceDestBuffer> dbufs;
+   dbufs.emplace_back( imf, "cartesianX", xData.data(), 64, true );
+
+   e57::CompressedVectorReader vectorReader = points.reader( dbufs );
+
+   e57::MemoryUsage whileReading = imf.memoryUsage();
+
+   EXPECT_GT( whileReading.packetCacheBytes, 0U );
+   EXPECT_GT( whileReading.decodeBufferBytes, 0U );
+
+   // 4. Closing the session releases the live bytes but keeps the high-water marks
+   vectorReader.close();
+
+   e57::MemoryUsage afterClose = imf.memoryUsage();
+
+   EXPECT_EQ( afterClose.packetCacheBytes, 0U );
+   EXPECT_EQ( afterClose.decodeBufferBytes, 0U );
+   EXPECT_EQ( afterClose.packetCachePeakBytes, whileReading.packetCacheBytes );
+   EXPECT_EQ( afterClose.decodeBufferPeakBytes, whileReading.decodeBufferBytes );
+
+   imf.close();
+}
+
+TEST( SimpleData, MemoryAllocator )
+{
+   // Setting only one hook is an error
+   EXPECT_THROW( e57::SetMemoryAllocator(
+                    []( size_t bytes ) -> void * { return new char[bytes]; }, {} ),
+                 e57::E57Exception );
+
+   // 1. Write a small file with the default allocator
+   {
+      e57::WriterOptions options;
+      options.guid = "Memory Allocator File GUID";
+
+      e57::Writer writer( "./MemoryAllocator.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Memory Allocator Scan GUID";
+      header.pointCount = 512;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < header.pointCount; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   int allocations = 0;
+   int deallocations = 0;
+
+   // 2. Route the library's internal buffers through counting hooks
+   e57::SetMemoryAllocator(
+      [&allocations]( size_t bytes ) -> void * {
+         ++allocations;
+         return new char[bytes];
+      },
+      [&deallocations]( void *block, size_t ) {
+         ++deallocations;
+         delete[] static_cast<char *>( block );
+      } );
+
+   {
+      const e57::Reader reader( "./MemoryAllocator.e57", {} );
+
+      e57::Data3D header;
+      ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+      EXPECT_EQ( header.pointCount, 512 );
+   }
+
+   // 3. Restore the default allocator; every hooked allocation must have been
+   // released through the matching hook
+   e57::SetMemoryAllocator( {}, {} );
+
+   EXPECT_GT( allocations, 0 );
+   EXPECT_EQ( deallocations, allocations );
+}
+
+TEST( SimpleData, ReadBackend )
+{
+   // 1. Write a small file the normal way
+   {
+      e57::WriterOptions options;
+      options.guid = "Read Backend File GUID";
+
+      e57::Writer writer( "./ReadBackend.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Read Backend Scan GUID";
+      header.pointCount = 1024;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < header.pointCount; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Slurp the bytes and serve them through a counting ReadBackend
+   std::vector<char> bytes;
+
+   {
+      std::ifstream in( "./ReadBackend.e57", std::ios::binary );
+      ASSERT_TRUE( in.good() );
+      bytes.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+   }
+
+   class MemoryBackend : public e57::ReadBackend
+   {
+   public:
+      explicit MemoryBackend( const std::vector<char> &bytes ) : bytes_( bytes )
+      {
+      }
+
+      uint64_t length() override
+      {
+         return bytes_.size();
+      }
+
+      void readAt( uint64_t offset, char *buffer, size_t count ) override
+      {
+         ASSERT_LE( offset + count, bytes_.size() );
+         std::memcpy( buffer, bytes_.data() + offset, count );
+         ++reads;
+      }
+
+      int reads = 0;
+
+   private:
+      const std::vector<char> &bytes_;
+   };
+
+   auto backend = std::make_shared<MemoryBackend>( bytes );
+
+   // 3. Open through the backend and read the points back
+   e57::ImageFile imf( backend );
+
+   ASSERT_TRUE( imf.isOpen() );
+
+   const e57::StructureNode scanNode( e57::VectorNode( imf.root().get( "data3D" ) ).get( 0 ) );
+   e57::CompressedVectorNode points( scanNode.get( "points" ) );
+
+   ASSERT_EQ( points.childCount(), 1024 );
+
+   std::vector<float> xData( 1024 );
+   std::vector<e57::SourceDestBuffer> destBuffers;
+   destBuffers.emplace_back( imf, "cartesianX", xData.data(), xData.size(), true );
+
+   e57::CompressedVectorReader vectorReader = points.reader( destBuffers );
+
+   ASSERT_EQ( vectorReader.read(), 1024U );
+   EXPECT_FLOAT_EQ( xData[1023], 1023.0f );
+
+   vectorReader.close();
+   imf.close();
+
+   EXPECT_GT( backend->reads, 0 );
+}
+
+TEST( SimpleData, TieredChecksum )
+{
+   constexpr int64_t cNumPoints = 4096;
+
+   // 1. Write a file to verify
+   {
+      e57::WriterOptions options;
+      options.guid = "Tiered Checksum File GUID";
+
+      e57::Writer writer( "./TieredChecksum.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Tiered Checksum Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back under the tiered policy: data pages are verified in the background
+   e57::ImageFile imf( "./TieredChecksum.e57", "r", e57::ChecksumTiered );
+
+   std::atomic<int> mismatches( 0 );
+
+   imf.setChecksumMismatchCallback(
+      [&mismatches]( const e57::E57Exception & ) { ++mismatches; } );
+
+   const e57::StructureNode scanNode( e57::VectorNode( imf.root().get( "data3D" ) ).get( 0 ) );
+   e57::CompressedVectorNode points( scanNode.get( "points" ) );
+
+   std::vector<float> xData( cNumPoints );
+   std::vector<e57::SourceDestBuffer> destBuffers;
+   destBuffers.emplace_back( imf, "cartesianX", xData.data(), xData.size(), true );
+
+   e57::CompressedVectorReader vectorReader = points.reader( destBuffers );
+
+   ASSERT_EQ( vectorReader.read(), static_cast<unsigned>( cNumPoints ) );
+   EXPECT_FLOAT_EQ( xData[cNumPoints - 1], static_cast<float>( cNumPoints - 1 ) );
+
+   vectorReader.close();
+
+   // 3. Wait for the verifier to catch up, then close; the file is intact, so the
+   // mismatch callback must never have fired
+   while ( imf.checksumVerifyPending() > 0 )
+   {
+      std::this_thread::yield();
+   }
+
+   imf.close();
+
+   EXPECT_EQ( mismatches.load(), 0 );
+}
+
+TEST( SimpleData, CompactedRead )
+{
+   constexpr int64_t cNumPoints = 2048;
+
+   // 1. Write a scan where every third point is flagged invalid
+   {
+      e57::WriterOptions options;
+      options.guid = "Compacted Read File GUID";
+
+      e57::Writer writer( "./CompactedRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Compacted Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+      header.pointFields.cartesianInvalidStateField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+         pointsData.cartesianInvalidState[i] = ( i % 3 == 0 ) ? 2 : 0;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back compacted: only the valid points may be delivered
+   const e57::Reader reader( "./CompactedRead.e57", {} );
+
+   uint64_t totalDelivered = 0;
+   bool allValid = true;
+   bool allExpected = true;
+
+   const bool ok = reader.ReadData3DCompacted(
+      0, 512,
+      [&]( const e57::Data3DPointsFloat &buffers, size_t count ) {
+         totalDelivered += count;
+
+         for ( size_t i = 0; i < count; ++i )
+         {
+            if ( buffers.cartesianInvalidState[i] != 0 )
+            {
+               allValid = false;
+            }
+
+            // Valid points keep file order; their x values are the non-multiples of 3
+            if ( static_cast<int64_t>( buffers.cartesianX[i] ) % 3 == 0 )
+            {
+               allExpected = false;
+            }
+         }
+
+         return true;
+      } );
+
+   ASSERT_TRUE( ok );
+
+   // 2048 points minus the 683 multiples of 3 below 2048
+   EXPECT_EQ( totalDelivered, static_cast<uint64_t>( cNumPoints - ( cNumPoints + 2 ) / 3 ) );
+   EXPECT_TRUE( allValid );
+   EXPECT_TRUE( allExpected );
+}
+
+TEST( SimpleData, PredicatedRead )
+{
+   constexpr int64_t cNumPoints = 2048;
+
+   // 1. Write a scan with a ramp of intensities and alternating return indices
+   {
+      e57::WriterOptions options;
+      options.guid = "Predicated Read File GUID";
+
+      e57::Writer writer( "./PredicatedRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Predicated Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+      header.pointFields.intensityField = true;
+      header.pointFields.returnIndexField = true;
+      header.pointFields.returnCountField = true;
+      header.pointFields.returnMaximum = 1;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+         pointsData.intensity[i] = static_cast<double>( i ) / cNumPoints;
+         pointsData.returnIndex[i] = static_cast<int8_t>( i % 2 );
+         pointsData.returnCount[i] = 2;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Select the bright first returns: intensity >= 0.5 and returnIndex == 0
+   const e57::Reader reader( "./PredicatedRead.e57", {} );
+
+   std::vector<e57::FieldPredicate> predicates( 2 );
+   predicates[0].pathName = "intensity";
+   predicates[0].minimum = 0.5;
+   predicates[1].pathName = "returnIndex";
+   predicates[1].maximum = 0.0;
+
+   uint64_t totalDelivered = 0;
+   bool allExpected = true;
+
+   bool ok = reader.ReadData3DPredicated(
+      0, 512, predicates,
+      [&]( const e57::Data3DPointsFloat &buffers, size_t count ) {
+         totalDelivered += count;
+
+         for ( size_t i = 0; i < count; ++i )
+         {
+            // Survivors keep file order: even x values in the upper half of the ramp
+            const auto x = static_cast<int64_t>( buffers.cartesianX[i] );
+
+            if ( ( x % 2 != 0 ) || ( x < cNumPoints / 2 ) )
+            {
+               allExpected = false;
+            }
+         }
+
+         return true;
+      } );
+
+   ASSERT_TRUE( ok );
+
+   // Half the points pass the intensity test, and half of those are first returns
+   EXPECT_EQ( totalDelivered, static_cast<uint64_t>( cNumPoints / 4 ) );
+   EXPECT_TRUE( allExpected );
+
+   // 3. A predicate on a field the scan does not carry is an error
+   std::vector<e57::FieldPredicate> badPredicates( 1 );
+   badPredicates[0].pathName = "sphericalRange";
+
+   ok = reader.ReadData3DPredicated(
+      0, 512, badPredicates,
+      []( const e57::Data3DPointsFloat &, size_t ) { return true; } );
+
+   EXPECT_FALSE( ok );
+}
+
+TEST( SimpleData, SharedPacketCache )
+{
+   constexpr int64_t cNumPoints = 2048;
+
+   // 1. Create a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Shared Packet Cache File GUID";
+
+      e57::Writer writer( "./SharedPacketCache.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Shared Packet Cache Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i ) * 2.0f;
+         pointsData.cartesianZ[i] = 1.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   e57::ReaderOptions options;
+   options.sharedPacketCache = true;
+
+   // 2. A first reader populates the shared segment as it pulls packets off the disk.
+   //    It stays open so the segment outlives it (the last detaching reader removes it).
+   e57::Reader firstReader( "./SharedPacketCache.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( firstReader.ReadData3D( 0, header ) );
+
+   {
+      e57::Data3DPointsFloat pointsData( header );
+
+      auto vectorReader = firstReader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+      ASSERT_EQ( vectorReader.read(), cNumPoints );
+      vectorReader.close();
+   }
+
+   // 3. A second reader (standing in for another process) attaches to the same segment
+   //    and must see the same data
+   {
+      e57::Reader secondReader( "./SharedPacketCache.e57", options );
+
+      e57::Data3D secondHeader;
+      ASSERT_TRUE( secondReader.ReadData3D( 0, secondHeader ) );
+
+      e57::Data3DPointsFloat pointsData( secondHeader );
+
+      auto vectorReader = secondReader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+      ASSERT_EQ( vectorReader.read(), cNumPoints );
+      vectorReader.close();
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+         ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( i ) * 2.0f );
+      }
+
+#if !defined( _WIN32 )
+      // On platforms with the POSIX backend the packets must have come from the segment
+      EXPECT_GT( secondReader.GetStats().packetCacheSharedHits, 0U );
+#endif
+
+      EXPECT_TRUE( secondReader.Close() );
+   }
+
+   EXPECT_TRUE( firstReader.Close() );
+}
+
+TEST( SimpleData, MappedRead )
+{
+   constexpr int64_t cNumPoints = 4096;
+
+   // 1. Create a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Mapped Read File GUID";
+
+      e57::Writer writer( "./MappedRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Mapped Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( cNumPoints - i );
+         pointsData.cartesianZ[i] = 0.5f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back through the whole-file mapping
+   e57::ReaderOptions options;
+   options.mappedRead = true;
+
+   e57::Reader reader( "./MappedRead.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+   EXPECT_EQ( header.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( cNumPoints - i ) );
+   }
+
+   // CRCs are still verified (in place, on the mapped bytes)
+   EXPECT_GT( reader.GetStats().crcVerifications, 0U );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, ParallelChecksum )
+{
+   constexpr int64_t cNumPoints = 8192;
+
+   // 1. Create a file big enough that its reads span many pages
+   {
+      e57::WriterOptions options;
+      options.guid = "Parallel Checksum File GUID";
+
+      e57::Writer writer( "./ParallelChecksum.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Parallel Checksum Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i % 97 );
+         pointsData.cartesianZ[i] = -1.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back with the parallel verification policy; every page is still checked
+   e57::ReaderOptions options;
+   options.checksumPolicy = e57::ChecksumParallel;
+
+   e57::Reader reader( "./ParallelChecksum.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( i % 97 ) );
+   }
+
+   EXPECT_GT( reader.GetStats().crcVerifications, 0U );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, DirectRead )
+{
+   constexpr int64_t cNumPoints = 4096;
+
+   // 1. Create a file with one scan
+   {
+      e57::WriterOptions options;
+      options.guid = "Direct Read File GUID";
+
+      e57::Writer writer( "./DirectRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Direct Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( cNumPoints - i );
+         pointsData.cartesianZ[i] = 2.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back with direct I/O requested; where O_DIRECT is unavailable the
+   // option is a silent no-op and this reads through the page cache
+   e57::ReaderOptions options;
+   options.directRead = true;
+
+   e57::Reader reader( "./DirectRead.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+   EXPECT_EQ( header.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( cNumPoints - i ) );
+   }
+
+   // CRCs are still verified on the directly read bytes
+   EXPECT_GT( reader.GetStats().crcVerifications, 0U );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, PacketReadAhead )
+{
+   constexpr int64_t cNumPoints = 16384;
+
+   // 1. Create a file whose scan spans several packets
+   {
+      e57::WriterOptions options;
+      options.guid = "Packet Read Ahead File GUID";
+
+      e57::Writer writer( "./PacketReadAhead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Packet Read Ahead Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i % 89 );
+         pointsData.cartesianZ[i] = 1.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back sequentially with background read-ahead staging packets
+   e57::ReaderOptions options;
+   options.packetReadAhead = 4;
+
+   e57::Reader reader( "./PacketReadAhead.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+   EXPECT_EQ( header.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( i % 89 ) );
+   }
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, PacketCacheSize )
+{
+   constexpr int64_t cNumPoints = 16384;
+
+   // 1. Create a file whose scan spans several packets
+   {
+      e57::WriterOptions options;
+      options.guid = "Packet Cache Size File GUID";
+
+      e57::Writer writer( "./PacketCacheSize.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Packet Cache Size Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i % 53 );
+         pointsData.cartesianZ[i] = -2.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Read it back through an enlarged packet cache
+   e57::ReaderOptions options;
+   options.packetCacheSize = 128;
+
+   e57::Reader reader( "./PacketCacheSize.e57", options );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+   EXPECT_EQ( header.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+   ASSERT_EQ( vectorReader.read(), cNumPoints );
+   vectorReader.close();
+
+   for ( int64_t i = 0; i < cNumPoints; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( i % 53 ) );
+   }
+
+   // Interleaved bytestream reads revisit packets, so the enlarged cache sees hits
+   EXPECT_GT( reader.GetStats().packetCacheHits, 0U );
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, SeekRead )
+{
+   constexpr int64_t cNumPoints = 16384;
+   constexpr int64_t cSeekForward = 10000;
+   constexpr int64_t cSeekBack = 4000;
+
+   // 1. Create a file whose scan spans several packets
+   {
+      e57::WriterOptions options;
+      options.guid = "Seek Read File GUID";
+
+      e57::Writer writer( "./SeekRead.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Seek Read Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i % 97 );
+         pointsData.cartesianZ[i] = -1.0f;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. Seek forward past most of the scan and read the tail
+   e57::Reader reader( "./SeekRead.e57", {} );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+   EXPECT_EQ( header.pointCount, cNumPoints );
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   auto vectorReader = reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+
+   vectorReader.seek( cSeekForward );
+   ASSERT_EQ( vectorReader.read(), static_cast<unsigned>( cNumPoints - cSeekForward ) );
+
+   for ( int64_t i = 0; i < cNumPoints - cSeekForward; ++i )
+   {
+      ASSERT_FLOAT_EQ( pointsData.cartesianX[i], static_cast<float>( cSeekForward + i ) );
+      ASSERT_FLOAT_EQ( pointsData.cartesianY[i], static_cast<float>( ( cSeekForward + i ) % 97 ) );
+   }
+
+   // 3. Seeking backward works too
+   vectorReader.seek( cSeekBack );
+   ASSERT_EQ( vectorReader.read(), static_cast<unsigned>( cNumPoints - cSeekBack ) );
+   ASSERT_FLOAT_EQ( pointsData.cartesianX[0], static_cast<float>( cSeekBack ) );
+   ASSERT_FLOAT_EQ( pointsData.cartesianY[0], static_cast<float>( cSeekBack % 97 ) );
+
+   // 4. Seeking to one past the end is allowed and yields an empty read
+   vectorReader.seek( cNumPoints );
+   EXPECT_EQ( vectorReader.read(), 0U );
+
+   vectorReader.close();
+
+   EXPECT_TRUE( reader.Close() );
+}
+
+TEST( SimpleData, TightenedIndexBounds )
+{
+   constexpr int64_t cNumPoints = 1000;
+   constexpr int32_t cNumColumns = 50;
+
+   // 1. Write a gridded scan, leaving the index maxima at their defaults so the
+   // writer tightens them from the data
+   {
+      e57::WriterOptions options;
+      options.guid = "Tightened Index Bounds File GUID";
+
+      e57::Writer writer( "./TightenedIndexBounds.e57", options );
+
+      e57::Data3D header;
+      header.guid = "Tightened Index Bounds Scan GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+      header.pointFields.rowIndexField = true;
+      header.pointFields.columnIndexField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( int64_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = 0.0f;
+         pointsData.cartesianZ[i] = 0.0f;
+         pointsData.rowIndex[i] = static_cast<int32_t>( i ) / cNumColumns;
+         pointsData.columnIndex[i] = static_cast<int32_t>( i ) % cNumColumns;
+      }
+
+      writer.WriteData3DData( header, pointsData );
+   }
+
+   // 2. The prototype integer bounds must match the data, not the 32-bit defaults
+   {
+      e57::ImageFile imf( "./TightenedIndexBounds.e57", "r" );
+
+      const e57::StructureNode scan( e57::VectorNode( imf.root().get( "data3D" ) ).get( 0 ) );
+      const e57::CompressedVectorNode points( scan.get( "points" ) );
+      const e57::StructureNode proto( points.prototype() );
+
+      const e57::IntegerNode rowNode( proto.get( "rowIndex" ) );
+      const e57::IntegerNode columnNode( proto.get( "columnIndex" ) );
+
+      EXPECT_EQ( rowNode.maximum(), ( cNumPoints - 1 ) / cNumColumns );
+      EXPECT_EQ( columnNode.maximum(), cNumColumns - 1 );
+
+      imf.close();
+   }
+
+   // 3. The values themselves must round-trip unchanged
+   const e57::Reader reader( "./TightenedIndexBounds.e57", {} );
+
+   e57::Data3D header;
+   ASSERT_TRUE( reader.ReadData3D( 0, header ) );
+
+   e57::Data3DPointsFloat pointsData( header );
+   e57::CompressedVectorReader vectorReader =
+      reader.SetUpData3DPointsData( 0, cNumPoints, pointsData );
+
+   ASSERT_EQ( vectorReader.read(), static_cast<unsigned>( cNumPoints ) );
+
+   EXPECT_EQ( pointsData.rowIndex[cNumPoints - 1], ( cNumPoints - 1 ) / cNumColumns );
+   EXPECT_EQ( pointsData.columnIndex[cNumPoints - 1], ( cNumPoints - 1 ) % cNumColumns );
+
+   vectorReader.close();
+}
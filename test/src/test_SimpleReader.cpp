@@ -216,6 +216,47 @@ TEST( SimpleReaderData, ColouredCubeFloat )
    delete reader;
 }
 
+TEST( SimpleReaderData, ReadStats )
+{
+   e57::Reader *reader = nullptr;
+
+   E57_ASSERT_NO_THROW(
+      reader = new e57::Reader( TestData::Path() + "/self/ColouredCubeFloat.e57", {} ) );
+
+   ASSERT_TRUE( reader->IsOpen() );
+
+   e57::Data3D data3DHeader;
+   ASSERT_TRUE( reader->ReadData3D( 0, data3DHeader ) );
+
+   const uint64_t cNumPoints = data3DHeader.pointCount;
+
+   e57::Data3DPointsFloat pointsData( data3DHeader );
+
+   auto vectorReader = reader->SetUpData3DPointsData( 0, cNumPoints, pointsData );
+
+   vectorReader.read();
+   vectorReader.close();
+
+   const e57::ReaderStats stats = reader->GetStats();
+
+   // Opening a file reads the header and XML; reading points reads packets.
+   EXPECT_GT( stats.bytesRead, 0 );
+   EXPECT_GT( stats.packetCacheMisses, 0 );
+
+   // Default checksum policy is ChecksumAll, so pages must have been verified.
+   EXPECT_GT( stats.crcVerifications, 0 );
+
+   // One decode channel per point field (xyz + rgb), each of which consumed bytes.
+   ASSERT_EQ( stats.bytesDecodedPerChannel.size(), 6 );
+
+   for ( const uint64_t bytesDecoded : stats.bytesDecodedPerChannel )
+   {
+      EXPECT_GT( bytesDecoded, 0 );
+   }
+
+   delete reader;
+}
+
 TEST( SimpleReaderData, ColouredCubeFloatToDouble )
 {
    e57::Reader *reader = nullptr;
@@ -705,3 +705,109 @@ TEST( SimpleWriterData, VisualRefImage )
 
    delete writer;
 }
+
+// The preallocation hint is best-effort and must not change what ends up in the file: the
+// reservation is released on Close(), so a wildly over-estimated hint still produces a
+// normal-sized, readable file.
+TEST( SimpleWriter, FileSizeHint )
+{
+   constexpr uint16_t cNumPoints = 128;
+
+   e57::WriterOptions options;
+   options.guid = "File Size Hint GUID";
+   options.expectedFileSizeHint = 16 * 1024 * 1024;
+
+   e57::Writer *writer = nullptr;
+
+   E57_ASSERT_NO_THROW( writer = new e57::Writer( "./FileSizeHint.e57", options ) );
+
+   e57::Data3D header;
+   header.guid = "File Size Hint Header GUID";
+   header.pointCount = cNumPoints;
+   header.pointFields.cartesianXField = true;
+   header.pointFields.cartesianYField = true;
+   header.pointFields.cartesianZField = true;
+
+   e57::Data3DPointsFloat pointsData( header );
+
+   for ( uint16_t i = 0; i < cNumPoints; ++i )
+   {
+      pointsData.cartesianX[i] = static_cast<float>( i );
+      pointsData.cartesianY[i] = static_cast<float>( i );
+      pointsData.cartesianZ[i] = static_cast<float>( i );
+   }
+
+   E57_ASSERT_NO_THROW( writer->WriteData3DData( header, pointsData ) );
+
+   delete writer;
+
+   // The file must be far smaller than the hint and still read back cleanly
+   std::ifstream file( "./FileSizeHint.e57", std::ifstream::ate | std::ifstream::binary );
+
+   ASSERT_EQ( file.rdstate(), std::ios_base::goodbit );
+   EXPECT_LT( file.tellg(), 1024 * 1024 );
+
+   file.close();
+
+   E57_ASSERT_NO_THROW( e57::ImageFile imf( "./FileSizeHint.e57", "r" ) );
+}
+
+// The memory-backed writer must produce a byte-for-byte complete E57 file in the buffer,
+// readable through the ImageFile buffer constructor without ever touching disk.
+TEST( SimpleWriter, MemoryBuffer )
+{
+   constexpr uint16_t cNumPoints = 64;
+
+   std::vector<char> buffer;
+
+   e57::WriterOptions options;
+   options.guid = "Memory Buffer File GUID";
+
+   {
+      e57::Writer writer( buffer, options );
+
+      e57::Data3D header;
+      header.guid = "Memory Buffer Header GUID";
+      header.pointCount = cNumPoints;
+      header.pointFields.cartesianXField = true;
+      header.pointFields.cartesianYField = true;
+      header.pointFields.cartesianZField = true;
+
+      e57::Data3DPointsFloat pointsData( header );
+
+      for ( uint16_t i = 0; i < cNumPoints; ++i )
+      {
+         pointsData.cartesianX[i] = static_cast<float>( i );
+         pointsData.cartesianY[i] = static_cast<float>( i );
+         pointsData.cartesianZ[i] = static_cast<float>( i );
+      }
+
+      E57_ASSERT_NO_THROW( writer.WriteData3DData( header, pointsData ) );
+
+      EXPECT_TRUE( writer.Close() );
+   }
+
+   // A checksummed page per kilobyte plus the XML section
+   ASSERT_GT( buffer.size(), 1024u );
+   EXPECT_EQ( buffer.size() % 1024, 0u );
+
+   // Read it back directly from memory
+   e57::ImageFile imf( buffer.data(), buffer.size() );
+
+   ASSERT_TRUE( imf.isOpen() );
+
+   const e57::StructureNode root = imf.root();
+
+   EXPECT_EQ( e57::StringNode( root.get( "guid" ) ).value(), "Memory Buffer File GUID" );
+
+   const e57::VectorNode data3D( root.get( "/data3D" ) );
+
+   ASSERT_EQ( data3D.childCount(), 1 );
+
+   const e57::StructureNode scan( data3D.get( 0 ) );
+   const e57::CompressedVectorNode points( scan.get( "points" ) );
+
+   EXPECT_EQ( points.childCount(), cNumPoints );
+
+   imf.close();
+}